@@ -65,7 +65,11 @@ BufferQueue::BufferQueue(const std::string &name, bool isShared)
 BufferQueue::~BufferQueue()
 {
     BLOGNI("dtor, Queue id: %{public}" PRIu64 "", uniqueId_);
-    // we don't have to do anything
+    if (onBufferDelete != nullptr) {
+        for (const auto &[sequence, element] : bufferQueueCache_) {
+            onBufferDelete(sequence);
+        }
+    }
 }
 
 GSError BufferQueue::Init()
@@ -536,6 +540,9 @@ void BufferQueue::DeleteBufferInCache(int32_t sequence)
     if (it != bufferQueueCache_.end()) {
         bufferQueueCache_.erase(it);
         deletingList_.push_back(sequence);
+        if (onBufferDelete != nullptr) {
+            onBufferDelete(sequence);
+        }
     }
 }
 
@@ -656,6 +663,9 @@ GSError BufferQueue::DetachBuffer(sptr<SurfaceBuffer> &buffer)
     }
 
     bufferQueueCache_.erase(sequence);
+    if (onBufferDelete != nullptr) {
+        onBufferDelete(sequence);
+    }
     return GSERROR_OK;
 }
 
@@ -715,6 +725,13 @@ GSError BufferQueue::RegisterReleaseListener(OnReleaseFunc func)
     return GSERROR_OK;
 }
 
+GSError BufferQueue::RegisterDeleteBufferListener(OnDeleteBufferFunc func)
+{
+    std::lock_guard<std::mutex> lockGuard(mutex_);
+    onBufferDelete = func;
+    return GSERROR_OK;
+}
+
 GSError BufferQueue::SetDefaultWidthAndHeight(int32_t width, int32_t height)
 {
     if (width <= 0) {
@@ -756,6 +773,11 @@ uint32_t BufferQueue::GetDefaultUsage()
 GSError BufferQueue::CleanCache()
 {
     std::lock_guard<std::mutex> lockGuard(mutex_);
+    if (onBufferDelete != nullptr) {
+        for (const auto &[sequence, element] : bufferQueueCache_) {
+            onBufferDelete(sequence);
+        }
+    }
     bufferQueueCache_.clear();
     freeList_.clear();
     dirtyList_.clear();
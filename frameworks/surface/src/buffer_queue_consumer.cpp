@@ -89,6 +89,14 @@ GSError BufferQueueConsumer::RegisterReleaseListener(OnReleaseFunc func)
     return bufferQueue_->RegisterReleaseListener(func);
 }
 
+GSError BufferQueueConsumer::RegisterDeleteBufferListener(OnDeleteBufferFunc func)
+{
+    if (bufferQueue_ == nullptr) {
+        return GSERROR_INVALID_ARGUMENTS;
+    }
+    return bufferQueue_->RegisterDeleteBufferListener(func);
+}
+
 GSError BufferQueueConsumer::UnregisterConsumerListener()
 {
     if (bufferQueue_ == nullptr) {
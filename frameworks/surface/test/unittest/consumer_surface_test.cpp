@@ -395,4 +395,56 @@ HWTEST_F(ConsumerSurfaceTest, isSupportedAlloc001, Function | MediumTest | Level
     GSError ret = cs->IsSupportedAlloc(infos, supporteds);
     ASSERT_EQ(ret, OHOS::GSERROR_NOT_SUPPORT);
 }
+
+/*
+* Function: RegisterDeleteBufferListener
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. call RegisterDeleteBufferListener on a new consumer surface
+*                  2. request, flush, acquire and detach a buffer
+*                  3. check the listener gets the sequence of the detached buffer
+*                  4. call CleanCache and check the listener gets the remaining buffer
+ */
+HWTEST_F(ConsumerSurfaceTest, RegisterDeleteBufferListener001, Function | MediumTest | Level2)
+{
+    sptr<Surface> csurf = Surface::CreateSurfaceAsConsumer();
+    sptr<IBufferConsumerListener> listener = new BufferConsumerListener();
+    csurf->RegisterConsumerListener(listener);
+    auto producer = csurf->GetProducer();
+    sptr<Surface> psurf = Surface::CreateSurfaceAsProducer(producer);
+    ASSERT_EQ(psurf->RegisterDeleteBufferListener(nullptr), OHOS::GSERROR_NOT_SUPPORT);
+
+    std::vector<int32_t> deleted;
+    auto func = [&deleted](int32_t sequence) {
+        deleted.push_back(sequence);
+    };
+    GSError ret = csurf->RegisterDeleteBufferListener(func);
+    ASSERT_EQ(ret, OHOS::GSERROR_OK);
+
+    sptr<SurfaceBuffer> buffer;
+    int releaseFence = -1;
+    ret = psurf->RequestBuffer(buffer, releaseFence, requestConfig);
+    ASSERT_EQ(ret, OHOS::GSERROR_OK);
+    ret = psurf->FlushBuffer(buffer, -1, flushConfig);
+    ASSERT_EQ(ret, OHOS::GSERROR_OK);
+
+    sptr<SurfaceBuffer> acquired;
+    int32_t flushFence;
+    ret = csurf->AcquireBuffer(acquired, flushFence, timestamp, damage);
+    ASSERT_EQ(ret, OHOS::GSERROR_OK);
+    ret = csurf->DetachBuffer(acquired);
+    ASSERT_EQ(ret, OHOS::GSERROR_OK);
+    ASSERT_EQ(deleted.size(), 1u);
+    ASSERT_EQ(deleted[0], acquired->GetSeqNum());
+
+    ret = psurf->RequestBuffer(buffer, releaseFence, requestConfig);
+    ASSERT_EQ(ret, OHOS::GSERROR_OK);
+    ret = psurf->CancelBuffer(buffer);
+    ASSERT_EQ(ret, OHOS::GSERROR_OK);
+    ret = csurf->CleanCache();
+    ASSERT_EQ(ret, OHOS::GSERROR_OK);
+    ASSERT_EQ(deleted.size(), 2u);
+    ASSERT_EQ(deleted[1], buffer->GetSeqNum());
+}
 }
@@ -16,20 +16,48 @@
 #ifndef FRAMEWORKS_WM_INCLUDE_SUBWINDOW_OFFSCREEN_IMPL_H
 #define FRAMEWORKS_WM_INCLUDE_SUBWINDOW_OFFSCREEN_IMPL_H
 
+#include <mutex>
+#include <queue>
+
 #include "subwindow_normal_impl.h"
 
 namespace OHOS {
+// The frame available callback runs on a frame worker shared by all offscreen subwindows, so the thread that flushes
+// the buffer returns at once and the fence of the callback goes to the server without waiting for the GPU. The worker
+// acquires the buffers too: acquiring makes the EGL context of the acquiring thread current, so every buffer and
+// callback stays on one thread and one context.
 class SubwindowOffscreenImpl : public SubwindowNormalImpl {
 public:
+    virtual GSError Destroy() override;
+
     virtual GSError OnFrameAvailable(FrameAvailableFunc func) override;
+    virtual GSError SetFrameQueueDepth(uint32_t depth) override;
+    virtual GSError GetFrameStatistics(struct SubwindowFrameStatistics &statistics) override;
 
 protected:
+    virtual ~SubwindowOffscreenImpl() override;
     virtual void OnBufferAvailable() override;
     virtual GSError CreateConsumerSurface(const sptr<SubwindowOption> &option) override;
 
 private:
-    int32_t GLOperation(sptr<SurfaceBuffer> &sbuffer);
+    static constexpr uint32_t DEFAULT_FRAME_QUEUE_DEPTH = 3;
+
+    void StopFrames();
+    // takes the oldest frame of the queue, runs on the frame worker
+    void ProcessNextFrame();
+    // acquires the next buffer, then releases it if [drop], else processes and sends it
+    void ProcessFrame(int64_t availableTime, bool drop, const FrameAvailableFunc &func);
+    int32_t GLOperation(sptr<SurfaceBuffer> &sbuffer, const FrameAvailableFunc &func);
+    void RecordFrame(int64_t availableTime, int64_t processTime);
+    void RecordFailedFrame();
 
+    // guards the members below
+    std::mutex frameMutex;
+    // the times the buffers became available, oldest first
+    std::queue<int64_t> frameQueue;
+    uint32_t frameQueueDepth = DEFAULT_FRAME_QUEUE_DEPTH;
+    bool framesStopped = false;
+    struct SubwindowFrameStatistics statistics = {};
     FrameAvailableFunc onFrameAvailable = nullptr;
 };
 } // namespace OHOS
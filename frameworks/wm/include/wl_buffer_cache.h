@@ -16,6 +16,9 @@
 #ifndef FRAMEWORKS_WM_INCLUDE_WL_BUFFER_CACHE_H
 #define FRAMEWORKS_WM_INCLUDE_WL_BUFFER_CACHE_H
 
+#include <mutex>
+#include <unordered_map>
+
 #include <refbase.h>
 #include <surface.h>
 
@@ -52,12 +55,40 @@ private:
     static inline sptr<WlBufferCache> instance = nullptr;
     static inline SingletonDelegator<WlBufferCache> delegator;
 
+    // a buffer is known by the unique id of its consumer surface and its sequence in the queue of the surface
+    struct BufferKey {
+        uint64_t surfaceId;
+        int32_t sequence;
+
+        bool operator==(const BufferKey &other) const
+        {
+            return surfaceId == other.surfaceId && sequence == other.sequence;
+        }
+    };
+
+    struct BufferKeyHash {
+        size_t operator()(const BufferKey &key) const
+        {
+            return std::hash<uint64_t>()(key.surfaceId) ^ (std::hash<int32_t>()(key.sequence) << 1);
+        }
+    };
+
     struct BufferCache {
         sptr<WlBuffer> wbuffer;
         wptr<Surface> csurf;
         wptr<SurfaceBuffer> sbuffer;
     };
-    std::vector<WlBufferCache::BufferCache> cache;
+    using CacheMap = std::unordered_map<BufferKey, BufferCache, BufferKeyHash>;
+
+    // the delete listener of the surfaces, the queue no longer holds the buffer
+    void OnBufferDeleted(uint64_t surfaceId, int32_t sequence);
+    CacheMap::iterator EraseLocked(CacheMap::iterator it);
+
+    CacheMap cache;
+    // the buffers by wl_buffer, for the release events of the compositor
+    std::unordered_map<const struct wl_buffer *, BufferKey> wlBufferIndex;
+    // the number of cached buffers by surface, a surface gets the delete listener with its first buffer
+    std::unordered_map<uint64_t, uint32_t> surfaceBufferCount;
     std::mutex cacheMutex;
 };
 } // namespace OHOS
@@ -26,9 +26,15 @@ public:
 
     void SetMmap(void *ptr, uint32_t size);
 
+    // the range of the buffer in the shm pool of WlSHMBufferFactory, given back on destruction
+    void SetPoolRange(uint32_t generation, uint32_t offset);
+
 protected:
     void *mmapPtr = nullptr;
     uint32_t mmapSize = 0;
+    bool hasPoolRange = false;
+    uint32_t poolGeneration = 0;
+    uint32_t poolOffset = 0;
 };
 } // namespace OHOS
 
@@ -16,6 +16,10 @@
 #ifndef FRAMEWORKS_WM_INCLUDE_WL_SHM_BUFFER_FACTORY_H
 #define FRAMEWORKS_WM_INCLUDE_WL_SHM_BUFFER_FACTORY_H
 
+#include <map>
+#include <mutex>
+#include <set>
+
 #include <refbase.h>
 
 #include "singleton_delegator.h"
@@ -32,6 +36,9 @@ public:
 
     MOCKABLE sptr<WlBuffer> Create(uint32_t w, uint32_t h, int32_t format);
 
+    // gives the range of a destroyed buffer back to the pool it was carved from
+    void Release(uint32_t generation, uint32_t offset, uint32_t size);
+
 private:
     WlSHMBufferFactory() = default;
     MOCKABLE ~WlSHMBufferFactory() = default;
@@ -39,9 +46,35 @@ private:
     static inline SingletonDelegator<WlSHMBufferFactory> delegator;
 
     static void OnAppear(const GetServiceFunc get, const std::string &iname, uint32_t ver);
+    static void OnFormat(void *, struct wl_shm *, uint32_t format);
     static inline struct wl_shm *shmbuf = nullptr;
+    // the formats the compositor announced, checked locally instead of waiting for a protocol error
+    static inline std::set<uint32_t> formats;
+    static inline std::mutex formatsMutex;
+
+    bool IsFormatSupported(int32_t format);
+
+    // The buffers of the client are carved out of a single shm file and wl_shm_pool, which grows when no free
+    // range is large enough. The pages of destroyed buffers are punched out of the file, so the pool keeps only
+    // its address range when the client lets go of its buffers. Offsets and sizes are multiples of the page size.
+    bool AllocateLocked(uint32_t size, uint32_t &offset);
+    bool GrowLocked(uint32_t minSize);
+    // returns the range to the free list, joined with its neighbours
+    void FreeLocked(uint32_t offset, uint32_t size);
+    void DestroyPoolLocked();
 
-    wl_shm_pool *CreatePool(uint32_t mmapSize, int32_t &fd, void *&mmapPtr);
+    struct wl_shm_pool *pool = nullptr;
+    int32_t poolFd = -1;
+    uint32_t poolSize = 0;
+    // the file is still zero from here on, ranges below it are cleared before they are reused
+    // when the file system can not punch holes
+    uint32_t poolUsedEnd = 0;
+    bool zeroOnReuse = false;
+    // releases of buffers from destroyed pools are ignored
+    uint32_t poolGeneration = 0;
+    // free ranges, size by offset
+    std::map<uint32_t, uint32_t> freeRanges;
+    std::mutex poolMutex;
 };
 } // namespace OHOS
 
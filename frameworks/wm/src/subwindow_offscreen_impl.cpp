@@ -15,14 +15,117 @@
 
 #include "subwindow_offscreen_impl.h"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <thread>
+
 #include <fence.h>
 #include <gslogger.h>
+#include <scoped_bytrace.h>
+#include <unistd.h>
 
 #include "static_call.h"
 
 namespace OHOS {
 namespace {
 DEFINE_HILOG_LABEL("SubwindowOffscreenImpl");
+
+int64_t GetNowTime()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+// The fence of both, consumes them. A fence that fails to merge is waited for here.
+int32_t MergeFence(int32_t fence1, int32_t fence2)
+{
+    if (fence1 < 0) {
+        return fence2;
+    }
+
+    if (fence2 < 0) {
+        return fence1;
+    }
+
+    int32_t fence = FenceMerge("merge", fence1, fence2);
+    if (fence < 0) {
+        GSLOG2HI(WARN) << "(subwindow offscreen) " << "FenceMerge failed, wait for the callback";
+        FenceHold(fence1, -1);
+        fence = fence2;
+    } else {
+        close(fence2);
+    }
+    close(fence1);
+    return fence;
+}
+
+// Runs the frames of all offscreen subwindows in the order their buffers became available.
+class FrameWorker {
+public:
+    static FrameWorker &GetInstance()
+    {
+        static FrameWorker worker;
+        return worker;
+    }
+
+    void PostTask(std::function<void()> task)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push(std::move(task));
+        if (thread == nullptr) {
+            thread = std::make_unique<std::thread>(std::bind(&FrameWorker::Main, this));
+        }
+        condition.notify_one();
+    }
+
+private:
+    FrameWorker() = default;
+    ~FrameWorker()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        condition.notify_all();
+        if (thread == nullptr) {
+            return;
+        }
+
+        // exit called by a frame available callback
+        if (thread->get_id() == std::this_thread::get_id()) {
+            thread->detach();
+        } else {
+            thread->join();
+        }
+    }
+
+    void Main()
+    {
+        while (true) {
+            std::function<void()> task = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [this] { return stop || !tasks.empty(); });
+                if (stop) {
+                    return;
+                }
+
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+            task();
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::queue<std::function<void()>> tasks;
+    bool stop = false;
+    std::unique_ptr<std::thread> thread = nullptr;
+};
 } // namespace
 
 GSError SubwindowOffscreenImpl::CreateConsumerSurface(const sptr<SubwindowOption> &option)
@@ -55,57 +158,140 @@ GSError SubwindowOffscreenImpl::CreateConsumerSurface(const sptr<SubwindowOption
     return GSERROR_OK;
 }
 
+SubwindowOffscreenImpl::~SubwindowOffscreenImpl()
+{
+    StopFrames();
+}
+
+GSError SubwindowOffscreenImpl::Destroy()
+{
+    StopFrames();
+    return SubwindowNormalImpl::Destroy();
+}
+
 void SubwindowOffscreenImpl::OnBufferAvailable()
 {
-    GSLOG2HI(INFO) << "(subwindow offscreen) " << "enter";
-    std::lock_guard<std::mutex> lock(publicMutex);
-    if (isDestroy == true) {
+    std::lock_guard<std::mutex> lock(frameMutex);
+    if (framesStopped == true) {
         GSLOG2HI(ERROR) << "(subwindow offscreen) " << "object destroyed";
         return;
     }
 
-    if (csurf == nullptr || wlSurface == nullptr) {
-        GSLOG2HI(ERROR) << "(subwindow offscreen) " << "csurf or wlSurface is nullptr";
-        return;
+    frameQueue.push(GetNowTime());
+    FrameWorker::GetInstance().PostTask([weakThis = wptr<SubwindowOffscreenImpl>(this)]() {
+        // keeps the subwindow alive until its frame is sent, even if it is destroyed by the callback
+        auto subwindow = weakThis.promote();
+        if (subwindow != nullptr) {
+            subwindow->ProcessNextFrame();
+        }
+    });
+}
+
+void SubwindowOffscreenImpl::StopFrames()
+{
+    std::lock_guard<std::mutex> lock(frameMutex);
+    framesStopped = true;
+    // the tasks of the frames left find the queue empty
+    frameQueue = {};
+}
+
+void SubwindowOffscreenImpl::ProcessNextFrame()
+{
+    int64_t availableTime = 0;
+    bool drop = false;
+    FrameAvailableFunc func = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(frameMutex);
+        if (framesStopped || frameQueue.empty()) {
+            return;
+        }
+
+        availableTime = frameQueue.front();
+        frameQueue.pop();
+        drop = frameQueue.size() >= frameQueueDepth;
+        func = onFrameAvailable;
+    }
+    ProcessFrame(availableTime, drop, func);
+}
+
+void SubwindowOffscreenImpl::ProcessFrame(int64_t availableTime, bool drop, const FrameAvailableFunc &func)
+{
+    sptr<Surface> surf = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(publicMutex);
+        if (isDestroy == true) {
+            GSLOG2HI(ERROR) << "(subwindow offscreen) " << "object destroyed";
+            RecordFailedFrame();
+            return;
+        }
+
+        if (csurf == nullptr || wlSurface == nullptr) {
+            GSLOG2HI(ERROR) << "(subwindow offscreen) " << "csurf or wlSurface is nullptr";
+            RecordFailedFrame();
+            return;
+        }
+        surf = csurf;
     }
 
     sptr<SurfaceBuffer> sbuffer = nullptr;
     int32_t flushFence = -1;
     int64_t timestamp = 0;
     Rect damage = {};
-    GSError ret = csurf->AcquireBuffer(sbuffer, flushFence, timestamp, damage);
+    GSError ret = surf->AcquireBuffer(sbuffer, flushFence, timestamp, damage);
     if (ret != GSERROR_OK) {
         GSLOG2HI(ERROR) << "(subwindow offscreen) " << "AcquireBuffer failed";
+        RecordFailedFrame();
+        return;
+    }
+
+    if (drop) {
+        // nothing reads the buffer, the producer may reuse it once its own rendering is done
+        if (surf->ReleaseBuffer(sbuffer, flushFence) != GSERROR_OK) {
+            GSLOG2HI(ERROR) << "(subwindow offscreen) " << "ReleaseBuffer failed";
+        }
+        std::lock_guard<std::mutex> lock(frameMutex);
+        statistics.droppedFrames++;
         return;
     }
 
     auto bc = SingletonContainer::Get<WlBufferCache>();
-    auto wbuffer = bc->GetWlBuffer(csurf, sbuffer);
+    auto wbuffer = bc->GetWlBuffer(surf, sbuffer);
     if (wbuffer == nullptr) {
         auto dmaBufferFactory = SingletonContainer::Get<WlDMABufferFactory>();
         auto dmaWlBuffer = dmaBufferFactory->Create(sbuffer->GetBufferHandle());
         if (dmaWlBuffer == nullptr) {
             GSLOG2HI(ERROR) << "(subwindow offscreen) " << "Create DMA Buffer Failed";
-            auto sret = csurf->ReleaseBuffer(sbuffer, -1);
+            auto sret = surf->ReleaseBuffer(sbuffer, flushFence);
             if (sret != GSERROR_OK) {
                 GSLOG2HI(ERROR) << "(subwindow offscreen) " << "ReleaseBuffer failed";
             }
+            RecordFailedFrame();
             return;
         }
         dmaWlBuffer->OnRelease(this);
 
         wbuffer = dmaWlBuffer;
-        bc->AddWlBuffer(wbuffer, csurf, sbuffer);
+        bc->AddWlBuffer(wbuffer, surf, sbuffer);
     }
 
-    int32_t onFrameAvailableFence = GLOperation(sbuffer);
-    flushFence = FenceMerge("merge", onFrameAvailableFence, flushFence);
+    int64_t processBegin = GetNowTime();
+    int32_t onFrameAvailableFence = GLOperation(sbuffer, func);
+    int64_t processTime = GetNowTime() - processBegin;
+    int32_t fence = MergeFence(onFrameAvailableFence, flushFence);
 
-    SendBufferToServer(wbuffer, sbuffer, flushFence, damage);
-    GSLOG2HI(INFO) << "(subwindow offscreen) " << "exit";
+    {
+        std::lock_guard<std::mutex> lock(publicMutex);
+        if (isDestroy == true) {
+            surf->ReleaseBuffer(sbuffer, fence);
+            RecordFailedFrame();
+            return;
+        }
+        SendBufferToServer(wbuffer, sbuffer, fence, damage);
+    }
+    RecordFrame(availableTime, processTime);
 }
 
-int32_t SubwindowOffscreenImpl::GLOperation(sptr<SurfaceBuffer> &sbuffer)
+int32_t SubwindowOffscreenImpl::GLOperation(sptr<SurfaceBuffer> &sbuffer, const FrameAvailableFunc &func)
 {
     auto eglData = sbuffer->GetEglData();
     if (eglData == nullptr) {
@@ -114,17 +300,54 @@ int32_t SubwindowOffscreenImpl::GLOperation(sptr<SurfaceBuffer> &sbuffer)
     }
 
     int32_t fd = -1;
-    if (onFrameAvailable) {
-        GSLOG2HI(INFO) << "OnFrameAvailable begin " << eglData->GetTexture();
-        fd = onFrameAvailable(sbuffer);
-        GSLOG2HI(INFO) << "OnFrameAvailable end";
+    if (func) {
+        ScopedBytrace bytrace("OnFrameAvailable");
+        fd = func(sbuffer);
     }
     return fd;
 }
 
+void SubwindowOffscreenImpl::RecordFrame(int64_t availableTime, int64_t processTime)
+{
+    uint64_t latency = static_cast<uint64_t>(GetNowTime() - availableTime);
+    std::lock_guard<std::mutex> lock(frameMutex);
+    statistics.presentedFrames++;
+    statistics.totalLatencyNs += latency;
+    statistics.maxLatencyNs = std::max(statistics.maxLatencyNs, latency);
+    statistics.totalProcessNs += static_cast<uint64_t>(processTime);
+    statistics.maxProcessNs = std::max(statistics.maxProcessNs, static_cast<uint64_t>(processTime));
+}
+
+void SubwindowOffscreenImpl::RecordFailedFrame()
+{
+    std::lock_guard<std::mutex> lock(frameMutex);
+    statistics.failedFrames++;
+}
+
 GSError SubwindowOffscreenImpl::OnFrameAvailable(FrameAvailableFunc func)
 {
+    std::lock_guard<std::mutex> lock(frameMutex);
     onFrameAvailable = func;
     return GSERROR_OK;
 }
+
+GSError SubwindowOffscreenImpl::SetFrameQueueDepth(uint32_t depth)
+{
+    if (depth == 0) {
+        GSLOG2HI(ERROR) << "(subwindow offscreen) " << "queue depth must be positive";
+        return GSERROR_INVALID_ARGUMENTS;
+    }
+
+    std::lock_guard<std::mutex> lock(frameMutex);
+    frameQueueDepth = depth;
+    return GSERROR_OK;
+}
+
+GSError SubwindowOffscreenImpl::GetFrameStatistics(struct SubwindowFrameStatistics &stats)
+{
+    std::lock_guard<std::mutex> lock(frameMutex);
+    stats = statistics;
+    stats.queuedFrames = static_cast<uint32_t>(frameQueue.size());
+    return GSERROR_OK;
+}
 } // namespace OHOS
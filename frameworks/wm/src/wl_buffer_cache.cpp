@@ -15,7 +15,9 @@
 
 #include "wl_buffer_cache.h"
 
+#include <cinttypes>
 #include <mutex>
+#include <vector>
 
 #include "window_manager_hilog.h"
 
@@ -32,6 +34,8 @@ void WlBufferCache::Deinit()
 {
     std::lock_guard<std::mutex> lock(cacheMutex);
     cache.clear();
+    wlBufferIndex.clear();
+    surfaceBufferCount.clear();
 }
 
 sptr<WlBufferCache> WlBufferCache::GetInstance()
@@ -53,16 +57,17 @@ sptr<WlBuffer> WlBufferCache::GetWlBuffer(const sptr<Surface> &surf,
         return nullptr;
     }
 
-    CleanCache();
-
     std::lock_guard<std::mutex> lock(cacheMutex);
-    for (const auto &c : cache) {
-        if (c.csurf != nullptr && c.csurf.promote() == surf &&
-            c.sbuffer != nullptr && c.sbuffer.promote() == buffer) {
-            return c.wbuffer;
-        }
+    auto it = cache.find({surf->GetUniqueId(), buffer->GetSeqNum()});
+    if (it == cache.end()) {
+        return nullptr;
     }
-    return nullptr;
+    // left behind by a surface without delete events
+    if (it->second.sbuffer == nullptr || it->second.sbuffer.promote() != buffer) {
+        EraseLocked(it);
+        return nullptr;
+    }
+    return it->second.wbuffer;
 }
 
 GSError WlBufferCache::AddWlBuffer(const sptr<WlBuffer> &wbuffer,
@@ -81,14 +86,41 @@ GSError WlBufferCache::AddWlBuffer(const sptr<WlBuffer> &wbuffer,
         WMLOGFW("sbuffer is nullptr");
         return GSERROR_INVALID_ARGUMENTS;
     }
-    if (GetWlBuffer(csurf, sbuffer) == nullptr) {
+
+    BufferKey key = {csurf->GetUniqueId(), sbuffer->GetSeqNum()};
+    bool firstOfSurface = false;
+    {
         std::lock_guard<std::mutex> lock(cacheMutex);
+        auto it = cache.find(key);
+        if (it != cache.end()) {
+            if (it->second.sbuffer != nullptr && it->second.sbuffer.promote() == sbuffer) {
+                return GSERROR_OK;
+            }
+            EraseLocked(it);
+        }
         struct BufferCache ele = {
             .wbuffer = wbuffer,
             .csurf = csurf,
             .sbuffer = sbuffer,
         };
-        cache.push_back(ele);
+        cache.emplace(key, ele);
+        wlBufferIndex[wbuffer->GetRawPtr()] = key;
+        firstOfSurface = surfaceBufferCount[key.surfaceId]++ == 0;
+    }
+
+    // outside of the lock, the queue calls the listener with its own lock held
+    if (firstOfSurface) {
+        wptr<WlBufferCache> weakThis = this;
+        uint64_t surfaceId = key.surfaceId;
+        auto func = [weakThis, surfaceId](int32_t sequence) {
+            auto bufferCache = weakThis.promote();
+            if (bufferCache != nullptr) {
+                bufferCache->OnBufferDeleted(surfaceId, sequence);
+            }
+        };
+        if (csurf->RegisterDeleteBufferListener(func) != GSERROR_OK) {
+            WMLOGFW("no delete events for surface %{public}" PRIu64 ", CleanCache drops its buffers", surfaceId);
+        }
     }
     return GSERROR_OK;
 }
@@ -102,31 +134,64 @@ bool WlBufferCache::GetSurfaceBuffer(const struct wl_buffer *wbuffer,
     }
 
     std::lock_guard<std::mutex> lock(cacheMutex);
-    for (const auto &c : cache) {
-        if (c.wbuffer != nullptr && c.wbuffer->GetRawPtr() == wbuffer) {
-            csurf = c.csurf.promote();
-            sbuffer = c.sbuffer.promote();
-            return true;
-        }
+    auto index = wlBufferIndex.find(wbuffer);
+    if (index == wlBufferIndex.end()) {
+        return false;
     }
-    return false;
+    auto it = cache.find(index->second);
+    if (it == cache.end()) {
+        return false;
+    }
+    csurf = it->second.csurf.promote();
+    sbuffer = it->second.sbuffer.promote();
+    return true;
 }
 
 void WlBufferCache::CleanCache()
 {
+    // released after the lock, the last reference to a surface calls its delete listener
+    std::vector<sptr<Surface>> surfaces;
     std::lock_guard<std::mutex> lock(cacheMutex);
-    for (auto it = cache.begin(); it != cache.end(); it++) {
+    for (auto it = cache.begin(); it != cache.end();) {
         sptr<SurfaceBuffer> buffer = nullptr;
-        if (it->sbuffer != nullptr) {
-            buffer = it->sbuffer.promote();
+        if (it->second.sbuffer != nullptr) {
+            buffer = it->second.sbuffer.promote();
+        }
+        sptr<Surface> surface = nullptr;
+        if (it->second.csurf != nullptr) {
+            surface = it->second.csurf.promote();
         }
 
-        if (it->csurf == nullptr ||
-            it->csurf.promote() == nullptr || buffer == nullptr ||
-            buffer->GetVirAddr() == nullptr || it->wbuffer == nullptr) {
-            cache.erase(it);
-            it--;
+        if (surface == nullptr || buffer == nullptr ||
+            buffer->GetVirAddr() == nullptr || it->second.wbuffer == nullptr) {
+            it = EraseLocked(it);
+        } else {
+            it++;
         }
+        if (surface != nullptr) {
+            surfaces.push_back(surface);
+        }
+    }
+}
+
+void WlBufferCache::OnBufferDeleted(uint64_t surfaceId, int32_t sequence)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = cache.find({surfaceId, sequence});
+    if (it != cache.end()) {
+        EraseLocked(it);
+    }
+}
+
+WlBufferCache::CacheMap::iterator WlBufferCache::EraseLocked(CacheMap::iterator it)
+{
+    if (it->second.wbuffer != nullptr) {
+        wlBufferIndex.erase(it->second.wbuffer->GetRawPtr());
+    }
+    auto count = surfaceBufferCount.find(it->first.surfaceId);
+    if (count != surfaceBufferCount.end() && --count->second == 0) {
+        surfaceBufferCount.erase(count);
     }
+    return cache.erase(it);
 }
 } // namespace OHOS
@@ -18,6 +18,7 @@
 #include <sys/mman.h>
 
 #include "window_manager_hilog.h"
+#include "wl_shm_buffer_factory.h"
 
 namespace OHOS {
 WlSHMBuffer::WlSHMBuffer(struct wl_buffer *buffer) : WlBuffer(buffer)
@@ -29,6 +30,14 @@ WlSHMBuffer::~WlSHMBuffer()
     if (mmapPtr != nullptr && mmapSize > 0) {
         munmap(mmapPtr, mmapSize);
     }
+    if (hasPoolRange) {
+        // the buffer goes before its range can be handed out again
+        if (buffer != nullptr) {
+            wl_buffer_destroy(buffer);
+            buffer = nullptr;
+        }
+        WlSHMBufferFactory::GetInstance()->Release(poolGeneration, poolOffset, mmapSize);
+    }
 }
 
 void WlSHMBuffer::SetMmap(void *ptr, uint32_t size)
@@ -36,4 +45,11 @@ void WlSHMBuffer::SetMmap(void *ptr, uint32_t size)
     mmapPtr = ptr;
     mmapSize = size;
 }
+
+void WlSHMBuffer::SetPoolRange(uint32_t generation, uint32_t offset)
+{
+    hasPoolRange = true;
+    poolGeneration = generation;
+    poolOffset = offset;
+}
 } // namespace OHOS
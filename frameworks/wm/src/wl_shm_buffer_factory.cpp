@@ -15,9 +15,11 @@
 
 #include "wl_shm_buffer_factory.h"
 
+#include <algorithm>
 #include <cerrno>
+#include <cinttypes>
 #include <fcntl.h>
-#include <map>
+#include <iterator>
 #include <securec.h>
 #include <sys/mman.h>
 #include <unistd.h>
@@ -30,6 +32,11 @@ namespace OHOS {
 namespace {
 constexpr HiviewDFX::HiLogLabel LABEL = { LOG_CORE, 0, "WMWlSHMBufferFactory" };
 constexpr int32_t STRIDE_NUM = 4;
+constexpr uint64_t DEFAULT_PAGE_SIZE = 4096;
+constexpr uint64_t INITIAL_POOL_SIZE = 4 * 1024 * 1024;
+constexpr uint64_t POOL_GROWTH = 2;
+// wl_shm_pool sizes are int32_t
+constexpr uint64_t MAX_POOL_SIZE = INT32_MAX / DEFAULT_PAGE_SIZE * DEFAULT_PAGE_SIZE;
 }
 
 sptr<WlSHMBufferFactory> WlSHMBufferFactory::GetInstance()
@@ -51,6 +58,14 @@ void WlSHMBufferFactory::Init()
 
 void WlSHMBufferFactory::Deinit()
 {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        DestroyPoolLocked();
+    }
+    {
+        std::lock_guard<std::mutex> lock(formatsMutex);
+        formats.clear();
+    }
     if (shmbuf != nullptr) {
         wl_shm_destroy(shmbuf);
         shmbuf = nullptr;
@@ -63,9 +78,19 @@ void WlSHMBufferFactory::OnAppear(const GetServiceFunc get, const std::string &i
         constexpr uint32_t wlShmVersion = 1;
         auto ret = get(&wl_shm_interface, wlShmVersion);
         shmbuf = static_cast<struct wl_shm *>(ret);
+        if (shmbuf != nullptr) {
+            static const struct wl_shm_listener listener = { &WlSHMBufferFactory::OnFormat };
+            wl_shm_add_listener(shmbuf, &listener, nullptr);
+        }
     }
 }
 
+void WlSHMBufferFactory::OnFormat(void *, struct wl_shm *, uint32_t format)
+{
+    std::lock_guard<std::mutex> lock(formatsMutex);
+    formats.insert(format);
+}
+
 namespace {
 int32_t CreateShmFile(int32_t size)
 {
@@ -126,10 +151,140 @@ int32_t CreateShmFile(int32_t size)
 }
 } // namespace
 
-wl_shm_pool *WlSHMBufferFactory::CreatePool(uint32_t mmapSize, int32_t &fd, void *&mmapPtr)
+bool WlSHMBufferFactory::IsFormatSupported(int32_t format)
 {
-    if (mmapSize == 0) {
-        WMLOGFE("shared memory size is zero");
+    std::lock_guard<std::mutex> lock(formatsMutex);
+    // nothing announced yet, leave the check to the compositor
+    return formats.empty() || formats.find(static_cast<uint32_t>(format)) != formats.end();
+}
+
+bool WlSHMBufferFactory::GrowLocked(uint32_t minSize)
+{
+    uint64_t newSize = std::max<uint64_t>(poolSize, INITIAL_POOL_SIZE);
+    while (newSize < static_cast<uint64_t>(poolSize) + minSize) {
+        newSize *= POOL_GROWTH;
+    }
+    if (newSize > MAX_POOL_SIZE) {
+        WMLOGFE("shm pool can not grow to %{public}" PRIu64 ", size: %{public}u", newSize, poolSize);
+        return false;
+    }
+
+    if (pool == nullptr) {
+        poolFd = CreateShmFile(static_cast<int32_t>(newSize));
+        if (poolFd < 0) {
+            WMLOGFE("CreateShmFile failed, size: %{public}" PRIu64, newSize);
+            return false;
+        }
+        pool = wl_shm_create_pool(shmbuf, poolFd, static_cast<int32_t>(newSize));
+        if (pool == nullptr) {
+            WMLOGFE("wl_shm_create_pool failed, size: %{public}" PRIu64 ", fd: %{public}d", newSize, poolFd);
+            close(poolFd);
+            poolFd = -1;
+            return false;
+        }
+    } else {
+        if (ftruncate(poolFd, static_cast<off_t>(newSize)) < 0) {
+            WMLOGFE("ftruncate: %{public}s, size: %{public}" PRIu64, strerror(errno), newSize);
+            return false;
+        }
+        wl_shm_pool_resize(pool, static_cast<int32_t>(newSize));
+    }
+
+    // the new tail is free, joined with a free range that ends at the old size
+    uint32_t offset = poolSize;
+    uint32_t size = static_cast<uint32_t>(newSize) - poolSize;
+    if (!freeRanges.empty()) {
+        auto last = std::prev(freeRanges.end());
+        if (last->first + last->second == offset) {
+            offset = last->first;
+            size += last->second;
+            freeRanges.erase(last);
+        }
+    }
+    freeRanges[offset] = size;
+    poolSize = static_cast<uint32_t>(newSize);
+    return true;
+}
+
+bool WlSHMBufferFactory::AllocateLocked(uint32_t size, uint32_t &offset)
+{
+    // first fit, the map is ordered by offset so the pool stays packed towards its start
+    auto it = freeRanges.begin();
+    while (it != freeRanges.end() && it->second < size) {
+        it++;
+    }
+    if (it == freeRanges.end()) {
+        if (!GrowLocked(size)) {
+            return false;
+        }
+        it = std::prev(freeRanges.end());
+    }
+
+    offset = it->first;
+    uint32_t rest = it->second - size;
+    freeRanges.erase(it);
+    if (rest > 0) {
+        freeRanges[offset + size] = rest;
+    }
+    return true;
+}
+
+void WlSHMBufferFactory::DestroyPoolLocked()
+{
+    if (pool != nullptr) {
+        wl_shm_pool_destroy(pool);
+        pool = nullptr;
+    }
+    if (poolFd >= 0) {
+        close(poolFd);
+        poolFd = -1;
+    }
+    poolSize = 0;
+    poolUsedEnd = 0;
+    zeroOnReuse = false;
+    poolGeneration++;
+    freeRanges.clear();
+}
+
+void WlSHMBufferFactory::Release(uint32_t generation, uint32_t offset, uint32_t size)
+{
+    std::lock_guard<std::mutex> lock(poolMutex);
+    if (generation != poolGeneration || size == 0) {
+        return;
+    }
+    // gives the pages back to the system, the range reads as zero afterwards
+    if (fallocate(poolFd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, offset, size) != 0) {
+        zeroOnReuse = true;
+    }
+    FreeLocked(offset, size);
+}
+
+void WlSHMBufferFactory::FreeLocked(uint32_t offset, uint32_t size)
+{
+    auto next = freeRanges.lower_bound(offset);
+    if (next != freeRanges.end() && offset + size == next->first) {
+        size += next->second;
+        next = freeRanges.erase(next);
+    }
+    if (next != freeRanges.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            offset = prev->first;
+            size += prev->second;
+            freeRanges.erase(prev);
+        }
+    }
+    freeRanges[offset] = size;
+}
+
+sptr<WlBuffer> WlSHMBufferFactory::Create(uint32_t w, uint32_t h, int32_t format)
+{
+    // Errors of earlier requests arrive asynchronously with the dispatched events. A connection with a protocol
+    // error is dead, so there is no point in creating more buffers on it.
+    auto display = delegator.Dep<WlDisplay>();
+    if (display->GetError() != 0) {
+        WMLOGFE("display has error %{public}d, %{public}dx%{public}d, format: %{public}d",
+            display->GetError(), w, h, format);
         return nullptr;
     }
 
@@ -138,58 +293,47 @@ wl_shm_pool *WlSHMBufferFactory::CreatePool(uint32_t mmapSize, int32_t &fd, void
         return nullptr;
     }
 
-    fd = CreateShmFile(mmapSize);
-    if (fd < 0) {
-        WMLOGFE("CreateShmFile failed, size: %{public}d", mmapSize);
+    if (!IsFormatSupported(format)) {
+        WMLOGFE("format %{public}d is not supported by the compositor", format);
         return nullptr;
     }
 
-    mmapPtr = mmap(nullptr, mmapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
-    if (mmapPtr == nullptr) {
-        WMLOGFE("mmap failed, size: %{public}d, fd: %{public}d", mmapSize, fd);
-        close(fd);
+    uint64_t stride = static_cast<uint64_t>(w) * STRIDE_NUM;
+    uint64_t bufferSize = stride * h;
+    long pageSize = sysconf(_SC_PAGESIZE);
+    uint64_t page = pageSize > 0 ? static_cast<uint64_t>(pageSize) : DEFAULT_PAGE_SIZE;
+    uint64_t rangeSize = (bufferSize + page - 1) / page * page;
+    if (bufferSize == 0 || stride > INT32_MAX || rangeSize > MAX_POOL_SIZE) {
+        WMLOGFE("invalid shared memory size, %{public}dx%{public}d", w, h);
         return nullptr;
     }
+    uint32_t mmapSize = static_cast<uint32_t>(rangeSize);
 
-    auto pool = wl_shm_create_pool(shmbuf, fd, mmapSize);
-    if (pool == nullptr) {
-        WMLOGFE("wl_shm_create_pool failed, size: %{public}d, fd: %{public}d", mmapSize, fd);
-        munmap(mmapPtr, mmapSize);
-        close(fd);
+    std::lock_guard<std::mutex> lock(poolMutex);
+    uint32_t offset = 0;
+    if (!AllocateLocked(mmapSize, offset)) {
+        return nullptr;
     }
-    return pool;
-}
 
-sptr<WlBuffer> WlSHMBufferFactory::Create(uint32_t w, uint32_t h, int32_t format)
-{
-    uint32_t stride = w * STRIDE_NUM;
-    uint32_t mmapSize = stride * h;
-    int32_t fd = -1;
-    void *mmapPtr = nullptr;
-    auto pool = CreatePool(mmapSize, fd, mmapPtr);
-    if (pool == nullptr) {
+    void *mmapPtr = mmap(nullptr, mmapSize, PROT_READ | PROT_WRITE, MAP_SHARED, poolFd, offset);
+    if (mmapPtr == MAP_FAILED) {
+        WMLOGFE("mmap failed: %{public}s, size: %{public}u, offset: %{public}u", strerror(errno), mmapSize, offset);
+        FreeLocked(offset, mmapSize);
         return nullptr;
     }
 
-    auto display = delegator.Dep<WlDisplay>();
-    auto buffer = wl_shm_pool_create_buffer(pool, 0, w, h, stride, format);
-    if (buffer == nullptr) {
-        WMLOGFE("%{public}s failed, %{public}dx%{public}d, stride: %{public}d, format: %{public}d",
-            "wl_shm_pool_create_buffer", w, h, stride, format);
-        munmap(mmapPtr, mmapSize);
-        close(fd);
-        wl_shm_pool_destroy(pool);
-        return nullptr;
+    // without hole punching a reused range still holds the pixels of its previous buffer
+    if (zeroOnReuse && offset < poolUsedEnd) {
+        (void)memset_s(mmapPtr, mmapSize, 0, std::min(mmapSize, poolUsedEnd - offset));
     }
+    poolUsedEnd = std::max(poolUsedEnd, offset + mmapSize);
 
-    display->Sync();
-    if (display->GetError() != 0) {
-        WMLOGFE("%{public}s failed with %{public}d, %{public}dx%{public}d, stride: %{public}d, format: %{public}d",
-            "wl_shm_pool_create_buffer", display->GetError(), w, h, stride, format);
-        wl_buffer_destroy(buffer);
+    auto buffer = wl_shm_pool_create_buffer(pool, offset, w, h, stride, format);
+    if (buffer == nullptr) {
+        WMLOGFE("%{public}s failed, %{public}dx%{public}d, stride: %{public}" PRIu64 ", format: %{public}d",
+            "wl_shm_pool_create_buffer", w, h, stride, format);
         munmap(mmapPtr, mmapSize);
-        close(fd);
-        wl_shm_pool_destroy(pool);
+        FreeLocked(offset, mmapSize);
         return nullptr;
     }
 
@@ -198,14 +342,11 @@ sptr<WlBuffer> WlSHMBufferFactory::Create(uint32_t w, uint32_t h, int32_t format
         WMLOGFE("new WlSHMBuffer failed");
         wl_buffer_destroy(buffer);
         munmap(mmapPtr, mmapSize);
-        close(fd);
-        wl_shm_pool_destroy(pool);
+        FreeLocked(offset, mmapSize);
         return nullptr;
     }
     ret->SetMmap(mmapPtr, mmapSize);
-
-    wl_shm_pool_destroy(pool);
-    close(fd);
+    ret->SetPoolRange(poolGeneration, offset);
     return ret;
 }
 } // namespace OHOS
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "id_map.h"
+
+#include <stdlib.h>
+
+#define ID_MAP_MIN_CAPACITY 16
+// grows when more than 3/4 of the slots are used
+#define ID_MAP_LOAD_NUMERATOR 3
+#define ID_MAP_LOAD_DENOMINATOR 4
+
+static uint32_t IdMapSlot(const struct IdMap *map, uint64_t key)
+{
+    // window ids and pointers have few random low bits, spread all bits over the slot index
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return (uint32_t)key & (map->capacity - 1);
+}
+
+static void IdMapPut(struct IdMap *map, uint64_t key, void *value)
+{
+    uint32_t slot = IdMapSlot(map, key);
+    while (map->entries[slot].value != NULL && map->entries[slot].key != key) {
+        slot = (slot + 1) & (map->capacity - 1);
+    }
+    if (map->entries[slot].value == NULL) {
+        map->count++;
+    }
+    map->entries[slot].key = key;
+    map->entries[slot].value = value;
+}
+
+static bool IdMapGrow(struct IdMap *map)
+{
+    uint32_t capacity = map->capacity == 0 ? ID_MAP_MIN_CAPACITY : map->capacity * 2;
+    if (capacity < map->capacity) {
+        return false;
+    }
+    struct IdMapEntry *entries = calloc(capacity, sizeof(*entries));
+    if (entries == NULL) {
+        return false;
+    }
+
+    struct IdMap old = *map;
+    map->entries = entries;
+    map->capacity = capacity;
+    map->count = 0;
+    for (uint32_t i = 0; i < old.capacity; i++) {
+        if (old.entries[i].value != NULL) {
+            IdMapPut(map, old.entries[i].key, old.entries[i].value);
+        }
+    }
+    free(old.entries);
+    return true;
+}
+
+void IdMapRelease(struct IdMap *map)
+{
+    free(map->entries);
+    map->entries = NULL;
+    map->capacity = 0;
+    map->count = 0;
+}
+
+bool IdMapInsert(struct IdMap *map, uint64_t key, void *value)
+{
+    if (value == NULL) {
+        return false;
+    }
+    if ((uint64_t)(map->count + 1) * ID_MAP_LOAD_DENOMINATOR >
+        (uint64_t)map->capacity * ID_MAP_LOAD_NUMERATOR && !IdMapGrow(map)) {
+        return false;
+    }
+    IdMapPut(map, key, value);
+    return true;
+}
+
+void *IdMapGet(const struct IdMap *map, uint64_t key)
+{
+    if (map->count == 0) {
+        return NULL;
+    }
+    uint32_t slot = IdMapSlot(map, key);
+    while (map->entries[slot].value != NULL) {
+        if (map->entries[slot].key == key) {
+            return map->entries[slot].value;
+        }
+        slot = (slot + 1) & (map->capacity - 1);
+    }
+    return NULL;
+}
+
+void IdMapRemove(struct IdMap *map, uint64_t key, const void *value)
+{
+    if (map->count == 0) {
+        return;
+    }
+    uint32_t mask = map->capacity - 1;
+    uint32_t slot = IdMapSlot(map, key);
+    while (map->entries[slot].value != NULL && map->entries[slot].key != key) {
+        slot = (slot + 1) & mask;
+    }
+    if (map->entries[slot].value == NULL || map->entries[slot].value != value) {
+        return;
+    }
+
+    // shifts the entries after the hole back, so every entry stays reachable from its home slot without tombstones
+    uint32_t hole = slot;
+    for (uint32_t next = (hole + 1) & mask; map->entries[next].value != NULL; next = (next + 1) & mask) {
+        uint32_t home = IdMapSlot(map, map->entries[next].key);
+        // the entry may move to the hole if its home is not in (hole, next] cyclically
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            map->entries[hole] = map->entries[next];
+            hole = next;
+        }
+    }
+    map->entries[hole].key = 0;
+    map->entries[hole].value = NULL;
+    map->count--;
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FRAMEWORKS_WMSERVER_SRC_ID_MAP_H
+#define FRAMEWORKS_WMSERVER_SRC_ID_MAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct IdMapEntry {
+    uint64_t key;
+    void *value; // NULL for a free slot
+};
+
+// A hash map from ids or pointers to objects, open addressing with linear probing. It is kept alongside the
+// wl_lists of the window manager so lookups by id do not walk them. A zeroed IdMap is empty.
+struct IdMap {
+    struct IdMapEntry *entries;
+    uint32_t capacity; // 0 or a power of two
+    uint32_t count;
+};
+
+// frees the entries, the map is empty afterwards
+void IdMapRelease(struct IdMap *map);
+
+// sets the value of [key], replacing the one it had. false if [value] is NULL or there is no memory.
+bool IdMapInsert(struct IdMap *map, uint64_t key, void *value);
+
+// the value of [key], NULL if it has none
+void *IdMapGet(const struct IdMap *map, uint64_t key);
+
+// removes [key] if its value is [value], so an object does not drop a newer one with the same key
+void IdMapRemove(struct IdMap *map, uint64_t key, const void *value);
+
+static inline uint64_t IdMapPointerKey(const void *pointer)
+{
+    return (uint64_t)(uintptr_t)pointer;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRAMEWORKS_WMSERVER_SRC_ID_MAP_H
@@ -16,23 +16,18 @@
 #include "rects.h"
 
 #include <algorithm>
+#include <iterator>
 
-template<typename T>
-T max(T a, T b)
-{
-    return (a > b) ? a : b;
-}
-
-template<typename T>
-T min(T a, T b)
-{
-    return (a < b) ? a : b;
-}
+namespace {
+constexpr size_t NO_BAND = static_cast<size_t>(-1);
+} // namespace
 
 Rects::Rects(int32_t x, int32_t y, int32_t w, int32_t h)
 {
-    struct Rect rect = {x, y, w, h};
-    rects.push_back(rect);
+    if (w > 0 && h > 0) {
+        struct Rect rect = {x, y, w, h};
+        rects.push_back(rect);
+    }
 }
 
 int32_t Rects::GetSize() const
@@ -72,105 +67,191 @@ int32_t Rects::GetH(int32_t index) const
     return 0;
 }
 
-Rects Rects::operator -(Rects &other)
+bool Rects::IsEmpty() const
 {
-    auto lrects = rects;
-    RectsSubtrace(lrects, other.rects);
+    return rects.empty();
+}
 
-    decltype(lrects) totalRects;
-    struct Rect totalRect = {};
-    for (const auto &rect : lrects) {
-        totalRect.x = min(totalRect.x, rect.x);
-        totalRect.y = min(totalRect.y, rect.y);
-        totalRect.w = max(totalRect.w, rect.x + rect.w);
-        totalRect.h = max(totalRect.h, rect.y + rect.h);
-    }
-    totalRect.w -= totalRect.x;
-    totalRect.h -= totalRect.y;
-    totalRects.push_back(totalRect);
-    RectsSubtrace(totalRects, lrects);
+bool Rects::operator ==(const Rects &other) const
+{
+    auto equal = [](const struct Rect &a, const struct Rect &b) {
+        return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+    };
+    return std::equal(rects.begin(), rects.end(), other.rects.begin(), other.rects.end(), equal);
+}
 
-    Rects result;
-    result.rects = lrects;
-    if (totalRects.size() == 0) {
-        totalRects.push_back(totalRect);
-        result.rects = totalRects;
-    }
-    return result;
+bool Rects::operator !=(const Rects &other) const
+{
+    return !(*this == other);
 }
 
-Rects &Rects::operator -=(Rects &other)
+Rects Rects::operator -(const Rects &other) const
+{
+    return Combine(*this, other, Op::SUBTRACT);
+}
+
+Rects &Rects::operator -=(const Rects &other)
 {
     *this = *this - other;
     return *this;
 }
 
-void Rects::Intersect(const struct Rect &a, const struct Rect &b, struct Rect &out)
+Rects Rects::operator |(const Rects &other) const
 {
-    out.x = max(a.x, b.x);
-    out.y = max(a.y, b.y);
-    out.w = min(a.x + a.w, b.x + b.w) - out.x;
-    out.h = min(a.y + a.h, b.y + b.h) - out.y;
+    return Combine(*this, other, Op::UNION);
 }
 
-void Rects::Subtrace(const struct Rect &rect, const struct Rect &inner, std::vector<struct Rect> &result)
+Rects &Rects::operator |=(const Rects &other)
 {
-    int32_t topDiff = inner.y - rect.y;
-    if (topDiff > 0) {
-        struct Rect r = {rect.x, rect.y, rect.w, topDiff};
-        result.push_back(r);
-    }
+    *this = *this | other;
+    return *this;
+}
 
-    int32_t bottomDiff = rect.y + rect.h - inner.y - inner.h;
-    if (bottomDiff > 0) {
-        struct Rect r = {rect.x, rect.y + rect.h - bottomDiff, rect.w, bottomDiff};
-        result.push_back(r);
-    }
+Rects Rects::operator &(const Rects &other) const
+{
+    return Combine(*this, other, Op::INTERSECT);
+}
 
-    int32_t middleYDiff = inner.h;
-    if (middleYDiff > 0) {
-        int32_t leftDiff = inner.x - rect.x;
-        if (leftDiff > 0) {
-            struct Rect r = {rect.x, inner.y, leftDiff, middleYDiff};
-            result.push_back(r);
-        }
+Rects &Rects::operator &=(const Rects &other)
+{
+    *this = *this & other;
+    return *this;
+}
 
-        int32_t rightDiff = rect.x + rect.w - inner.x - inner.w;
-        if (rightDiff > 0) {
-            struct Rect r = {inner.x + inner.w, inner.y, rightDiff, middleYDiff};
-            result.push_back(r);
+Rects Rects::Combine(const Rects &a, const Rects &b, Op op)
+{
+    // the tops and bottoms of all bands, both lists are sorted because bands do not overlap
+    auto bandEdges = [](const std::vector<struct Rect> &rects, std::vector<int64_t> &edges) {
+        for (size_t i = 0; i < rects.size(); i++) {
+            if (i == 0 || rects[i].y != rects[i - 1].y) {
+                edges.push_back(rects[i].y);
+                edges.push_back(static_cast<int64_t>(rects[i].y) + rects[i].h);
+            }
         }
+    };
+    std::vector<int64_t> aEdges;
+    std::vector<int64_t> bEdges;
+    bandEdges(a.rects, aEdges);
+    bandEdges(b.rects, bEdges);
+    std::vector<int64_t> edges;
+    edges.reserve(aEdges.size() + bEdges.size());
+    std::merge(aEdges.begin(), aEdges.end(), bEdges.begin(), bEdges.end(), std::back_inserter(edges));
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    // between two edges neither region changes, the band there is the combination of their spans
+    Rects result;
+    size_t aIndex = 0;
+    size_t bIndex = 0;
+    size_t lastBand = NO_BAND;
+    std::vector<Span> aSpans;
+    std::vector<Span> bSpans;
+    std::vector<Span> spans;
+    for (size_t i = 0; i + 1 < edges.size(); i++) {
+        BandSpans(a.rects, aIndex, edges[i], aSpans);
+        BandSpans(b.rects, bIndex, edges[i], bSpans);
+        CombineSpans(aSpans, bSpans, op, spans);
+        result.AppendBand(edges[i], edges[i + 1], spans, lastBand);
+    }
+    return result;
+}
+
+void Rects::BandSpans(const std::vector<struct Rect> &rects, size_t &index, int64_t y, std::vector<Span> &out)
+{
+    out.clear();
+    while (index < rects.size() && static_cast<int64_t>(rects[index].y) + rects[index].h <= y) {
+        index++;
+    }
+    if (index == rects.size() || rects[index].y > y) {
+        return;
+    }
+    for (size_t i = index; i < rects.size() && rects[i].y == rects[index].y; i++) {
+        out.push_back({rects[i].x, static_cast<int64_t>(rects[i].x) + rects[i].w});
     }
 }
 
-void Rects::RectsSubtrace(std::vector<struct Rect> &lrects, std::vector<struct Rect> rrects)
+void Rects::CombineSpans(const std::vector<Span> &a, const std::vector<Span> &b, Op op, std::vector<Span> &out)
 {
-    while (true) {
-        if (rrects.size() == 0) {
-            break;
+    out.clear();
+    if (op == Op::UNION) {
+        std::vector<Span> all;
+        all.reserve(a.size() + b.size());
+        auto lessX = [](const Span &l, const Span &r) { return l.x1 < r.x1; };
+        std::merge(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(all), lessX);
+        for (const auto &span : all) {
+            if (!out.empty() && span.x1 <= out.back().x2) {
+                out.back().x2 = std::max(out.back().x2, span.x2);
+            } else {
+                out.push_back(span);
+            }
+        }
+        return;
+    }
+
+    if (op == Op::INTERSECT) {
+        size_t i = 0;
+        size_t j = 0;
+        while (i < a.size() && j < b.size()) {
+            int64_t x1 = std::max(a[i].x1, b[j].x1);
+            int64_t x2 = std::min(a[i].x2, b[j].x2);
+            if (x1 < x2) {
+                out.push_back({x1, x2});
+            }
+            if (a[i].x2 < b[j].x2) {
+                i++;
+            } else {
+                j++;
+            }
         }
+        return;
+    }
 
-        for (auto it = rrects.begin(); it != rrects.end(); it++) {
-            struct Rect inter = {};
-            auto findRect = [&it, &inter](const auto &item) {
-                Rects::Intersect(*it, item, inter);
-                return inter.w > 0 && inter.h > 0;
-            };
-            auto jt = std::find_if(lrects.begin(), lrects.end(), findRect);
-            if (jt == lrects.end()) {
-                rrects.erase(it);
-                break;
+    size_t j = 0;
+    for (const auto &span : a) {
+        while (j < b.size() && b[j].x2 <= span.x1) {
+            j++;
+        }
+        int64_t x = span.x1;
+        for (size_t k = j; k < b.size() && b[k].x1 < span.x2; k++) {
+            if (b[k].x1 > x) {
+                out.push_back({x, b[k].x1});
             }
+            x = std::max(x, b[k].x2);
+        }
+        if (x < span.x2) {
+            out.push_back({x, span.x2});
+        }
+    }
+}
 
-            // found, lrect -= inter, rrect -= inter
-            struct Rect rrect = *it;
-            rrects.erase(it);
-            Subtrace(rrect, inter, rrects);
+void Rects::AppendBand(int64_t y1, int64_t y2, const std::vector<Span> &spans, size_t &lastBand)
+{
+    if (spans.empty()) {
+        return;
+    }
 
-            struct Rect lrect = *jt;
-            lrects.erase(jt);
-            Subtrace(lrect, inter, lrects);
-            break;
+    if (lastBand != NO_BAND && static_cast<int64_t>(rects[lastBand].y) + rects[lastBand].h == y1 &&
+        rects.size() - lastBand == spans.size()) {
+        bool same = true;
+        for (size_t i = 0; i < spans.size() && same; i++) {
+            const auto &rect = rects[lastBand + i];
+            same = rect.x == spans[i].x1 && static_cast<int64_t>(rect.x) + rect.w == spans[i].x2;
         }
+        if (same) {
+            for (size_t i = lastBand; i < rects.size(); i++) {
+                rects[i].h += static_cast<int32_t>(y2 - y1);
+            }
+            return;
+        }
+    }
+
+    lastBand = rects.size();
+    for (const auto &span : spans) {
+        struct Rect rect = {
+            static_cast<int32_t>(span.x1),
+            static_cast<int32_t>(y1),
+            static_cast<int32_t>(span.x2 - span.x1),
+            static_cast<int32_t>(y2 - y1),
+        };
+        rects.push_back(rect);
     }
 }
@@ -16,8 +16,14 @@
 #ifndef FRAMEWORKS_WMSERVER_SRC_RECTS_H
 #define FRAMEWORKS_WMSERVER_SRC_RECTS_H
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
+// A region of the screen as banded rects: sorted by y, then by x. The rects of a band share y and h, do not
+// overlap or touch each other, and vertically adjacent bands never have the same spans. This form is unique
+// for a region, so a region that is a single rectangle has size 1. Union, subtraction and intersection walk
+// both regions band by band in time linear in their number of rects.
 class Rects {
 public:
     Rects() = default;
@@ -30,8 +36,16 @@ public:
     int32_t GetW(int32_t index) const;
     int32_t GetH(int32_t index) const;
 
-    Rects operator -(Rects &other);
-    Rects &operator -=(Rects &other);
+    bool IsEmpty() const;
+    bool operator ==(const Rects &other) const;
+    bool operator !=(const Rects &other) const;
+
+    Rects operator -(const Rects &other) const;
+    Rects &operator -=(const Rects &other);
+    Rects operator |(const Rects &other) const;
+    Rects &operator |=(const Rects &other);
+    Rects operator &(const Rects &other) const;
+    Rects &operator &=(const Rects &other);
 
 private:
     struct Rect {
@@ -40,9 +54,25 @@ private:
         int32_t w;
         int32_t h;
     };
-    static void Intersect(const struct Rect &a, const struct Rect &b, struct Rect &out);
-    static void Subtrace(const struct Rect &rect, const struct Rect &inner, std::vector<struct Rect> &result);
-    static void RectsSubtrace(std::vector<struct Rect> &lrects, std::vector<struct Rect> rrects);
+
+    // a horizontal run [x1, x2) of a band
+    struct Span {
+        int64_t x1;
+        int64_t x2;
+    };
+
+    enum class Op {
+        UNION,
+        SUBTRACT,
+        INTERSECT,
+    };
+
+    static Rects Combine(const Rects &a, const Rects &b, Op op);
+    static void CombineSpans(const std::vector<Span> &a, const std::vector<Span> &b, Op op, std::vector<Span> &out);
+    // the spans of the band of [rects] that covers [y], advancing [index] past the bands above it
+    static void BandSpans(const std::vector<struct Rect> &rects, size_t &index, int64_t y, std::vector<Span> &out);
+    // appends the band [y1, y2) of [spans], joined with the last band if that one ends at y1 with the same spans
+    void AppendBand(int64_t y1, int64_t y2, const std::vector<Span> &spans, size_t &lastBand);
 
     std::vector<struct Rect> rects;
 };
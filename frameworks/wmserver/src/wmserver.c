@@ -287,18 +287,22 @@ static bool CheckWindowId(struct wl_client *client,
     return false;
 }
 
-static struct WindowSurface *GetSurface(const struct wl_list *surfaceList,
+static struct WindowSurface *GetSurface(const struct WmsContext *ctx,
     uint32_t surfaceId)
 {
-    struct WindowSurface *windowSurface = NULL;
+    return IdMapGet(&ctx->windowIndex, surfaceId);
+}
 
-    wl_list_for_each(windowSurface, surfaceList, link) {
-        if (windowSurface->surfaceId == surfaceId) {
-            return windowSurface;
-        }
+// the newest window of [type], NULL if there is none
+static struct WindowSurface *GetSurfaceByType(const struct WmsContext *ctx, uint32_t type)
+{
+    struct wl_list *windowList = &ctx->wlListWindowByType[type];
+    if (wl_list_empty(windowList)) {
+        return NULL;
     }
 
-    return NULL;
+    struct WindowSurface *windowSurface = wl_container_of(windowList->next, windowSurface, typeLink);
+    return windowSurface;
 }
 
 static void ClearWindowId(struct WmsController *pController, uint32_t windowId)
@@ -315,7 +319,7 @@ static uint32_t GetWindowId(struct WmsController *pController)
 {
     pid_t pid = 0;
     uint32_t windowId = WINDOW_ID_INVALID;
-    uint32_t windowCount = wl_list_length(&pController->pWmsCtx->wlListWindow);
+    uint32_t windowCount = pController->pWmsCtx->windowIndex.count;
     if (windowCount >= WINDOW_ID_NUM_MAX) {
         LOGE("failed, window count = %{public}d", WINDOW_ID_NUM_MAX);
         return windowId;
@@ -367,25 +371,12 @@ struct ivi_layout_layer *GetLayer(struct weston_output *westonOutput, uint32_t l
 static struct WmsScreen *GetScreenFromId(const struct WmsContext *ctx,
                                          uint32_t screenId)
 {
-    struct WmsScreen *screen = NULL;
-    wl_list_for_each(screen, &ctx->wlListScreen, wlListLink) {
-        if (screen->screenId == screenId) {
-            return screen;
-        }
-    }
-    return NULL;
+    return IdMapGet(&ctx->screenIndex, screenId);
 }
 
 static struct WmsScreen *GetScreen(const struct WindowSurface *windowSurface)
 {
-    struct WmsScreen *screen = NULL;
-    struct WmsContext *ctx = windowSurface->controller->pWmsCtx;
-    wl_list_for_each(screen, &ctx->wlListScreen, wlListLink) {
-        if (screen->screenId == windowSurface->screenId) {
-            return screen;
-        }
-    }
-    return NULL;
+    return GetScreenFromId(windowSurface->controller->pWmsCtx, windowSurface->screenId);
 }
 
 static void CalcWindowInfo(struct WindowSurface *surf)
@@ -1002,7 +993,7 @@ static void ControllerSetWindowType(struct wl_client *pWlClient,
         return;
     }
 
-    pWindowSurface = GetSurface(&pWmsCtx->wlListWindow, windowId);
+    pWindowSurface = GetSurface(pWmsCtx, windowId);
     if (!pWindowSurface) {
         LOGE("pWindowSurface is not found[%{public}d].", windowId);
         wms_send_reply_error(pWlResource, WMS_ERROR_INVALID_PARAM);
@@ -1020,6 +1011,8 @@ static void ControllerSetWindowType(struct wl_client *pWlClient,
     SetWindowType(pWindowSurface, windowType);
 
     pWindowSurface->type = windowType;
+    wl_list_remove(&pWindowSurface->typeLink);
+    wl_list_insert(&pWmsCtx->wlListWindowByType[windowType], &pWindowSurface->typeLink);
 
     wms_send_reply_error(pWlResource, WMS_ERROR_OK);
     wl_client_flush(wl_resource_get_client(pWlResource));
@@ -1049,7 +1042,7 @@ static void ControllerSetWindowMode(struct wl_client *pWlClient,
         return;
     }
 
-    pWindowSurface = GetSurface(&pWmsCtx->wlListWindow, windowId);
+    pWindowSurface = GetSurface(pWmsCtx, windowId);
     if (!pWindowSurface) {
         LOGE("pWindowSurface is not found[%{public}d].", windowId);
         wms_send_reply_error(pWlResource, WMS_ERROR_INVALID_PARAM);
@@ -1087,7 +1080,7 @@ static void ControllerSetWindowVisibility(
         return;
     }
 
-    windowSurface = GetSurface(&ctx->wlListWindow, windowId);
+    windowSurface = GetSurface(ctx, windowId);
     if (!windowSurface) {
         LOGE("windowSurface is not found[%{public}d].", windowId);
         wms_send_reply_error(resource, WMS_ERROR_INVALID_PARAM);
@@ -1118,7 +1111,7 @@ static void ControllerSetWindowSize(struct wl_client *client,
         return;
     }
 
-    windowSurface = GetSurface(&ctx->wlListWindow, windowId);
+    windowSurface = GetSurface(ctx, windowId);
     if (!windowSurface) {
         LOGE("windowSurface is not found[%{public}d].", windowId);
         wms_send_reply_error(resource, WMS_ERROR_INVALID_PARAM);
@@ -1149,7 +1142,7 @@ static void ControllerSetWindowScale(struct wl_client *client,
         return;
     }
 
-    windowSurface = GetSurface(&ctx->wlListWindow, windowId);
+    windowSurface = GetSurface(ctx, windowId);
     if (!windowSurface) {
         LOGE("windowSurface is not found[%{public}d].", windowId);
         wms_send_reply_error(resource, WMS_ERROR_INVALID_PARAM);
@@ -1181,7 +1174,7 @@ static void ControllerSetWindowPosition(struct wl_client *client,
         return;
     }
 
-    struct WindowSurface *windowSurface = GetSurface(&ctx->wlListWindow, windowId);
+    struct WindowSurface *windowSurface = GetSurface(ctx, windowId);
     if (!windowSurface) {
         LOGE("windowSurface is not found[%{public}d].", windowId);
         wms_send_reply_error(resource, WMS_ERROR_INVALID_PARAM);
@@ -1204,7 +1197,7 @@ static void PointerSetFocus(const struct WmsSeat *seat)
     DEBUG_LOG("seat->deviceFlags: %{public}d", seat->deviceFlags);
     DEBUG_LOG("seat->focusWindowId: %{public}d", seat->focusWindowId);
 
-    struct WindowSurface *forcedWindow = GetSurface(&seat->pWmsCtx->wlListWindow, seat->focusWindowId);
+    struct WindowSurface *forcedWindow = GetSurface(seat->pWmsCtx, seat->focusWindowId);
     if (!forcedWindow) {
         LOGE("forcedWindow is not found[%{public}d].", seat->focusWindowId);
         return;
@@ -1249,6 +1242,10 @@ static void PointerSetFocus(const struct WmsSeat *seat)
 static struct WmsSeat *GetWmsSeat(const char *seatName)
 {
     struct WmsContext *pWmsCtx = GetWmsInstance();
+    if (!strcmp(seatName, DEFAULT_SEAT_NAME)) {
+        return pWmsCtx->pDefaultSeat;
+    }
+
     struct WmsSeat *pSeat = NULL;
     wl_list_for_each(pSeat, &pWmsCtx->wlListSeat, wlListLink) {
         if (!strcmp(pSeat->pWestonSeat->seat_name, seatName)) {
@@ -1279,7 +1276,7 @@ static struct WindowSurface *GetDefaultFocusableWindow(uint32_t screenId)
         pLayoutInterface->get_surfaces_on_layer(layerList[i], &surfaceCnt, &surfaceList);
 
         for (int j = surfaceCnt - 1; j >= 0; j--) {
-            struct WindowSurface *pWindow = GetSurface(&pWmsCtx->wlListWindow, surfaceList[j]->id_surface);
+            struct WindowSurface *pWindow = GetSurface(pWmsCtx, surfaceList[j]->id_surface);
             if (pWindow && pWindow->type != WINDOW_TYPE_STATUS_BAR
                 && pWindow->type != WINDOW_TYPE_NAVI_BAR) {
                 LOGI("DefaultFocusableWindow found %{public}d.", pWindow->surfaceId);
@@ -1359,15 +1356,8 @@ static void ControllerSetStatusBarVisibility(const struct wl_client *client,
     struct WmsController *controller = wl_resource_get_user_data(resource);
     struct WmsContext *ctx = controller->pWmsCtx;
 
-    struct WindowSurface *windowSurface = NULL;
-    bool have = false;
-    wl_list_for_each(windowSurface, (&ctx->wlListWindow), link) {
-        if (windowSurface->type == WINDOW_TYPE_STATUS_BAR) {
-            have = true;
-            break;
-        }
-    }
-    if (!have) {
+    struct WindowSurface *windowSurface = GetSurfaceByType(ctx, WINDOW_TYPE_STATUS_BAR);
+    if (!windowSurface) {
         LOGE("StatusBar is not found");
         wms_send_reply_error(resource, WMS_ERROR_INNER_ERROR);
         wl_client_flush(wl_resource_get_client(resource));
@@ -1409,15 +1399,8 @@ static void ControllerSetNavigationBarVisibility(const struct wl_client *client,
     struct WmsController *controller = wl_resource_get_user_data(resource);
     struct WmsContext *ctx = controller->pWmsCtx;
 
-    struct WindowSurface *windowSurface = NULL;
-    bool have = false;
-    wl_list_for_each(windowSurface, (&ctx->wlListWindow), link) {
-        if (windowSurface->type == WINDOW_TYPE_NAVI_BAR) {
-            have = true;
-            break;
-        }
-    }
-    if (!have) {
+    struct WindowSurface *windowSurface = GetSurfaceByType(ctx, WINDOW_TYPE_NAVI_BAR);
+    if (!windowSurface) {
         LOGE("NavigationBar is not found");
         wms_send_reply_error(resource, WMS_ERROR_INNER_ERROR);
         wl_client_flush(wl_resource_get_client(resource));
@@ -1452,7 +1435,7 @@ static void ControllerSetWindowTop(struct wl_client *client,
         return;
     }
 
-    windowSurface = GetSurface(&ctx->wlListWindow, windowId);
+    windowSurface = GetSurface(ctx, windowId);
     if (!windowSurface) {
         LOGE("windowSurface is not found[%{public}d].", windowId);
         wms_send_reply_error(resource, WMS_ERROR_INVALID_PARAM);
@@ -1502,6 +1485,8 @@ static void SurfaceDestroy(const struct WindowSurface *surf)
 
     ClearWindowId(surf->controller, surf->surfaceId);
     wl_list_remove(&surf->link);
+    wl_list_remove(&surf->typeLink);
+    IdMapRemove(&surf->controller->pWmsCtx->windowIndex, surf->surfaceId, surf);
 
     if (surf->surf) {
         surf->surf->committed = NULL;
@@ -1539,7 +1524,7 @@ static void ControllerDestroyWindow(struct wl_client *client,
         return;
     }
 
-    windowSurface = GetSurface(&ctx->wlListWindow, windowId);
+    windowSurface = GetSurface(ctx, windowId);
     if (!windowSurface) {
         LOGE("windowSurface is not found[%{public}d].", windowId);
         wms_send_reply_error(resource, WMS_ERROR_INVALID_PARAM);
@@ -1622,11 +1607,24 @@ static void CreateWindow(struct WmsController *pWmsController,
     pWindow->isSplited = false;
     pWindow->screenId = screenId;
 
+    if (!IdMapInsert(&pWmsCtx->windowIndex, windowId, pWindow)) {
+        LOGE("IdMapInsert failed.");
+        wl_client_post_no_memory(pWmsController->pWlClient);
+        wms_send_window_status(pWlResource, WMS_WINDOW_STATUS_FAILED, WINDOW_ID_INVALID, 0, 0, 0, 0);
+        wl_client_flush(wl_resource_get_client(pWlResource));
+
+        pWmsCtx->pLayoutInterface->surface_destroy(pWindow->layoutSurface);
+        ClearWindowId(pWmsController, windowId);
+        free(pWindow);
+        return;
+    }
+
     if (!AddWindow(pWindow)) {
         LOGE("AddWindow failed.");
         wms_send_window_status(pWlResource, WMS_WINDOW_STATUS_FAILED, WINDOW_ID_INVALID, 0, 0, 0, 0);
         wl_client_flush(wl_resource_get_client(pWlResource));
 
+        IdMapRemove(&pWmsCtx->windowIndex, windowId, pWindow);
         pWmsCtx->pLayoutInterface->surface_destroy(pWindow->layoutSurface);
         ClearWindowId(pWmsController, windowId);
         free(pWindow);
@@ -1638,6 +1636,7 @@ static void CreateWindow(struct WmsController *pWmsController,
 
     wl_list_init(&pWindow->link);
     wl_list_insert(&pWmsCtx->wlListWindow, &pWindow->link);
+    wl_list_insert(&pWmsCtx->wlListWindowByType[windowType], &pWindow->typeLink);
 
     pWindow->surfaceDestroyListener.notify = WindowSurfaceDestroy;
     wl_signal_add(&pWestonSurface->destroy_signal, &pWindow->surfaceDestroyListener);
@@ -1726,7 +1725,7 @@ static void ControllerWindowshot(struct wl_client *pWlClient,
     DEBUG_LOG("start. windowId = %{public}d.", windowId);
     struct WmsController *pWmsController = wl_resource_get_user_data(pWlResource);
 
-    struct WindowSurface *pWindowSurface = GetSurface(&pWmsController->pWmsCtx->wlListWindow, windowId);
+    struct WindowSurface *pWindowSurface = GetSurface(pWmsController->pWmsCtx, windowId);
     if (!pWindowSurface) {
         LOGE("pWindowSurface is not found[%{public}d].", windowId);
         wms_send_windowshot_error(pWlResource, WMS_ERROR_INVALID_PARAM, windowId);
@@ -2080,6 +2079,7 @@ static void BindWmsController(struct wl_client *pClient,
 
 static void DestroyScreen(struct WmsScreen *pScreen)
 {
+    IdMapRemove(&pScreen->pWmsCtx->screenIndex, pScreen->screenId, pScreen);
     wl_list_remove(&pScreen->wlListLink);
     free(pScreen);
 }
@@ -2096,11 +2096,24 @@ static void WmsScreenDestroy(struct WmsContext *pCtx)
     DEBUG_LOG("end.");
 }
 
+static void UpdateDefaultSeat(struct WmsContext *pCtx)
+{
+    struct WmsSeat *pSeat = NULL;
+    pCtx->pDefaultSeat = NULL;
+    wl_list_for_each(pSeat, &pCtx->wlListSeat, wlListLink) {
+        if (!strcmp(pSeat->pWestonSeat->seat_name, DEFAULT_SEAT_NAME)) {
+            pCtx->pDefaultSeat = pSeat;
+            return;
+        }
+    }
+}
+
 static void DestroySeat(struct WmsSeat *pSeat)
 {
     DEBUG_LOG("start.");
     wl_list_remove(&pSeat->wlListenerDestroyed.link);
     wl_list_remove(&pSeat->wlListLink);
+    UpdateDefaultSeat(pSeat->pWmsCtx);
     free(pSeat);
     DEBUG_LOG("end.");
 }
@@ -2111,6 +2124,7 @@ static void SeatDestroyedEvent(struct wl_listener *listener, void *seat)
     struct WmsSeat *pSeat = wl_container_of(listener, pSeat, wlListenerDestroyed);
     wl_list_remove(&pSeat->wlListenerDestroyed.link);
     wl_list_remove(&pSeat->wlListLink);
+    UpdateDefaultSeat(pSeat->pWmsCtx);
     free(pSeat);
     SeatInfoChangerNotify();
     DEBUG_LOG("end.");
@@ -2140,6 +2154,11 @@ static void WmsControllerDestroy(struct wl_listener *listener, void *data)
         DestroySeat(pSeat);
     }
 
+    IdMapRelease(&ctx->windowIndex);
+    IdMapRelease(&ctx->screenIndex);
+    free(ctx->wlListWindowByType);
+    ctx->wlListWindowByType = NULL;
+
     free(ctx);
     DEBUG_LOG("end.");
 }
@@ -2160,6 +2179,12 @@ static int32_t CreateScreen(struct WmsContext *pCtx,
     pScreen->screenId = pOutput->id;
     pScreen->screenType = screenType;
 
+    if (!IdMapInsert(&pCtx->screenIndex, pScreen->screenId, pScreen)) {
+        LOGE("IdMapInsert failed.");
+        free(pScreen);
+        return -1;
+    }
+
     if (pScreen->screenId == 0) {
         pCtx->pMainScreen = pScreen;
     }
@@ -2223,6 +2248,7 @@ static void SeatCreatedEvent(struct wl_listener *listener, void *data)
     pSeat->pWmsCtx = pCtx;
     pSeat->pWestonSeat = seat;
     wl_list_insert(&pCtx->wlListSeat, &pSeat->wlListLink);
+    UpdateDefaultSeat(pCtx);
 
     pSeat->wlListenerDestroyed.notify = &SeatDestroyedEvent;
     wl_signal_add(&seat->destroy_signal, &pSeat->wlListenerDestroyed);
@@ -2263,6 +2289,15 @@ static int WmsContextInit(struct WmsContext *ctx, struct weston_compositor *comp
     }
 #endif
 
+    ctx->wlListWindowByType = calloc(WINDOW_TYPE_MAX, sizeof(*ctx->wlListWindowByType));
+    if (!ctx->wlListWindowByType) {
+        LOGE("calloc failed.");
+        return -1;
+    }
+    for (int i = 0; i < WINDOW_TYPE_MAX; i++) {
+        wl_list_init(&ctx->wlListWindowByType[i]);
+    }
+
     ctx->wlListenerOutputCreated.notify = OutputCreatedEvent;
     ctx->wlListenerOutputDestroyed.notify = OutputDestroyedEvent;
 
@@ -2309,8 +2344,8 @@ WL_EXPORT int wet_module_init(struct weston_compositor *compositor,
 
     wl_list_for_each(output, &compositor->output_list, link) {
         if (CreateScreen(ctx, output, WMS_SCREEN_TYPE_PHYSICAL) < 0) {
-            WmsScreenDestroy(ctx);
-            free(ctx);
+            // the listeners, seats, screens and indexes set up so far go the same way as on compositor destroy
+            WmsControllerDestroy(&ctx->wlListenerDestroy, NULL);
             return -1;
         }
     }
@@ -24,6 +24,8 @@
 #include <ivi-layout-export.h>
 #include <wms-server-protocol.h>
 
+#include "id_map.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -54,6 +56,13 @@ struct WmsContext {
 #endif
     DeviceFuncs *deviceFuncs;
     uint32_t splitMode;
+    // WindowSurface by surfaceId and WmsScreen by screenId, for the lookups of the controller requests
+    struct IdMap windowIndex;
+    struct IdMap screenIndex;
+    // the windows of each window type, newest first like wlListWindow
+    struct wl_list *wlListWindowByType;
+    // the newest seat named "default", the seat that takes the window focus
+    struct WmsSeat *pDefaultSeat;
 };
 
 struct WmsSeat {
@@ -96,6 +105,7 @@ struct WindowSurface {
     bool isSplited;
 
     struct wl_list link;
+    struct wl_list typeLink;
 };
 
 struct ScreenshotFrameListener {
@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "rects.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace {
+constexpr int32_t GRID_SIZE = 48;
+// random rects may stick out of the grid on every side
+constexpr int32_t GRID_MARGIN = 8;
+constexpr int32_t RANDOM_CASE_COUNT = 500;
+constexpr int32_t MAX_RECT_COUNT = 8;
+constexpr int32_t BENCHMARK_WINDOW_COUNT = 64;
+constexpr int32_t BENCHMARK_WIDTH = 1920;
+constexpr int32_t BENCHMARK_HEIGHT = 1080;
+
+struct TestRect {
+    int32_t x;
+    int32_t y;
+    int32_t w;
+    int32_t h;
+};
+
+using Grid = std::vector<bool>;
+
+// The subtraction Rects used before it was banded, kept as the reference for the new one.
+namespace Legacy {
+void Intersect(const TestRect &a, const TestRect &b, TestRect &out)
+{
+    out.x = std::max(a.x, b.x);
+    out.y = std::max(a.y, b.y);
+    out.w = std::min(a.x + a.w, b.x + b.w) - out.x;
+    out.h = std::min(a.y + a.h, b.y + b.h) - out.y;
+}
+
+void Subtrace(const TestRect &rect, const TestRect &inner, std::vector<TestRect> &result)
+{
+    int32_t topDiff = inner.y - rect.y;
+    if (topDiff > 0) {
+        result.push_back({rect.x, rect.y, rect.w, topDiff});
+    }
+
+    int32_t bottomDiff = rect.y + rect.h - inner.y - inner.h;
+    if (bottomDiff > 0) {
+        result.push_back({rect.x, rect.y + rect.h - bottomDiff, rect.w, bottomDiff});
+    }
+
+    int32_t middleYDiff = inner.h;
+    if (middleYDiff > 0) {
+        int32_t leftDiff = inner.x - rect.x;
+        if (leftDiff > 0) {
+            result.push_back({rect.x, inner.y, leftDiff, middleYDiff});
+        }
+
+        int32_t rightDiff = rect.x + rect.w - inner.x - inner.w;
+        if (rightDiff > 0) {
+            result.push_back({inner.x + inner.w, inner.y, rightDiff, middleYDiff});
+        }
+    }
+}
+
+void RectsSubtrace(std::vector<TestRect> &lrects, std::vector<TestRect> rrects)
+{
+    while (!rrects.empty()) {
+        auto it = rrects.begin();
+        TestRect inter = {};
+        auto findRect = [&it, &inter](const auto &item) {
+            Intersect(*it, item, inter);
+            return inter.w > 0 && inter.h > 0;
+        };
+        auto jt = std::find_if(lrects.begin(), lrects.end(), findRect);
+        if (jt == lrects.end()) {
+            rrects.erase(it);
+            continue;
+        }
+
+        TestRect rrect = *it;
+        rrects.erase(it);
+        Subtrace(rrect, inter, rrects);
+
+        TestRect lrect = *jt;
+        lrects.erase(jt);
+        Subtrace(lrect, inter, lrects);
+    }
+}
+} // namespace Legacy
+} // namespace
+
+class RectsTest : public testing::Test {
+public:
+    static void SetUpTestCase()
+    {
+    }
+
+    static void TearDownTestCase()
+    {
+    }
+
+    static std::vector<TestRect> RandomRects(std::mt19937 &random)
+    {
+        std::uniform_int_distribution<int32_t> count(0, MAX_RECT_COUNT);
+        std::uniform_int_distribution<int32_t> position(-GRID_MARGIN, GRID_SIZE);
+        std::uniform_int_distribution<int32_t> size(1, GRID_SIZE / 2);
+        std::vector<TestRect> rects(count(random));
+        for (auto &rect : rects) {
+            rect = {position(random), position(random), size(random), size(random)};
+        }
+        return rects;
+    }
+
+    static Rects ToRects(const std::vector<TestRect> &rects)
+    {
+        Rects region;
+        for (const auto &rect : rects) {
+            region |= Rects(rect.x, rect.y, rect.w, rect.h);
+        }
+        return region;
+    }
+
+    static void Fill(Grid &grid, const TestRect &rect)
+    {
+        for (int32_t y = std::max(rect.y, 0); y < std::min(rect.y + rect.h, GRID_SIZE); y++) {
+            for (int32_t x = std::max(rect.x, 0); x < std::min(rect.x + rect.w, GRID_SIZE); x++) {
+                grid[y * GRID_SIZE + x] = true;
+            }
+        }
+    }
+
+    static Grid ToGrid(const std::vector<TestRect> &rects)
+    {
+        Grid grid(GRID_SIZE * GRID_SIZE);
+        for (const auto &rect : rects) {
+            Fill(grid, rect);
+        }
+        return grid;
+    }
+
+    static Grid ToGrid(const Rects &region)
+    {
+        Grid grid(GRID_SIZE * GRID_SIZE);
+        for (int32_t i = 0; i < region.GetSize(); i++) {
+            Fill(grid, {region.GetX(i), region.GetY(i), region.GetW(i), region.GetH(i)});
+        }
+        return grid;
+    }
+
+    static Grid Combine(const Grid &a, const Grid &b, bool (*op)(bool, bool))
+    {
+        Grid grid(a.size());
+        for (size_t i = 0; i < grid.size(); i++) {
+            grid[i] = op(a[i], b[i]);
+        }
+        return grid;
+    }
+
+    // the rects are banded, disjoint and as few as the region allows
+    static void ExpectBanded(const Rects &region)
+    {
+        for (int32_t i = 0; i < region.GetSize(); i++) {
+            ASSERT_GT(region.GetW(i), 0);
+            ASSERT_GT(region.GetH(i), 0);
+            if (i == 0) {
+                continue;
+            }
+            if (region.GetY(i) == region.GetY(i - 1)) {
+                ASSERT_EQ(region.GetH(i), region.GetH(i - 1));
+                // not even touching, they would be one rect
+                ASSERT_GT(region.GetX(i), region.GetX(i - 1) + region.GetW(i - 1));
+            } else {
+                ASSERT_GE(region.GetY(i), region.GetY(i - 1) + region.GetH(i - 1));
+            }
+        }
+    }
+};
+
+/*
+* Function: operator -
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. subtract random rects from random rects with Rects and with the former subtraction
+*                  2. check both cover the same area and the result of Rects is banded
+ */
+HWTEST_F(RectsTest, Subtract001, Function | MediumTest | Level2)
+{
+    std::mt19937 random(0);
+    for (int32_t i = 0; i < RANDOM_CASE_COUNT; i++) {
+        Rects lregion = ToRects(RandomRects(random));
+        auto rrects = RandomRects(random);
+        Rects region = lregion - ToRects(rrects);
+        ExpectBanded(region);
+
+        // the former subtraction takes disjoint rects only
+        std::vector<TestRect> lrects;
+        for (int32_t j = 0; j < lregion.GetSize(); j++) {
+            lrects.push_back({lregion.GetX(j), lregion.GetY(j), lregion.GetW(j), lregion.GetH(j)});
+        }
+        Legacy::RectsSubtrace(lrects, rrects);
+        ASSERT_EQ(ToGrid(region), ToGrid(lrects)) << "case " << i;
+    }
+}
+
+/*
+* Function: operator |, operator &, operator -
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. combine random regions
+*                  2. check the results cover the combination of the areas and are banded
+ */
+HWTEST_F(RectsTest, Combine001, Function | MediumTest | Level2)
+{
+    std::mt19937 random(1);
+    for (int32_t i = 0; i < RANDOM_CASE_COUNT; i++) {
+        auto arects = RandomRects(random);
+        auto brects = RandomRects(random);
+        Rects a = ToRects(arects);
+        Rects b = ToRects(brects);
+        Grid aGrid = ToGrid(arects);
+        Grid bGrid = ToGrid(brects);
+
+        Rects unionRegion = a | b;
+        Rects intersection = a & b;
+        Rects difference = a - b;
+        ExpectBanded(unionRegion);
+        ExpectBanded(intersection);
+        ExpectBanded(difference);
+        ASSERT_EQ(ToGrid(unionRegion), Combine(aGrid, bGrid, [](bool l, bool r) { return l || r; }));
+        ASSERT_EQ(ToGrid(intersection), Combine(aGrid, bGrid, [](bool l, bool r) { return l && r; }));
+        ASSERT_EQ(ToGrid(difference), Combine(aGrid, bGrid, [](bool l, bool r) { return l && !r; }));
+    }
+}
+
+/*
+* Function: operator ==
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. build the same areas in different ways
+*                  2. check the results are the same rects
+ */
+HWTEST_F(RectsTest, Canonical001, Function | MediumTest | Level2)
+{
+    std::mt19937 random(2);
+    for (int32_t i = 0; i < RANDOM_CASE_COUNT; i++) {
+        Rects a = ToRects(RandomRects(random));
+        Rects b = ToRects(RandomRects(random));
+        ASSERT_EQ(a | b, b | a);
+        ASSERT_EQ(a & b, b & a);
+        ASSERT_EQ((a - b) | (a & b), a);
+        ASSERT_TRUE((a - a).IsEmpty());
+        ASSERT_EQ(a & a, a);
+    }
+
+    // a rectangle built from pieces is one rect
+    Rects pieces = Rects(0, 0, 10, 5) | Rects(0, 5, 4, 5) | Rects(4, 5, 6, 5);
+    ASSERT_EQ(pieces.GetSize(), 1);
+    ASSERT_EQ(pieces, Rects(0, 0, 10, 10));
+    ASSERT_TRUE(Rects(0, 0, 0, 10).IsEmpty());
+}
+
+/*
+* Function: operator -=
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. subtract a status bar and a navigation bar from the display
+*                  2. check the space left for normal windows is one rect
+ */
+HWTEST_F(RectsTest, Layout001, Function | MediumTest | Level2)
+{
+    Rects totalRects(0, 0, BENCHMARK_WIDTH, BENCHMARK_HEIGHT);
+    totalRects -= Rects(0, 0, BENCHMARK_WIDTH, 75);
+    totalRects -= Rects(0, BENCHMARK_HEIGHT - 75, BENCHMARK_WIDTH, 75);
+    ASSERT_EQ(totalRects.GetSize(), 1);
+    ASSERT_EQ(totalRects.GetX(0), 0);
+    ASSERT_EQ(totalRects.GetY(0), 75);
+    ASSERT_EQ(totalRects.GetW(0), BENCHMARK_WIDTH);
+    ASSERT_EQ(totalRects.GetH(0), BENCHMARK_HEIGHT - 150);
+}
+
+/*
+* Function: operator -
+* Type: Performance
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. subtract cascaded windows from the display with Rects and with the former subtraction
+*                  2. print the time of both
+ */
+HWTEST_F(RectsTest, Benchmark001, Function | MediumTest | Level2)
+{
+    std::vector<TestRect> windows;
+    for (int32_t i = 0; i < BENCHMARK_WINDOW_COUNT; i++) {
+        windows.push_back({i * 17, i * 11, BENCHMARK_WIDTH / 3, BENCHMARK_HEIGHT / 3});
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Rects region(0, 0, BENCHMARK_WIDTH, BENCHMARK_HEIGHT);
+    for (const auto &window : windows) {
+        region -= Rects(window.x, window.y, window.w, window.h);
+    }
+    std::chrono::duration<double, std::micro> banded = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    std::vector<TestRect> lrects = {{0, 0, BENCHMARK_WIDTH, BENCHMARK_HEIGHT}};
+    for (const auto &window : windows) {
+        Legacy::RectsSubtrace(lrects, {window});
+    }
+    std::chrono::duration<double, std::micro> legacy = std::chrono::steady_clock::now() - start;
+
+    printf("RectsTest %d windows: banded %.1f us in %d rects, former %.1f us in %zu rects\n",
+        BENCHMARK_WINDOW_COUNT, banded.count(), region.GetSize(), legacy.count(), lrects.size());
+}
+} // namespace OHOS
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pref_native_test_2.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include <display_type.h>
+#include <option_parser.h>
+#include <window_manager.h>
+
+#include "inative_test.h"
+#include "native_test_class.h"
+#include "util.h"
+
+using namespace OHOS;
+
+namespace {
+constexpr int32_t DEFAULT_WINDOW_NUMBER = 16;
+constexpr int32_t DEFAULT_QUEUE_SIZE = 8;
+constexpr int32_t DEFAULT_FRAME_NUMBER = 300;
+constexpr int32_t REQUEST_TIMEOUT_MS = 100;
+
+class PrefNativeTest2 : public INativeTest {
+public:
+    std::string GetDescription() const override
+    {
+        constexpr const char *desc = "flush perf test, many windows with deep queues";
+        return desc;
+    }
+
+    std::string GetDomain() const override
+    {
+        constexpr const char *domain = "!pref";
+        return domain;
+    }
+
+    int32_t GetID() const override
+    {
+        constexpr int32_t id = 2;
+        return id;
+    }
+
+    uint32_t GetLastTime() const override
+    {
+        constexpr uint32_t lastTime = LAST_TIME_FOREVER;
+        return lastTime;
+    }
+
+    AutoLoadService GetAutoLoadService() const override
+    {
+        return AutoLoadService::WindowManager;
+    }
+
+    // The consumer of a window looks up the wl_buffer of every flushed buffer in the WlBufferCache, which holds a
+    // buffer per window and queue slot. The flush time grows with the cost of that lookup.
+    void Run(int32_t argc, const char **argv) override
+    {
+        OptionParser parser;
+        int32_t windowNumber = DEFAULT_WINDOW_NUMBER;
+        int32_t queueSize = DEFAULT_QUEUE_SIZE;
+        int32_t frameNumber = DEFAULT_FRAME_NUMBER;
+        parser.AddOption("w", "windows", windowNumber);
+        parser.AddOption("q", "queue-size", queueSize);
+        parser.AddOption("f", "frames", frameNumber);
+        if (parser.Parse(argc, argv)) {
+            std::cerr << parser.GetErrorString() << std::endl;
+            ExitTest();
+            return;
+        }
+
+        for (int32_t i = 0; i < windowNumber; i++) {
+            auto window = NativeTestFactory::CreateWindow(WINDOW_TYPE_NORMAL);
+            if (window == nullptr) {
+                printf("create window %d failed\n", i);
+                ExitTest();
+                return;
+            }
+            window->GetSurface()->SetQueueSize(queueSize);
+            windows.push_back(window);
+        }
+
+        int64_t flushTime = 0;
+        int64_t flushCount = 0;
+        for (int32_t frame = 0; frame < frameNumber; frame++) {
+            for (const auto &window : windows) {
+                flushTime += FlushFrame(window->GetSurface(), flushCount);
+            }
+        }
+        if (flushCount == 0) {
+            printf("no buffer flushed\n");
+            ExitTest();
+            return;
+        }
+        printf("%d windows, queue size %d: %" PRId64 " flushes, flush time %" PRId64 " ns\n",
+            windowNumber, queueSize, flushCount, flushTime / flushCount);
+        windows.clear();
+        ExitTest();
+    }
+
+    // returns the time spent in FlushBuffer
+    int64_t FlushFrame(const sptr<Surface> &surf, int64_t &flushCount) const
+    {
+        BufferRequestConfig rconfig = {
+            .width = surf->GetDefaultWidth(),
+            .height = surf->GetDefaultHeight(),
+            .strideAlignment = 0x8,
+            .format = PIXEL_FMT_RGBA_8888,
+            .usage = surf->GetDefaultUsage(),
+            .timeout = REQUEST_TIMEOUT_MS,
+        };
+        sptr<SurfaceBuffer> buffer;
+        int32_t releaseFence = -1;
+        if (surf->RequestBuffer(buffer, releaseFence, rconfig) != GSERROR_OK || buffer == nullptr) {
+            return 0;
+        }
+
+        BufferFlushConfig fconfig = {
+            .damage = {
+                .w = buffer->GetWidth(),
+                .h = buffer->GetHeight(),
+            },
+        };
+        int64_t start = GetNowTime();
+        if (surf->FlushBuffer(buffer, -1, fconfig) != GSERROR_OK) {
+            return 0;
+        }
+        flushCount++;
+        return GetNowTime() - start;
+    }
+
+private:
+    std::vector<sptr<Window>> windows;
+} g_autoload;
+} // namespace
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pref_native_test_3.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include <option_parser.h>
+#include <window_manager.h>
+
+#include "inative_test.h"
+#include "native_test_class.h"
+#include "util.h"
+
+using namespace OHOS;
+
+namespace {
+constexpr int32_t DEFAULT_WINDOW_NUMBER = 32;
+constexpr int32_t DEFAULT_REQUEST_NUMBER = 5000;
+constexpr int32_t MOVE_STEP = 7;
+constexpr int32_t MOVE_RANGE = 200;
+constexpr int32_t REQUEST_KINDS = 4;
+
+class PrefNativeTest3 : public INativeTest {
+public:
+    std::string GetDescription() const override
+    {
+        constexpr const char *desc = "controller request stress test, many windows";
+        return desc;
+    }
+
+    std::string GetDomain() const override
+    {
+        constexpr const char *domain = "!pref";
+        return domain;
+    }
+
+    int32_t GetID() const override
+    {
+        constexpr int32_t id = 3;
+        return id;
+    }
+
+    uint32_t GetLastTime() const override
+    {
+        constexpr uint32_t lastTime = LAST_TIME_FOREVER;
+        return lastTime;
+    }
+
+    AutoLoadService GetAutoLoadService() const override
+    {
+        return AutoLoadService::WindowManager;
+    }
+
+    // Every request looks up its window by id in the window manager server, focus changes also look up the seat
+    // and the screen. The request time grows with the cost of those lookups.
+    void Run(int32_t argc, const char **argv) override
+    {
+        OptionParser parser;
+        int32_t windowNumber = DEFAULT_WINDOW_NUMBER;
+        int32_t requestNumber = DEFAULT_REQUEST_NUMBER;
+        parser.AddOption("w", "windows", windowNumber);
+        parser.AddOption("r", "requests", requestNumber);
+        if (parser.Parse(argc, argv)) {
+            std::cerr << parser.GetErrorString() << std::endl;
+            ExitTest();
+            return;
+        }
+
+        if (windowNumber <= 0) {
+            std::cerr << "windows must be positive" << std::endl;
+            ExitTest();
+            return;
+        }
+
+        for (int32_t i = 0; i < windowNumber; i++) {
+            auto window = NativeTestFactory::CreateWindow(WINDOW_TYPE_NORMAL);
+            if (window == nullptr) {
+                printf("create window %d failed\n", i);
+                ExitTest();
+                return;
+            }
+            windows.push_back(window);
+        }
+
+        int32_t failed = 0;
+        int64_t start = GetNowTime();
+        for (int32_t i = 0; i < requestNumber; i++) {
+            if (Request(i) != GSERROR_OK) {
+                failed++;
+            }
+        }
+        int64_t time = GetNowTime() - start;
+        printf("%d windows: %d requests, %d failed, request time %" PRId64 " ns\n",
+            windowNumber, requestNumber, failed, requestNumber > 0 ? time / requestNumber : 0);
+        windows.clear();
+        ExitTest();
+    }
+
+    // the i-th request, cycling through the windows and the kinds of requests
+    GSError Request(int32_t i) const
+    {
+        const auto &window = windows[i % windows.size()];
+        int32_t offset = (i * MOVE_STEP) % MOVE_RANGE;
+        switch ((i / windows.size()) % REQUEST_KINDS) {
+            case 0:
+                return window->Move(offset, offset)->Await();
+            case 1:
+                return window->SwitchTop()->Await();
+            case 2:
+                return window->Hide()->Await();
+            default:
+                return window->Show()->Await();
+        }
+    }
+
+private:
+    std::vector<sptr<Window>> windows;
+} g_autoload;
+} // namespace
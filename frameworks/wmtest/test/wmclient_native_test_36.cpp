@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "wmclient_native_test_36.h"
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+#include <display_type.h>
+#include <gslogger.h>
+#include <unistd.h>
+#include <window_manager.h>
+
+#include "inative_test.h"
+#include "native_test_class.h"
+#include "util.h"
+
+using namespace OHOS;
+
+namespace {
+constexpr uint32_t FRAME_QUEUE_DEPTH = 2;
+constexpr int32_t FRAME_COUNT = 200;
+constexpr int32_t OTHER_FRAME_COUNT = 50;
+constexpr uint32_t CALLBACK_TIME_US = 2000;
+constexpr uint32_t FAST_FRAME_TIME_US = 100;
+constexpr uint32_t SLOW_FRAME_TIME_US = 3000;
+constexpr uint32_t NO_BUFFER_WAIT_US = 1000;
+constexpr uint32_t SETTLE_TIME_MS = 500;
+
+class WMClientNativeTest36 : public INativeTest {
+public:
+    std::string GetDescription() const override
+    {
+        constexpr const char *desc = "offscreen subwindow frame queue, drop and destroy in callback";
+        return desc;
+    }
+
+    std::string GetDomain() const override
+    {
+        constexpr const char *domain = "wmclient";
+        return domain;
+    }
+
+    int32_t GetID() const override
+    {
+        constexpr int32_t id = 36;
+        return id;
+    }
+
+    uint32_t GetLastTime() const override
+    {
+        constexpr uint32_t lastTime = 10000;
+        return lastTime;
+    }
+
+    AutoLoadService GetAutoLoadService() const override
+    {
+        return AutoLoadService::WindowManager;
+    }
+
+    void Run(int32_t argc, const char **argv) override
+    {
+        window = NativeTestFactory::CreateWindow(WINDOW_TYPE_NORMAL);
+        if (window == nullptr) {
+            ExitTest();
+            return;
+        }
+
+        window->SwitchTop();
+        auto surf = window->GetSurface();
+        windowSync = NativeTestSync::CreateSync(NativeTestDraw::FlushDraw, surf);
+        subwindow = CreateOffscreenSubwindow();
+        otherSubwindow = CreateOffscreenSubwindow();
+        if (subwindow == nullptr || otherSubwindow == nullptr) {
+            ExitTest();
+            return;
+        }
+
+        // the callback is slower than every other frame, the queue overflows
+        subwindow->SetFrameQueueDepth(FRAME_QUEUE_DEPTH);
+        subwindow->OnFrameAvailable([](sptr<SurfaceBuffer> &buffer) {
+            usleep(CALLBACK_TIME_US);
+            return -1;
+        });
+        otherSubwindow->OnFrameAvailable([](sptr<SurfaceBuffer> &buffer) { return -1; });
+
+        // both subwindows share the frame worker
+        std::thread otherProducer([this]() {
+            auto psurf = otherSubwindow->GetSurface();
+            for (int32_t i = 0; i < OTHER_FRAME_COUNT; i++) {
+                Flush(psurf);
+                usleep(SLOW_FRAME_TIME_US);
+            }
+        });
+        auto psurf = subwindow->GetSurface();
+        for (int32_t i = 0; i < FRAME_COUNT; i++) {
+            Flush(psurf);
+            usleep(i % 0x2 ? FAST_FRAME_TIME_US : SLOW_FRAME_TIME_US);
+        }
+        otherProducer.join();
+        PostTask(std::bind(&WMClientNativeTest36::CheckStatistics, this), SETTLE_TIME_MS);
+    }
+
+private:
+    sptr<Subwindow> CreateOffscreenSubwindow()
+    {
+        auto so = SubwindowOption::Get();
+        so->SetWidth(window->GetWidth() / 0x2);
+        so->SetHeight(window->GetHeight() / 0x2);
+        so->SetX(window->GetWidth() / 0x4);
+        so->SetY(window->GetHeight() / 0x4);
+        so->SetWindowType(SUBWINDOW_TYPE_OFFSCREEN);
+        sptr<Subwindow> offscreen = nullptr;
+        auto ret = windowManager->CreateSubwindow(offscreen, window, so);
+        if (ret != GSERROR_OK || offscreen == nullptr) {
+            printf("CreateSubwindow failed with %s\n", GSErrorStr(ret).c_str());
+            return nullptr;
+        }
+        return offscreen;
+    }
+
+    void Flush(const sptr<Surface> &psurf)
+    {
+        BufferRequestConfig rconfig = {
+            .width = psurf->GetDefaultWidth(),
+            .height = psurf->GetDefaultHeight(),
+            .strideAlignment = 0x8,
+            .format = PIXEL_FMT_RGBA_8888,
+            .usage = psurf->GetDefaultUsage(),
+            .timeout = 0,
+        };
+        sptr<SurfaceBuffer> buffer = nullptr;
+        int32_t releaseFence = -1;
+        auto ret = psurf->RequestBuffer(buffer, releaseFence, rconfig);
+        while (ret == GSERROR_NO_BUFFER) {
+            usleep(NO_BUFFER_WAIT_US);
+            ret = psurf->RequestBuffer(buffer, releaseFence, rconfig);
+        }
+        if (ret != GSERROR_OK || buffer == nullptr) {
+            GSLOG7SE(ERROR) << ret;
+            return;
+        }
+
+        BufferFlushConfig fconfig = {
+            .damage = {
+                .w = buffer->GetWidth(),
+                .h = buffer->GetHeight(),
+            },
+        };
+        psurf->FlushBuffer(buffer, -1, fconfig);
+    }
+
+    static bool CheckFrames(const sptr<Subwindow> &offscreen, int32_t count, const char *name)
+    {
+        struct SubwindowFrameStatistics statistics = {};
+        offscreen->GetFrameStatistics(statistics);
+        printf("%s: presented %llu, dropped %llu, failed %llu, queued %u\n", name,
+            static_cast<unsigned long long>(statistics.presentedFrames),
+            static_cast<unsigned long long>(statistics.droppedFrames),
+            static_cast<unsigned long long>(statistics.failedFrames), statistics.queuedFrames);
+        // every buffer is either presented, released back to the producer, or counted as failed
+        return statistics.presentedFrames + statistics.droppedFrames + statistics.failedFrames ==
+            static_cast<uint64_t>(count) && statistics.queuedFrames == 0;
+    }
+
+    void CheckStatistics()
+    {
+        bool ok = CheckFrames(subwindow, FRAME_COUNT, "subwindow");
+        ok = CheckFrames(otherSubwindow, OTHER_FRAME_COUNT, "other subwindow") && ok;
+        printf("frame statistics: %s\n", ok ? "ok" : "failed");
+
+        // the subwindow goes away while its frame is processed, the frames after it are not processed
+        subwindow->OnFrameAvailable([this](sptr<SurfaceBuffer> &buffer) {
+            subwindow->Destroy();
+            destroyed = true;
+            return -1;
+        });
+        auto psurf = subwindow->GetSurface();
+        Flush(psurf);
+        Flush(psurf);
+        PostTask(std::bind(&WMClientNativeTest36::CheckDestroy, this), SETTLE_TIME_MS);
+    }
+
+    void CheckDestroy()
+    {
+        // the frame of the callback is released instead of sent, the frame after it is never queued
+        struct SubwindowFrameStatistics statistics = {};
+        subwindow->GetFrameStatistics(statistics);
+        printf("destroy in callback: %s\n", destroyed && statistics.failedFrames == 1 ? "ok" : "failed");
+        subwindow = nullptr;
+        otherSubwindow = nullptr;
+        ExitTest();
+    }
+
+    sptr<Window> window = nullptr;
+    sptr<NativeTestSync> windowSync = nullptr;
+    sptr<Subwindow> subwindow = nullptr;
+    sptr<Subwindow> otherSubwindow = nullptr;
+    std::atomic<bool> destroyed = false;
+} g_autoload;
+} // namespace
@@ -78,6 +78,8 @@ protected:
 };
 
 using OnReleaseFunc = std::function<GSError(sptr<SurfaceBuffer> &)>;
+// called with the sequence of a buffer the queue no longer holds
+using OnDeleteBufferFunc = std::function<void(int32_t)>;
 } // namespace OHOS
 
 #endif // INTERFACES_INNERKITS_SURFACE_SURFACE_BUFFER_H
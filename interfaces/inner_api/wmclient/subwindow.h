@@ -39,6 +39,17 @@ public:
     {
         return GSERROR_NOT_SUPPORT;
     }
+
+    // the number of available frames that may wait for the frame available callback before the oldest is dropped
+    virtual GSError SetFrameQueueDepth(uint32_t depth)
+    {
+        return GSERROR_NOT_SUPPORT;
+    }
+
+    virtual GSError GetFrameStatistics(struct SubwindowFrameStatistics &statistics)
+    {
+        return GSERROR_NOT_SUPPORT;
+    }
 };
 } // namespace OHOS
 
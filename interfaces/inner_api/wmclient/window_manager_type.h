@@ -105,6 +105,23 @@ struct WMDisplayInfo {
     enum DisplayType type;
 };
 
+// counters of the frames an offscreen subwindow passed through its frame available callback
+struct SubwindowFrameStatistics {
+    uint64_t presentedFrames;
+    // frames released unprocessed because more than the queue depth were waiting
+    uint64_t droppedFrames;
+    // frames that could not be acquired, sent to the server, or whose subwindow was destroyed meanwhile
+    uint64_t failedFrames;
+    // frames waiting for the callback now
+    uint32_t queuedFrames;
+    // from the buffer becoming available to its commit to the server
+    uint64_t totalLatencyNs;
+    uint64_t maxLatencyNs;
+    // spent in the callback
+    uint64_t totalProcessNs;
+    uint64_t maxProcessNs;
+};
+
 #ifdef __cplusplus
 using WindowModeChangeFunc = std::function<void(WindowMode mode)>;
 using BeforeFrameSubmitFunc = std::function<void()>;
@@ -21,6 +21,7 @@
 #include <EGL/eglext.h>
 #include "../canvas_render_context_base.h"
 #include "webgl_context_attributes.h"
+#include "../util/pixel_readback.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -76,6 +77,12 @@ public:
     int mBitMapWidth = 0;
     int mBitMapHeight = 0;
     std::function<void()> mUpdateCallback;
+
+private:
+    // the context whose bitmap the dirty region of the shared EGL context was last taken for
+    static WebGLRenderingContextBasicBase *readbackOwner;
+
+    PixelReadback mReadback;
 };
 } // namespace Rosen
 } // namespace OHOS
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ROSENRENDER_ROSEN_WEBGL_GL_STATE_CACHE
+#define ROSENRENDER_ROSEN_WEBGL_GL_STATE_CACHE
+
+#include <cstdint>
+#include <unordered_map>
+#include <GLES3/gl3.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+namespace OHOS {
+namespace Rosen {
+struct GLRect {
+    GLint x = 0;
+    GLint y = 0;
+    GLsizei width = 0;
+    GLsizei height = 0;
+};
+
+// Shadow of the bindings and capabilities of the EGL context shared by all WebGL contexts. The WebGL calls ask it
+// whether a state change still has to reach the driver, so the redundant binds that JS frameworks issue before
+// every draw are skipped. State that was never set through the shadow is unknown and always passed on. Calls that GL
+// rejects are always passed on too, so the driver raises their error every time, and they leave the shadow as is.
+class GLStateCache {
+public:
+    static GLStateCache& GetInstance()
+    {
+        static GLStateCache cache;
+        return cache;
+    }
+
+    ~GLStateCache() {}
+
+    // forgets all state, for a new context
+    void Reset();
+
+    // GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS of the context, active textures beyond it are rejected
+    void SetTextureUnitCount(GLuint count)
+    {
+        mTextureUnitCount = count;
+    }
+
+    // The Set functions record the new state and return false if it was already set, the GL call can be skipped.
+    bool SetProgram(GLuint program);
+
+    bool SetBuffer(GLenum target, GLuint buffer);
+
+    // GL_FRAMEBUFFER sets both the draw and the read framebuffer
+    bool SetFramebuffer(GLenum target, GLuint framebuffer);
+
+    bool SetRenderbuffer(GLuint renderbuffer);
+
+    bool SetActiveTexture(GLenum unit);
+
+    // binds [texture] to the active texture unit
+    bool SetTexture(GLenum target, GLuint texture);
+
+    bool SetCapability(GLenum cap, bool enabled);
+
+    bool SetViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    bool SetScissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    // A draw call, it touches the viewport clipped to the scissor box. Draws into framebuffer objects are not tracked.
+    void OnDraw();
+
+    // A clear or blit call, it touches the scissor box or the whole surface.
+    void OnClear();
+
+    // The region of the default framebuffer of [width] x [height] touched since the last call, false if there is none.
+    // The whole surface is reported after Reset and after draws or clears that are not clipped to a known box.
+    bool TakeDirtyRect(GLint width, GLint height, GLRect& rect);
+
+    // GL unbinds deleted objects from the context
+    void OnBufferDeleted(GLuint buffer);
+
+    void OnTextureDeleted(GLuint texture);
+
+    void OnFramebufferDeleted(GLuint framebuffer);
+
+    void OnRenderbufferDeleted(GLuint renderbuffer);
+
+    // for calls that change the state behind the shadow, such as binding a vertex array or failed useProgram calls
+    void InvalidateProgram();
+
+    void InvalidateBuffer(GLenum target);
+
+    uint64_t GetSkippedCount() const
+    {
+        return mSkippedCount;
+    }
+
+private:
+    static constexpr GLuint UNKNOWN = 0xFFFFFFFF;
+
+    GLStateCache() = default;
+    GLStateCache(const GLStateCache&) = delete;
+    GLStateCache& operator=(const GLStateCache&) = delete;
+
+    // records [value] in [state], false and counted as skipped if it is already there
+    bool Set(GLuint& state, GLuint value);
+
+    bool SetRect(GLRect& state, bool& known, GLint x, GLint y, GLsizei width, GLsizei height);
+
+    static bool IsBufferTarget(GLenum target);
+
+    static bool IsTextureTarget(GLenum target);
+
+    static bool IsCapability(GLenum cap);
+
+    // adds [x0, x1) x [y0, y1) to the dirty region
+    void AddDirty(int64_t x0, int64_t y0, int64_t x1, int64_t y1);
+
+    bool IsDrawingToSurface() const
+    {
+        return mDrawFramebuffer == 0 || mDrawFramebuffer == UNKNOWN;
+    }
+
+    bool IsScissorEnabled() const;
+
+    GLuint mProgram = UNKNOWN;
+    GLuint mDrawFramebuffer = UNKNOWN;
+    GLuint mReadFramebuffer = UNKNOWN;
+    GLuint mRenderbuffer = UNKNOWN;
+    GLuint mActiveTexture = UNKNOWN;
+    // the GLES 3.0 minimum until the context reports its own
+    GLuint mTextureUnitCount = 32;
+    std::unordered_map<GLenum, GLuint> mBuffers;
+    // whether a buffer was bound as an element array buffer, WebGL keeps those apart from the other targets
+    std::unordered_map<GLuint, bool> mElementBuffers;
+    // by active texture unit in the high and target in the low 32 bits
+    std::unordered_map<uint64_t, GLuint> mTextures;
+    // the target a texture was first bound to, it can't be bound to another one
+    std::unordered_map<GLuint, GLenum> mTextureTargets;
+    std::unordered_map<GLenum, GLuint> mCapabilities;
+    GLRect mViewport;
+    GLRect mScissor;
+    bool mViewportKnown = false;
+    bool mScissorKnown = false;
+    // bounds of the dirty region, empty when mDirtyX0 >= mDirtyX1
+    int64_t mDirtyX0 = 0;
+    int64_t mDirtyY0 = 0;
+    int64_t mDirtyX1 = 0;
+    int64_t mDirtyY1 = 0;
+    bool mDirtyAll = true;
+    uint64_t mSkippedCount = 0;
+};
+} // namespace Rosen
+} // namespace OHOS
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ROSENRENDER_ROSEN_WEBGL_GL_STATE_CACHE
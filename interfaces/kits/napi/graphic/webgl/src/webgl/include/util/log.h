@@ -35,7 +35,12 @@ void PrintLogI(const std::string &func, const std::string &format, Args... args)
     OHOS::HiviewDFX::HiLogLabel label {LOG_CORE, 0xD001400, "WebGL"};
     OHOS::HiviewDFX::HiLog::Info(label, formatFull.c_str(), func.c_str(), args...);
 }
+// Info logs trace every call and argument, they are only built with webgl_debug_log = true.
+#ifdef WEBGL_DEBUG_LOG
 #define LOGI(...) PrintLogI(__func__, ##__VA_ARGS__)
+#else
+#define LOGI(...) do { if (false) { PrintLogI(__func__, ##__VA_ARGS__); } } while (0)
+#endif
 #define LOGE(...) PrintLogE(__func__, ##__VA_ARGS__)
 
 #endif // ROSENRENDER_ROSEN_WEBGL_LOG
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ROSENRENDER_ROSEN_WEBGL_PIXEL_READBACK
+#define ROSENRENDER_ROSEN_WEBGL_PIXEL_READBACK
+
+#include <array>
+#include <cstddef>
+#include <GLES3/gl3.h>
+#include "gl_state_cache.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+namespace OHOS {
+namespace Rosen {
+// Copies the default framebuffer of a canvas without an EGL window into its bitmap. A synchronous read stalls until
+// the GPU has drawn the frame. A deferred read goes through a ring of pixel pack buffers with a fence each: the
+// pixels of a frame reach the bitmap at a later Read once the GPU is done, the frame after it or, when the GPU falls
+// behind, the one after that. Deferred reads need OpenGL ES 3 and fall back to synchronous reads on ES 2.
+class PixelReadback {
+public:
+    PixelReadback() = default;
+
+    ~PixelReadback();
+
+    // Reads [rect] into [bitmap] of [width] x [height] RGBA pixels in GL row order, no rect if nothing was drawn.
+    // Returns false if nothing reached the bitmap.
+    bool Read(char *bitmap, int width, int height, const GLRect *rect, bool deferred);
+
+private:
+    static constexpr size_t SLOT_COUNT = 3;
+    static constexpr size_t BYTES_PER_PIXEL = 4;
+
+    struct Slot {
+        GLuint buffer = 0;
+        GLsizeiptr capacity = 0;
+        GLsync fence = nullptr;
+        GLRect rect;
+    };
+
+    PixelReadback(const PixelReadback&) = delete;
+    PixelReadback& operator=(const PixelReadback&) = delete;
+
+    bool IsGLES3();
+
+    void ReadNow(const GLRect& rect, bool gles3);
+
+    void ReadDeferred(const GLRect& rect);
+
+    // copies the oldest pending slot into the bitmap, false if its fence is not signaled and [wait] is false
+    bool CompleteOldest(bool wait);
+
+    void DropPending();
+
+    int mSupported = -1;
+    std::array<Slot, SLOT_COUNT> mSlots;
+    size_t mOldest = 0;
+    size_t mPending = 0;
+    char *mBitMapPtr = nullptr;
+    int mBitMapWidth = 0;
+    int mBitMapHeight = 0;
+};
+} // namespace Rosen
+} // namespace OHOS
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ROSENRENDER_ROSEN_WEBGL_PIXEL_READBACK
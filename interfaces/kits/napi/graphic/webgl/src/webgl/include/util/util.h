@@ -40,6 +40,24 @@ public:
     static std::string GetContextAttr(const std::string& str, const std::string& key, int keyLength, int value);
 
     static void SetContextAttr(std::vector<std::string>& vec, WebGLContextAttributes *webGlContextAttributes);
+
+    // Location id of a WebGLUniformLocation, false for null locations.
+    static bool GetUniformLocation(napi_env env, napi_value value, GLint& location);
+
+    // Values of a Float32Array, an Int32Array or a JS array of numbers. Typed arrays are read in place, JS arrays
+    // are converted into a buffer of the calling thread that is reused, so [data] is valid until the next call.
+    static bool GetUniformFloats(napi_env env, napi_value value, const GLfloat*& data, size_t& length);
+
+    static bool GetUniformInts(napi_env env, napi_value value, const GLint*& data, size_t& length);
+
+    // Number of vectors or matrices of [components] values in the [srcLength] values after [srcOffset], all of them
+    // if [srcLength] is 0. Returns 0 if the values are out of [length] or do not fill whole vectors.
+    static GLsizei GetUniformCount(size_t length, size_t components, size_t srcOffset = 0, size_t srcLength = 0);
+
+    // Contents of an ArrayBuffer, a typed array or a DataView, read in place. [elementSize] is the element size of
+    // typed arrays and 1 for the others.
+    static bool GetBufferSource(napi_env env, napi_value value, void*& data, size_t& byteLength,
+        size_t& elementSize);
 };
 } // namespace Rosen
 } // namespace OHOS
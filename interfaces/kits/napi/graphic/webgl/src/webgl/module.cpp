@@ -89,6 +89,12 @@ static napi_value Export(napi_env env, napi_value exports)
         } else {
             webGl2RenderingContext = reinterpret_cast<WebGL2RenderingContext *>(it->second);
         }
+        if (vec.size() > 1) {
+            WebGLContextAttributes *webGlContextAttributes = new WebGLContextAttributes();
+            Util::SetContextAttr(vec, webGlContextAttributes);
+            webGl2RenderingContext->webGlContextAttributes = webGlContextAttributes;
+            webGlContextAttributes = nullptr;
+        }
 
         webGl2RenderingContext->mEGLSurface = EglManager::GetInstance().CreateSurface(
             webGl2RenderingContext->mEglWindow);
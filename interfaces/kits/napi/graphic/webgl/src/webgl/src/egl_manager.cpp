@@ -15,6 +15,7 @@
 
 #include "../include/util/egl_manager.h"
 #include "../../common/napi/n_class.h"
+#include "../include/util/gl_state_cache.h"
 #include "../include/util/log.h"
 
 #ifdef __cplusplus
@@ -147,6 +148,12 @@ void EglManager::Init()
         LOGE("EglManager Init eglCreateContext error %x", error);
     }
     eglMakeCurrent(mEGLDisplay, mCurrentSurface, mCurrentSurface, mEGLContext);
+    GLStateCache::GetInstance().Reset();
+    GLint textureUnits = 0;
+    glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &textureUnits);
+    if (textureUnits > 0) {
+        GLStateCache::GetInstance().SetTextureUnitCount(static_cast<GLuint>(textureUnits));
+    }
 }
 } // namespace Rosen
 } // namespace OHOS
@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../include/util/gl_state_cache.h"
+
+#include <algorithm>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+namespace OHOS {
+namespace Rosen {
+void GLStateCache::Reset()
+{
+    mProgram = UNKNOWN;
+    mDrawFramebuffer = UNKNOWN;
+    mReadFramebuffer = UNKNOWN;
+    mRenderbuffer = UNKNOWN;
+    mActiveTexture = UNKNOWN;
+    mBuffers.clear();
+    mElementBuffers.clear();
+    mTextures.clear();
+    mTextureTargets.clear();
+    mCapabilities.clear();
+    mViewportKnown = false;
+    mScissorKnown = false;
+    mDirtyAll = true;
+}
+
+bool GLStateCache::Set(GLuint& state, GLuint value)
+{
+    if (state == value) {
+        mSkippedCount++;
+        return false;
+    }
+    state = value;
+    return true;
+}
+
+bool GLStateCache::SetProgram(GLuint program)
+{
+    return Set(mProgram, program);
+}
+
+bool GLStateCache::SetBuffer(GLenum target, GLuint buffer)
+{
+    if (!IsBufferTarget(target)) {
+        // GL_INVALID_ENUM, the binding stays
+        return true;
+    }
+    // the copy targets take buffers of both kinds
+    if (buffer != 0 && target != GL_COPY_READ_BUFFER && target != GL_COPY_WRITE_BUFFER) {
+        bool element = target == GL_ELEMENT_ARRAY_BUFFER;
+        auto [kind, inserted] = mElementBuffers.emplace(buffer, element);
+        if (!inserted && kind->second != element) {
+            // invalid in WebGL but GL ES binds it, so the binding is unknown afterwards
+            mBuffers.erase(target);
+            return true;
+        }
+    }
+    auto [iter, inserted] = mBuffers.emplace(target, buffer);
+    return inserted || Set(iter->second, buffer);
+}
+
+bool GLStateCache::SetFramebuffer(GLenum target, GLuint framebuffer)
+{
+    if (target == GL_DRAW_FRAMEBUFFER) {
+        return Set(mDrawFramebuffer, framebuffer);
+    }
+    if (target == GL_READ_FRAMEBUFFER) {
+        return Set(mReadFramebuffer, framebuffer);
+    }
+    if (mDrawFramebuffer == framebuffer && mReadFramebuffer == framebuffer) {
+        mSkippedCount++;
+        return false;
+    }
+    mDrawFramebuffer = framebuffer;
+    mReadFramebuffer = framebuffer;
+    return true;
+}
+
+bool GLStateCache::SetRenderbuffer(GLuint renderbuffer)
+{
+    return Set(mRenderbuffer, renderbuffer);
+}
+
+bool GLStateCache::SetActiveTexture(GLenum unit)
+{
+    if (unit < GL_TEXTURE0 || unit - GL_TEXTURE0 >= mTextureUnitCount) {
+        // GL_INVALID_ENUM, the active texture stays
+        return true;
+    }
+    return Set(mActiveTexture, unit);
+}
+
+bool GLStateCache::SetTexture(GLenum target, GLuint texture)
+{
+    if (!IsTextureTarget(target)) {
+        // GL_INVALID_ENUM, the binding stays
+        return true;
+    }
+    if (texture != 0) {
+        auto [iter, inserted] = mTextureTargets.emplace(texture, target);
+        if (!inserted && iter->second != target) {
+            // GL_INVALID_OPERATION, the binding stays
+            return true;
+        }
+    }
+    if (mActiveTexture == UNKNOWN) {
+        return true;
+    }
+    uint64_t key = (static_cast<uint64_t>(mActiveTexture) << 32) | target;
+    auto [iter, inserted] = mTextures.emplace(key, texture);
+    return inserted || Set(iter->second, texture);
+}
+
+bool GLStateCache::SetCapability(GLenum cap, bool enabled)
+{
+    if (!IsCapability(cap)) {
+        // GL_INVALID_ENUM
+        return true;
+    }
+    GLuint value = enabled ? GL_TRUE : GL_FALSE;
+    auto [iter, inserted] = mCapabilities.emplace(cap, value);
+    return inserted || Set(iter->second, value);
+}
+
+bool GLStateCache::SetRect(GLRect& state, bool& known, GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    if (width < 0 || height < 0) {
+        // GL rejects the call and keeps the state
+        return true;
+    }
+    if (known && state.x == x && state.y == y && state.width == width && state.height == height) {
+        mSkippedCount++;
+        return false;
+    }
+    state = { x, y, width, height };
+    known = true;
+    return true;
+}
+
+bool GLStateCache::IsBufferTarget(GLenum target)
+{
+    switch (target) {
+        case GL_ARRAY_BUFFER:
+        case GL_ELEMENT_ARRAY_BUFFER:
+        case GL_COPY_READ_BUFFER:
+        case GL_COPY_WRITE_BUFFER:
+        case GL_PIXEL_PACK_BUFFER:
+        case GL_PIXEL_UNPACK_BUFFER:
+        case GL_TRANSFORM_FEEDBACK_BUFFER:
+        case GL_UNIFORM_BUFFER:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool GLStateCache::IsTextureTarget(GLenum target)
+{
+    switch (target) {
+        case GL_TEXTURE_2D:
+        case GL_TEXTURE_CUBE_MAP:
+        case GL_TEXTURE_3D:
+        case GL_TEXTURE_2D_ARRAY:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool GLStateCache::IsCapability(GLenum cap)
+{
+    switch (cap) {
+        case GL_BLEND:
+        case GL_CULL_FACE:
+        case GL_DEPTH_TEST:
+        case GL_DITHER:
+        case GL_POLYGON_OFFSET_FILL:
+        case GL_RASTERIZER_DISCARD:
+        case GL_SAMPLE_ALPHA_TO_COVERAGE:
+        case GL_SAMPLE_COVERAGE:
+        case GL_SCISSOR_TEST:
+        case GL_STENCIL_TEST:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool GLStateCache::SetViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    return SetRect(mViewport, mViewportKnown, x, y, width, height);
+}
+
+bool GLStateCache::SetScissor(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    return SetRect(mScissor, mScissorKnown, x, y, width, height);
+}
+
+bool GLStateCache::IsScissorEnabled() const
+{
+    auto iter = mCapabilities.find(GL_SCISSOR_TEST);
+    return iter != mCapabilities.end() && iter->second == GL_TRUE;
+}
+
+void GLStateCache::AddDirty(int64_t x0, int64_t y0, int64_t x1, int64_t y1)
+{
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+    if (mDirtyX0 >= mDirtyX1) {
+        mDirtyX0 = x0;
+        mDirtyY0 = y0;
+        mDirtyX1 = x1;
+        mDirtyY1 = y1;
+        return;
+    }
+    mDirtyX0 = std::min(mDirtyX0, x0);
+    mDirtyY0 = std::min(mDirtyY0, y0);
+    mDirtyX1 = std::max(mDirtyX1, x1);
+    mDirtyY1 = std::max(mDirtyY1, y1);
+}
+
+void GLStateCache::OnDraw()
+{
+    if (!IsDrawingToSurface() || mDirtyAll) {
+        return;
+    }
+    if (!mViewportKnown) {
+        mDirtyAll = true;
+        return;
+    }
+    int64_t x0 = mViewport.x;
+    int64_t y0 = mViewport.y;
+    int64_t x1 = x0 + mViewport.width;
+    int64_t y1 = y0 + mViewport.height;
+    if (IsScissorEnabled() && mScissorKnown) {
+        x0 = std::max<int64_t>(x0, mScissor.x);
+        y0 = std::max<int64_t>(y0, mScissor.y);
+        x1 = std::min<int64_t>(x1, static_cast<int64_t>(mScissor.x) + mScissor.width);
+        y1 = std::min<int64_t>(y1, static_cast<int64_t>(mScissor.y) + mScissor.height);
+    }
+    AddDirty(x0, y0, x1, y1);
+}
+
+void GLStateCache::OnClear()
+{
+    if (!IsDrawingToSurface() || mDirtyAll) {
+        return;
+    }
+    if (!IsScissorEnabled() || !mScissorKnown) {
+        mDirtyAll = true;
+        return;
+    }
+    AddDirty(mScissor.x, mScissor.y, static_cast<int64_t>(mScissor.x) + mScissor.width,
+        static_cast<int64_t>(mScissor.y) + mScissor.height);
+}
+
+bool GLStateCache::TakeDirtyRect(GLint width, GLint height, GLRect& rect)
+{
+    int64_t x0 = 0;
+    int64_t y0 = 0;
+    int64_t x1 = width;
+    int64_t y1 = height;
+    if (!mDirtyAll) {
+        x0 = std::max<int64_t>(x0, mDirtyX0);
+        y0 = std::max<int64_t>(y0, mDirtyY0);
+        x1 = std::min<int64_t>(x1, mDirtyX1);
+        y1 = std::min<int64_t>(y1, mDirtyY1);
+    }
+    mDirtyAll = false;
+    mDirtyX0 = 0;
+    mDirtyX1 = 0;
+    if (x0 >= x1 || y0 >= y1) {
+        return false;
+    }
+    rect = { static_cast<GLint>(x0), static_cast<GLint>(y0), static_cast<GLsizei>(x1 - x0),
+        static_cast<GLsizei>(y1 - y0) };
+    return true;
+}
+
+void GLStateCache::OnBufferDeleted(GLuint buffer)
+{
+    mElementBuffers.erase(buffer);
+    for (auto& [target, bound] : mBuffers) {
+        if (bound == buffer) {
+            bound = 0;
+        }
+    }
+}
+
+void GLStateCache::OnTextureDeleted(GLuint texture)
+{
+    mTextureTargets.erase(texture);
+    for (auto& [key, bound] : mTextures) {
+        if (bound == texture) {
+            bound = 0;
+        }
+    }
+}
+
+void GLStateCache::OnFramebufferDeleted(GLuint framebuffer)
+{
+    if (mDrawFramebuffer == framebuffer) {
+        mDrawFramebuffer = 0;
+    }
+    if (mReadFramebuffer == framebuffer) {
+        mReadFramebuffer = 0;
+    }
+}
+
+void GLStateCache::OnRenderbufferDeleted(GLuint renderbuffer)
+{
+    if (mRenderbuffer == renderbuffer) {
+        mRenderbuffer = 0;
+    }
+}
+
+void GLStateCache::InvalidateProgram()
+{
+    mProgram = UNKNOWN;
+}
+
+void GLStateCache::InvalidateBuffer(GLenum target)
+{
+    mBuffers.erase(target);
+}
+} // namespace Rosen
+} // namespace OHOS
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../include/util/pixel_readback.h"
+
+#include <cstring>
+#include "../include/util/log.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+constexpr GLuint64 WAIT_TIMEOUT_NS = 1000000000;
+constexpr char GLES3_VERSION[] = "OpenGL ES 3";
+
+// Packs tightly from the default framebuffer and puts back the state of the application afterwards.
+class ScopedPackState {
+public:
+    explicit ScopedPackState(bool gles3) : mGLES3(gles3)
+    {
+        glGetIntegerv(GL_PACK_ALIGNMENT, &mAlignment);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glGetIntegerv(mGLES3 ? GL_READ_FRAMEBUFFER_BINDING : GL_FRAMEBUFFER_BINDING, &mFramebuffer);
+        if (mFramebuffer != 0) {
+            glBindFramebuffer(mGLES3 ? GL_READ_FRAMEBUFFER : GL_FRAMEBUFFER, 0);
+        }
+        if (!mGLES3) {
+            return;
+        }
+        glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &mPackBuffer);
+        if (mPackBuffer != 0) {
+            // with a pack buffer bound, glReadPixels would write into it instead of our memory
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        }
+        glGetIntegerv(GL_PACK_ROW_LENGTH, &mRowLength);
+        glGetIntegerv(GL_PACK_SKIP_PIXELS, &mSkipPixels);
+        glGetIntegerv(GL_PACK_SKIP_ROWS, &mSkipRows);
+        glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+        glPixelStorei(GL_PACK_SKIP_PIXELS, 0);
+        glPixelStorei(GL_PACK_SKIP_ROWS, 0);
+    }
+
+    ~ScopedPackState()
+    {
+        glPixelStorei(GL_PACK_ALIGNMENT, mAlignment);
+        if (mFramebuffer != 0) {
+            glBindFramebuffer(mGLES3 ? GL_READ_FRAMEBUFFER : GL_FRAMEBUFFER, static_cast<GLuint>(mFramebuffer));
+        }
+        if (!mGLES3) {
+            return;
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, static_cast<GLuint>(mPackBuffer));
+        glPixelStorei(GL_PACK_ROW_LENGTH, mRowLength);
+        glPixelStorei(GL_PACK_SKIP_PIXELS, mSkipPixels);
+        glPixelStorei(GL_PACK_SKIP_ROWS, mSkipRows);
+    }
+
+private:
+    bool mGLES3;
+    GLint mAlignment = 1;
+    GLint mFramebuffer = 0;
+    GLint mPackBuffer = 0;
+    GLint mRowLength = 0;
+    GLint mSkipPixels = 0;
+    GLint mSkipRows = 0;
+};
+} // namespace
+
+PixelReadback::~PixelReadback()
+{
+    DropPending();
+    for (auto& slot : mSlots) {
+        if (slot.buffer != 0) {
+            glDeleteBuffers(1, &slot.buffer);
+        }
+    }
+}
+
+bool PixelReadback::IsGLES3()
+{
+    if (mSupported < 0) {
+        const char *version = reinterpret_cast<const char *>(glGetString(GL_VERSION));
+        mSupported = (version != nullptr && strncmp(version, GLES3_VERSION, strlen(GLES3_VERSION)) == 0) ? 1 : 0;
+        LOGI("PixelReadback GL version %{public}s", version == nullptr ? "unknown" : version);
+    }
+    return mSupported == 1;
+}
+
+bool PixelReadback::Read(char *bitmap, int width, int height, const GLRect *rect, bool deferred)
+{
+    if (bitmap != mBitMapPtr || width != mBitMapWidth || height != mBitMapHeight) {
+        // the pending pixels belong to the previous bitmap
+        DropPending();
+        mBitMapPtr = bitmap;
+        mBitMapWidth = width;
+        mBitMapHeight = height;
+    }
+    if (mBitMapPtr == nullptr) {
+        LOGE("PixelReadback bitmap null");
+        return false;
+    }
+    bool gles3 = IsGLES3();
+    ScopedPackState packState(gles3);
+    bool updated = false;
+    if (!deferred || !gles3) {
+        // the frames still in flight go first
+        while (mPending > 0) {
+            updated = CompleteOldest(true) || updated;
+        }
+        if (rect != nullptr) {
+            ReadNow(*rect, gles3);
+            updated = true;
+        }
+        return updated;
+    }
+    // Earlier frames the GPU is done with. It waits for the oldest one only when all slots are in flight, or when
+    // there is no new frame and the pending ones would otherwise never reach the bitmap.
+    while (mPending > 0 && CompleteOldest(mPending == SLOT_COUNT || rect == nullptr)) {
+        updated = true;
+    }
+    if (rect != nullptr) {
+        ReadDeferred(*rect);
+    }
+    return updated;
+}
+
+void PixelReadback::ReadNow(const GLRect& rect, bool gles3)
+{
+    size_t rowBytes = static_cast<size_t>(mBitMapWidth) * BYTES_PER_PIXEL;
+    if (gles3) {
+        glPixelStorei(GL_PACK_ROW_LENGTH, mBitMapWidth);
+        glReadPixels(rect.x, rect.y, rect.width, rect.height, GL_RGBA, GL_UNSIGNED_BYTE,
+            mBitMapPtr + rect.y * rowBytes + rect.x * BYTES_PER_PIXEL);
+        return;
+    }
+    // no row length on ES 2, whole rows keep the bitmap layout
+    glReadPixels(0, rect.y, mBitMapWidth, rect.height, GL_RGBA, GL_UNSIGNED_BYTE, mBitMapPtr + rect.y * rowBytes);
+}
+
+void PixelReadback::ReadDeferred(const GLRect& rect)
+{
+    Slot& slot = mSlots[(mOldest + mPending) % SLOT_COUNT];
+    if (slot.buffer == 0) {
+        glGenBuffers(1, &slot.buffer);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    GLsizeiptr size = static_cast<GLsizeiptr>(rect.width) * rect.height * BYTES_PER_PIXEL;
+    if (slot.capacity < size) {
+        // room for the whole bitmap, so later frames do not grow the buffer again
+        slot.capacity = static_cast<GLsizeiptr>(mBitMapWidth) * mBitMapHeight * BYTES_PER_PIXEL;
+        glBufferData(GL_PIXEL_PACK_BUFFER, slot.capacity, nullptr, GL_STREAM_READ);
+    }
+    glReadPixels(rect.x, rect.y, rect.width, rect.height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (slot.fence == nullptr) {
+        LOGE("PixelReadback glFenceSync failed");
+        return;
+    }
+    slot.rect = rect;
+    mPending++;
+}
+
+bool PixelReadback::CompleteOldest(bool wait)
+{
+    Slot& slot = mSlots[mOldest];
+    GLenum status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, wait ? WAIT_TIMEOUT_NS : 0);
+    if (status == GL_TIMEOUT_EXPIRED && !wait) {
+        return false;
+    }
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+    mOldest = (mOldest + 1) % SLOT_COUNT;
+    mPending--;
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+        LOGE("PixelReadback glClientWaitSync status = %{public}u", status);
+        return false;
+    }
+
+    const GLRect& rect = slot.rect;
+    size_t bytes = static_cast<size_t>(rect.width) * BYTES_PER_PIXEL;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    const char *pixels = static_cast<const char *>(
+        glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bytes * rect.height, GL_MAP_READ_BIT));
+    if (pixels == nullptr) {
+        LOGE("PixelReadback glMapBufferRange failed");
+        return false;
+    }
+    size_t rowBytes = static_cast<size_t>(mBitMapWidth) * BYTES_PER_PIXEL;
+    char *dst = mBitMapPtr + rect.y * rowBytes + rect.x * BYTES_PER_PIXEL;
+    for (GLsizei row = 0; row < rect.height; row++) {
+        memcpy(dst + row * rowBytes, pixels + row * bytes, bytes);
+    }
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    return true;
+}
+
+void PixelReadback::DropPending()
+{
+    for (; mPending > 0; mPending--) {
+        glDeleteSync(mSlots[mOldest].fence);
+        mSlots[mOldest].fence = nullptr;
+        mOldest = (mOldest + 1) % SLOT_COUNT;
+    }
+}
+} // namespace Rosen
+} // namespace OHOS
+
+#ifdef __cplusplus
+}
+#endif
@@ -15,6 +15,85 @@
 
 #include "../include/util/util.h"
 
+#include "../include/webgl/webgl_uniform_location.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+size_t GetTypedArrayElementSize(napi_typedarray_type type)
+{
+    switch (type) {
+        case napi_int8_array:
+        case napi_uint8_array:
+        case napi_uint8_clamped_array:
+            return sizeof(uint8_t);
+        case napi_int16_array:
+        case napi_uint16_array:
+            return sizeof(uint16_t);
+        case napi_int32_array:
+        case napi_uint32_array:
+        case napi_float32_array:
+            return sizeof(uint32_t);
+        default:
+            return sizeof(uint64_t);
+    }
+}
+
+bool GetNumber(napi_env env, napi_value value, GLfloat& number)
+{
+    double result = 0.0;
+    if (napi_get_value_double(env, value, &result) != napi_ok) {
+        return false;
+    }
+    number = static_cast<GLfloat>(result);
+    return true;
+}
+
+bool GetNumber(napi_env env, napi_value value, GLint& number)
+{
+    return napi_get_value_int32(env, value, &number) == napi_ok;
+}
+
+template<typename T>
+bool GetUniformValues(napi_env env, napi_value value, napi_typedarray_type typedArrayType, std::vector<T>& buffer,
+    const T*& data, size_t& length)
+{
+    bool isTypedArray = false;
+    if (napi_is_typedarray(env, value, &isTypedArray) == napi_ok && isTypedArray) {
+        napi_typedarray_type type;
+        void *typedArrayData = nullptr;
+        napi_value arrayBuffer = nullptr;
+        size_t byteOffset = 0;
+        if (napi_get_typedarray_info(env, value, &type, &length, &typedArrayData, &arrayBuffer, &byteOffset) !=
+            napi_ok || type != typedArrayType) {
+            LOGE("WebGL uniform values are not a typed array of type %{public}d", typedArrayType);
+            return false;
+        }
+        // the data pointer already includes byteOffset
+        data = static_cast<const T*>(typedArrayData);
+        return true;
+    }
+    uint32_t arrayLength = 0;
+    if (napi_get_array_length(env, value, &arrayLength) != napi_ok) {
+        LOGE("WebGL uniform values are neither a typed array nor an array");
+        return false;
+    }
+    buffer.resize(arrayLength);
+    for (uint32_t i = 0; i < arrayLength; i++) {
+        napi_value element = nullptr;
+        if (napi_get_element(env, value, i, &element) != napi_ok || !GetNumber(env, element, buffer[i])) {
+            LOGE("WebGL uniform value %{public}u is not a number", i);
+            return false;
+        }
+    }
+    data = buffer.data();
+    length = arrayLength;
+    return true;
+}
+} // namespace
+} // namespace Rosen
+} // namespace OHOS
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -120,6 +199,74 @@ void Util::SetContextAttr(vector<string>& vec, WebGLContextAttributes *webGlCont
         }
     }
 }
+
+bool Util::GetUniformLocation(napi_env env, napi_value value, GLint& location)
+{
+    WebGLUniformLocation *webGLUniformLocation = nullptr;
+    if (value == nullptr || napi_unwrap(env, value, (void **)&webGLUniformLocation) != napi_ok ||
+        webGLUniformLocation == nullptr) {
+        return false;
+    }
+    location = static_cast<GLint>(webGLUniformLocation->GetUniformLocationId());
+    return true;
+}
+
+bool Util::GetUniformFloats(napi_env env, napi_value value, const GLfloat*& data, size_t& length)
+{
+    thread_local std::vector<GLfloat> buffer;
+    return GetUniformValues(env, value, napi_float32_array, buffer, data, length);
+}
+
+bool Util::GetUniformInts(napi_env env, napi_value value, const GLint*& data, size_t& length)
+{
+    thread_local std::vector<GLint> buffer;
+    return GetUniformValues(env, value, napi_int32_array, buffer, data, length);
+}
+
+GLsizei Util::GetUniformCount(size_t length, size_t components, size_t srcOffset, size_t srcLength)
+{
+    if (srcOffset > length || srcLength > length - srcOffset) {
+        LOGE("WebGL uniform values %{public}zu + %{public}zu are out of %{public}zu", srcOffset, srcLength, length);
+        return 0;
+    }
+    size_t valueCount = (srcLength == 0) ? length - srcOffset : srcLength;
+    if (valueCount == 0 || valueCount % components != 0) {
+        LOGE("WebGL %{public}zu uniform values are not a multiple of %{public}zu", valueCount, components);
+        return 0;
+    }
+    return static_cast<GLsizei>(valueCount / components);
+}
+
+bool Util::GetBufferSource(napi_env env, napi_value value, void*& data, size_t& byteLength, size_t& elementSize)
+{
+    if (value == nullptr) {
+        return false;
+    }
+    elementSize = 1;
+    bool isType = false;
+    if (napi_is_typedarray(env, value, &isType) == napi_ok && isType) {
+        napi_typedarray_type type;
+        size_t length = 0;
+        napi_value arrayBuffer = nullptr;
+        size_t byteOffset = 0;
+        if (napi_get_typedarray_info(env, value, &type, &length, &data, &arrayBuffer, &byteOffset) != napi_ok) {
+            return false;
+        }
+        elementSize = GetTypedArrayElementSize(type);
+        byteLength = length * elementSize;
+        return true;
+    }
+    if (napi_is_dataview(env, value, &isType) == napi_ok && isType) {
+        napi_value arrayBuffer = nullptr;
+        size_t byteOffset = 0;
+        return napi_get_dataview_info(env, value, &byteLength, &data, &arrayBuffer, &byteOffset) == napi_ok;
+    }
+    if (napi_is_arraybuffer(env, value, &isType) == napi_ok && isType) {
+        return napi_get_arraybuffer_info(env, value, &data, &byteLength) == napi_ok;
+    }
+    LOGE("WebGL buffer data is not an ArrayBuffer, a typed array or a DataView");
+    return false;
+}
 } // namespace Rosen
 } // namespace OHOS
 
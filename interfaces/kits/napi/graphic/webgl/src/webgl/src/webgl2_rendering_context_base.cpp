@@ -28,6 +28,7 @@
 #include "../include/webgl/webgl_transform_feedback.h"
 #include "../include/webgl/webgl_uniform_location.h"
 #include "../include/webgl/webgl_vertex_array_object.h"
+#include "../include/util/gl_state_cache.h"
 #include "../include/util/log.h"
 #include "../include/util/util.h"
 
@@ -140,6 +141,7 @@ napi_value WebGL2RenderingContextBase::ClearBufferfv(napi_env env, napi_callback
         }
         glClearBufferfv(static_cast<GLenum>(buffer), static_cast<GLint>(drawbuffer),
             reinterpret_cast<GLfloat *>(clearBufferfv + srcOffset));
+        GLStateCache::GetInstance().OnClear();
         LOGI("WebGL2 clearBufferfv array end");
         return nullptr;
     }
@@ -159,6 +161,7 @@ napi_value WebGL2RenderingContextBase::ClearBufferfv(napi_env env, napi_callback
         float* inputFloat = (float*)((uint8_t*)(data) + srcOffset);
         glClearBufferfv(static_cast<GLenum>(buffer), static_cast<GLint>(drawbuffer),
             reinterpret_cast<GLfloat *>(inputFloat));
+        GLStateCache::GetInstance().OnClear();
     }
     LOGI("WebGL2 clearBufferfv typeArray end");
     return nullptr;
@@ -226,6 +229,7 @@ napi_value WebGL2RenderingContextBase::ClearBufferiv(napi_env env, napi_callback
         }
         glClearBufferiv(static_cast<GLenum>(buffer), static_cast<GLint>(drawbuffer),
             reinterpret_cast<GLint *>(clearBufferiv + srcOffset));
+        GLStateCache::GetInstance().OnClear();
         LOGI("WebGL2 clearBufferiv array end");
         return nullptr;
     }
@@ -245,6 +249,7 @@ napi_value WebGL2RenderingContextBase::ClearBufferiv(napi_env env, napi_callback
         int8_t* inputInt8 = (int8_t*)((uint8_t*)(data) + srcOffset);
         glClearBufferiv(static_cast<GLenum>(buffer), static_cast<GLint>(drawbuffer),
             reinterpret_cast<GLint *>(inputInt8));
+        GLStateCache::GetInstance().OnClear();
     }
     LOGI("WebGL2 clearBufferiv typeArray end");
     return nullptr;
@@ -312,6 +317,7 @@ napi_value WebGL2RenderingContextBase::ClearBufferuiv(napi_env env, napi_callbac
         }
         glClearBufferuiv(static_cast<GLenum>(buffer), static_cast<GLint>(drawbuffer),
             reinterpret_cast<GLuint *>(clearBufferuiv + srcOffset));
+        GLStateCache::GetInstance().OnClear();
         LOGI("WebGL2 clearBufferuiv array end");
         return nullptr;
     }
@@ -331,6 +337,7 @@ napi_value WebGL2RenderingContextBase::ClearBufferuiv(napi_env env, napi_callbac
         uint8_t* inputUint8 = (uint8_t*)((uint8_t*)(data) + srcOffset);
         glClearBufferuiv(static_cast<GLenum>(buffer), static_cast<GLint>(drawbuffer),
             reinterpret_cast<GLuint *>(inputUint8));
+        GLStateCache::GetInstance().OnClear();
     }
 
     LOGI("WebGL2 clearBufferuiv typeArray end");
@@ -372,6 +379,7 @@ napi_value WebGL2RenderingContextBase::ClearBufferfi(napi_env env, napi_callback
     LOGI("WebGL2 WebGL2RenderingContextBase::clearBufferfi stencil = %{public}u", stencil);
     glClearBufferfi(static_cast<GLenum>(buffer), static_cast<GLint>(drawbuffer),
         static_cast<GLfloat>((float) depth), static_cast<GLint>(stencil));
+    GLStateCache::GetInstance().OnClear();
     LOGI("WebGL2 clearBufferfi end");
     return nullptr;
 }
@@ -1052,6 +1060,7 @@ napi_value WebGL2RenderingContextBase::DeleteTransformFeedback(napi_env env, nap
     unsigned int transformFeedback = static_cast<unsigned int>(webGlTransformFeedback->GetTransformFeedback());
 
     glDeleteTransformFeedbacks(1, &transformFeedback);
+    GLStateCache::GetInstance().InvalidateBuffer(GL_TRANSFORM_FEEDBACK_BUFFER);
     LOGI("WebGL2 deleteTransformFeedback end");
     return nullptr;
 }
@@ -1105,6 +1114,7 @@ napi_value WebGL2RenderingContextBase::BindTransformFeedback(napi_env env, napi_
     unsigned int transformFeedback = static_cast<unsigned int>(webGlTransformFeedback->GetTransformFeedback());
 
     glBindTransformFeedback(static_cast<GLenum>(target), static_cast<GLuint>(transformFeedback));
+    GLStateCache::GetInstance().InvalidateBuffer(GL_TRANSFORM_FEEDBACK_BUFFER);
     LOGI("WebGL2 bindTransformFeedback end");
     return nullptr;
 }
@@ -2175,6 +2185,7 @@ napi_value WebGL2RenderingContextBase::DrawArraysInstanced(napi_env env, napi_ca
     LOGI("WebGL WebGL2RenderingContextBase::drawArraysInstanced instanceCount = %{public}u", instanceCount);
     glDrawArraysInstanced(static_cast<GLenum>(mode), static_cast<GLint>(first), static_cast<GLsizei>(count),
                           static_cast<GLsizei>(instanceCount));
+    GLStateCache::GetInstance().OnDraw();
     LOGI("WebGL drawArraysInstanced end");
     return nullptr;
 }
@@ -2221,6 +2232,7 @@ napi_value WebGL2RenderingContextBase::DrawElementsInstanced(napi_env env, napi_
     glDrawElementsInstanced(static_cast<GLenum>(mode), static_cast<GLsizei>(count), static_cast<GLenum>(type),
                             reinterpret_cast<GLvoid *>(static_cast<intptr_t>(offset)),
                             static_cast<GLsizei>(instanceCount));
+    GLStateCache::GetInstance().OnDraw();
     LOGI("WebGL drawElementsInstanced end");
     return nullptr;
 }
@@ -2273,6 +2285,7 @@ napi_value WebGL2RenderingContextBase::DrawRangeElements(napi_env env, napi_call
     glDrawRangeElements(static_cast<GLenum>(mode), static_cast<GLuint>(start), static_cast<GLuint>(end),
                         static_cast<GLsizei>(count), static_cast<GLenum>(type),
                         reinterpret_cast<GLvoid *>(static_cast<intptr_t>(offset)));
+    GLStateCache::GetInstance().OnDraw();
     LOGI("WebGL drawRangeElements end");
     return nullptr;
 }
@@ -2428,6 +2441,7 @@ napi_value WebGL2RenderingContextBase::BlitFramebuffer(napi_env env, napi_callba
         static_cast<GLint>(srcY1), static_cast<GLint>(dstX0),
         static_cast<GLint>(dstY0), static_cast<GLint>(dstX1), static_cast<GLint>(dstY1),
         static_cast<GLbitfield>(mask), static_cast<GLenum>(filter));
+    GLStateCache::GetInstance().OnClear();
     LOGI("WebGL blitFramebuffer end");
     return nullptr;
 }
@@ -2689,6 +2703,8 @@ napi_value WebGL2RenderingContextBase::BindBufferBase(napi_env env, napi_callbac
     unsigned int buffer = webGlBuffer->GetBuffer();
     LOGI("WebGL WebGLRenderContext::WebGL2RenderingContextBase bindBufferBase buffer= %{public}u", buffer);
     glBindBufferBase(static_cast<GLenum>(target), static_cast<GLuint>(index), static_cast<GLuint>(buffer));
+    // also binds the generic binding point of [target]
+    GLStateCache::GetInstance().InvalidateBuffer(static_cast<GLenum>(target));
     LOGI("WebGL bindBufferBase end");
     return nullptr;
 }
@@ -2737,6 +2753,7 @@ napi_value WebGL2RenderingContextBase::BindBufferRange(napi_env env, napi_callba
     LOGI("WebGL WebGL2RenderingContextBase::bindBufferRange size = %{public}u", size);
     glBindBufferRange(static_cast<GLenum>(target), static_cast<GLuint>(index), static_cast<GLuint>(buffer),
         static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size));
+    GLStateCache::GetInstance().InvalidateBuffer(static_cast<GLenum>(target));
     LOGI("WebGL bindBufferRange end");
     return nullptr;
 }
@@ -2897,6 +2914,7 @@ napi_value WebGL2RenderingContextBase::DeleteVertexArray(napi_env env, napi_call
     unsigned int vertexArrays = webGLVertexArrayObject->GetVertexArrays();
 
     glDeleteVertexArrays(1, &vertexArrays);
+    GLStateCache::GetInstance().InvalidateBuffer(GL_ELEMENT_ARRAY_BUFFER);
     LOGI("WebGL deleteVertexArray end");
     return nullptr;
 }
@@ -2942,6 +2960,8 @@ napi_value WebGL2RenderingContextBase::BindVertexArray(napi_env env, napi_callba
     }
     unsigned int vertexArrays = webGlVertexArrayObject->GetVertexArrays();
     glBindVertexArray(static_cast<GLuint>(vertexArrays));
+    // the element array buffer binding belongs to the vertex array
+    GLStateCache::GetInstance().InvalidateBuffer(GL_ELEMENT_ARRAY_BUFFER);
     LOGI("WebGL bindVertexArray end");
     return nullptr;
 }
@@ -22,6 +22,117 @@
 #include "../include/webgl/webgl_shader.h"
 #include "../include/webgl/webgl_texture.h"
 #include "../include/util/log.h"
+#include "../include/util/util.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+using namespace std;
+
+// optional size or offset argument, absent and undefined arguments leave [size] unchanged
+bool GetOptionalSize(napi_env env, napi_value value, size_t& size)
+{
+    if (value == nullptr || NVal(env, value).TypeIs(napi_undefined)) {
+        return true;
+    }
+    bool succ = false;
+    int64_t result = 0;
+    tie(succ, result) = NVal(env, value).ToInt64();
+    if (!succ || result < 0) {
+        LOGE("WebGL2 size or offset is not a non negative number");
+        return false;
+    }
+    size = static_cast<size_t>(result);
+    return true;
+}
+
+// narrows [data, data + byteLength) to the [srcLength] elements after [srcOffset], all of them if [srcLength] is 0
+bool SelectSrcRange(void*& data, size_t& byteLength, size_t elementSize, size_t srcOffset, size_t srcLength)
+{
+    size_t length = byteLength / elementSize;
+    if (srcOffset > length || srcLength > length - srcOffset) {
+        LOGE("WebGL2 source range %{public}zu + %{public}zu is out of %{public}zu elements",
+            srcOffset, srcLength, length);
+        return false;
+    }
+    data = static_cast<uint8_t*>(data) + srcOffset * elementSize;
+    byteLength = ((srcLength == 0) ? length - srcOffset : srcLength) * elementSize;
+    return true;
+}
+
+bool GetUniformValues(napi_env env, napi_value value, const GLfloat*& data, size_t& length)
+{
+    return Util::GetUniformFloats(env, value, data, length);
+}
+
+bool GetUniformValues(napi_env env, napi_value value, const GLint*& data, size_t& length)
+{
+    return Util::GetUniformInts(env, value, data, length);
+}
+
+// uniform[1234][fi]v(location, data, srcOffset, srcLength) with [elementSize] values per uniform
+template<typename T>
+napi_value UniformVector(napi_env env, napi_callback_info info, size_t elementSize,
+    void (GL_APIENTRY *uniform)(GLint, GLsizei, const T*))
+{
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgs(NARG_CNT::TWO, NARG_CNT::FOUR)) {
+        return nullptr;
+    }
+    GLint location = 0;
+    const T *data = nullptr;
+    size_t length = 0;
+    size_t srcOffset = 0;
+    size_t srcLength = 0;
+    if (!Util::GetUniformLocation(env, funcArg[NARG_POS::FIRST], location) ||
+        !GetUniformValues(env, funcArg[NARG_POS::SECOND], data, length) ||
+        !GetOptionalSize(env, funcArg[NARG_POS::THIRD], srcOffset) ||
+        !GetOptionalSize(env, funcArg[NARG_POS::FOURTH], srcLength)) {
+        return nullptr;
+    }
+    GLsizei count = Util::GetUniformCount(length, elementSize, srcOffset, srcLength);
+    if (count > 0) {
+        uniform(location, count, data + srcOffset);
+    }
+    return nullptr;
+}
+
+// uniformMatrix[234]fv(location, transpose, data, srcOffset, srcLength) with [elementSize] values per matrix
+napi_value UniformMatrix(napi_env env, napi_callback_info info, size_t elementSize,
+    void (GL_APIENTRY *uniform)(GLint, GLsizei, GLboolean, const GLfloat*))
+{
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgs(NARG_CNT::THREE, NARG_CNT::FIVE)) {
+        return nullptr;
+    }
+    GLint location = 0;
+    if (!Util::GetUniformLocation(env, funcArg[NARG_POS::FIRST], location)) {
+        return nullptr;
+    }
+    bool succ = false;
+    bool transpose = false;
+    tie(succ, transpose) = NVal(env, funcArg[NARG_POS::SECOND]).ToBool();
+    if (!succ) {
+        return nullptr;
+    }
+    const GLfloat *data = nullptr;
+    size_t length = 0;
+    size_t srcOffset = 0;
+    size_t srcLength = 0;
+    if (!Util::GetUniformFloats(env, funcArg[NARG_POS::THIRD], data, length) ||
+        !GetOptionalSize(env, funcArg[NARG_POS::FOURTH], srcOffset) ||
+        !GetOptionalSize(env, funcArg[NARG_POS::FIFTH], srcLength)) {
+        return nullptr;
+    }
+    GLsizei count = Util::GetUniformCount(length, elementSize, srcOffset, srcLength);
+    if (count > 0) {
+        uniform(location, count, static_cast<GLboolean>(transpose), data + srcOffset);
+    }
+    return nullptr;
+}
+} // namespace
+} // namespace Rosen
+} // namespace OHOS
 
 #ifdef __cplusplus
 extern "C" {
@@ -46,43 +157,23 @@ napi_value WebGL2RenderingContextOverloads::BufferData(napi_env env, napi_callba
     }
     LOGI("WebGL2 WebGL2RenderContext::bufferData target = %{public}u", target);
     GLvoid *data = nullptr;
-    int64_t size = 0;
-    bool usageSucc = NVal(env, funcArg[NARG_POS::SECOND]).TypeIs(napi_number);
-    if (usageSucc) {
-        LOGI("WebGL2 WebGL2RenderContext::bufferData usageSucc");
-        tie(succ, size) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt64();
-        if (!succ) {
+    size_t size = 0;
+    if (NVal(env, funcArg[NARG_POS::SECOND]).TypeIs(napi_number)) {
+        if (!GetOptionalSize(env, funcArg[NARG_POS::SECOND], size)) {
             return nullptr;
         }
-        LOGI("WebGL2 WebGL2RenderContext::bufferData size = %{public}u", size);
     } else {
-        int64_t srcOffset = 0;
-        if (funcArg[NARG_POS::FOURTH] != nullptr) {
-            tie(succ, srcOffset) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt64();
-            if (!succ) {
-                return nullptr;
-            }
-            LOGI("WebGL2 WebGL2RenderingContextBase::bufferData srcOffset = %{public}u", srcOffset);
-        }
-        int64_t length;
-        if (funcArg[NARG_POS::FIFTH] != nullptr) {
-            tie(succ, length) = NVal(env, funcArg[NARG_POS::FIFTH]).ToInt64();
-            if (!succ) {
-                return nullptr;
-            }
-            LOGI("WebGL2 WebGL2RenderingContextBase::bufferData length = %{public}u", length);
-        }
-        tie(succ, data, length) = NVal(env, funcArg[NARG_POS::SECOND]).ToArraybuffer();
-        if (!succ) {
-            tie(succ, data, length) = NVal(env, funcArg[NARG_POS::SECOND]).ToDataview();
-            if (!succ) {
-                return nullptr;
-            }
+        size_t elementSize = 0;
+        size_t srcOffset = 0;
+        size_t srcLength = 0;
+        if (!Util::GetBufferSource(env, funcArg[NARG_POS::SECOND], data, size, elementSize) ||
+            !GetOptionalSize(env, funcArg[NARG_POS::FOURTH], srcOffset) ||
+            !GetOptionalSize(env, funcArg[NARG_POS::FIFTH], srcLength) ||
+            !SelectSrcRange(data, size, elementSize, srcOffset, srcLength)) {
+            return nullptr;
         }
-        char *srcDataBase = static_cast<char *>(data);
-        data = reinterpret_cast<GLvoid *>((srcDataBase + srcOffset));
-        LOGI("WebGL2 WebGL2RenderContext::bufferData data = %{public}u", data);
     }
+    LOGI("WebGL2 WebGL2RenderContext::bufferData size = %{public}u", size);
     int64_t usage;
     tie(succ, usage) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt64();
     if (!succ) {
@@ -115,35 +206,20 @@ napi_value WebGL2RenderingContextOverloads::BufferSubData(napi_env env, napi_cal
         return nullptr;
     }
     LOGI("WebGL2 WebGL2RenderContext::bufferSubData dstByteOffset = %{public}u", dstByteOffset);
-    int64_t srcOffset = 0;
-    if (funcArg[NARG_POS::FOURTH] != nullptr) {
-        tie(succ, srcOffset) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderContext::bufferSubData srcOffset = %{public}u", srcOffset);
-    }
-    int64_t length;
-    if (funcArg[NARG_POS::FIFTH] != nullptr) {
-        tie(succ, length) = NVal(env, funcArg[NARG_POS::FIFTH]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderContext::bufferSubData length = %{public}u", length);
-    }
     GLvoid *srcData = nullptr;
-    tie(succ, srcData, length) = NVal(env, funcArg[NARG_POS::THIRD]).ToArraybuffer();
-    if (!succ) {
-        tie(succ, srcData, length) = NVal(env, funcArg[NARG_POS::THIRD]).ToDataview();
-        if (!succ) {
-            return nullptr;
-        }
+    size_t size = 0;
+    size_t elementSize = 0;
+    size_t srcOffset = 0;
+    size_t srcLength = 0;
+    if (!Util::GetBufferSource(env, funcArg[NARG_POS::THIRD], srcData, size, elementSize) ||
+        !GetOptionalSize(env, funcArg[NARG_POS::FOURTH], srcOffset) ||
+        !GetOptionalSize(env, funcArg[NARG_POS::FIFTH], srcLength) ||
+        !SelectSrcRange(srcData, size, elementSize, srcOffset, srcLength)) {
+        return nullptr;
     }
-    char *srcDataBase = static_cast<char *>(srcData);
-    srcData = reinterpret_cast<GLvoid *>((srcDataBase + srcOffset));
-    LOGI("WebGL2 WebGL2RenderContext::bufferSubData srcData = %{public}u", srcData);
+    LOGI("WebGL2 WebGL2RenderContext::bufferSubData size = %{public}u", size);
     glBufferSubData(static_cast<GLenum>(target), static_cast<GLintptr>(dstByteOffset),
-                    static_cast<GLsizeiptr>(length), reinterpret_cast<GLvoid *>(srcData));
+                    static_cast<GLsizeiptr>(size), reinterpret_cast<GLvoid *>(srcData));
     LOGI("WebGL2 bufferSubData end");
     return nullptr;
 }
@@ -828,935 +904,57 @@ napi_value WebGL2RenderingContextOverloads::CompressedTexSubImage2D(napi_env env
 
 napi_value WebGL2RenderingContextOverloads::Uniform1fv(napi_env env, napi_callback_info info)
 {
-    NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::TWO, NARG_CNT::FOUR)) {
-        return nullptr;
-    }
-    bool succ = false;
-    LOGI("WebGL2 uniform1fv start");
-    WebGLUniformLocation *webGLUniformLocation = nullptr;
-    napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
-    if (locationStatus != napi_ok) {
-        return nullptr;
-    }
-    int locationId = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform1fv locationId = %{public}u", locationId);
-    if (funcArg[NARG_POS::SECOND] == nullptr) {
-        return nullptr;
-    }
-    int64_t srcOffset = 0;
-    if (funcArg[NARG_POS::THIRD] != nullptr) {
-        tie(succ, srcOffset) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform1fv srcOffset = %{public}u", srcOffset);
-    }
-    uint32_t length;
-    if (funcArg[NARG_POS::FOURTH] != nullptr) {
-        tie(succ, length) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform1fv length = %{public}u", length);
-    }
-    napi_value array = funcArg[NARG_POS::SECOND];
-    bool isArray = false;
-    tie(succ, isArray) = NVal(env, array).IsArray();
-    if (isArray) {
-        LOGI("WebGL2 uniform1fv is Array");
-        napi_status lengthStatus = napi_get_array_length(env, array, &length);
-        if (lengthStatus != napi_ok) {
-            return nullptr;
-        }
-        float uniform1fv[length];
-        uint32_t i;
-        for (i = 0; i < length; i++) {
-            napi_value element = nullptr;
-            napi_status eleStatus = napi_get_element(env, array, i, &element);
-            if (eleStatus != napi_ok) {
-                return nullptr;
-            }
-            double ele;
-            napi_status doubleStatus = napi_get_value_double(env, element, &ele);
-            if (doubleStatus != napi_ok) {
-                return nullptr;
-            }
-            uniform1fv[i] = (float)ele;
-        }
-        glUniform1fv(static_cast<GLint>(locationId), static_cast<GLsizei>(length),
-                     reinterpret_cast<GLfloat*>(uniform1fv + srcOffset));
-        LOGI("WebGL2 uniform1fv end");
-        return nullptr;
-    }
-    bool isTypedarray = false;
-    tie(succ, isTypedarray) = NVal(env, array).IsTypeArray();
-    if (!isTypedarray || !succ) {
-        return nullptr;
-    }
-    void *data = nullptr;
-    napi_typedarray_type type;
-    tie(succ, type, data, length) = NVal(env, array).ToTypedArray();
-    if (type == napi_float32_array) {
-        float* inputFloat = (float*)((uint8_t*)(data) + srcOffset);
-        glUniform1fv(static_cast<GLint>(locationId), static_cast<GLsizei>(length),
-                     reinterpret_cast<GLfloat*>(inputFloat));
-        LOGI("WebGL2 uniform1fv end");
-        return nullptr;
-    }
-    LOGI("WebGL2 uniform1fv end");
-    return nullptr;
+    return UniformVector<GLfloat>(env, info, 1, glUniform1fv);
 }
 
 napi_value WebGL2RenderingContextOverloads::Uniform2fv(napi_env env, napi_callback_info info)
 {
-    NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::TWO, NARG_CNT::FOUR)) {
-        return nullptr;
-    }
-    bool succ = false;
-    LOGI("WebGL2 uniform2fv start");
-    WebGLUniformLocation *webGLUniformLocation = nullptr;
-    napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
-    if (locationStatus != napi_ok) {
-        return nullptr;
-    }
-    int locationId = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform2fv locationId = %{public}u", locationId);
-    if (funcArg[NARG_POS::SECOND] == nullptr) {
-        return nullptr;
-    }
-    int64_t srcOffset = 0;
-    if (funcArg[NARG_POS::THIRD] != nullptr) {
-        tie(succ, srcOffset) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform2fv srcOffset = %{public}u", srcOffset);
-    }
-    uint32_t length;
-    if (funcArg[NARG_POS::FOURTH] != nullptr) {
-        tie(succ, length) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderingContextOverloads::length length = %{public}u", length);
-    }
-    napi_value array = funcArg[NARG_POS::SECOND];
-    bool isArray = false;
-    tie(succ, isArray) = NVal(env, array).IsArray();
-    if (isArray) {
-        LOGI("WebGL2 uniform2fv is Array");
-        napi_status lengthStatus = napi_get_array_length(env, array, &length);
-        if (lengthStatus != napi_ok) {
-            return nullptr;
-        }
-        float uniform2fv[length];
-        uint32_t i;
-        for (i = 0; i < length; i++) {
-            napi_value element = nullptr;
-            napi_status eleStatus = napi_get_element(env, array, i, &element);
-            if (eleStatus != napi_ok) {
-                return nullptr;
-            }
-            double ele;
-            napi_status doubleStatus = napi_get_value_double(env, element, &ele);
-            if (doubleStatus != napi_ok) {
-                return nullptr;
-            }
-            uniform2fv[i] = (float)ele;
-        }
-        glUniform2fv(static_cast<GLint>(locationId), static_cast<GLsizei>(length),
-                     reinterpret_cast<GLfloat*>(uniform2fv + srcOffset));
-        LOGI("WebGL2 uniform2fv end");
-        return nullptr;
-    }
-    bool isTypedarray = false;
-    tie(succ, isTypedarray) = NVal(env, array).IsTypeArray();
-    if (!isTypedarray || !succ) {
-        return nullptr;
-    }
-    void *data = nullptr;
-    napi_typedarray_type type;
-    tie(succ, type, data, length) = NVal(env, array).ToTypedArray();
-    if (type == napi_float32_array) {
-        float* inputFloat = (float*)((uint8_t*)(data) + srcOffset);
-        glUniform2fv(static_cast<GLint>(locationId), static_cast<GLsizei>(length),
-                     reinterpret_cast<GLfloat*>(inputFloat));
-        LOGI("WebGL2 uniform2fv end");
-        return nullptr;
-    }
-    LOGI("WebGL2 uniform2fv end");
-    return nullptr;
+    return UniformVector<GLfloat>(env, info, 2, glUniform2fv);
 }
 
 napi_value WebGL2RenderingContextOverloads::Uniform3fv(napi_env env, napi_callback_info info)
 {
-    NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::TWO, NARG_CNT::FOUR)) {
-        return nullptr;
-    }
-    bool succ = false;
-    LOGI("WebGL2 uniform3fv start");
-    WebGLUniformLocation *webGLUniformLocation = nullptr;
-    napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
-    if (locationStatus != napi_ok) {
-        return nullptr;
-    }
-    int locationId = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform3fv locationId = %{public}u", locationId);
-    if (funcArg[NARG_POS::SECOND] == nullptr) {
-        return nullptr;
-    }
-    int64_t srcOffset = 0;
-    if (funcArg[NARG_POS::THIRD] != nullptr) {
-        tie(succ, srcOffset) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform3fv srcOffset = %{public}u", srcOffset);
-    }
-    uint32_t length;
-    if (funcArg[NARG_POS::FOURTH] != nullptr) {
-        tie(succ, length) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform3fv length = %{public}u", length);
-    }
-    napi_value array = funcArg[NARG_POS::SECOND];
-    bool isArray = false;
-    tie(succ, isArray) = NVal(env, array).IsArray();
-    if (isArray) {
-        LOGI("WebGL2 uniform3fv is Array");
-        napi_status lengthStatus = napi_get_array_length(env, array, &length);
-        if (lengthStatus != napi_ok) {
-            return nullptr;
-        }
-        float uniform3fv[length];
-        uint32_t i;
-        for (i = 0; i < length; i++) {
-            napi_value element = nullptr;
-            napi_status eleStatus = napi_get_element(env, array, i, &element);
-            if (eleStatus != napi_ok) {
-                return nullptr;
-            }
-            double ele;
-            napi_status doubleStatus = napi_get_value_double(env, element, &ele);
-            if (doubleStatus != napi_ok) {
-                return nullptr;
-            }
-            uniform3fv[i] = (float)ele;
-        }
-        glUniform3fv(static_cast<GLint>(locationId), static_cast<GLsizei>(length),
-                     reinterpret_cast<GLfloat*>(uniform3fv + srcOffset));
-        LOGI("WebGL2 uniform3fv end");
-        return nullptr;
-    }
-    bool isTypedarray = false;
-    tie(succ, isTypedarray) = NVal(env, array).IsTypeArray();
-    if (!isTypedarray || !succ) {
-        return nullptr;
-    }
-    void *data = nullptr;
-    napi_typedarray_type type;
-    tie(succ, type, data, length) = NVal(env, array).ToTypedArray();
-    if (type == napi_float32_array) {
-        float* inputFloat = (float*)((uint8_t*)(data) + srcOffset);
-        glUniform3fv(static_cast<GLint>(locationId), static_cast<GLsizei>(length),
-                     reinterpret_cast<GLfloat*>(inputFloat));
-        LOGI("WebGL2 uniform3fv end");
-        return nullptr;
-    }
-    LOGI("WebGL2 uniform3fv end");
-    return nullptr;
+    return UniformVector<GLfloat>(env, info, 3, glUniform3fv);
 }
 
 napi_value WebGL2RenderingContextOverloads::Uniform4fv(napi_env env, napi_callback_info info)
 {
-    NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::TWO, NARG_CNT::FOUR)) {
-        return nullptr;
-    }
-    bool succ = false;
-    LOGI("WebGL2 uniform4fv start");
-    WebGLUniformLocation *webGLUniformLocation = nullptr;
-    napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
-    if (locationStatus != napi_ok) {
-        return nullptr;
-    }
-    int locationId = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform4fv locationId = %{public}u", locationId);
-    if (funcArg[NARG_POS::SECOND] == nullptr) {
-        return nullptr;
-    }
-    int64_t srcOffset = 0;
-    if (funcArg[NARG_POS::THIRD] != nullptr) {
-        tie(succ, srcOffset) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform4fv srcOffset = %{public}u", srcOffset);
-    }
-    uint32_t length;
-    if (funcArg[NARG_POS::FOURTH] != nullptr) {
-        tie(succ, length) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform4fv length = %{public}u", length);
-    }
-    napi_value array = funcArg[NARG_POS::SECOND];
-    bool isArray = false;
-    tie(succ, isArray) = NVal(env, array).IsArray();
-    if (isArray) {
-        LOGI("WebGL2 uniform4fv is Array");
-        napi_status lengthStatus = napi_get_array_length(env, array, &length);
-        if (lengthStatus != napi_ok) {
-            return nullptr;
-        }
-        float uniform4fv[length];
-        uint32_t i;
-        for (i = 0; i < length; i++) {
-            napi_value element = nullptr;
-            napi_status eleStatus = napi_get_element(env, array, i, &element);
-            if (eleStatus != napi_ok) {
-                return nullptr;
-            }
-            double ele;
-            napi_status doubleStatus = napi_get_value_double(env, element, &ele);
-            if (doubleStatus != napi_ok) {
-                return nullptr;
-            }
-            uniform4fv[i] = (float)ele;
-        }
-        glUniform4fv(static_cast<GLint>(locationId), static_cast<GLsizei>(length),
-                     reinterpret_cast<GLfloat*>(uniform4fv + srcOffset));
-        LOGI("WebGL2 uniform4fv end");
-        return nullptr;
-    }
-    bool isTypedarray = false;
-    tie(succ, isTypedarray) = NVal(env, array).IsTypeArray();
-    if (!isTypedarray || !succ) {
-        return nullptr;
-    }
-    void *data = nullptr;
-    napi_typedarray_type type;
-    tie(succ, type, data, length) = NVal(env, array).ToTypedArray();
-    if (type == napi_float32_array) {
-        float* inputFloat = (float*)((uint8_t*)(data) + srcOffset);
-        glUniform4fv(static_cast<GLint>(locationId), static_cast<GLsizei>(length),
-                     reinterpret_cast<GLfloat*>(inputFloat));
-        LOGI("WebGL2 uniform4fv end");
-        return nullptr;
-    }
-    LOGI("WebGL2 uniform4fv end");
-    return nullptr;
+    return UniformVector<GLfloat>(env, info, 4, glUniform4fv);
 }
 
 napi_value WebGL2RenderingContextOverloads::Uniform1iv(napi_env env, napi_callback_info info)
 {
-    NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::TWO, NARG_CNT::FOUR)) {
-        return nullptr;
-    }
-    bool succ = false;
-    LOGI("WebGL2 uniform1iv start");
-    WebGLUniformLocation *webGLUniformLocation = nullptr;
-    napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
-    if (locationStatus != napi_ok) {
-        return nullptr;
-    }
-    int locationId = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform1iv locationId = %{public}u", locationId);
-    if (funcArg[NARG_POS::SECOND] == nullptr) {
-        return nullptr;
-    }
-    int64_t srcOffset = 0;
-    if (funcArg[NARG_POS::THIRD] != nullptr) {
-        tie(succ, srcOffset) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform1iv srcOffset = %{public}u", srcOffset);
-    }
-    uint32_t length;
-    if (funcArg[NARG_POS::FOURTH] != nullptr) {
-        tie(succ, length) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform1iv length = %{public}u", length);
-    }
-    napi_value array = funcArg[NARG_POS::SECOND];
-    bool isArray = false;
-    tie(succ, isArray) = NVal(env, array).IsArray();
-    if (isArray) {
-        LOGI("WebGL2 uniform1iv is Array");
-        uint32_t length;
-        napi_status lengthStatus = napi_get_array_length(env, array, &length);
-        if (lengthStatus != napi_ok) {
-            return nullptr;
-        }
-        int64_t uniform1iv[length];
-        uint32_t i;
-        for (i = 0; i < length; i++) {
-            napi_value element = nullptr;
-            napi_status eleStatus = napi_get_element(env, array, i, &element);
-            if (eleStatus != napi_ok) {
-                return nullptr;
-            }
-            int64_t ele;
-            napi_status intStatus = napi_get_value_int64(env, element, &ele);
-            if (intStatus != napi_ok) {
-                return nullptr;
-            }
-            uniform1iv[i] = ele;
-        }
-        glUniform1iv(static_cast<GLint>(locationId), static_cast<GLsizei>(length),
-                     reinterpret_cast<GLint *>(uniform1iv + srcOffset));
-        LOGI("WebGL2 uniform1iv array end");
-        return nullptr;
-    }
-    bool isTypedarray = false;
-    tie(succ, isTypedarray) = NVal(env, array).IsTypeArray();
-    if (!isTypedarray || !succ) {
-        return nullptr;
-    }
-    void *data = nullptr;
-    napi_typedarray_type type;
-    tie(succ, type, data, length) = NVal(env, array).ToTypedArray();
-    if (type == napi_int8_array) {
-        int8_t* inputInt8 = (int8_t*)((uint8_t*)(data) + srcOffset);
-        glUniform1iv(static_cast<GLint>(locationId), static_cast<GLsizei>(length),
-                     reinterpret_cast<GLint*>(inputInt8));
-        LOGI("WebGL2 uniform1iv end");
-        return nullptr;
-    }
-    LOGI("WebGL2 uniform1iv end");
-    return nullptr;
+    return UniformVector<GLint>(env, info, 1, glUniform1iv);
 }
 
 napi_value WebGL2RenderingContextOverloads::Uniform2iv(napi_env env, napi_callback_info info)
 {
-    NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::TWO, NARG_CNT::FOUR)) {
-        return nullptr;
-    }
-    bool succ = false;
-    LOGI("WebGL2 uniform2iv start");
-    WebGLUniformLocation *webGLUniformLocation = nullptr;
-    napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
-    if (locationStatus != napi_ok) {
-        return nullptr;
-    }
-    int locationId = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform2iv locationId = %{public}u", locationId);
-    if (funcArg[NARG_POS::SECOND] == nullptr) {
-        return nullptr;
-    }
-    int64_t srcOffset = 0;
-    if (funcArg[NARG_POS::THIRD] != nullptr) {
-        tie(succ, srcOffset) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform2iv srcOffset = %{public}u", srcOffset);
-    }
-    uint32_t length;
-    if (funcArg[NARG_POS::FOURTH] != nullptr) {
-        tie(succ, length) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform2iv length = %{public}u", length);
-    }
-    napi_value array = funcArg[NARG_POS::SECOND];
-    bool isArray = false;
-    tie(succ, isArray) = NVal(env, array).IsArray();
-    if (isArray) {
-        LOGI("WebGL2 uniform2iv is Array");
-        napi_status lengthStatus = napi_get_array_length(env, array, &length);
-        if (lengthStatus != napi_ok) {
-            return nullptr;
-        }
-        int64_t uniform2iv[length];
-        uint32_t i;
-        for (i = 0; i < length; i++) {
-            napi_value element = nullptr;
-            napi_status eleStatus = napi_get_element(env, array, i, &element);
-            if (eleStatus != napi_ok) {
-                return nullptr;
-            }
-            int64_t ele;
-            napi_status intStatus = napi_get_value_int64(env, element, &ele);
-            if (intStatus != napi_ok) {
-                return nullptr;
-            }
-            uniform2iv[i] = ele;
-        }
-        glUniform2iv(static_cast<GLint>(locationId), static_cast<GLsizei>(length),
-                     reinterpret_cast<GLint *>(uniform2iv + srcOffset));
-        LOGI("WebGL2 uniform2iv array end");
-        return nullptr;
-    }
-    bool isTypedarray = false;
-    tie(succ, isTypedarray) = NVal(env, array).IsTypeArray();
-    if (!isTypedarray || !succ) {
-        return nullptr;
-    }
-    void *data = nullptr;
-    napi_typedarray_type type;
-    tie(succ, type, data, length) = NVal(env, array).ToTypedArray();
-    if (type == napi_int8_array) {
-        int8_t* inputInt8 = (int8_t*)((uint8_t*)(data) + srcOffset);
-        glUniform2iv(static_cast<GLint>(locationId), static_cast<GLsizei>(length),
-                     reinterpret_cast<GLint*>(inputInt8));
-        LOGI("WebGL2 uniform2iv end");
-        return nullptr;
-    }
-    LOGI("WebGL2 uniform2iv end");
-    return nullptr;
+    return UniformVector<GLint>(env, info, 2, glUniform2iv);
 }
 
 napi_value WebGL2RenderingContextOverloads::Uniform3iv(napi_env env, napi_callback_info info)
 {
-    NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::TWO, NARG_CNT::FOUR)) {
-        return nullptr;
-    }
-    bool succ = false;
-    LOGI("WebGL2 uniform3iv start");
-    WebGLUniformLocation *webGLUniformLocation = nullptr;
-    napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
-    if (locationStatus != napi_ok) {
-        return nullptr;
-    }
-    int locationId = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform3iv locationId = %{public}u", locationId);
-    if (funcArg[NARG_POS::SECOND] == nullptr) {
-        return nullptr;
-    }
-    int64_t srcOffset = 0;
-    if (funcArg[NARG_POS::THIRD] != nullptr) {
-        tie(succ, srcOffset) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform3iv srcOffset = %{public}u", srcOffset);
-    }
-    uint32_t length;
-    if (funcArg[NARG_POS::FOURTH] != nullptr) {
-        tie(succ, length) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform3iv length = %{public}u", length);
-    }
-    napi_value array = funcArg[NARG_POS::SECOND];
-    bool isArray = false;
-    tie(succ, isArray) = NVal(env, array).IsArray();
-    if (isArray) {
-        LOGI("WebGL2 uniform3iv is Array");
-        napi_status lengthStatus = napi_get_array_length(env, array, &length);
-        if (lengthStatus != napi_ok) {
-            return nullptr;
-        }
-        int64_t uniform3iv[length];
-        uint32_t i;
-        for (i = 0; i < length; i++) {
-            napi_value element = nullptr;
-            napi_status eleStatus = napi_get_element(env, array, i, &element);
-            if (eleStatus != napi_ok) {
-                return nullptr;
-            }
-            int64_t ele;
-            napi_status intStatus = napi_get_value_int64(env, element, &ele);
-            if (intStatus != napi_ok) {
-                return nullptr;
-            }
-            uniform3iv[i] = ele;
-        }
-        glUniform3iv(static_cast<GLint>(locationId), static_cast<GLsizei>(length),
-                     reinterpret_cast<GLint *>(uniform3iv + srcOffset));
-        LOGI("WebGL2 uniform3iv array end");
-        return nullptr;
-    }
-    bool isTypedarray = false;
-    tie(succ, isTypedarray) = NVal(env, array).IsTypeArray();
-    if (!isTypedarray || !succ) {
-        return nullptr;
-    }
-    void *data = nullptr;
-    napi_typedarray_type type;
-    tie(succ, type, data, length) = NVal(env, array).ToTypedArray();
-    if (type == napi_int8_array) {
-        int8_t* inputInt8 = (int8_t*)((uint8_t*)(data) + srcOffset);
-        glUniform3iv(static_cast<GLint>(locationId), static_cast<GLsizei>(length),
-                     reinterpret_cast<GLint*>(inputInt8));
-        LOGI("WebGL2 uniform3iv end");
-        return nullptr;
-    }
-    LOGI("WebGL2 uniform3iv end");
-    return nullptr;
+    return UniformVector<GLint>(env, info, 3, glUniform3iv);
 }
 
 napi_value WebGL2RenderingContextOverloads::Uniform4iv(napi_env env, napi_callback_info info)
 {
-    NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::TWO, NARG_CNT::FOUR)) {
-        return nullptr;
-    }
-    bool succ = false;
-    LOGI("WebGL2 uniform4iv start");
-    WebGLUniformLocation *webGLUniformLocation = nullptr;
-    napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
-    if (locationStatus != napi_ok) {
-        return nullptr;
-    }
-    int locationId = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform4iv locationId = %{public}u", locationId);
-    if (funcArg[NARG_POS::SECOND] == nullptr) {
-        return nullptr;
-    }
-    int64_t srcOffset = 0;
-    if (funcArg[NARG_POS::THIRD] != nullptr) {
-        tie(succ, srcOffset) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform4iv srcOffset = %{public}u", srcOffset);
-    }
-    uint32_t length = 0;
-    if (funcArg[NARG_POS::FOURTH] != nullptr) {
-        tie(succ, length) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderingContextOverloads::uniform4iv length = %{public}u", length);
-    }
-    napi_value array = funcArg[NARG_POS::SECOND];
-    bool isArray = false;
-    tie(succ, isArray) = NVal(env, array).IsArray();
-    if (isArray) {
-        LOGI("WebGL2 uniform4iv is Array");
-        napi_status lengthStatus = napi_get_array_length(env, array, &length);
-        if (lengthStatus != napi_ok) {
-            return nullptr;
-        }
-        int64_t uniform4iv[length];
-        uint32_t i;
-        for (i = 0; i < length; i++) {
-            napi_value element = nullptr;
-            napi_status eleStatus = napi_get_element(env, array, i, &element);
-            if (eleStatus != napi_ok) {
-                return nullptr;
-            }
-            int64_t ele;
-            napi_status intStatus = napi_get_value_int64(env, element, &ele);
-            if (intStatus != napi_ok) {
-                return nullptr;
-            }
-            uniform4iv[i] = ele;
-        }
-        glUniform4iv(static_cast<GLint>(locationId), static_cast<GLsizei>(length),
-                     reinterpret_cast<GLint *>(uniform4iv + srcOffset));
-        LOGI("WebGL2 uniform4iv array end");
-        return nullptr;
-    }
-    bool isTypedarray = false;
-    tie(succ, isTypedarray) = NVal(env, array).IsTypeArray();
-    if (!isTypedarray || !succ) {
-        return nullptr;
-    }
-    void *data = nullptr;
-    napi_typedarray_type type;
-    tie(succ, type, data, length) = NVal(env, array).ToTypedArray();
-    if (type == napi_int8_array) {
-        int8_t* inputInt8 = (int8_t*)((uint8_t*)(data) + srcOffset);
-        glUniform4iv(static_cast<GLint>(locationId), static_cast<GLsizei>(length),
-                     reinterpret_cast<GLint*>(inputInt8));
-        LOGI("WebGL2 uniform4iv end");
-        return nullptr;
-    }
-    LOGI("WebGL2 uniform4iv end");
-    return nullptr;
+    return UniformVector<GLint>(env, info, 4, glUniform4iv);
 }
 
 napi_value WebGL2RenderingContextOverloads::UniformMatrix2fv(napi_env env, napi_callback_info info)
 {
-    NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::THREE, NARG_CNT::FIVE)) {
-        return nullptr;
-    }
-    if (funcArg[NARG_POS::FIRST] == nullptr) {
-        return nullptr;
-    }
-    bool succ = false;
-    LOGI("WebGL2 uniformMatrix2fv start");
-    WebGLUniformLocation *webGLUniformLocation = nullptr;
-    napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
-    if (locationStatus != napi_ok) {
-        return nullptr;
-    }
-    int locationId = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL2 WebGL2RenderContext::uniformMatrix2fv locationId = %{public}u", locationId);
-    bool transpose = false;
-    tie(succ, transpose)  = NVal(env, funcArg[NARG_POS::SECOND]).ToBool();
-    if (!succ) {
-        return nullptr;
-    }
-    LOGI("WebGL2 WebGL2RenderContext::uniformMatrix2fv transpose = %{public}u", transpose);
-    if (funcArg[NARG_POS::THIRD] == nullptr) {
-        return nullptr;
-    }
-    int64_t srcOffset = 0;
-    if (funcArg[NARG_POS::FOURTH] != nullptr) {
-        tie(succ, srcOffset) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderingContextOverloads::uniformMatrix2fv srcOffset = %{public}u", srcOffset);
-    }
-    uint32_t length;
-    if (funcArg[NARG_POS::FIFTH] != nullptr) {
-        tie(succ, length) = NVal(env, funcArg[NARG_POS::FIFTH]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderingContextOverloads::uniformMatrix2fv length = %{public}u", length);
-    }
-    napi_value array = funcArg[NARG_POS::THIRD];
-    bool isArray = false;
-    tie(succ, isArray) = NVal(env, array).IsArray();
-    if (isArray) {
-        LOGI("WebGL2 uniformMatrix2fv is Array");
-        napi_status lengthStatus = napi_get_array_length(env, array, &length);
-        if (lengthStatus != napi_ok) {
-            return nullptr;
-        }
-        float uniformMatrix2fv[length];
-        uint32_t i;
-        for (i = 0; i < length; i++) {
-            napi_value element = nullptr;
-            napi_status eleStatus = napi_get_element(env, array, i, &element);
-            if (eleStatus != napi_ok) {
-                return nullptr;
-            }
-            double ele;
-            napi_status doubleStatus = napi_get_value_double(env, element, &ele);
-            if (doubleStatus != napi_ok) {
-                return nullptr;
-            }
-            uniformMatrix2fv[i] = (float)ele;
-        }
-        glUniformMatrix2fv(static_cast<GLint>(locationId), static_cast<GLsizei>(length),
-                           static_cast<GLboolean>(transpose),
-                           reinterpret_cast<GLfloat *>(uniformMatrix2fv + srcOffset));
-        LOGI("WebGL2 uniformMatrix2fv end");
-        return nullptr;
-    }
-    bool isTypedarray = false;
-    tie(succ, isTypedarray) = NVal(env, array).IsTypeArray();
-    if (!isTypedarray || !succ) {
-        return nullptr;
-    }
-    void *data = nullptr;
-    napi_typedarray_type type;
-    tie(succ, type, data, length) = NVal(env, array).ToTypedArray();
-    if (type == napi_float32_array) {
-        float* inputFloat = (float*)((uint8_t*)(data) + srcOffset);
-        glUniformMatrix2fv(static_cast<GLint>(locationId), static_cast<GLsizei>(length),
-                           static_cast<GLboolean>(transpose), reinterpret_cast<GLfloat *>(inputFloat));
-        LOGI("WebGL2 uniformMatrix2fv end");
-        return nullptr;
-    }
-    LOGI("WebGL2 uniformMatrix2fv end");
-    return nullptr;
+    return UniformMatrix(env, info, 4, glUniformMatrix2fv);
 }
 
 napi_value WebGL2RenderingContextOverloads::UniformMatrix3fv(napi_env env, napi_callback_info info)
 {
-    NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::THREE, NARG_CNT::FIVE)) {
-        return nullptr;
-    }
-    if (funcArg[NARG_POS::FIRST] == nullptr) {
-        return nullptr;
-    }
-    bool succ = false;
-    LOGI("WebGL2 uniformMatrix3fv start");
-    WebGLUniformLocation *webGLUniformLocation = nullptr;
-    napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
-    if (locationStatus != napi_ok) {
-        return nullptr;
-    }
-    int locationId = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL2 WebGL2RenderContext::uniformMatrix3fv locationId = %{public}u", locationId);
-    bool transpose = false;
-    tie(succ, transpose)  = NVal(env, funcArg[NARG_POS::SECOND]).ToBool();
-    if (!succ) {
-        return nullptr;
-    }
-    LOGI("WebGL2 WebGL2RenderContext::uniformMatrix3fv transpose = %{public}u", transpose);
-    if (funcArg[NARG_POS::THIRD] == nullptr) {
-        return nullptr;
-    }
-    int64_t srcOffset = 0;
-    if (funcArg[NARG_POS::FOURTH] != nullptr) {
-        tie(succ, srcOffset) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderingContextOverloads::uniformMatrix3fv srcOffset = %{public}u", srcOffset);
-    }
-    uint32_t length;
-    if (funcArg[NARG_POS::FIFTH] != nullptr) {
-        tie(succ, length) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderingContextOverloads::uniformMatrix3fv length = %{public}u", length);
-    }
-    napi_value array = funcArg[NARG_POS::THIRD];
-    bool isArray = false;
-    tie(succ, isArray) = NVal(env, array).IsArray();
-    if (isArray) {
-        LOGI("WebGL2 uniformMatrix3fv is Array");
-        napi_status lengthStatus = napi_get_array_length(env, array, &length);
-        if (lengthStatus != napi_ok) {
-            return nullptr;
-        }
-        float uniformMatrix3fv[length];
-        uint32_t i;
-        for (i = 0; i < length; i++) {
-            napi_value element = nullptr;
-            napi_status eleStatus = napi_get_element(env, array, i, &element);
-            if (eleStatus != napi_ok) {
-                return nullptr;
-            }
-            double ele;
-            napi_status doubleStatus = napi_get_value_double(env, element, &ele);
-            if (doubleStatus != napi_ok) {
-                return nullptr;
-            }
-            uniformMatrix3fv[i] = (float)ele;
-        }
-        glUniformMatrix3fv(static_cast<GLint>(locationId), static_cast<GLsizei>(length),
-                           static_cast<GLboolean>(transpose),
-                           reinterpret_cast<GLfloat *>(uniformMatrix3fv + srcOffset));
-        LOGI("WebGL2 uniformMatrix3fv end");
-        return nullptr;
-    }
-    bool isTypedarray = false;
-    tie(succ, isTypedarray) = NVal(env, array).IsTypeArray();
-    if (!isTypedarray || !succ) {
-        return nullptr;
-    }
-    void *data = nullptr;
-    napi_typedarray_type type;
-    tie(succ, type, data, length) = NVal(env, array).ToTypedArray();
-    if (type == napi_float32_array) {
-        float* inputFloat = (float*)((uint8_t*)(data) + srcOffset);
-        glUniformMatrix3fv(static_cast<GLint>(locationId), static_cast<GLsizei>(length),
-                           static_cast<GLboolean>(transpose), reinterpret_cast<GLfloat *>(inputFloat));
-        LOGI("WebGL2 uniformMatrix3fv end");
-        return nullptr;
-    }
-    LOGI("WebGL2 uniformMatrix3fv end");
-    return nullptr;
+    return UniformMatrix(env, info, 9, glUniformMatrix3fv);
 }
 
 napi_value WebGL2RenderingContextOverloads::UniformMatrix4fv(napi_env env, napi_callback_info info)
 {
-    NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::THREE, NARG_CNT::FIVE)) {
-        return nullptr;
-    }
-    if (funcArg[NARG_POS::FIRST] == nullptr) {
-        return nullptr;
-    }
-    bool succ = false;
-    LOGI("WebGL2 uniformMatrix4fv start");
-    WebGLUniformLocation *webGLUniformLocation = nullptr;
-    napi_status locationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
-    if (locationStatus != napi_ok) {
-        return nullptr;
-    }
-    int locationId = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL2 WebGL2RenderContext::uniformMatrix4fv locationId = %{public}u", locationId);
-    bool transpose = false;
-    tie(succ, transpose)  = NVal(env, funcArg[NARG_POS::SECOND]).ToBool();
-    if (!succ) {
-        return nullptr;
-    }
-    LOGI("WebGL2 WebGL2RenderContext::uniformMatrix4fv transpose = %{public}u", transpose);
-    if (funcArg[NARG_POS::THIRD] == nullptr) {
-        return nullptr;
-    }
-    int64_t srcOffset = 0;
-    if (funcArg[NARG_POS::FOURTH] != nullptr) {
-        tie(succ, srcOffset) = NVal(env, funcArg[NARG_POS::FOURTH]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderingContextOverloads::uniformMatrix4fv srcOffset = %{public}u", srcOffset);
-    }
-    uint32_t length;
-    if (funcArg[NARG_POS::FIFTH] != nullptr) {
-        tie(succ, length) = NVal(env, funcArg[NARG_POS::FIFTH]).ToInt64();
-        if (!succ) {
-            return nullptr;
-        }
-        LOGI("WebGL2 WebGL2RenderingContextOverloads::uniformMatrix4fv length = %{public}u", length);
-    }
-    napi_value array = funcArg[NARG_POS::THIRD];
-    bool isArray = false;
-    tie(succ, isArray) = NVal(env, array).IsArray();
-    if (isArray) {
-        LOGI("WebGL2 uniformMatrix4fv is Array");
-        napi_status lengthStatus = napi_get_array_length(env, array, &length);
-        if (lengthStatus != napi_ok) {
-            return nullptr;
-        }
-        float uniformMatrix4fv[length];
-        uint32_t i;
-        for (i = 0; i < length; i++) {
-            napi_value element = nullptr;
-            napi_status eleStatus = napi_get_element(env, array, i, &element);
-            if (eleStatus != napi_ok) {
-                return nullptr;
-            }
-            double ele;
-            napi_status doubleStatus = napi_get_value_double(env, element, &ele);
-            if (doubleStatus != napi_ok) {
-                return nullptr;
-            }
-            uniformMatrix4fv[i] = (float)ele;
-        }
-        glUniformMatrix4fv(static_cast<GLint>(locationId), static_cast<GLsizei>(length),
-                           static_cast<GLboolean>(transpose),
-                           reinterpret_cast<GLfloat *>(uniformMatrix4fv + srcOffset));
-        LOGI("WebGL2 uniformMatrix4fv end");
-        return nullptr;
-    }
-    bool isTypedarray = false;
-    tie(succ, isTypedarray) = NVal(env, array).IsTypeArray();
-    if (!isTypedarray || !succ) {
-        return nullptr;
-    }
-    void *data = nullptr;
-    napi_typedarray_type type;
-    tie(succ, type, data, length) = NVal(env, array).ToTypedArray();
-    if (type == napi_float32_array) {
-        float* inputFloat = (float*)((uint8_t*)(data) + srcOffset);
-        glUniformMatrix4fv(static_cast<GLint>(locationId), static_cast<GLsizei>(length),
-                           static_cast<GLboolean>(transpose), reinterpret_cast<GLfloat *>(inputFloat));
-        LOGI("WebGL2 uniformMatrix4fv end");
-        return nullptr;
-    }
-    LOGI("WebGL2 uniformMatrix4fv end");
-    return nullptr;
+    return UniformMatrix(env, info, 16, glUniformMatrix4fv);
 }
 
 napi_value WebGL2RenderingContextOverloads::ReadPixels(napi_env env, napi_callback_info info)
@@ -30,6 +30,7 @@
 #include "../include/webgl/webgl_shader_precision_format.h"
 #include "../include/util/log.h"
 #include "../include/util/egl_manager.h"
+#include "../include/util/gl_state_cache.h"
 #include "../include/util/object_source.h"
 #include "../include/util/util.h"
 
@@ -125,7 +126,9 @@ napi_value WebGLRenderingContextBase::ActiveTexture(napi_env env, napi_callback_
         return nullptr;
     }
     LOGI("WebGL WebGLRenderingContextBase::activeTexture texture = %{public}u", texture);
-    glActiveTexture(static_cast<GLenum>(texture));
+    if (GLStateCache::GetInstance().SetActiveTexture(static_cast<GLenum>(texture))) {
+        glActiveTexture(static_cast<GLenum>(texture));
+    }
     LOGI("WebGL activeTexture end");
     return nullptr;
 }
@@ -221,7 +224,9 @@ napi_value WebGLRenderingContextBase::BindBuffer(napi_env env, napi_callback_inf
         return nullptr;
     }
     unsigned int buffer = webGlBuffer->GetBuffer();
-    glBindBuffer(static_cast<GLenum>(target), static_cast<GLuint>(buffer));
+    if (GLStateCache::GetInstance().SetBuffer(static_cast<GLenum>(target), static_cast<GLuint>(buffer))) {
+        glBindBuffer(static_cast<GLenum>(target), static_cast<GLuint>(buffer));
+    }
     LOGI("WebGL bindBuffer end");
     return nullptr;
 }
@@ -251,7 +256,9 @@ napi_value WebGLRenderingContextBase::BindFramebuffer(napi_env env, napi_callbac
         return nullptr;
     }
     unsigned int framebuffer = webGlFramebuffer->GetFramebuffer();
-    glBindFramebuffer(static_cast<GLenum>(target), static_cast<GLuint>(framebuffer));
+    if (GLStateCache::GetInstance().SetFramebuffer(static_cast<GLenum>(target), static_cast<GLuint>(framebuffer))) {
+        glBindFramebuffer(static_cast<GLenum>(target), static_cast<GLuint>(framebuffer));
+    }
     LOGI("WebGL bindFramebuffer end");
     return nullptr;
 }
@@ -281,7 +288,9 @@ napi_value WebGLRenderingContextBase::BindRenderbuffer(napi_env env, napi_callba
         return nullptr;
     }
     unsigned int renderbuffer = webGlRenderbuffer->GetRenderbuffer();
-    glBindRenderbuffer(static_cast<GLenum>(target), static_cast<GLuint>(renderbuffer));
+    if (GLStateCache::GetInstance().SetRenderbuffer(static_cast<GLuint>(renderbuffer))) {
+        glBindRenderbuffer(static_cast<GLenum>(target), static_cast<GLuint>(renderbuffer));
+    }
     LOGI("WebGL bindRenderbuffer end");
     return nullptr;
 }
@@ -312,7 +321,9 @@ napi_value WebGLRenderingContextBase::BindTexture(napi_env env, napi_callback_in
     }
     unsigned int texture = webGlTexture->GetTexture();
     LOGI("WebGL WebGLRenderingContextBase::bindTexture textureId = %{public}u", texture);
-    glBindTexture(static_cast<GLenum>(target), static_cast<GLuint>(texture));
+    if (GLStateCache::GetInstance().SetTexture(static_cast<GLenum>(target), static_cast<GLuint>(texture))) {
+        glBindTexture(static_cast<GLenum>(target), static_cast<GLuint>(texture));
+    }
     LOGI("WebGL bindTexture end");
     return nullptr;
 }
@@ -499,6 +510,7 @@ napi_value WebGLRenderingContextBase::Clear(napi_env env, napi_callback_info inf
     }
     LOGI("WebGL WebGLRenderingContextBase::clear mask = %{public}u", mask);
     glClear(static_cast<GLbitfield>(mask));
+    GLStateCache::GetInstance().OnClear();
     LOGI("WebGL clear end");
     return nullptr;
 }
@@ -932,6 +944,7 @@ napi_value WebGLRenderingContextBase::DeleteBuffer(napi_env env, napi_callback_i
     unsigned int buffer = webGlBuffer->GetBuffer();
 
     glDeleteBuffers(1, &buffer);
+    GLStateCache::GetInstance().OnBufferDeleted(buffer);
     LOGI("WebGL deleteBuffer end");
     return nullptr;
 }
@@ -955,6 +968,7 @@ napi_value WebGLRenderingContextBase::DeleteFramebuffer(napi_env env, napi_callb
     }
     unsigned int framebuffer = webGlFramebuffer->GetFramebuffer();
     glDeleteFramebuffers(1, &framebuffer);
+    GLStateCache::GetInstance().OnFramebufferDeleted(framebuffer);
     LOGI("WebGL deleteFramebuffer end");
     return nullptr;
 }
@@ -1003,6 +1017,7 @@ napi_value WebGLRenderingContextBase::DeleteRenderbuffer(napi_env env, napi_call
     unsigned int renderbuffer = webGlRenderbuffer->GetRenderbuffer();
 
     glDeleteRenderbuffers(1, &renderbuffer);
+    GLStateCache::GetInstance().OnRenderbufferDeleted(renderbuffer);
     LOGI("WebGL deleteRenderbuffer end");
     return nullptr;
 }
@@ -1051,6 +1066,7 @@ napi_value WebGLRenderingContextBase::DeleteTexture(napi_env env, napi_callback_
     unsigned int texture = webGlTexture->GetTexture();
 
     glDeleteTextures(1, &texture);
+    GLStateCache::GetInstance().OnTextureDeleted(texture);
     LOGI("WebGL deleteTexture end");
     return nullptr;
 }
@@ -1164,7 +1180,9 @@ napi_value WebGLRenderingContextBase::Disable(napi_env env, napi_callback_info i
         return nullptr;
     }
     LOGI("WebGL WebGLRenderingContextBase::disable cap = %{public}u", cap);
-    glDisable(static_cast<GLenum>(cap));
+    if (GLStateCache::GetInstance().SetCapability(static_cast<GLenum>(cap), false)) {
+        glDisable(static_cast<GLenum>(cap));
+    }
     LOGI("WebGL disable end");
     return nullptr;
 }
@@ -1217,6 +1235,7 @@ napi_value WebGLRenderingContextBase::DrawArrays(napi_env env, napi_callback_inf
     }
     LOGI("WebGL WebGLRenderingContextBase::drawArrays count = %{public}u", count);
     glDrawArrays(static_cast<GLenum>(mode), static_cast<GLint>(first), static_cast<GLsizei>(count));
+    GLStateCache::GetInstance().OnDraw();
     LOGI("WebGL drawArrays end");
     return nullptr;
 }
@@ -1256,6 +1275,7 @@ napi_value WebGLRenderingContextBase::DrawElements(napi_env env, napi_callback_i
     LOGI("WebGL WebGLRenderingContextBase::drawElements offset = %{public}u", offset);
     glDrawElements(static_cast<GLenum>(mode), static_cast<GLsizei>(count), static_cast<GLenum>(type),
         reinterpret_cast<GLvoid *>(static_cast<intptr_t>(offset)));
+    GLStateCache::GetInstance().OnDraw();
     LOGI("WebGL drawElements end");
     return nullptr;
 }
@@ -1275,7 +1295,9 @@ napi_value WebGLRenderingContextBase::Enable(napi_env env, napi_callback_info in
         return nullptr;
     }
     LOGI("WebGL WebGLRenderingContextBase::enable cap = %{public}u", cap);
-    glEnable(static_cast<GLenum>(cap));
+    if (GLStateCache::GetInstance().SetCapability(static_cast<GLenum>(cap), true)) {
+        glEnable(static_cast<GLenum>(cap));
+    }
     LOGI("WebGL enable end");
     return nullptr;
 }
@@ -1683,8 +1705,11 @@ napi_value WebGLRenderingContextBase::Scissor(napi_env env, napi_callback_info i
         return nullptr;
     }
     LOGI("WebGL WebGLRenderContext::scissor height = %{public}u", height);
-    glScissor(static_cast<GLint>(x), static_cast<GLint>(y), static_cast<GLsizei>(width),
-              static_cast<GLsizei>(height));
+    if (GLStateCache::GetInstance().SetScissor(static_cast<GLint>(x), static_cast<GLint>(y),
+        static_cast<GLsizei>(width), static_cast<GLsizei>(height))) {
+        glScissor(static_cast<GLint>(x), static_cast<GLint>(y), static_cast<GLsizei>(width),
+                  static_cast<GLsizei>(height));
+    }
     LOGI("WebGL scissor end");
     return nullptr;
 }
@@ -2239,7 +2264,9 @@ napi_value WebGLRenderingContextBase::UseProgram(napi_env env, napi_callback_inf
         return nullptr;
     }
     int program = webGlProgram->GetProgramId();
-    glUseProgram(static_cast<GLuint>(program));
+    if (GLStateCache::GetInstance().SetProgram(static_cast<GLuint>(program))) {
+        glUseProgram(static_cast<GLuint>(program));
+    }
     LOGI("WebGL useProgram end");
     return nullptr;
 }
@@ -2491,8 +2518,11 @@ napi_value WebGLRenderingContextBase::Viewport(napi_env env, napi_callback_info
         return nullptr;
     }
     LOGI("webgl WebGLRenderContext::viewport height = %{public}u", height);
-    glViewport(static_cast<GLint>(x), static_cast<GLint>(y), static_cast<GLsizei>(width),
-               static_cast<GLsizei>(height));
+    if (GLStateCache::GetInstance().SetViewport(static_cast<GLint>(x), static_cast<GLint>(y),
+        static_cast<GLsizei>(width), static_cast<GLsizei>(height))) {
+        glViewport(static_cast<GLint>(x), static_cast<GLint>(y), static_cast<GLsizei>(width),
+                   static_cast<GLsizei>(height));
+    }
     LOGI("webgl viewport end");
     return nullptr;
 }
@@ -2653,6 +2683,8 @@ napi_value WebGLRenderingContextBase::LinkProgram(napi_env env, napi_callback_in
     unsigned int linkprogram = static_cast<unsigned int>(webGLProgram->GetProgramId());
     LOGI("WebGL WebGLRenderContext::linkProgram linkprogram = %{public}u", linkprogram);
     glLinkProgram(static_cast<GLuint>(linkprogram));
+    // a useProgram call that failed before linking was recorded by the shadow
+    GLStateCache::GetInstance().InvalidateProgram();
     LOGI("WebGL linkProgram end");
     return nullptr;
 }
@@ -20,6 +20,7 @@
 #include "../../common/napi/n_class.h"
 #include "../include/util/log.h"
 #include "../include/util/object_manager.h"
+#include "../include/util/gl_state_cache.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -35,6 +36,7 @@ OHOS::Rosen::WebGLRenderingContextBasicBase *GetWebGLInstance(string id)
 namespace OHOS {
 namespace Rosen {
 WebGLRenderingContextBasicBase *WebGLRenderingContextBasicBase::instance = nullptr;
+WebGLRenderingContextBasicBase *WebGLRenderingContextBasicBase::readbackOwner = nullptr;
 
 WebGLRenderingContextBasicBase *WebGLRenderingContextBasicBase::GetContext(string id)
 {
@@ -64,6 +66,10 @@ void WebGLRenderingContextBasicBase::SetBitMapPtr(char *bitMapPtr, int bitMapWid
     mBitMapPtr = bitMapPtr;
     mBitMapWidth = bitMapWidth;
     mBitMapHeight = bitMapHeight;
+    // the new bitmap holds none of the pixels drawn so far
+    if (readbackOwner == this) {
+        readbackOwner = nullptr;
+    }
     EglManager::GetInstance().SetPbufferAttributes(bitMapWidth, bitMapHeight);
 }
 
@@ -88,9 +94,21 @@ void WebGLRenderingContextBasicBase::Update()
         EGLDisplay eglDisplay = EglManager::GetInstance().GetEGLDisplay();
         eglSwapBuffers(eglDisplay, mEGLSurface);
     } else {
-        LOGI("WebGLRenderingContextBasicBase glReadPixels");
-        glPixelStorei(GL_PACK_ALIGNMENT, 1);
-        glReadPixels(0, 0, mBitMapWidth, mBitMapHeight, GL_RGBA, GL_UNSIGNED_BYTE, mBitMapPtr);
+        // only the region drawn since the last update, all of it when another context read the region last
+        GLRect rect;
+        bool dirty = GLStateCache::GetInstance().TakeDirtyRect(mBitMapWidth, mBitMapHeight, rect);
+        if (readbackOwner != this) {
+            readbackOwner = this;
+            rect = { 0, 0, mBitMapWidth, mBitMapHeight };
+            dirty = true;
+        }
+        // desynchronized contexts take the pixels one frame late instead of waiting for the GPU
+        bool deferred = webGlContextAttributes != nullptr && webGlContextAttributes->desynchronized;
+        LOGI("WebGLRenderingContextBasicBase readback dirty = %{public}d, deferred = %{public}d", dirty, deferred);
+        if (!mReadback.Read(mBitMapPtr, mBitMapWidth, mBitMapHeight, dirty ? &rect : nullptr, deferred)) {
+            // the bitmap did not change
+            return;
+        }
     }
     if (mUpdateCallback) {
         LOGI("WebGLRenderingContextBasicBase mUpdateCallback");
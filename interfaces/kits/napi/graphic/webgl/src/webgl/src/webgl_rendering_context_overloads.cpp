@@ -22,6 +22,7 @@
 #include "../include/webgl/webgl_shader.h"
 #include "../include/webgl/webgl_texture.h"
 #include "../include/util/log.h"
+#include "../include/util/util.h"
 #include "../include/webgl/webgl_uniform_location.h"
 
 #ifdef __cplusplus
@@ -46,43 +47,20 @@ napi_value WebGLRenderingContextOverloads::BufferData(napi_env env, napi_callbac
         return nullptr;
     }
     LOGI("WebGL WebGLRenderContext::bufferData target = %{public}u", target);
-    bool usagesucc = NVal(env, funcArg[NARG_POS::SECOND]).TypeIs(napi_number);
-    LOGI("WebGL WebGLRenderContext::bufferData usagesucc = %{public}u", usagesucc);
-    size_t size;
+    size_t size = 0;
     void *data = nullptr;
-    if (usagesucc) {
+    if (NVal(env, funcArg[NARG_POS::SECOND]).TypeIs(napi_number)) {
         tie(succ, size) = NVal(env, funcArg[NARG_POS::SECOND]).ToInt32();
         if (!succ) {
             return nullptr;
         }
     } else {
-        if (funcArg[NARG_POS::SECOND] == nullptr) {
+        size_t elementSize = 0;
+        if (!Util::GetBufferSource(env, funcArg[NARG_POS::SECOND], data, size, elementSize)) {
             return nullptr;
         }
-        bool isdataview = false;
-        napi_is_dataview(env, funcArg[NARG_POS::SECOND], &isdataview);
-        LOGI("WebGL WebGLRenderContext::bufferData isdataview = %{public}u", isdataview);
-        if (isdataview) {
-            tie(succ, data, size) = NVal(env, funcArg[NARG_POS::SECOND]).ToDataview();
-            if (!succ) {
-                return nullptr;
-            }
-        } else {
-            bool isarraybuffer = false;
-            napi_is_arraybuffer(env, funcArg[NARG_POS::SECOND], &isarraybuffer);
-            LOGI("WebGL WebGLRenderContext::bufferData isarraybuffer = %{public}u", isarraybuffer);
-            if (isarraybuffer) {
-                tie(succ, data, size) = NVal(env, funcArg[NARG_POS::SECOND]).ToArraybuffer();
-                if (!succ) {
-                    return nullptr;
-                }
-            } else {
-                return nullptr;
-            }
-        }
     }
     LOGI("WebGL WebGLRenderContext::bufferData size = %{public}u", size);
-    LOGI("WebGL WebGLRenderContext::bufferData data = %{public}u", data);
     int32_t usage;
     tie(succ, usage) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32();
     if (!succ) {
@@ -105,7 +83,6 @@ napi_value WebGLRenderingContextOverloads::BufferSubData(napi_env env, napi_call
     LOGI("WebGL bufferSubData start");
     int64_t target;
     tie(succ, target) = NVal(env, funcArg[NARG_POS::FIRST]).ToInt64();
-    LOGI("WebGL WebGLRenderContext::bufferSubData succ = %{public}u", succ);
     if (!succ) {
         return nullptr;
     }
@@ -116,31 +93,13 @@ napi_value WebGLRenderingContextOverloads::BufferSubData(napi_env env, napi_call
         return nullptr;
     }
     LOGI("WebGL WebGLRenderContext::bufferSubData offset = %{public}u", offset);
-    size_t size;
+    size_t size = 0;
     void *data = nullptr;
-    bool isdataview = false;
-    napi_is_dataview(env, funcArg[NARG_POS::THIRD], &isdataview);
-    LOGI("WebGL WebGLRenderContext::bufferSubData isdataview = %{public}u", isdataview);
-    if (isdataview) {
-        tie(succ, data, size) = NVal(env, funcArg[NARG_POS::THIRD]).ToDataview();
-        if (!succ) {
-            return nullptr;
-        }
-    } else {
-        bool isarraybuffer = false;
-        napi_is_arraybuffer(env, funcArg[NARG_POS::THIRD], &isarraybuffer);
-        LOGI("WebGL WebGLRenderContext::bufferSubData isarraybuffer = %{public}u", isarraybuffer);
-        if (isarraybuffer) {
-            tie(succ, data, size) = NVal(env, funcArg[NARG_POS::THIRD]).ToArraybuffer();
-            if (!succ) {
-                return nullptr;
-            }
-        } else {
-            return nullptr;
-        }
+    size_t elementSize = 0;
+    if (!Util::GetBufferSource(env, funcArg[NARG_POS::THIRD], data, size, elementSize)) {
+        return nullptr;
     }
     LOGI("WebGL WebGLRenderContext::bufferSubData size = %{public}u", size);
-    LOGI("WebGL WebGLRenderContext::bufferSubData data = %{public}u", data);
     glBufferSubData(static_cast<GLenum>(target), static_cast<GLintptr>(offset),
         static_cast<GLsizeiptr>(size), static_cast<void*>(data));
     LOGI("WebGL bufferSubData end");
@@ -682,79 +641,17 @@ napi_value WebGLRenderingContextOverloads::Uniform1fv(napi_env env, napi_callbac
     if (!funcArg.InitArgs(NARG_CNT::TWO)) {
         return nullptr;
     }
-    if (funcArg[NARG_POS::FIRST] == nullptr) {
-        return nullptr;
-    }
-    bool succ = false;
-    LOGI("WebGL uniform1fv start");
-    WebGLUniformLocation *webGLUniformlocation = nullptr;
-    napi_status uniformlocationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformlocation);
-    if (uniformlocationStatus != napi_ok) {
-        return nullptr;
-    }
-    int location = webGLUniformlocation->GetUniformLocationId();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform1fv location = %{public}u", location);
-
-    napi_value uniformarray = funcArg[NARG_POS::SECOND];
-
-    bool isUniformArray = false;
-    tie(succ, isUniformArray) = NVal(env, uniformarray).IsArray();
-    if (isUniformArray) {
-        float* a = nullptr;
-        LOGI("WebGL uniform1fv is isUniformArray");
-        uint32_t count;
-        napi_status countStatus = napi_get_array_length(env, uniformarray, &count);
-        if (countStatus != napi_ok) {
-            return nullptr;
-        }
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform1fv count = %{public}u", count);
-        float uniformfv[count];
-        uint32_t i;
-        for (i = 0; i < count; i++) {
-            napi_value element;
-            napi_status eleStatus = napi_get_element(env, uniformarray, i, &element);
-            LOGI("WebGL WebGLRenderingContextOverloads::uniform1fv element = %{public}u", element);
-            if (eleStatus != napi_ok) {
-                return nullptr;
-            }
-            double ele;
-            napi_status doubleStatus = napi_get_value_double(env, element, &ele);
-            LOGI("WebGL WebGLRenderingContextOverloads::uniform1fv ele = %{public}f", (float)ele);
-            if (doubleStatus != napi_ok) {
-                return nullptr;
-            }
-            uniformfv[i] = (float)ele;
-        }
-        a = uniformfv;
-        glUniform1fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            reinterpret_cast<GLfloat *>(uniformfv));
-        LOGI("WebGL uniform1fv uniformarray end");
-        return nullptr;
-    }
-    bool isTypedarray = false;
-    tie(succ, isTypedarray) = NVal(env, uniformarray).IsTypeArray();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform1fv isTypedarray = %{public}u", isTypedarray);
-    if (!isTypedarray || !succ) {
-        return nullptr;
-    }
-    void *value = nullptr;
-    size_t count;
-    size_t byteOffset;
-    napi_typedarray_type type;
-    tie(succ, value, count, byteOffset, type)  = NVal(env, funcArg[NARG_POS::SECOND]).ToTypedArrayInfo();
-    if (!succ) {
+    GLint location = 0;
+    const GLfloat *data = nullptr;
+    size_t length = 0;
+    if (!Util::GetUniformLocation(env, funcArg[NARG_POS::FIRST], location) ||
+        !Util::GetUniformFloats(env, funcArg[NARG_POS::SECOND], data, length)) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform1fv value = %{public}u", value);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform1fv count = %{public}u", count);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform1fv type = %{public}u", type);
-    if (type == napi_float32_array) {
-        float *inputFloat32 = (float *)((float *)value - byteOffset);
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform1fv input_float32_array = %{public}u", inputFloat32);
-        glUniform1fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLfloat*>(inputFloat32));
+    GLsizei count = Util::GetUniformCount(length, 1);
+    if (count > 0) {
+        glUniform1fv(location, count, data);
     }
-    LOGI("WebGL uniform1fv end");
     return nullptr;
 }
 
@@ -764,235 +661,57 @@ napi_value WebGLRenderingContextOverloads::Uniform2fv(napi_env env, napi_callbac
     if (!funcArg.InitArgs(NARG_CNT::TWO)) {
         return nullptr;
     }
-    if (funcArg[NARG_POS::FIRST] == nullptr) {
-        return nullptr;
-    }
-    bool succ = false;
-    LOGI("WebGL uniform2fv start");
-    WebGLUniformLocation *webGLUniformLocation = nullptr;
-    napi_status uniformlocationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
-    if (uniformlocationStatus != napi_ok) {
-        return nullptr;
-    }
-    int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform2fv location = %{public}u", location);
-    napi_value uniformarray = funcArg[NARG_POS::SECOND];
-    bool isUniformArray = false;
-    float* a = nullptr;
-    tie(succ, isUniformArray) = NVal(env, uniformarray).IsArray();
-    if (isUniformArray) {
-        LOGI("WebGL uniform2fv is isUniformArray");
-        uint32_t count;
-        napi_status countStatus = napi_get_array_length(env, uniformarray, &count);
-        if (countStatus != napi_ok) {
-            return nullptr;
-        }
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform2fv count = %{public}u", count);
-        float uniformfv[count];
-        uint32_t i;
-        for (i = 0; i < count; i++) {
-            napi_value element;
-            napi_status eleStatus = napi_get_element(env, uniformarray, i, &element);
-            if (eleStatus != napi_ok) {
-                return nullptr;
-            }
-            double ele;
-            napi_status doubleStatus = napi_get_value_double(env, element, &ele);
-            if (doubleStatus != napi_ok) {
-                return nullptr;
-            }
-            LOGI("WebGL WebGLRenderingContextOverloads::uniform2fv ele = %{public}f", (float)ele);
-            uniformfv[i] = (float)ele;
-        }
-        a = uniformfv;
-        glUniform2fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            reinterpret_cast<GLfloat *>(uniformfv));
-        LOGI("WebGL uniform2fv uniformarray end");
-        return nullptr;
-    }
-
-    bool isTypedarray = false;
-    tie(succ, isTypedarray) = NVal(env, uniformarray).IsTypeArray();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform2fv isTypedarray = %{public}u", isTypedarray);
-    if (!isTypedarray || !succ) {
+    GLint location = 0;
+    const GLfloat *data = nullptr;
+    size_t length = 0;
+    if (!Util::GetUniformLocation(env, funcArg[NARG_POS::FIRST], location) ||
+        !Util::GetUniformFloats(env, funcArg[NARG_POS::SECOND], data, length)) {
         return nullptr;
     }
-    void *value = nullptr;
-    size_t count;
-    size_t byteOffset;
-    napi_typedarray_type type;
-    tie(succ, value, count, byteOffset, type)  = NVal(env, funcArg[NARG_POS::SECOND]).ToTypedArrayInfo();
-    if (!succ) {
-        return nullptr;
+    GLsizei count = Util::GetUniformCount(length, 2);
+    if (count > 0) {
+        glUniform2fv(location, count, data);
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform2fv value = %{public}u", value);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform2fv count = %{public}u", count);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform2fv type = %{public}u", type);
-    if (type == napi_float32_array) {
-        float *inputFloat32 = (float *)((float *)value - byteOffset);
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform2fv input_float32_array = %{public}u", inputFloat32);
-        glUniform2fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLfloat*>(inputFloat32));
-    }
-    LOGI("WebGL uniform2fv end");
     return nullptr;
 }
 
 napi_value WebGLRenderingContextOverloads::Uniform3fv(napi_env env, napi_callback_info info)
 {
     NFuncArg funcArg(env, info);
-
     if (!funcArg.InitArgs(NARG_CNT::TWO)) {
         return nullptr;
     }
-    if (funcArg[NARG_POS::FIRST] == nullptr) {
+    GLint location = 0;
+    const GLfloat *data = nullptr;
+    size_t length = 0;
+    if (!Util::GetUniformLocation(env, funcArg[NARG_POS::FIRST], location) ||
+        !Util::GetUniformFloats(env, funcArg[NARG_POS::SECOND], data, length)) {
         return nullptr;
     }
-    bool succ = false;
-    LOGI("WebGL uniform3fv start");
-    WebGLUniformLocation *webGLUniformLocation = nullptr;
-    napi_status uniformlocationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
-    if (uniformlocationStatus != napi_ok) {
-        return nullptr;
-    }
-    int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform3fv location = %{public}u", location);
-    napi_value uniformarray = funcArg[NARG_POS::SECOND];
-    bool isUniformArray = false;
-    tie(succ, isUniformArray) = NVal(env, uniformarray).IsArray();
-    if (isUniformArray) {
-        LOGI("WebGL uniform3fv is isUniformArray");
-        float* a = nullptr;
-        uint32_t count;
-        napi_status countStatus = napi_get_array_length(env, uniformarray, &count);
-        if (countStatus != napi_ok) {
-            return nullptr;
-        }
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform3fv count = %{public}u", count);
-        float uniformfv[count];
-        uint32_t i;
-        for (i = 0; i < count; i++) {
-            napi_value element;
-            napi_status eleStatus = napi_get_element(env, uniformarray, i, &element);
-            if (eleStatus != napi_ok) {
-                return nullptr;
-            }
-            double ele;
-            napi_status doubleStatus = napi_get_value_double(env, element, &ele);
-            if (doubleStatus != napi_ok) {
-                return nullptr;
-            }
-            LOGI("WebGL WebGLRenderingContextOverloads::uniform3fv ele = %{public}f", (float)ele);
-            uniformfv[i] = (float)ele;
-        }
-        a = uniformfv;
-        glUniform3fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            reinterpret_cast<GLfloat *>(uniformfv));
-        LOGI("WebGL uniform3fv uniformarray end");
-        return nullptr;
-    }
-    bool isTypedarray = false;
-    tie(succ, isTypedarray) = NVal(env, uniformarray).IsTypeArray();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform3fv isTypedarray = %{public}u", isTypedarray);
-    if (!isTypedarray || !succ) {
-        return nullptr;
-    }
-    void *value = nullptr;
-    size_t count;
-    size_t byteOffset;
-    napi_typedarray_type type;
-    tie(succ, value, count, byteOffset, type)  = NVal(env, funcArg[NARG_POS::SECOND]).ToTypedArrayInfo();
-    if (!succ) {
-        return nullptr;
+    GLsizei count = Util::GetUniformCount(length, 3);
+    if (count > 0) {
+        glUniform3fv(location, count, data);
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform3fv value = %{public}u", value);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform3fv count = %{public}u", count);
-    if (type == napi_float32_array) {
-        float *inputFloat32 = (float *)((float *)value - byteOffset);
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform3fv input_float32_array = %{public}u", inputFloat32);
-        glUniform3fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLfloat*>(inputFloat32));
-    }
-    LOGI("WebGL uniform3fv end");
     return nullptr;
 }
 
 napi_value WebGLRenderingContextOverloads::Uniform4fv(napi_env env, napi_callback_info info)
 {
     NFuncArg funcArg(env, info);
-
     if (!funcArg.InitArgs(NARG_CNT::TWO)) {
-            return nullptr;
-    }
-    if (funcArg[NARG_POS::FIRST] == nullptr) {
         return nullptr;
     }
-    bool succ = false;
-    LOGI("WebGL uniform4fv start");
-    WebGLUniformLocation *webGLUniformLocation = nullptr;
-    napi_status uniformlocationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
-    if (uniformlocationStatus != napi_ok) {
-        return nullptr;
-    }
-    int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform4fv location = %{public}u", location);
-    napi_value uniformarray = funcArg[NARG_POS::SECOND];
-    bool isUniformArray = false;
-    tie(succ, isUniformArray) = NVal(env, uniformarray).IsArray();
-    if (isUniformArray) {
-        LOGI("WebGL uniform4fv is isUniformArray");
-        uint32_t count;
-        napi_status countStatus = napi_get_array_length(env, uniformarray, &count);
-        if (countStatus != napi_ok) {
-            return nullptr;
-        }
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform4fv count = %{public}u", count);
-        float* a = nullptr;
-        float uniformfv[count];
-        uint32_t i;
-        for (i = 0; i < count; i++) {
-            napi_value element;
-            napi_status eleStatus = napi_get_element(env, uniformarray, i, &element);
-            if (eleStatus != napi_ok) {
-                return nullptr;
-            }
-            double ele;
-            napi_status doubleStatus = napi_get_value_double(env, element, &ele);
-            if (doubleStatus != napi_ok) {
-                return nullptr;
-            }
-            LOGI("WebGL WebGLRenderingContextOverloads::uniform4fv ele = %{public}f", (float)ele);
-            uniformfv[i] = (float)ele;
-        }
-        a = uniformfv;
-        glUniform4fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            reinterpret_cast<GLfloat *>(uniformfv));
-        LOGI("WebGL uniform4fv uniformarray end");
+    GLint location = 0;
+    const GLfloat *data = nullptr;
+    size_t length = 0;
+    if (!Util::GetUniformLocation(env, funcArg[NARG_POS::FIRST], location) ||
+        !Util::GetUniformFloats(env, funcArg[NARG_POS::SECOND], data, length)) {
         return nullptr;
     }
-    bool isTypedarray = false;
-    tie(succ, isTypedarray) = NVal(env, uniformarray).IsTypeArray();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform4fv isTypedarray = %{public}u", isTypedarray);
-    if (!isTypedarray || !succ) {
-        return nullptr;
+    GLsizei count = Util::GetUniformCount(length, 4);
+    if (count > 0) {
+        glUniform4fv(location, count, data);
     }
-    void *value = nullptr;
-    size_t count;
-    size_t byteOffset;
-    napi_typedarray_type type;
-    tie(succ, value, count, byteOffset, type)  = NVal(env, funcArg[NARG_POS::SECOND]).ToTypedArrayInfo();
-    if (!succ) {
-        return nullptr;
-    }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform4fv value = %{public}u", value);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform4fv count = %{public}u", count);
-    if (type == napi_float32_array) {
-        float *inputFloat32 = (float *)((float *)value - byteOffset);
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform4fv input_float32_array = %{public}u", inputFloat32);
-        glUniform4fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLfloat*>(inputFloat32));
-    }
-    LOGI("WebGL uniform4fv end");
     return nullptr;
 }
 
@@ -1002,75 +721,17 @@ napi_value WebGLRenderingContextOverloads::Uniform1iv(napi_env env, napi_callbac
     if (!funcArg.InitArgs(NARG_CNT::TWO)) {
         return nullptr;
     }
-    if (funcArg[NARG_POS::FIRST] == nullptr) {
+    GLint location = 0;
+    const GLint *data = nullptr;
+    size_t length = 0;
+    if (!Util::GetUniformLocation(env, funcArg[NARG_POS::FIRST], location) ||
+        !Util::GetUniformInts(env, funcArg[NARG_POS::SECOND], data, length)) {
         return nullptr;
     }
-    bool succ = false;
-    LOGI("WebGL uniform1iv start");
-    WebGLUniformLocation *webGLUniformLocation = nullptr;
-    napi_status uniformlocationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
-    if (uniformlocationStatus != napi_ok) {
-        return nullptr;
-    }
-    int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform1iv location = %{public}u", location);
-    napi_value uniformarray = funcArg[NARG_POS::SECOND];
-    bool isUniformArray = false;
-    tie(succ, isUniformArray) = NVal(env, uniformarray).IsArray();
-    if (isUniformArray) {
-        int* a = nullptr;
-        LOGI("WebGL uniform1iv is isUniformArray");
-        uint32_t count;
-        napi_status countStatus = napi_get_array_length(env, uniformarray, &count);
-        if (countStatus != napi_ok) {
-            return nullptr;
-        }
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform1iv count = %{public}u", count);
-        int uniformfv[count];
-        uint32_t i;
-        for (i = 0; i < count; i++) {
-            napi_value element;
-            napi_status eleStatus = napi_get_element(env, uniformarray, i, &element);
-            if (eleStatus != napi_ok) {
-                return nullptr;
-            }
-            int64_t ele;
-            napi_status doubleStatus = napi_get_value_int64(env, element, &ele);
-            if (doubleStatus != napi_ok) {
-                return nullptr;
-            }
-            LOGI("WebGL WebGLRenderingContextOverloads::uniform1iv ele = %{public}f", (float)ele);
-            uniformfv[i] = (int)ele;
-        }
-        a = uniformfv;
-        glUniform1iv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            reinterpret_cast<GLint *>(a));
-        LOGI("WebGL uniform1iv uniformarray end");
-        return nullptr;
+    GLsizei count = Util::GetUniformCount(length, 1);
+    if (count > 0) {
+        glUniform1iv(location, count, data);
     }
-    bool isTypedarray = false;
-    tie(succ, isTypedarray) = NVal(env, uniformarray).IsTypeArray();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform1iv isTypedarray = %{public}u", isTypedarray);
-    if (!isTypedarray || !succ) {
-        return nullptr;
-    }
-    void *value = nullptr;
-    size_t count;
-    size_t byteOffset;
-    napi_typedarray_type type;
-    tie(succ, value, count, byteOffset, type)  = NVal(env, funcArg[NARG_POS::SECOND]).ToTypedArrayInfo();
-    if (!succ) {
-        return nullptr;
-    }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform1iv value = %{public}u", value);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform1iv count = %{public}u", count);
-    if (type == napi_int32_array) {
-        int *intInt32 = (int *)((int *)value - byteOffset);
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform1iv int_int32_array = %{public}u", intInt32);
-        glUniform1iv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLint*>(intInt32));
-    }
-    LOGI("WebGL uniform1iv end");
     return nullptr;
 }
 
@@ -1080,75 +741,17 @@ napi_value WebGLRenderingContextOverloads::Uniform2iv(napi_env env, napi_callbac
     if (!funcArg.InitArgs(NARG_CNT::TWO)) {
         return nullptr;
     }
-    if (funcArg[NARG_POS::FIRST] == nullptr) {
+    GLint location = 0;
+    const GLint *data = nullptr;
+    size_t length = 0;
+    if (!Util::GetUniformLocation(env, funcArg[NARG_POS::FIRST], location) ||
+        !Util::GetUniformInts(env, funcArg[NARG_POS::SECOND], data, length)) {
         return nullptr;
     }
-    bool succ = false;
-    LOGI("WebGL uniform2iv start");
-    WebGLUniformLocation *webGLUniformLocation = nullptr;
-    napi_status uniformlocationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
-    if (uniformlocationStatus != napi_ok) {
-        return nullptr;
-    }
-    int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform2iv location = %{public}u", location);
-    napi_value uniformarray = funcArg[NARG_POS::SECOND];
-    bool isUniformArray = false;
-    tie(succ, isUniformArray) = NVal(env, uniformarray).IsArray();
-    if (isUniformArray) {
-        LOGI("WebGL uniform2iv is isUniformArray");
-        int* a = nullptr;
-        uint32_t count;
-        napi_status countStatus = napi_get_array_length(env, uniformarray, &count);
-        if (countStatus != napi_ok) {
-            return nullptr;
-        }
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform2iv count = %{public}u", count);
-        int uniformfv[count];
-        uint32_t i;
-        for (i = 0; i < count; i++) {
-            napi_value element;
-            napi_status eleStatus = napi_get_element(env, uniformarray, i, &element);
-            if (eleStatus != napi_ok) {
-                return nullptr;
-            }
-            int64_t ele;
-            napi_status doubleStatus = napi_get_value_int64(env, element, &ele);
-            if (doubleStatus != napi_ok) {
-                return nullptr;
-            }
-            LOGI("WebGL WebGLRenderingContextOverloads::uniform2iv ele = %{public}d", ele);
-            uniformfv[i] = (int)ele;
-        }
-        a = uniformfv;
-        glUniform2iv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            reinterpret_cast<GLint *>(a));
-        LOGI("WebGL uniform2iv uniformarray end");
-        return nullptr;
-    }
-    bool isTypedarray = false;
-    tie(succ, isTypedarray) = NVal(env, uniformarray).IsTypeArray();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform2iv isTypedarray = %{public}u", isTypedarray);
-    if (!isTypedarray || !succ) {
-        return nullptr;
-    }
-    void *value = nullptr;
-    size_t count;
-    size_t byteOffset;
-    napi_typedarray_type type;
-    tie(succ, value, count, byteOffset, type)  = NVal(env, funcArg[NARG_POS::SECOND]).ToTypedArrayInfo();
-    if (!succ) {
-        return nullptr;
+    GLsizei count = Util::GetUniformCount(length, 2);
+    if (count > 0) {
+        glUniform2iv(location, count, data);
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform2iv value = %{public}u", value);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform2iv count = %{public}u", count);
-    if (type == napi_int32_array) {
-        int *intInt32 = (int *)((int *)value - byteOffset);
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform2iv int_int32_array = %{public}u", intInt32);
-        glUniform2iv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLint*>(intInt32));
-    }
-    LOGI("WebGL uniform2iv end");
     return nullptr;
 }
 
@@ -1158,75 +761,17 @@ napi_value WebGLRenderingContextOverloads::Uniform3iv(napi_env env, napi_callbac
     if (!funcArg.InitArgs(NARG_CNT::TWO)) {
         return nullptr;
     }
-    if (funcArg[NARG_POS::FIRST] == nullptr) {
-        return nullptr;
-    }
-    bool succ = false;
-    LOGI("WebGL uniform3iv start");
-    WebGLUniformLocation *webGLUniformLocation = nullptr;
-    napi_status uniformlocationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
-    if (uniformlocationStatus != napi_ok) {
-        return nullptr;
-    }
-    int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform3iv location = %{public}u", location);
-    napi_value uniformarray = funcArg[NARG_POS::SECOND];
-    bool isUniformArray = false;
-    tie(succ, isUniformArray) = NVal(env, uniformarray).IsArray();
-    if (isUniformArray) {
-        int* a = nullptr;
-        LOGI("WebGL uniform3iv is isUniformArray");
-        uint32_t count;
-        napi_status countStatus = napi_get_array_length(env, uniformarray, &count);
-        if (countStatus != napi_ok) {
-            return nullptr;
-        }
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform3iv count = %{public}u", count);
-        int uniformfv[count];
-        uint32_t i;
-        for (i = 0; i < count; i++) {
-            napi_value element;
-            napi_status eleStatus = napi_get_element(env, uniformarray, i, &element);
-            if (eleStatus != napi_ok) {
-                return nullptr;
-            }
-            int64_t ele;
-            napi_status doubleStatus = napi_get_value_int64(env, element, &ele);
-            if (doubleStatus != napi_ok) {
-                return nullptr;
-            }
-            LOGI("WebGL WebGLRenderingContextOverloads::uniform3iv ele = %{public}f", (float)ele);
-            uniformfv[i] = (int)ele;
-        }
-        a = uniformfv;
-        glUniform3iv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            reinterpret_cast<GLint *>(a));
-        LOGI("WebGL uniform3iv uniformarray end");
+    GLint location = 0;
+    const GLint *data = nullptr;
+    size_t length = 0;
+    if (!Util::GetUniformLocation(env, funcArg[NARG_POS::FIRST], location) ||
+        !Util::GetUniformInts(env, funcArg[NARG_POS::SECOND], data, length)) {
         return nullptr;
     }
-    bool isTypedarray = false;
-    tie(succ, isTypedarray) = NVal(env, uniformarray).IsTypeArray();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform3iv isTypedarray = %{public}u", isTypedarray);
-    if (!isTypedarray || !succ) {
-        return nullptr;
-    }
-    void *value = nullptr;
-    size_t count;
-    size_t byteOffset;
-    napi_typedarray_type type;
-    tie(succ, value, count, byteOffset, type)  = NVal(env, funcArg[NARG_POS::SECOND]).ToTypedArrayInfo();
-    if (!succ) {
-        return nullptr;
+    GLsizei count = Util::GetUniformCount(length, 3);
+    if (count > 0) {
+        glUniform3iv(location, count, data);
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform3iv value = %{public}u", value);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform3iv count = %{public}u", count);
-    if (type == napi_int32_array) {
-        int *intInt32 = (int *)((int *)value - byteOffset);
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform3iv int_int32_array = %{public}u", intInt32);
-        glUniform3iv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLint*>(intInt32));
-    }
-    LOGI("WebGL uniform3iv end");
     return nullptr;
 }
 
@@ -1236,75 +781,17 @@ napi_value WebGLRenderingContextOverloads::Uniform4iv(napi_env env, napi_callbac
     if (!funcArg.InitArgs(NARG_CNT::TWO)) {
         return nullptr;
     }
-    if (funcArg[NARG_POS::FIRST] == nullptr) {
-        return nullptr;
-    }
-    bool succ = false;
-    LOGI("WebGL uniform4iv start");
-    WebGLUniformLocation *webGLUniformLocation = nullptr;
-    napi_status uniformlocationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
-    if (uniformlocationStatus != napi_ok) {
-        return nullptr;
-    }
-    int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform4iv location = %{public}u", location);
-    napi_value uniformarray = funcArg[NARG_POS::SECOND];
-    bool isUniformArray = false;
-    tie(succ, isUniformArray) = NVal(env, uniformarray).IsArray();
-    if (isUniformArray) {
-        int* a = nullptr;
-        LOGI("WebGL uniform4iv is isUniformArray");
-        uint32_t count;
-        napi_status countStatus = napi_get_array_length(env, uniformarray, &count);
-        if (countStatus != napi_ok) {
-            return nullptr;
-        }
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform4iv count = %{public}u", count);
-        int uniformfv[count];
-        uint32_t i;
-        for (i = 0; i < count; i++) {
-            napi_value element;
-            napi_status eleStatus = napi_get_element(env, uniformarray, i, &element);
-            if (eleStatus != napi_ok) {
-                return nullptr;
-            }
-            int64_t ele;
-            napi_status doubleStatus = napi_get_value_int64(env, element, &ele);
-            if (doubleStatus != napi_ok) {
-                return nullptr;
-            }
-            LOGI("WebGL WebGLRenderingContextOverloads::uniform4iv ele = %{public}f", (float)ele);
-            uniformfv[i] = (int)ele;
-        }
-        a = uniformfv;
-        glUniform4iv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            reinterpret_cast<GLint *>(a));
-        LOGI("WebGL uniform4iv uniformarray end");
+    GLint location = 0;
+    const GLint *data = nullptr;
+    size_t length = 0;
+    if (!Util::GetUniformLocation(env, funcArg[NARG_POS::FIRST], location) ||
+        !Util::GetUniformInts(env, funcArg[NARG_POS::SECOND], data, length)) {
         return nullptr;
     }
-    bool isTypedarray = false;
-    tie(succ, isTypedarray) = NVal(env, uniformarray).IsTypeArray();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform4iv isTypedarray = %{public}u", isTypedarray);
-    if (!isTypedarray || !succ) {
-        return nullptr;
+    GLsizei count = Util::GetUniformCount(length, 4);
+    if (count > 0) {
+        glUniform4iv(location, count, data);
     }
-    void *value = nullptr;
-    size_t count;
-    size_t byteOffset;
-    napi_typedarray_type type;
-    tie(succ, value, count, byteOffset, type)  = NVal(env, funcArg[NARG_POS::SECOND]).ToTypedArrayInfo();
-    if (!succ) {
-        return nullptr;
-    }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform4iv value = %{public}u", value);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniform4iv count = %{public}u", count);
-    if (type == napi_int32_array) {
-        int *intInt32 = (int *)((int *)value - byteOffset);
-        LOGI("WebGL WebGLRenderingContextOverloads::uniform4iv int_int32_array = %{public}u", intInt32);
-        glUniform4iv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLint*>(intInt32));
-    }
-    LOGI("WebGL uniform4iv end");
     return nullptr;
 }
 
@@ -1312,163 +799,55 @@ napi_value WebGLRenderingContextOverloads::UniformMatrix2fv(napi_env env, napi_c
 {
     NFuncArg funcArg(env, info);
     if (!funcArg.InitArgs(NARG_CNT::THREE)) {
-    return nullptr;
-    }
-    if (funcArg[NARG_POS::FIRST] == nullptr) {
         return nullptr;
     }
-    bool succ = false;
-    LOGI("WebGL uniformMatrix2fv start");
-    WebGLUniformLocation *webGLUniformLocation = nullptr;
-    napi_status uniformlocationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
-    if (uniformlocationStatus != napi_ok) {
+    GLint location = 0;
+    if (!Util::GetUniformLocation(env, funcArg[NARG_POS::FIRST], location)) {
         return nullptr;
     }
-    int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix2fv location = %{public}d", location);
+    bool succ = false;
     bool transpose = false;
     tie(succ, transpose) = NVal(env, funcArg[NARG_POS::SECOND]).ToBool();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix2fv succ = %{public}u", succ);
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix2fv transpose = %{public}u", transpose);
-    napi_value uniformarray = funcArg[NARG_POS::THIRD];
-    bool isUniformArray = false;
-    tie(succ, isUniformArray) = NVal(env, uniformarray).IsArray();
-    if (isUniformArray) {
-        float* a = nullptr;
-        LOGI("WebGL uniformMatrix2fv is isUniformArray");
-        uint32_t count;
-        napi_status countStatus = napi_get_array_length(env, uniformarray, &count);
-        if (countStatus != napi_ok) {
-            return nullptr;
-        }
-        LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix2fv count = %{public}u", count);
-        float uniformfv[count];
-        uint32_t i;
-        for (i = 0; i < count; i++) {
-            napi_value element;
-            napi_status eleStatus = napi_get_element(env, uniformarray, i, &element);
-            if (eleStatus != napi_ok) {
-                return nullptr;
-            }
-            double ele;
-            napi_status doubleStatus = napi_get_value_double(env, element, &ele);
-            if (doubleStatus != napi_ok) {
-                return nullptr;
-            }
-            LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix2fv ele = %{public}f", (float)ele);
-            uniformfv[i] = (float)ele;
-        }
-        a = uniformfv;
-        glUniformMatrix2fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLboolean>(transpose), static_cast<GLfloat*>(a));
-        LOGI("WebGL uniformMatrix2fv uniformarray end");
-        return nullptr;
-    }
-    bool isTypedarray = false;
-    tie(succ, isTypedarray) = NVal(env, uniformarray).IsTypeArray();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix2fv isTypedarray = %{public}u", isTypedarray);
-    if (!isTypedarray || !succ) {
+    const GLfloat *data = nullptr;
+    size_t length = 0;
+    if (!Util::GetUniformFloats(env, funcArg[NARG_POS::THIRD], data, length)) {
         return nullptr;
     }
-    void *value = nullptr;
-    size_t count;
-    size_t byteOffset;
-    napi_typedarray_type type;
-    tie(succ, value, count, byteOffset, type)  = NVal(env, funcArg[NARG_POS::THIRD]).ToTypedArrayInfo();
-    if (!succ) {
-        return nullptr;
+    GLsizei count = Util::GetUniformCount(length, 4);
+    if (count > 0) {
+        glUniformMatrix2fv(location, count, static_cast<GLboolean>(transpose), data);
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix2fv value = %{public}u", value);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix2fv count = %{public}u", count);
-    if (type == napi_float32_array) {
-        float *inputFloat32 = (float *)((float *)value - byteOffset);
-        LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix2fv aint32 = %{public}u", inputFloat32);
-        glUniformMatrix2fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLboolean>(transpose), static_cast<GLfloat*>(inputFloat32));
-    }
-    LOGI("WebGL uniformMatrix2fv end");
     return nullptr;
 }
 
 napi_value WebGLRenderingContextOverloads::UniformMatrix3fv(napi_env env, napi_callback_info info)
 {
     NFuncArg funcArg(env, info);
-
     if (!funcArg.InitArgs(NARG_CNT::THREE)) {
         return nullptr;
     }
-    if (funcArg[NARG_POS::FIRST] == nullptr) {
+    GLint location = 0;
+    if (!Util::GetUniformLocation(env, funcArg[NARG_POS::FIRST], location)) {
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL uniformMatrix3fv start");
-    WebGLUniformLocation *webGLUniformLocation = nullptr;
-    napi_status uniformlocationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
-    if (uniformlocationStatus != napi_ok) {
-        return nullptr;
-    }
-    int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix3fv location = %{public}d", location);
     bool transpose = false;
     tie(succ, transpose) = NVal(env, funcArg[NARG_POS::SECOND]).ToBool();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix3fv transpose = %{public}u", transpose);
-    napi_value uniformarray = funcArg[NARG_POS::THIRD];
-    bool isUniformArray = false;
-    tie(succ, isUniformArray) = NVal(env, uniformarray).IsArray();
-    if (isUniformArray) {
-        float* a = nullptr;
-        LOGI("WebGL uniformMatrix3fv is isUniformArray");
-        uint32_t count;
-        napi_status countStatus = napi_get_array_length(env, uniformarray, &count);
-        if (countStatus != napi_ok) {
-            return nullptr;
-        }
-        LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix3fv count = %{public}u", count);
-        float uniformfv[count];
-        uint32_t i;
-        for (i = 0; i < count; i++) {
-            napi_value element;
-            napi_status eleStatus = napi_get_element(env, uniformarray, i, &element);
-            if (eleStatus != napi_ok) {
-                return nullptr;
-            }
-            double ele;
-            napi_status doubleStatus = napi_get_value_double(env, element, &ele);
-            if (doubleStatus != napi_ok) {
-                return nullptr;
-            }
-            LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix3fv ele = %{public}f", (float)ele);
-            uniformfv[i] = (float)ele;
-        }
-        a = uniformfv;
-        glUniformMatrix3fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLboolean>(transpose),  static_cast<GLfloat*>(a));
-        LOGI("WebGL uniformMatrix3fv uniformarray end");
-        return nullptr;
-    }
-    void *value = nullptr;
-    size_t count;
-    size_t byteOffset;
-    napi_typedarray_type type;
-    tie(succ, value, count, byteOffset, type)  = NVal(env, funcArg[NARG_POS::THIRD]).ToTypedArrayInfo();
-    if (!succ) {
+    const GLfloat *data = nullptr;
+    size_t length = 0;
+    if (!Util::GetUniformFloats(env, funcArg[NARG_POS::THIRD], data, length)) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix3fv value = %{public}u", value);
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix3fv count = %{public}u", count);
-    if (type == napi_float32_array) {
-        float *inputFloat32 = (float *)((float *)value - byteOffset);
-        LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix3fv aint32 = %{public}u", inputFloat32);
-        glUniformMatrix3fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLboolean>(transpose), static_cast<GLfloat*>(inputFloat32));
+    GLsizei count = Util::GetUniformCount(length, 9);
+    if (count > 0) {
+        glUniformMatrix3fv(location, count, static_cast<GLboolean>(transpose), data);
     }
-    LOGI("WebGL uniformMatrix3fv end");
     return nullptr;
 }
 
@@ -1478,75 +857,25 @@ napi_value WebGLRenderingContextOverloads::UniformMatrix4fv(napi_env env, napi_c
     if (!funcArg.InitArgs(NARG_CNT::THREE)) {
         return nullptr;
     }
-    if (funcArg[NARG_POS::FIRST] == nullptr) {
+    GLint location = 0;
+    if (!Util::GetUniformLocation(env, funcArg[NARG_POS::FIRST], location)) {
         return nullptr;
     }
     bool succ = false;
-    LOGI("WebGL uniformMatrix4fv start");
-    WebGLUniformLocation *webGLUniformLocation = nullptr;
-    napi_status uniformlocationStatus = napi_unwrap(env, funcArg[NARG_POS::FIRST], (void **)&webGLUniformLocation);
-    if (uniformlocationStatus != napi_ok) {
-        return nullptr;
-    }
-    int location = webGLUniformLocation->GetUniformLocationId();
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix4fv location = %{public}u", location);
     bool transpose = false;
     tie(succ, transpose) = NVal(env, funcArg[NARG_POS::SECOND]).ToBool();
     if (!succ) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix4fv transpose = %{public}u", transpose);
-    napi_value uniformarray = funcArg[NARG_POS::THIRD];
-    bool isUniformArray = false;
-    tie(succ, isUniformArray) = NVal(env, uniformarray).IsArray();
-    if (isUniformArray) {
-        float* a = nullptr;
-        LOGI("WebGL glUniformMatrix4fv is isUniformArray");
-        uint32_t count;
-        napi_status countStatus = napi_get_array_length(env, uniformarray, &count);
-        if (countStatus != napi_ok) {
-            return nullptr;
-        }
-        LOGI("WebGL WebGLRenderingContextOverloads::glUniformMatrix4fv count = %{public}u", count);
-        float uniformfv[count];
-        uint32_t i;
-        for (i = 0; i < count; i++) {
-            napi_value element;
-            napi_status eleStatus = napi_get_element(env, uniformarray, i, &element);
-            if (eleStatus != napi_ok) {
-                return nullptr;
-            }
-            double ele;
-            napi_status doubleStatus = napi_get_value_double(env, element, &ele);
-            if (doubleStatus != napi_ok) {
-                return nullptr;
-            }
-            LOGI("WebGL WebGLRenderingContextOverloads::glUniformMatrix4fv ele = %{public}f", (float)ele);
-            uniformfv[i] = (float)ele;
-        }
-        a = uniformfv;
-        glUniformMatrix4fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLboolean>(transpose), static_cast<GLfloat*>(a));
-        LOGI("WebGL glUniformMatrix4fv uniformarray end");
-        return nullptr;
-    }
-    void *value = nullptr;
-    size_t count;
-    size_t byteOffset;
-    napi_typedarray_type type;
-    tie(succ, value, count, byteOffset, type)  = NVal(env, funcArg[NARG_POS::THIRD]).ToTypedArrayInfo();
-    if (!succ) {
+    const GLfloat *data = nullptr;
+    size_t length = 0;
+    if (!Util::GetUniformFloats(env, funcArg[NARG_POS::THIRD], data, length)) {
         return nullptr;
     }
-    LOGI("WebGL WebGLRenderingContextOverloads::glUniformMatrix4fv value = %{public}u", value);
-    LOGI("WebGL WebGLRenderingContextOverloads::glUniformMatrix4fv count = %{public}u", count);
-    if (type == napi_float32_array) {
-        float *inputFloat32 = (float *)((float *)value - byteOffset);
-        LOGI("WebGL WebGLRenderingContextOverloads::uniformMatrix4fv aint32 = %{public}u", inputFloat32);
-        glUniformMatrix4fv(static_cast<GLint>(location), static_cast<GLsizei>(count),
-            static_cast<GLboolean>(transpose), static_cast<GLfloat*>(inputFloat32));
+    GLsizei count = Util::GetUniformCount(length, 16);
+    if (count > 0) {
+        glUniformMatrix4fv(location, count, static_cast<GLboolean>(transpose), data);
     }
-    LOGI("WebGL uniformMatrix4fv end");
     return nullptr;
 }
 } // namespace Rosen
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Uniform and buffer upload calls per second of a WebGL context, for typed arrays, typed arrays with a byte offset
+// and plain arrays. Call runUniformUploadBenchmark(gl) from a page that owns a WebGL or WebGL2 context.
+
+const VERTEX_SHADER = `
+    attribute vec4 position;
+    uniform mat4 matrices[4];
+    uniform vec4 color;
+    varying vec4 vColor;
+    void main() {
+        gl_Position = matrices[0] * matrices[1] * matrices[2] * matrices[3] * position;
+        vColor = color;
+    }`;
+
+const FRAGMENT_SHADER = `
+    precision mediump float;
+    varying vec4 vColor;
+    void main() {
+        gl_FragColor = vColor;
+    }`;
+
+const DEFAULT_DURATION_MS = 1000;
+const MATRIX_COUNT = 4;
+const MATRIX_SIZE = 16;
+const BUFFER_FLOATS = 1024;
+
+function compileShader(gl, type, source) {
+    const shader = gl.createShader(type);
+    gl.shaderSource(shader, source);
+    gl.compileShader(shader);
+    return shader;
+}
+
+function createProgram(gl) {
+    const program = gl.createProgram();
+    gl.attachShader(program, compileShader(gl, gl.VERTEX_SHADER, VERTEX_SHADER));
+    gl.attachShader(program, compileShader(gl, gl.FRAGMENT_SHADER, FRAGMENT_SHADER));
+    gl.linkProgram(program);
+    gl.useProgram(program);
+    return program;
+}
+
+// calls [upload] for [durationMs] and returns the calls per second
+function measure(durationMs, upload) {
+    let calls = 0;
+    const start = Date.now();
+    let elapsed = 0;
+    while (elapsed < durationMs) {
+        // check the clock every 100 calls only
+        for (let i = 0; i < 100; i++) {
+            upload(calls++);
+        }
+        elapsed = Date.now() - start;
+    }
+    return Math.round(calls * 1000 / elapsed);
+}
+
+export function runUniformUploadBenchmark(gl, durationMs = DEFAULT_DURATION_MS) {
+    const program = createProgram(gl);
+    const matrices = gl.getUniformLocation(program, 'matrices');
+    const color = gl.getUniformLocation(program, 'color');
+
+    const matrixArray = new Float32Array(MATRIX_COUNT * MATRIX_SIZE);
+    for (let i = 0; i < MATRIX_COUNT; i++) {
+        matrixArray[i * MATRIX_SIZE] = 1;
+        matrixArray[i * MATRIX_SIZE + 5] = 1;
+        matrixArray[i * MATRIX_SIZE + 10] = 1;
+        matrixArray[i * MATRIX_SIZE + 15] = 1;
+    }
+    const matrixList = Array.from(matrixArray);
+    // a view that starts after the first matrix of a larger buffer
+    const matrixBuffer = new Float32Array(MATRIX_SIZE + matrixArray.length);
+    matrixBuffer.set(matrixArray, MATRIX_SIZE);
+    const matrixView = matrixBuffer.subarray(MATRIX_SIZE);
+    const colorArray = new Float32Array([1, 0, 0, 1]);
+
+    const buffer = gl.createBuffer();
+    gl.bindBuffer(gl.ARRAY_BUFFER, buffer);
+    const bufferData = new Float32Array(BUFFER_FLOATS);
+    gl.bufferData(gl.ARRAY_BUFFER, bufferData, gl.DYNAMIC_DRAW);
+
+    const results = {
+        uniformMatrix4fvFloat32Array: measure(durationMs, () => gl.uniformMatrix4fv(matrices, false, matrixArray)),
+        uniformMatrix4fvSubarray: measure(durationMs, () => gl.uniformMatrix4fv(matrices, false, matrixView)),
+        uniformMatrix4fvArray: measure(durationMs, () => gl.uniformMatrix4fv(matrices, false, matrixList)),
+        uniform4fvFloat32Array: measure(durationMs, () => gl.uniform4fv(color, colorArray)),
+        uniform4fvArray: measure(durationMs, () => gl.uniform4fv(color, [1, 0, 0, 1])),
+        bufferSubDataFloat32Array: measure(durationMs, () => gl.bufferSubData(gl.ARRAY_BUFFER, 0, bufferData)),
+    };
+    gl.deleteBuffer(buffer);
+    gl.deleteProgram(program);
+
+    const error = gl.getError();
+    for (const name in results) {
+        console.info(`webgl upload benchmark ${name}: ${results[name]} calls/s`);
+    }
+    console.info(`webgl upload benchmark gl error: ${error}`);
+    return results;
+}
@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "webgl/include/util/gl_state_cache.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+namespace {
+constexpr int DRAW_COUNT = 100;
+constexpr GLuint PROGRAM = 3;
+constexpr GLuint BUFFER = 5;
+constexpr GLuint OTHER_BUFFER = 6;
+constexpr GLuint TEXTURE = 7;
+constexpr GLuint FRAMEBUFFER = 9;
+constexpr GLint SURFACE_WIDTH = 200;
+constexpr GLint SURFACE_HEIGHT = 100;
+} // namespace
+
+// Issues the calls of the WebGL entry points and counts the ones that reach the driver.
+class GLStateCacheTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+
+    void Call(bool reachesDriver)
+    {
+        if (reachesDriver) {
+            driverCalls_++;
+        }
+    }
+
+    // the state a typical framework sets before each draw
+    void SetDrawState()
+    {
+        auto& cache = GLStateCache::GetInstance();
+        Call(cache.SetProgram(PROGRAM));
+        Call(cache.SetBuffer(GL_ARRAY_BUFFER, BUFFER));
+        Call(cache.SetCapability(GL_BLEND, true));
+        Call(cache.SetCapability(GL_DEPTH_TEST, false));
+        Call(cache.SetActiveTexture(GL_TEXTURE0));
+        Call(cache.SetTexture(GL_TEXTURE_2D, TEXTURE));
+    }
+
+    // the dirty region of the surface, expected to be [x, y, width, height]
+    static void ExpectDirty(GLint x, GLint y, GLsizei width, GLsizei height)
+    {
+        GLRect rect;
+        ASSERT_TRUE(GLStateCache::GetInstance().TakeDirtyRect(SURFACE_WIDTH, SURFACE_HEIGHT, rect));
+        EXPECT_EQ(rect.x, x);
+        EXPECT_EQ(rect.y, y);
+        EXPECT_EQ(rect.width, width);
+        EXPECT_EQ(rect.height, height);
+    }
+
+    static void ExpectClean()
+    {
+        GLRect rect;
+        EXPECT_FALSE(GLStateCache::GetInstance().TakeDirtyRect(SURFACE_WIDTH, SURFACE_HEIGHT, rect));
+    }
+
+    int driverCalls_ = 0;
+};
+
+void GLStateCacheTest::SetUpTestCase() {}
+void GLStateCacheTest::TearDownTestCase() {}
+void GLStateCacheTest::SetUp()
+{
+    GLStateCache::GetInstance().Reset();
+    driverCalls_ = 0;
+}
+void GLStateCacheTest::TearDown() {}
+
+/**
+ * @tc.name: RedundantState001
+ * @tc.desc: state set again before every draw reaches the driver once
+ * @tc.type:FUNC
+ */
+HWTEST_F(GLStateCacheTest, RedundantState001, TestSize.Level1)
+{
+    auto& cache = GLStateCache::GetInstance();
+    uint64_t skipped = cache.GetSkippedCount();
+    for (int i = 0; i < DRAW_COUNT; i++) {
+        SetDrawState();
+    }
+    constexpr int stateCalls = 6;
+    EXPECT_EQ(driverCalls_, stateCalls);
+    EXPECT_EQ(cache.GetSkippedCount() - skipped, static_cast<uint64_t>(stateCalls * (DRAW_COUNT - 1)));
+
+    // changed state reaches the driver
+    EXPECT_TRUE(cache.SetBuffer(GL_ARRAY_BUFFER, OTHER_BUFFER));
+    EXPECT_TRUE(cache.SetBuffer(GL_ELEMENT_ARRAY_BUFFER, BUFFER));
+    EXPECT_TRUE(cache.SetCapability(GL_BLEND, false));
+    EXPECT_TRUE(cache.SetActiveTexture(GL_TEXTURE1));
+    EXPECT_TRUE(cache.SetTexture(GL_TEXTURE_2D, TEXTURE));
+    EXPECT_FALSE(cache.SetTexture(GL_TEXTURE_2D, TEXTURE));
+    EXPECT_TRUE(cache.SetActiveTexture(GL_TEXTURE0));
+    EXPECT_FALSE(cache.SetTexture(GL_TEXTURE_2D, TEXTURE));
+}
+
+/**
+ * @tc.name: UnknownState001
+ * @tc.desc: state not set through the cache always reaches the driver
+ * @tc.type:FUNC
+ */
+HWTEST_F(GLStateCacheTest, UnknownState001, TestSize.Level1)
+{
+    auto& cache = GLStateCache::GetInstance();
+    // the active texture unit is unknown, texture binds can not be tracked
+    EXPECT_TRUE(cache.SetTexture(GL_TEXTURE_2D, TEXTURE));
+    EXPECT_TRUE(cache.SetTexture(GL_TEXTURE_2D, TEXTURE));
+
+    EXPECT_TRUE(cache.SetProgram(PROGRAM));
+    cache.InvalidateProgram();
+    EXPECT_TRUE(cache.SetProgram(PROGRAM));
+
+    // binding a vertex array changes the element array buffer
+    EXPECT_TRUE(cache.SetBuffer(GL_ELEMENT_ARRAY_BUFFER, BUFFER));
+    cache.InvalidateBuffer(GL_ELEMENT_ARRAY_BUFFER);
+    EXPECT_TRUE(cache.SetBuffer(GL_ELEMENT_ARRAY_BUFFER, BUFFER));
+
+    SetDrawState();
+    cache.Reset();
+    driverCalls_ = 0;
+    SetDrawState();
+    EXPECT_EQ(driverCalls_, 6);
+}
+
+/**
+ * @tc.name: DeletedObjects001
+ * @tc.desc: deleted objects are unbound, their names may be bound again
+ * @tc.type:FUNC
+ */
+HWTEST_F(GLStateCacheTest, DeletedObjects001, TestSize.Level1)
+{
+    auto& cache = GLStateCache::GetInstance();
+    SetDrawState();
+    EXPECT_TRUE(cache.SetBuffer(GL_ELEMENT_ARRAY_BUFFER, BUFFER));
+    cache.OnBufferDeleted(BUFFER);
+    EXPECT_TRUE(cache.SetBuffer(GL_ARRAY_BUFFER, BUFFER));
+    EXPECT_TRUE(cache.SetBuffer(GL_ELEMENT_ARRAY_BUFFER, BUFFER));
+
+    cache.OnTextureDeleted(TEXTURE);
+    EXPECT_FALSE(cache.SetTexture(GL_TEXTURE_2D, 0));
+    EXPECT_TRUE(cache.SetTexture(GL_TEXTURE_2D, TEXTURE));
+
+    EXPECT_TRUE(cache.SetRenderbuffer(BUFFER));
+    cache.OnRenderbufferDeleted(BUFFER);
+    EXPECT_FALSE(cache.SetRenderbuffer(0));
+}
+
+/**
+ * @tc.name: RejectedState001
+ * @tc.desc: calls GL rejects reach the driver every time and keep the state
+ * @tc.type:FUNC
+ */
+HWTEST_F(GLStateCacheTest, RejectedState001, TestSize.Level1)
+{
+    auto& cache = GLStateCache::GetInstance();
+    constexpr GLuint textureUnitCount = 8;
+    cache.SetTextureUnitCount(textureUnitCount);
+    SetDrawState();
+
+    // an unknown capability
+    EXPECT_TRUE(cache.SetCapability(GL_TEXTURE_2D, true));
+    EXPECT_TRUE(cache.SetCapability(GL_TEXTURE_2D, true));
+
+    // a texture unit beyond the context's, the active texture stays
+    EXPECT_TRUE(cache.SetActiveTexture(GL_TEXTURE0 + textureUnitCount));
+    EXPECT_TRUE(cache.SetActiveTexture(GL_TEXTURE0 + textureUnitCount));
+    EXPECT_FALSE(cache.SetActiveTexture(GL_TEXTURE0));
+    EXPECT_FALSE(cache.SetTexture(GL_TEXTURE_2D, TEXTURE));
+
+    // a texture bound to another target than its first one, the binding stays
+    EXPECT_TRUE(cache.SetTexture(GL_TEXTURE_CUBE_MAP, TEXTURE));
+    EXPECT_TRUE(cache.SetTexture(GL_TEXTURE_CUBE_MAP, TEXTURE));
+    EXPECT_FALSE(cache.SetTexture(GL_TEXTURE_2D, TEXTURE));
+    EXPECT_TRUE(cache.SetTexture(GL_TEXTURE_CUBE_MAP, 0));
+
+    // unknown targets
+    EXPECT_TRUE(cache.SetTexture(GL_TEXTURE0, TEXTURE));
+    EXPECT_TRUE(cache.SetTexture(GL_TEXTURE0, TEXTURE));
+    EXPECT_TRUE(cache.SetBuffer(GL_TEXTURE_2D, BUFFER));
+    EXPECT_TRUE(cache.SetBuffer(GL_TEXTURE_2D, BUFFER));
+    EXPECT_FALSE(cache.SetBuffer(GL_ARRAY_BUFFER, BUFFER));
+
+    // an array buffer bound as element array buffer, the copy targets take both
+    EXPECT_TRUE(cache.SetBuffer(GL_ELEMENT_ARRAY_BUFFER, OTHER_BUFFER));
+    EXPECT_TRUE(cache.SetBuffer(GL_ELEMENT_ARRAY_BUFFER, BUFFER));
+    EXPECT_TRUE(cache.SetBuffer(GL_ELEMENT_ARRAY_BUFFER, BUFFER));
+    EXPECT_TRUE(cache.SetBuffer(GL_ELEMENT_ARRAY_BUFFER, OTHER_BUFFER));
+    EXPECT_TRUE(cache.SetBuffer(GL_COPY_READ_BUFFER, BUFFER));
+    EXPECT_TRUE(cache.SetBuffer(GL_COPY_WRITE_BUFFER, OTHER_BUFFER));
+    EXPECT_FALSE(cache.SetBuffer(GL_COPY_WRITE_BUFFER, OTHER_BUFFER));
+}
+
+/**
+ * @tc.name: Framebuffer001
+ * @tc.desc: GL_FRAMEBUFFER binds the draw and the read framebuffer
+ * @tc.type:FUNC
+ */
+HWTEST_F(GLStateCacheTest, Framebuffer001, TestSize.Level1)
+{
+    auto& cache = GLStateCache::GetInstance();
+    EXPECT_TRUE(cache.SetFramebuffer(GL_FRAMEBUFFER, FRAMEBUFFER));
+    EXPECT_FALSE(cache.SetFramebuffer(GL_FRAMEBUFFER, FRAMEBUFFER));
+    EXPECT_FALSE(cache.SetFramebuffer(GL_DRAW_FRAMEBUFFER, FRAMEBUFFER));
+    EXPECT_TRUE(cache.SetFramebuffer(GL_READ_FRAMEBUFFER, 0));
+    EXPECT_TRUE(cache.SetFramebuffer(GL_FRAMEBUFFER, FRAMEBUFFER));
+
+    cache.OnFramebufferDeleted(FRAMEBUFFER);
+    EXPECT_FALSE(cache.SetFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+/**
+ * @tc.name: DirtyRect001
+ * @tc.desc: draws touch the viewport clipped to the scissor box, clears the scissor box, both within the surface
+ * @tc.type:FUNC
+ */
+HWTEST_F(GLStateCacheTest, DirtyRect001, TestSize.Level1)
+{
+    auto& cache = GLStateCache::GetInstance();
+    // the content of a new context is unknown
+    ExpectDirty(0, 0, SURFACE_WIDTH, SURFACE_HEIGHT);
+    ExpectClean();
+
+    EXPECT_TRUE(cache.SetViewport(10, 20, 30, 40));
+    EXPECT_FALSE(cache.SetViewport(10, 20, 30, 40));
+    cache.OnDraw();
+    ExpectDirty(10, 20, 30, 40);
+
+    EXPECT_TRUE(cache.SetScissor(0, 0, 15, 25));
+    EXPECT_FALSE(cache.SetScissor(0, 0, 15, 25));
+    // the scissor box applies only with the scissor test
+    cache.OnDraw();
+    ExpectDirty(10, 20, 30, 40);
+    cache.SetCapability(GL_SCISSOR_TEST, true);
+    cache.OnDraw();
+    ExpectDirty(10, 20, 5, 5);
+
+    // the bounds of both, clipped to the surface
+    cache.OnClear();
+    cache.SetCapability(GL_SCISSOR_TEST, false);
+    cache.SetViewport(150, 90, 100, 100);
+    cache.OnDraw();
+    ExpectDirty(0, 0, SURFACE_WIDTH, SURFACE_HEIGHT);
+
+    // a scissor box outside the surface touches nothing of it
+    cache.SetCapability(GL_SCISSOR_TEST, true);
+    cache.SetScissor(-50, -50, 10, 10);
+    cache.OnClear();
+    ExpectClean();
+}
+
+/**
+ * @tc.name: DirtyRect002
+ * @tc.desc: draws into framebuffer objects are not tracked, unknown boxes touch the whole surface
+ * @tc.type:FUNC
+ */
+HWTEST_F(GLStateCacheTest, DirtyRect002, TestSize.Level1)
+{
+    auto& cache = GLStateCache::GetInstance();
+    ExpectDirty(0, 0, SURFACE_WIDTH, SURFACE_HEIGHT);
+    // the viewport is unknown
+    cache.OnDraw();
+    ExpectDirty(0, 0, SURFACE_WIDTH, SURFACE_HEIGHT);
+
+    cache.SetFramebuffer(GL_FRAMEBUFFER, FRAMEBUFFER);
+    cache.OnDraw();
+    cache.OnClear();
+    ExpectClean();
+    cache.SetFramebuffer(GL_FRAMEBUFFER, 0);
+
+    // the scissor test is unknown
+    EXPECT_TRUE(cache.SetScissor(0, 0, 10, 10));
+    cache.OnClear();
+    ExpectDirty(0, 0, SURFACE_WIDTH, SURFACE_HEIGHT);
+
+    // GL rejects negative sizes and keeps the viewport
+    EXPECT_TRUE(cache.SetViewport(5, 5, 10, 10));
+    EXPECT_TRUE(cache.SetViewport(0, 0, -1, 10));
+    cache.OnDraw();
+    ExpectDirty(5, 5, 10, 10);
+
+    cache.Reset();
+    ExpectDirty(0, 0, SURFACE_WIDTH, SURFACE_HEIGHT);
+}
+} // namespace OHOS::Rosen
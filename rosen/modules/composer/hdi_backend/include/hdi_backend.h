@@ -50,6 +50,9 @@ public:
     void Repaint(std::vector<OutputPtr> &outputs);
     /* for RS end */
 
+    /* only used for mock and headless tests, must be called before RegScreenHotplug */
+    void SetHdiBackendDevice(Base::HdiDevice* device);
+
 private:
     HdiBackend() = default;
     virtual ~HdiBackend() = default;
@@ -60,6 +63,7 @@ private:
     HdiBackend& operator=(HdiBackend&& rhs) = delete;
 
     Base::HdiDevice *device_ = nullptr;
+    bool deviceInited_ = false;
     void* onHotPlugCbData_ = nullptr;
     void* onPrepareCompleteCbData_ = nullptr;
     OnScreenHotplugFunc onScreenHotplugCb_ = nullptr;
@@ -321,11 +321,13 @@ void HdiBackend::OnScreenHotplug(uint32_t screenId, bool connected)
 
 RosenError HdiBackend::InitDevice()
 {
-    if (device_ != nullptr) {
+    if (deviceInited_) {
         return ROSEN_ERROR_OK;
     }
 
-    device_ = HdiDevice::GetInstance();
+    if (device_ == nullptr) {
+        device_ = HdiDevice::GetInstance();
+    }
     if (device_ == nullptr) {
         HLOGE("Get HdiDevice failed");
         return ROSEN_ERROR_NOT_INIT;
@@ -336,12 +338,27 @@ RosenError HdiBackend::InitDevice()
         HLOGE("RegHotPlugCallback failed, ret is %{public}d", ret);
         return ROSEN_ERROR_API_FAILED;
     }
+    deviceInited_ = true;
 
     HLOGI("Init device succeed");
 
     return ROSEN_ERROR_OK;
 }
 
+void HdiBackend::SetHdiBackendDevice(Base::HdiDevice* device)
+{
+    if (device == nullptr) {
+        HLOGE("Input HdiDevice is null");
+        return;
+    }
+
+    if (device_ != nullptr) {
+        HLOGW("HdiDevice has been changed");
+        return;
+    }
+    device_ = device;
+}
+
 void HdiBackend::CheckRet(int32_t ret, const char* func)
 {
     if (ret != DISPLAY_SUCCESS) {
@@ -42,6 +42,7 @@ void RSCompatibleProcessor::Init(ScreenId id, int32_t offsetX, int32_t offsetY)
         return;
     }
     output_ = screenManager_->GetOutput(id);
+    currScreenInfo_ = screenManager_->QueryScreenInfo(id);
 
     consumerSurface_ = Surface::CreateSurfaceAsConsumer();
     sptr<IBufferConsumerListener> listener = new RSRenderBufferListener(*this);
@@ -52,9 +53,21 @@ void RSCompatibleProcessor::Init(ScreenId id, int32_t offsetX, int32_t offsetY)
     }
     sptr<IBufferProducer> producer = consumerSurface_->GetProducer();
     producerSurface_ = Surface::CreateSurfaceAsProducer(producer);
+}
+
+void RSCompatibleProcessor::PreProcess(const ScreenInfo& screenInfo, int32_t offsetX, int32_t offsetY)
+{
+    offsetX_ = offsetX;
+    offsetY_ = offsetY;
+    currScreenInfo_ = screenInfo;
+    canvas_ = nullptr;
+    if (producerSurface_ == nullptr) {
+        RS_LOGE("RSCompatibleProcessor::PreProcess producerSurface is nullptr");
+        return;
+    }
     BufferRequestConfig requestConfig = {
-        .width = 2800,
-        .height = 1600,
+        .width = static_cast<int32_t>(currScreenInfo_.width),
+        .height = static_cast<int32_t>(currScreenInfo_.height),
         .strideAlignment = 0x8,
         .format = PIXEL_FMT_RGBA_8888,
         .usage = HBM_USE_CPU_READ | HBM_USE_CPU_WRITE | HBM_USE_MEM_DMA,
@@ -62,6 +75,7 @@ void RSCompatibleProcessor::Init(ScreenId id, int32_t offsetX, int32_t offsetY)
     };
     auto uniqueCanvasPtr = CreateCanvas(producerSurface_, requestConfig);
     canvas_ = std::move(uniqueCanvasPtr);
+    BeginDamageFrame(requestConfig.width, requestConfig.height);
 }
 
 void RSCompatibleProcessor::ProcessSurface(RSSurfaceRenderNode& node)
@@ -73,6 +87,7 @@ void RSCompatibleProcessor::ProcessSurface(RSSurfaceRenderNode& node)
         return;
     }
     OHOS::sptr<SurfaceBuffer> cbuffer;
+    sptr<SurfaceBuffer> prevBuffer = node.GetBuffer();
     RSProcessor::SpecialTask task = [&node, &cbuffer] () -> void{
         if (cbuffer != node.GetBuffer() && node.GetBuffer() != nullptr) {
             auto& surfaceConsumer = node.GetConsumer();
@@ -100,23 +115,19 @@ void RSCompatibleProcessor::ProcessSurface(RSSurfaceRenderNode& node)
         geoPtr->GetAbsRect().width_, geoPtr->GetAbsRect().height_,
         node.GetDamageRegion().w, node.GetDamageRegion().y);
 
-    SkMatrix matrix;
-    matrix.reset();
-    auto params = RsRenderServiceUtil::CreateBufferDrawParam(node);
-    RsRenderServiceUtil::DrawBuffer(*canvas_, params);
+    node.SetDstRect({geoPtr->GetAbsRect().left_ - offsetX_, geoPtr->GetAbsRect().top_ - offsetY_,
+        geoPtr->GetAbsRect().width_, geoPtr->GetAbsRect().height_});
+    AddSurfaceToRedraw(node, cbuffer != prevBuffer);
 }
 
 void RSCompatibleProcessor::PostProcess()
 {
-    BufferFlushConfig flushConfig = {
-        .damage = {
-            .x = 0,
-            .y = 0,
-            .w = 2800,
-            .h = 1600,
-        },
-    };
-    FlushBuffer(producerSurface_, flushConfig);
+    if (!canvas_) {
+        RS_LOGE("RsDebug RSCompatibleProcessor::PostProcess canvas is nullptr");
+        FlushBuffer(producerSurface_, {});
+        return;
+    }
+    DrawAndFlushDamage(*canvas_, producerSurface_, {});
 }
 
 void RSCompatibleProcessor::DoComposeSurfaces()
@@ -157,6 +168,9 @@ void RSCompatibleProcessor::DoComposeSurfaces()
     std::shared_ptr<HdiLayerInfo> layer = HdiLayerInfo::CreateHdiLayerInfo();
     std::vector<LayerInfoPtr> layers;
     RsRenderServiceUtil::ComposeSurface(layer, consumerSurface_, layers, info);
+    if (damage.w > 0 && damage.h > 0) {
+        layer->SetDirtyRegion({ damage.x, damage.y, damage.w, damage.h });
+    }
     output_->SetLayerInfo(layers);
     std::vector<std::shared_ptr<HdiOutput>> outputs{output_};
     backend_->Repaint(outputs);
@@ -33,6 +33,7 @@ public:
     ~RSCompatibleProcessor() override;
     void ProcessSurface(RSSurfaceRenderNode& node) override;
     void Init(ScreenId id, int32_t offsetX, int32_t offsetY) override;
+    void PreProcess(const ScreenInfo& screenInfo, int32_t offsetX, int32_t offsetY) override;
     void PostProcess() override;
     void DoComposeSurfaces();
 
@@ -51,6 +52,7 @@ private:
     sptr<Surface> consumerSurface_;
     sptr<Surface> producerSurface_;
     std::unique_ptr<SkCanvas> canvas_;
+    ScreenInfo currScreenInfo_;
     LayerAlpha alpha_ = { .enPixelAlpha = true };
     int32_t offsetX_ = 0;
     int32_t offsetY_ = 0;
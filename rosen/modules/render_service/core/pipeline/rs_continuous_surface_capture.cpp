@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/rs_continuous_surface_capture.h"
+
+#include <algorithm>
+
+#include "pipeline/rs_surface_capture_task.h"
+#include "pipeline/rs_surface_capture_thread.h"
+#include "platform/common/rs_log.h"
+#include "rs_trace.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+constexpr uint64_t NS_PER_SECOND = 1000000000;
+constexpr uint32_t MAX_FPS = 60;
+// one pixelmap being delivered while the next one is rendered
+constexpr uint32_t MAX_PENDING_FRAMES = 2;
+} // namespace
+
+RSContinuousSurfaceCapture::RSContinuousSurfaceCapture(NodeId id, sptr<RSISurfaceCaptureCallback> callback,
+    float scaleX, float scaleY, uint32_t fps)
+    : nodeId_(id), callback_(callback), scaleX_(scaleX), scaleY_(scaleY),
+      interval_(NS_PER_SECOND / std::clamp<uint32_t>(fps, 1, MAX_FPS))
+{
+}
+
+void RSContinuousSurfaceCapture::OnFrame(uint64_t timestamp)
+{
+    if (callback_ == nullptr) {
+        return;
+    }
+    if (captured_ && timestamp < lastCaptureTime_ + interval_) {
+        return;
+    }
+    if (pendingFrames_.load() >= MAX_PENDING_FRAMES) {
+        RS_LOGD("RSContinuousSurfaceCapture::OnFrame node[%llu] drops a frame, capture thread is busy", nodeId_);
+        return;
+    }
+    ROSEN_TRACE_BEGIN(BYTRACE_TAG_GRAPHIC_AGP, "RSContinuousSurfaceCapture::Snapshot");
+    auto task = std::make_shared<RSSurfaceCaptureTask>(nodeId_, scaleX_, scaleY_);
+    bool snapshotted = task->Snapshot();
+    ROSEN_TRACE_END(BYTRACE_TAG_GRAPHIC_AGP);
+    if (!snapshotted) {
+        return;
+    }
+    captured_ = true;
+    lastCaptureTime_ = timestamp;
+    ++pendingFrames_;
+    RSSurfaceCaptureThread::Instance().PostTask([capture = shared_from_this(), task]() {
+        ROSEN_TRACE_BEGIN(BYTRACE_TAG_GRAPHIC_AGP, "RSContinuousSurfaceCapture::Render");
+        auto pixelmap = task->Render(capture->AcquirePixelMap());
+        capture->callback_->OnSurfaceCapture(capture->nodeId_, pixelmap.get());
+        capture->ReleasePixelMap(std::move(pixelmap));
+        --capture->pendingFrames_;
+        ROSEN_TRACE_END(BYTRACE_TAG_GRAPHIC_AGP);
+    });
+}
+
+std::unique_ptr<Media::PixelMap> RSContinuousSurfaceCapture::AcquirePixelMap()
+{
+    std::lock_guard<std::mutex> lock(poolMutex_);
+    if (pixelmapPool_.empty()) {
+        return nullptr;
+    }
+    auto pixelmap = std::move(pixelmapPool_.back());
+    pixelmapPool_.pop_back();
+    return pixelmap;
+}
+
+void RSContinuousSurfaceCapture::ReleasePixelMap(std::unique_ptr<Media::PixelMap> pixelmap)
+{
+    if (pixelmap == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(poolMutex_);
+    if (pixelmapPool_.size() < MAX_PENDING_FRAMES) {
+        pixelmapPool_.push_back(std::move(pixelmap));
+    }
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RS_CONTINUOUS_SURFACE_CAPTURE_H
+#define RS_CONTINUOUS_SURFACE_CAPTURE_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/rs_common_def.h"
+#include "ipc_callbacks/surface_capture_callback.h"
+#include "pixel_map.h"
+
+namespace OHOS {
+namespace Rosen {
+// Captures a node repeatedly, at most at a requested rate. Snapshots are taken on the main thread after each composed
+// frame (an idle screen produces no new frames) and rendered on the capture thread into a small pool of pixelmaps
+// which are reused from frame to frame.
+class RSContinuousSurfaceCapture : public std::enable_shared_from_this<RSContinuousSurfaceCapture> {
+public:
+    RSContinuousSurfaceCapture(NodeId id, sptr<RSISurfaceCaptureCallback> callback, float scaleX, float scaleY,
+        uint32_t fps);
+    ~RSContinuousSurfaceCapture() = default;
+
+    // called on the main thread once per composed frame, [timestamp] in nanoseconds
+    void OnFrame(uint64_t timestamp);
+
+private:
+    std::unique_ptr<Media::PixelMap> AcquirePixelMap();
+    void ReleasePixelMap(std::unique_ptr<Media::PixelMap> pixelmap);
+
+    NodeId nodeId_;
+    sptr<RSISurfaceCaptureCallback> callback_;
+    float scaleX_;
+    float scaleY_;
+    uint64_t interval_;
+    uint64_t lastCaptureTime_ = 0;
+    bool captured_ = false;
+    // frames snapshotted but not delivered yet, new frames are dropped while the pool is exhausted
+    std::atomic<uint32_t> pendingFrames_ { 0 };
+    std::mutex poolMutex_;
+    std::vector<std::unique_ptr<Media::PixelMap>> pixelmapPool_;
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // RS_CONTINUOUS_SURFACE_CAPTURE_H
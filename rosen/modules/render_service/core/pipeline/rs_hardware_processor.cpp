@@ -35,17 +35,27 @@
 
 namespace OHOS {
 namespace Rosen {
+RSHardwareProcessor* RSHardwareProcessor::prepareCompleteOwner_ = nullptr;
+
 RSHardwareProcessor::RSHardwareProcessor() {}
 
-RSHardwareProcessor::~RSHardwareProcessor() {}
+RSHardwareProcessor::~RSHardwareProcessor()
+{
+    if (prepareCompleteOwner_ == this) {
+        prepareCompleteOwner_ = nullptr;
+        if (backend_) {
+            // the backend must not call back into a destroyed processor
+            backend_->RegPrepareComplete([](sptr<Surface>&, const struct PrepareCompleteParam&, void*) {}, nullptr);
+        }
+    }
+}
 
 void RSHardwareProcessor::Init(ScreenId id, int32_t offsetX, int32_t offsetY)
 {
     offsetX_ = offsetX;
     offsetY_ = offsetY;
+    screenId_ = id;
     backend_ = HdiBackend::GetInstance();
-    backend_->RegPrepareComplete(std::bind(&RSHardwareProcessor::Redraw, this, std::placeholders::_1,
-        std::placeholders::_2, std::placeholders::_3), nullptr);
     screenManager_ = CreateOrGetScreenManager();
     if (!screenManager_) {
         RS_LOGE("RSHardwareProcessor::Init ScreenManager is nullptr");
@@ -59,12 +69,6 @@ void RSHardwareProcessor::Init(ScreenId id, int32_t offsetX, int32_t offsetY)
     }
     currScreenInfo_ = screenManager_->QueryScreenInfo(id);
     RS_LOGI("RSHardwareProcessor::Init screen w:%d, w:%d", currScreenInfo_.width, currScreenInfo_.height);
-    IRect damageRect;
-    damageRect.x = 0;
-    damageRect.y = 0;
-    damageRect.w = static_cast<int32_t>(currScreenInfo_.width);
-    damageRect.h = static_cast<int32_t>(currScreenInfo_.height);
-    output_->SetOutputDamage(1, damageRect);
 
 #ifdef RS_ENABLE_GL
     auto mainThread = RSMainThread::Instance();
@@ -75,6 +79,35 @@ void RSHardwareProcessor::Init(ScreenId id, int32_t offsetX, int32_t offsetY)
 #endif // RS_ENABLE_GL
 }
 
+void RSHardwareProcessor::PreProcess(const ScreenInfo& screenInfo, int32_t offsetX, int32_t offsetY)
+{
+    offsetX_ = offsetX;
+    offsetY_ = offsetY;
+    currScreenInfo_ = screenInfo;
+    layers_.clear();
+    if (!screenManager_ || !output_) {
+        RS_LOGE("RSHardwareProcessor::PreProcess screenManager or output is nullptr");
+        return;
+    }
+    rotation_ = screenManager_->GetRotation(screenId_);
+    IRect damageRect;
+    damageRect.x = 0;
+    damageRect.y = 0;
+    damageRect.w = static_cast<int32_t>(currScreenInfo_.width);
+    damageRect.h = static_cast<int32_t>(currScreenInfo_.height);
+    output_->SetOutputDamage(1, damageRect);
+}
+
+void RSHardwareProcessor::RegisterPrepareComplete()
+{
+    if (prepareCompleteOwner_ == this || backend_ == nullptr) {
+        return;
+    }
+    backend_->RegPrepareComplete(std::bind(&RSHardwareProcessor::Redraw, this, std::placeholders::_1,
+        std::placeholders::_2, std::placeholders::_3), nullptr);
+    prepareCompleteOwner_ = this;
+}
+
 void RSHardwareProcessor::PostProcess()
 {
     if (output_ == nullptr) {
@@ -87,6 +120,8 @@ void RSHardwareProcessor::PostProcess()
     output_->SetLayerInfo(layers_);
     std::vector<std::shared_ptr<HdiOutput>> outputs{output_};
     if (backend_) {
+        // Repaint calls back synchronously, so the callback only needs to change hands between screens
+        RegisterPrepareComplete();
         backend_->Repaint(outputs);
     }
 }
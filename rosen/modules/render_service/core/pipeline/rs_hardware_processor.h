@@ -39,6 +39,7 @@ public:
     ~RSHardwareProcessor() override;
     void ProcessSurface(RSSurfaceRenderNode& node) override;
     void Init(ScreenId id, int32_t offsetX, int32_t offsetY) override;
+    void PreProcess(const ScreenInfo& screenInfo, int32_t offsetX, int32_t offsetY) override;
     void PostProcess() override;
     void CropLayers();
 
@@ -49,8 +50,12 @@ private:
         ComposeInfo& info, RSSurfaceRenderNode& node);
     void CalculateInfoWithVideo(ComposeInfo& info, RSSurfaceRenderNode& node);
     void ReleaseNodePrevBuffer(RSSurfaceRenderNode& node);
+    void RegisterPrepareComplete();
+    // HdiBackend holds a single prepare complete callback shared by all hardware screens
+    static RSHardwareProcessor* prepareCompleteOwner_;
     HdiBackend* backend_ = nullptr;
     sptr<RSScreenManager> screenManager_;
+    ScreenId screenId_ = INVALID_SCREEN_ID;
     ScreenInfo currScreenInfo_;
     std::shared_ptr<HdiOutput> output_;
     std::vector<LayerInfoPtr> layers_;
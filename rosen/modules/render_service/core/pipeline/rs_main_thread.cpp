@@ -14,8 +14,12 @@
  */
 #include "pipeline/rs_main_thread.h"
 
+#include <chrono>
+
 #include "command/rs_message_processor.h"
 #include "pipeline/rs_base_render_node.h"
+#include "pipeline/rs_continuous_surface_capture.h"
+#include "pipeline/rs_processor_factory.h"
 #include "pipeline/rs_render_service_util.h"
 #include "pipeline/rs_render_service_visitor.h"
 #include "platform/common/rs_log.h"
@@ -26,6 +30,13 @@
 
 namespace OHOS {
 namespace Rosen {
+namespace {
+int64_t ElapsedUs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
 RSMainThread* RSMainThread::Instance()
 {
     static RSMainThread instance;
@@ -44,12 +55,7 @@ void RSMainThread::Init()
 {
     mainLoop_ = [&]() {
         RS_LOGI("RsDebug mainLoop start");
-        ROSEN_TRACE_BEGIN(BYTRACE_TAG_GRAPHIC_AGP, "RSMainThread::DoComposition");
-        ProcessCommand();
-        Animate(timestamp_);
-        Render();
-        SendCommands();
-        ROSEN_TRACE_END(BYTRACE_TAG_GRAPHIC_AGP);
+        DoComposition(timestamp_);
         RS_LOGI("RsDebug mainLoop end");
     };
 
@@ -76,6 +82,26 @@ void RSMainThread::Start()
     }
 }
 
+void RSMainThread::DoComposition(uint64_t timestamp)
+{
+    ROSEN_TRACE_BEGIN(BYTRACE_TAG_GRAPHIC_AGP, "RSMainThread::DoComposition");
+    timestamp_ = timestamp;
+    auto start = std::chrono::steady_clock::now();
+    ProcessCommand();
+    lastFrameTimings_.processCommand = ElapsedUs(start);
+
+    start = std::chrono::steady_clock::now();
+    Animate(timestamp_);
+    lastFrameTimings_.animate = ElapsedUs(start);
+
+    Render();
+
+    start = std::chrono::steady_clock::now();
+    SendCommands();
+    lastFrameTimings_.sendCommands = ElapsedUs(start);
+    ROSEN_TRACE_END(BYTRACE_TAG_GRAPHIC_AGP);
+}
+
 void RSMainThread::ProcessCommand()
 {
     {
@@ -97,11 +123,22 @@ void RSMainThread::Render()
     const std::shared_ptr<RSBaseRenderNode> rootNode = context_.GetGlobalRootRenderNode();
     if (rootNode == nullptr) {
         RS_LOGE("RSMainThread::Draw GetGlobalRootRenderNode fail");
+        // nothing was drawn, the timings of the previous frame do not apply
+        lastFrameTimings_.prepare = 0;
+        lastFrameTimings_.process = 0;
         return;
     }
     std::shared_ptr<RSNodeVisitor> visitor = std::make_shared<RSRenderServiceVisitor>();
+    auto start = std::chrono::steady_clock::now();
     rootNode->Prepare(visitor);
+    lastFrameTimings_.prepare = ElapsedUs(start);
+
+    start = std::chrono::steady_clock::now();
     rootNode->Process(visitor);
+    lastFrameTimings_.process = ElapsedUs(start);
+    for (auto& entry : continuousCaptures_) {
+        entry.second->OnFrame(timestamp_);
+    }
 }
 
 void RSMainThread::RequestNextVSync()
@@ -145,18 +182,7 @@ void RSMainThread::Animate(uint64_t timestamp)
     }
 
     // iterate and animate all animating nodes, remove if animation finished
-    std::__libcpp_erase_if_container(context_.animatingNodeList_, [timestamp](const auto& iter) -> bool {
-        auto node = iter.second.lock();
-        if (node == nullptr) {
-            RS_LOGD("RSMainThread::Animate removing expired animating node");
-            return true;
-        }
-        bool animationFinished = !node->Animate(timestamp);
-        if (animationFinished) {
-            RS_LOGD("RSMainThread::Animate removing finished animating node %llu", node->GetId());
-        }
-        return animationFinished;
-    });
+    animator_.Animate(context_.animatingNodeList_, timestamp);
 
     RequestNextVSync();
 }
@@ -188,6 +214,73 @@ void RSMainThread::UnregisterApplicationRenderThread(sptr<IApplicationRenderThre
     std::__libcpp_erase_if_container(applicationRenderThreadMap_, [&app](auto& iter) { return iter.second == app; });
 }
 
+std::shared_ptr<RSProcessor> RSMainThread::GetOrCreateProcessor(ScreenId id,
+    RSDisplayRenderNode::CompositeType type, const ScreenInfo& screenInfo, int32_t offsetX, int32_t offsetY)
+{
+    auto iter = screenProcessors_.find(id);
+    if (iter != screenProcessors_.end()) {
+        auto& entry = iter->second;
+        if (entry.type == type && entry.width == screenInfo.width && entry.height == screenInfo.height) {
+            return entry.processor;
+        }
+        RS_LOGI("RSMainThread::GetOrCreateProcessor screen %llu changed, type:%d->%d, size:[%u %u]->[%u %u]", id,
+            entry.type, type, entry.width, entry.height, screenInfo.width, screenInfo.height);
+        screenProcessors_.erase(iter);
+    }
+    auto processor = RSProcessorFactory::CreateProcessor(type);
+    if (processor == nullptr) {
+        return nullptr;
+    }
+    processor->Init(id, offsetX, offsetY);
+    screenProcessors_.emplace(id, ScreenProcessor { type, screenInfo.width, screenInfo.height, processor });
+    return processor;
+}
+
+void RSMainThread::RemoveProcessor(ScreenId id)
+{
+    screenProcessors_.erase(id);
+    lastCulledSurfaces_.erase(id);
+}
+
+void RSMainThread::AddContinuousSurfaceCapture(pid_t pid, NodeId id,
+    std::shared_ptr<RSContinuousSurfaceCapture> capture)
+{
+    continuousCaptures_[std::make_pair(pid, id)] = capture;
+    RequestNextVSync();
+}
+
+void RSMainThread::RemoveContinuousSurfaceCapture(pid_t pid, NodeId id)
+{
+    continuousCaptures_.erase(std::make_pair(pid, id));
+}
+
+bool RSMainThread::HasContinuousSurfaceCapture(pid_t pid, NodeId id) const
+{
+    return continuousCaptures_.count(std::make_pair(pid, id)) != 0;
+}
+
+void RSMainThread::UpdateOcclusionStats(ScreenId id, uint32_t culledCount)
+{
+    lastCulledSurfaces_[id] = culledCount;
+    totalCulledSurfaces_ += culledCount;
+}
+
+void RSMainThread::OcclusionDump(std::string& dumpString) const
+{
+    dumpString.append("\n");
+    dumpString.append("-- Occlusion\n");
+    for (const auto& [id, count] : lastCulledSurfaces_) {
+        dumpString += "screen[" + std::to_string(id) + "] culled surfaces in last frame: " +
+            std::to_string(count) + "\n";
+    }
+    dumpString += "total culled surfaces: " + std::to_string(totalCulledSurfaces_) + "\n";
+}
+
+void RSMainThread::AnimationDump(std::string& dumpString) const
+{
+    animator_.Dump(dumpString);
+}
+
 void RSMainThread::SendCommands()
 {
     RS_TRACE_FUNC();
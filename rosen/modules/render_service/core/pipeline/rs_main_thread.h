@@ -16,16 +16,21 @@
 #ifndef RS_MAIN_THREAD
 #define RS_MAIN_THREAD
 
+#include <cstdint>
 #include <future>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <utility>
 
+#include "animation/rs_parallel_animator.h"
 #include "common/rs_thread_handler.h"
 #include "common/rs_thread_looper.h"
 #include "ipc_callbacks/iapplication_render_thread.h"
 #include "pipeline/rs_context.h"
+#include "pipeline/rs_display_render_node.h"
 #include "platform/drawing/rs_vsync_client.h"
 #include "refbase.h"
 #include "vsync_receiver.h"
@@ -38,7 +43,10 @@
 
 namespace OHOS {
 namespace Rosen {
+class RSContinuousSurfaceCapture;
+class RSProcessor;
 class RSTransactionData;
+struct ScreenInfo;
 
 namespace Detail {
 template<typename Task>
@@ -64,12 +72,27 @@ private:
 };
 } // namespace Detail
 
+// durations of the phases of a composed frame in us, process includes flushing the frame to the screens
+struct RSFrameTimings {
+    int64_t processCommand = 0;
+    int64_t animate = 0;
+    int64_t prepare = 0;
+    int64_t process = 0;
+    int64_t sendCommands = 0;
+};
+
 class RSMainThread {
 public:
     static RSMainThread* Instance();
 
     void Init();
     void Start();
+    // composes one frame for vsync [timestamp], also used to drive the pipeline without a looper or vsync
+    void DoComposition(uint64_t timestamp);
+    const RSFrameTimings& GetLastFrameTimings() const
+    {
+        return lastFrameTimings_;
+    }
     void RecvRSTransactionData(std::unique_ptr<RSTransactionData>& rsTransactionData);
     void RequestNextVSync();
     void PostTask(RSTaskMessage::RSTask task);
@@ -104,6 +127,22 @@ public:
     void RegisterApplicationRenderThread(uint32_t pid, sptr<IApplicationRenderThread> app);
     void UnregisterApplicationRenderThread(sptr<IApplicationRenderThread> app);
 
+    // processors are kept per screen and only recreated when the composite type or resolution changes
+    std::shared_ptr<RSProcessor> GetOrCreateProcessor(ScreenId id, RSDisplayRenderNode::CompositeType type,
+        const ScreenInfo& screenInfo, int32_t offsetX, int32_t offsetY);
+    void RemoveProcessor(ScreenId id);
+
+    // continuous captures are snapshotted after every composed frame, up to their own rate. They are kept per client
+    // pid, so clients capturing the same node don't replace or stop each other's captures.
+    void AddContinuousSurfaceCapture(pid_t pid, NodeId id, std::shared_ptr<RSContinuousSurfaceCapture> capture);
+    void RemoveContinuousSurfaceCapture(pid_t pid, NodeId id);
+    bool HasContinuousSurfaceCapture(pid_t pid, NodeId id) const;
+
+    // statistics of surfaces skipped in composition because they are fully occluded
+    void UpdateOcclusionStats(ScreenId id, uint32_t culledCount);
+    void OcclusionDump(std::string& dumpString) const;
+    void AnimationDump(std::string& dumpString) const;
+
     sptr<VSyncDistributor> rsVSyncDistributor_;
 private:
     RSMainThread();
@@ -131,7 +170,20 @@ private:
     uint64_t timestamp_ = 0;
     std::unordered_map<uint32_t, sptr<IApplicationRenderThread>> applicationRenderThreadMap_;
 
+    struct ScreenProcessor {
+        RSDisplayRenderNode::CompositeType type;
+        uint32_t width;
+        uint32_t height;
+        std::shared_ptr<RSProcessor> processor;
+    };
+    std::unordered_map<ScreenId, ScreenProcessor> screenProcessors_;
+    std::map<std::pair<pid_t, NodeId>, std::shared_ptr<RSContinuousSurfaceCapture>> continuousCaptures_;
+    std::map<ScreenId, uint32_t> lastCulledSurfaces_;
+    uint64_t totalCulledSurfaces_ = 0;
+    RSFrameTimings lastFrameTimings_;
+
     RSContext context_;
+    RSParallelAnimator animator_;
     std::thread::id mainThreadId_;
     std::shared_ptr<VSyncReceiver> receiver_ = nullptr;
 
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/rs_output_damage_tracker.h"
+
+#include <cmath>
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+// buffers older than this are redrawn entirely, producer surfaces rarely have more than 3 buffers
+constexpr size_t MAX_BUFFER_AGE = 4;
+
+RectI JoinDamage(const RectI& damage, const RectI& rect)
+{
+    if (rect.IsEmpty()) {
+        return damage;
+    }
+    return damage.IsEmpty() ? rect : damage.JoinRect(rect);
+}
+} // namespace
+
+void RSOutputDamageTracker::BeginFrame(int32_t width, int32_t height)
+{
+    RectI screenRect(0, 0, width, height);
+    if (screenRect != screenRect_) {
+        // contents of all buffers are of no use after a resolution change
+        screenRect_ = screenRect;
+        damageHistory_.clear();
+        bufferFrames_.clear();
+        lastSurfaces_.clear();
+        frameDamage_ = screenRect_;
+    } else {
+        frameDamage_.Clear();
+    }
+    currSurfaces_.clear();
+}
+
+void RSOutputDamageTracker::AddSurface(NodeId id, const RectI& dstRect, float alpha)
+{
+    SurfaceState state = {
+        .dstRect = dstRect,
+        .alpha = alpha,
+        .order = static_cast<uint32_t>(currSurfaces_.size()),
+    };
+    auto iter = lastSurfaces_.find(id);
+    if (iter == lastSurfaces_.end()) {
+        AddDamage(dstRect);
+    } else if (iter->second.dstRect != dstRect || !ROSEN_EQ(iter->second.alpha, alpha) ||
+        iter->second.order != state.order) {
+        AddDamage(iter->second.dstRect);
+        AddDamage(dstRect);
+    }
+    currSurfaces_[id] = state;
+}
+
+void RSOutputDamageTracker::AddDamage(const RectI& rect)
+{
+    frameDamage_ = JoinDamage(frameDamage_, rect.IntersectRect(screenRect_));
+}
+
+void RSOutputDamageTracker::AddFullDamage()
+{
+    frameDamage_ = screenRect_;
+}
+
+RectI RSOutputDamageTracker::EndFrame(int32_t bufferId)
+{
+    for (const auto& [id, state] : lastSurfaces_) {
+        if (currSurfaces_.count(id) == 0) {
+            AddDamage(state.dstRect);
+        }
+    }
+    lastSurfaces_.swap(currSurfaces_);
+
+    // the buffer holds the contents of the frame it was drawn in last, the damages of all frames since then
+    // have to be redrawn.
+    RectI redrawRect = screenRect_;
+    auto iter = bufferFrames_.find(bufferId);
+    if (iter != bufferFrames_.end()) {
+        uint64_t age = frameCount_ - iter->second;
+        if (age > 0 && age - 1 <= damageHistory_.size()) {
+            redrawRect = frameDamage_;
+            for (uint64_t i = 0; i + 1 < age; ++i) {
+                redrawRect = JoinDamage(redrawRect, damageHistory_[i]);
+            }
+        }
+    }
+
+    damageHistory_.push_front(frameDamage_);
+    if (damageHistory_.size() > MAX_BUFFER_AGE) {
+        damageHistory_.pop_back();
+    }
+    bufferFrames_[bufferId] = frameCount_;
+    // forget buffers which are not in use anymore
+    for (auto it = bufferFrames_.begin(); it != bufferFrames_.end();) {
+        if (frameCount_ - it->second > MAX_BUFFER_AGE) {
+            it = bufferFrames_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    ++frameCount_;
+    return redrawRect;
+}
+
+RectI RSOutputDamageTracker::MapBufferDamage(const Rect& damage, int32_t bufferWidth, int32_t bufferHeight,
+    const RectI& dstRect)
+{
+    if (damage.w <= 0 || damage.h <= 0 || bufferWidth <= 0 || bufferHeight <= 0) {
+        return dstRect;
+    }
+    float scaleX = static_cast<float>(dstRect.width_) / bufferWidth;
+    float scaleY = static_cast<float>(dstRect.height_) / bufferHeight;
+    int32_t left = dstRect.left_ + static_cast<int32_t>(std::floor(damage.x * scaleX));
+    int32_t top = dstRect.top_ + static_cast<int32_t>(std::floor(damage.y * scaleY));
+    int32_t right = dstRect.left_ + static_cast<int32_t>(std::ceil((damage.x + damage.w) * scaleX));
+    int32_t bottom = dstRect.top_ + static_cast<int32_t>(std::ceil((damage.y + damage.h) * scaleY));
+    return RectI(left, top, right - left, bottom - top).IntersectRect(dstRect);
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RS_OUTPUT_DAMAGE_TRACKER_H
+#define RS_OUTPUT_DAMAGE_TRACKER_H
+
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+
+#include <surface_type.h>
+
+#include "common/rs_common_def.h"
+#include "common/rs_rect.h"
+
+namespace OHOS {
+namespace Rosen {
+// Tracks which part of a software composed output changed between frames. The output is drawn into the buffers of
+// a producer surface which are recycled, so the area to redraw into a buffer is the union of the damages of all the
+// frames since that buffer was drawn last (its age).
+class RSOutputDamageTracker {
+public:
+    RSOutputDamageTracker() = default;
+    ~RSOutputDamageTracker() = default;
+
+    void BeginFrame(int32_t width, int32_t height);
+    // record a surface composed in this frame, a surface which moved, changed alpha or order, appeared or
+    // disappeared damages its old and new rect.
+    void AddSurface(NodeId id, const RectI& dstRect, float alpha);
+    // content damage in output coordinates, e.g. the flush damage of a new buffer
+    void AddDamage(const RectI& rect);
+    void AddFullDamage();
+    // finish the frame drawn into output buffer [bufferId], returns the rect to redraw into that buffer.
+    RectI EndFrame(int32_t bufferId);
+
+    // damage of the last frame compared to the frame before, to be forwarded to the consumer of the output
+    const RectI& GetFrameDamage() const
+    {
+        return frameDamage_;
+    }
+
+    // map the damage of a surface buffer of [bufferWidth]x[bufferHeight] to [dstRect], an empty damage means the
+    // whole buffer changed.
+    static RectI MapBufferDamage(const Rect& damage, int32_t bufferWidth, int32_t bufferHeight,
+        const RectI& dstRect);
+
+private:
+    struct SurfaceState {
+        RectI dstRect;
+        float alpha = 1.0f;
+        uint32_t order = 0;
+    };
+
+    RectI screenRect_;
+    RectI frameDamage_;
+    std::unordered_map<NodeId, SurfaceState> lastSurfaces_;
+    std::unordered_map<NodeId, SurfaceState> currSurfaces_;
+    // damages of the previous frames, most recent first
+    std::deque<RectI> damageHistory_;
+    std::unordered_map<int32_t, uint64_t> bufferFrames_;
+    uint64_t frameCount_ = 0;
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // RS_OUTPUT_DAMAGE_TRACKER_H
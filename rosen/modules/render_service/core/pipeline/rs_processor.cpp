@@ -83,6 +83,69 @@ void RSProcessor::FlushBuffer(sptr<Surface> surface, BufferFlushConfig flushConf
         return;
     }
     surface->FlushBuffer(buffer_, -1, flushConfig);
+    // processors are reused across frames, never flush the same buffer twice
+    buffer_ = nullptr;
+}
+
+void RSProcessor::BeginDamageFrame(int32_t width, int32_t height)
+{
+    damageTracker_.BeginFrame(width, height);
+    pendingDraws_.clear();
+}
+
+void RSProcessor::AddSurfaceToRedraw(RSSurfaceRenderNode& node, bool hasNewBuffer)
+{
+    const RectI& dstRect = node.GetDstRect();
+    damageTracker_.AddSurface(node.GetId(), dstRect, node.GetAlpha() * node.GetRenderProperties().GetAlpha());
+    const auto& buffer = node.GetBuffer();
+    if (hasNewBuffer && buffer != nullptr) {
+        damageTracker_.AddDamage(RSOutputDamageTracker::MapBufferDamage(node.GetDamageRegion(),
+            buffer->GetSurfaceBufferWidth(), buffer->GetSurfaceBufferHeight(), dstRect));
+    }
+    if (node.GetAnimationManager().HasTransition()) {
+        // the area covered by a transition can't be told from the geometry of the node
+        damageTracker_.AddFullDamage();
+    }
+    pendingDraws_.emplace_back(RsRenderServiceUtil::CreateBufferDrawParam(node));
+}
+
+void RSProcessor::DrawAndFlushDamage(SkCanvas& canvas, sptr<Surface> surface, BufferFlushConfig flushConfig)
+{
+    if (!surface || !buffer_) {
+        RS_LOGE("RSProcessor::DrawAndFlushDamage surface or buffer is nullptr");
+        pendingDraws_.clear();
+        return;
+    }
+    RectI redrawRect = damageTracker_.EndFrame(buffer_->GetSeqNum());
+    if (!redrawRect.IsEmpty()) {
+        SkRect clipRect = SkRect::MakeXYWH(redrawRect.left_, redrawRect.top_, redrawRect.width_,
+            redrawRect.height_);
+        canvas.save();
+        canvas.clipRect(clipRect);
+        canvas.clear(SK_ColorTRANSPARENT);
+        for (auto& params : pendingDraws_) {
+            if (params.clipRect.intersects(clipRect)) {
+                RsRenderServiceUtil::DrawBuffer(canvas, params);
+            }
+        }
+        canvas.restore();
+    }
+    pendingDraws_.clear();
+
+    const RectI& damage = damageTracker_.GetFrameDamage();
+    if (damage.IsEmpty()) {
+        // nothing changed since the last frame, the consumer doesn't need a new buffer
+        (void)surface->CancelBuffer(buffer_);
+        buffer_ = nullptr;
+        return;
+    }
+    flushConfig.damage = {
+        .x = damage.left_,
+        .y = damage.top_,
+        .w = damage.width_,
+        .h = damage.height_,
+    };
+    FlushBuffer(surface, flushConfig);
 }
 
 void RSProcessor::SetBufferTimeStamp()
@@ -150,5 +213,24 @@ bool RSProcessor::ConsumeAndUpdateBuffer(RSSurfaceRenderNode& node, SpecialTask&
 
     return true;
 }
+
+void RSProcessor::SkipSurface(RSSurfaceRenderNode& node)
+{
+    sptr<SurfaceBuffer> cbuffer;
+    SpecialTask task = [] () -> void {};
+    if (!ConsumeAndUpdateBuffer(node, task, cbuffer)) {
+        return;
+    }
+    const auto& preBuffer = node.GetPreBuffer();
+    if (preBuffer == nullptr || preBuffer == node.GetBuffer()) {
+        return;
+    }
+    const auto& consumer = node.GetConsumer();
+    if (consumer == nullptr) {
+        RS_LOGE("RSProcessor::SkipSurface(node: %lld): consumer is null!", node.GetId());
+        return;
+    }
+    (void)consumer->ReleaseBuffer(preBuffer, SyncFence::INVALID_FENCE);
+}
 } // namespace Rosen
 } // namespace OHOS
@@ -19,11 +19,15 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkMatrix.h"
 #include <surface.h>
+#include <vector>
 
 #include "hdi_output.h"
 #include "pipeline/rs_base_render_node.h"
 #include "pipeline/rs_display_render_node.h"
+#include "pipeline/rs_output_damage_tracker.h"
+#include "pipeline/rs_render_service_util.h"
 #include "pipeline/rs_surface_render_node.h"
+#include "screen_manager/rs_screen_manager.h"
 #include "screen_manager/screen_types.h"
 
 #include "platform/drawing/rs_surface_frame.h"
@@ -43,8 +47,14 @@ public:
     RSProcessor() {}
     virtual ~RSProcessor() {}
     virtual void ProcessSurface(RSSurfaceRenderNode &node) = 0;
+    // Init is called once when the processor is created for a screen, the processor is then reused across frames
+    // and PreProcess/PostProcess enclose the surfaces processed in every single frame.
     virtual void Init(ScreenId id, int32_t offsetX, int32_t offsetY) = 0;
+    virtual void PreProcess(const ScreenInfo& screenInfo, int32_t offsetX, int32_t offsetY) = 0;
     virtual void PostProcess() = 0;
+    // Consume the latest buffer of a surface which is not composed in this frame (e.g. occluded) and release the
+    // previous one, so that its producer doesn't run out of buffers.
+    void SkipSurface(RSSurfaceRenderNode& node);
 
 protected:
     SkCanvas* CreateCanvas(
@@ -56,6 +66,11 @@ protected:
     void FlushBuffer(sptr<Surface> surface, BufferFlushConfig flushConfig);
 
     bool ConsumeAndUpdateBuffer(RSSurfaceRenderNode& node, SpecialTask& task, sptr<SurfaceBuffer>& buffer);
+    // Software composition: surfaces are collected in ProcessSurface with AddSurfaceToRedraw, PostProcess then only
+    // redraws the damaged part of the output buffer and flushes it with the damage of the frame.
+    void BeginDamageFrame(int32_t width, int32_t height);
+    void AddSurfaceToRedraw(RSSurfaceRenderNode& node, bool hasNewBuffer);
+    void DrawAndFlushDamage(SkCanvas& canvas, sptr<Surface> surface, BufferFlushConfig flushConfig);
     void SetBufferTimeStamp();
     int32_t GetOffsetX();
     int32_t GetOffsetY();
@@ -67,6 +82,8 @@ protected:
     std::unique_ptr<RSSurfaceFrame> currFrame_;
 
 private:
+    RSOutputDamageTracker damageTracker_;
+    std::vector<BufferDrawParam> pendingDraws_;
     sptr<SurfaceBuffer> buffer_;
     int32_t releaseFence_ = -1;
 };
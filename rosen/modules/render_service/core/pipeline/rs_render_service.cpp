@@ -16,6 +16,7 @@
 #include "rs_render_service.h"
 #include "rs_main_thread.h"
 #include "rs_render_service_connection.h"
+#include "pipeline/rs_render_node_cache.h"
 #include "vsync_generator.h"
 
 #include <unordered_set>
@@ -110,6 +111,9 @@ int RSRenderService::Dump(int fd, const std::vector<std::u16string>& args)
     std::u16string arg3(u"fps");
     std::u16string arg4(u"nodeNotOnTree");
     std::u16string arg5(u"allSurfacesMem");
+    std::u16string arg6(u"nodeCache");
+    std::u16string arg7(u"occlusion");
+    std::u16string arg8(u"animation");
 
     for (decltype(args.size()) index = 0; index < args.size(); ++index) {
         argSets.insert(args[index]);
@@ -139,6 +143,21 @@ int RSRenderService::Dump(int fd, const std::vector<std::u16string>& args)
             mainThread_->GetContext().GetNodeMap().DumpAllNodeMemSize(dumpString);
         }).wait();
     }
+    if (args.size() == 0 || argSets.count(arg6) != 0) {
+        mainThread_->ScheduleTask([&dumpString]() {
+            RSRenderNodeCache::Instance().Dump(dumpString);
+        }).wait();
+    }
+    if (args.size() == 0 || argSets.count(arg7) != 0) {
+        mainThread_->ScheduleTask([this, &dumpString]() {
+            mainThread_->OcclusionDump(dumpString);
+        }).wait();
+    }
+    if (args.size() == 0 || argSets.count(arg8) != 0) {
+        mainThread_->ScheduleTask([this, &dumpString]() {
+            mainThread_->AnimationDump(dumpString);
+        }).wait();
+    }
     auto iter = argSets.find(arg3);
     if (iter != argSets.end()) {
         argSets.erase(iter);
@@ -15,9 +15,11 @@
 
 #include "rs_render_service_connection.h"
 
+#include "pipeline/rs_continuous_surface_capture.h"
 #include "pipeline/rs_render_node_map.h"
 #include "pipeline/rs_render_service_listener.h"
 #include "pipeline/rs_surface_capture_task.h"
+#include "pipeline/rs_surface_capture_thread.h"
 #include "pipeline/rs_surface_render_node.h"
 #include "platform/common/rs_log.h"
 #include "rs_main_thread.h"
@@ -76,6 +78,15 @@ void RSRenderServiceConnection::CleanRenderNodes() noexcept
     nodeMap.FilterNodeByPid(remotePid_);
 }
 
+void RSRenderServiceConnection::CleanContinuousSurfaceCaptures() noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto id : continuousCaptureIds_) {
+        mainThread_->RemoveContinuousSurfaceCapture(remotePid_, id);
+    }
+    continuousCaptureIds_.clear();
+}
+
 void RSRenderServiceConnection::CleanAll(bool toDelete) noexcept
 {
     {
@@ -88,6 +99,7 @@ void RSRenderServiceConnection::CleanAll(bool toDelete) noexcept
     mainThread_->ScheduleTask([this]() {
         CleanVirtualScreens();
         CleanRenderNodes();
+        CleanContinuousSurfaceCaptures();
     }).wait();
 
     for (auto& conn : vsyncConnections_) {
@@ -296,14 +308,54 @@ void RSRenderServiceConnection::TakeSurfaceCapture(NodeId id, sptr<RSISurfaceCap
     std::function<void()> captureTask = [scaleY, scaleX, callback, id]() -> void {
         RS_LOGD("RSRenderService::TakeSurfaceCapture callback->OnSurfaceCapture nodeId:[%llu]", id);
         ROSEN_TRACE_BEGIN(BYTRACE_TAG_GRAPHIC_AGP, "RSRenderService::TakeSurfaceCapture");
-        RSSurfaceCaptureTask task(id, scaleX, scaleY);
-        std::unique_ptr<Media::PixelMap> pixelmap = task.Run();
-        callback->OnSurfaceCapture(id, pixelmap.get());
+        auto task = std::make_shared<RSSurfaceCaptureTask>(id, scaleX, scaleY);
+        bool snapshotted = task->Snapshot();
         ROSEN_TRACE_END(BYTRACE_TAG_GRAPHIC_AGP);
+        if (!snapshotted) {
+            callback->OnSurfaceCapture(id, nullptr);
+            return;
+        }
+        // scaling into the pixelmap and the callback IPC don't hold up composition
+        RSSurfaceCaptureThread::Instance().PostTask([task, callback, id]() {
+            ROSEN_TRACE_BEGIN(BYTRACE_TAG_GRAPHIC_AGP, "RSRenderService::RenderSurfaceCapture");
+            std::unique_ptr<Media::PixelMap> pixelmap = task->Render();
+            callback->OnSurfaceCapture(id, pixelmap.get());
+            ROSEN_TRACE_END(BYTRACE_TAG_GRAPHIC_AGP);
+        });
     };
     mainThread_->PostTask(captureTask);
 }
 
+void RSRenderServiceConnection::StartContinuousSurfaceCapture(NodeId id, sptr<RSISurfaceCaptureCallback> callback,
+    float scaleX, float scaleY, uint32_t fps)
+{
+    if (callback == nullptr) {
+        RS_LOGE("RSRenderServiceConnection::StartContinuousSurfaceCapture callback is nullptr");
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        continuousCaptureIds_.insert(id);
+    }
+    auto capture = std::make_shared<RSContinuousSurfaceCapture>(id, callback, scaleX, scaleY, fps);
+    mainThread_->PostTask([mainThread = mainThread_, pid = remotePid_, id, capture]() {
+        mainThread->AddContinuousSurfaceCapture(pid, id, capture);
+    });
+}
+
+void RSRenderServiceConnection::StopContinuousSurfaceCapture(NodeId id)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (continuousCaptureIds_.erase(id) == 0) {
+            return;
+        }
+    }
+    mainThread_->PostTask([mainThread = mainThread_, pid = remotePid_, id]() {
+        mainThread->RemoveContinuousSurfaceCapture(pid, id);
+    });
+}
+
 void RSRenderServiceConnection::RegisterApplicationRenderThread(uint32_t pid, sptr<IApplicationRenderThread> app)
 {
     auto captureTask = [=]() -> void {
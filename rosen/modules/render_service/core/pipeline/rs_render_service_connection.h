@@ -48,6 +48,7 @@ public:
 private:
     void CleanVirtualScreens() noexcept;
     void CleanRenderNodes() noexcept;
+    void CleanContinuousSurfaceCaptures() noexcept;
     void CleanAll(bool toDelete = false) noexcept;
 
     // IPC RSIRenderServiceConnection Interfaces
@@ -80,6 +81,11 @@ private:
 
     void TakeSurfaceCapture(NodeId id, sptr<RSISurfaceCaptureCallback> callback, float scaleX, float scaleY) override;
 
+    void StartContinuousSurfaceCapture(NodeId id, sptr<RSISurfaceCaptureCallback> callback,
+        float scaleX, float scaleY, uint32_t fps) override;
+
+    void StopContinuousSurfaceCapture(NodeId id) override;
+
     void RegisterApplicationRenderThread(uint32_t pid, sptr<IApplicationRenderThread> app) override;
 
     void UnregisterApplicationRenderThread(sptr<IApplicationRenderThread> app);
@@ -156,6 +162,8 @@ private:
 
     // save all virtual screenIds created by this connection.
     std::unordered_set<ScreenId> virtualScreenIds_;
+    // nodes captured continuously for this connection.
+    std::unordered_set<NodeId> continuousCaptureIds_;
     sptr<RSIScreenChangeCallback> screenChangeCallback_;
     sptr<VSyncDistributor> appVSyncDistributor_;
     std::vector<sptr<VSyncConnection>> vsyncConnections_;
@@ -23,9 +23,10 @@
 #include "common/rs_obj_abs_geometry.h"
 #include "display_type.h"
 #include "pipeline/rs_base_render_node.h"
+#include "pipeline/rs_canvas_render_node.h"
 #include "pipeline/rs_display_render_node.h"
+#include "pipeline/rs_main_thread.h"
 #include "pipeline/rs_processor.h"
-#include "pipeline/rs_processor_factory.h"
 #include "pipeline/rs_surface_render_node.h"
 #include "platform/common/rs_log.h"
 #include "platform/drawing/rs_surface.h"
@@ -34,6 +35,52 @@
 
 namespace OHOS {
 namespace Rosen {
+namespace {
+// the coverage test of a single surface gives up (and keeps the surface) beyond this number of uncovered fragments
+constexpr size_t MAX_UNCOVERED_FRAGMENTS = 32;
+
+// append the parts of [rect] not covered by [cover] to [result], at most 4 rects
+void SubtractRect(const RectI& rect, const RectI& cover, std::vector<RectI>& result)
+{
+    RectI inter = rect.IntersectRect(cover);
+    if (inter.IsEmpty()) {
+        result.push_back(rect);
+        return;
+    }
+    if (inter.top_ > rect.top_) {
+        result.emplace_back(rect.left_, rect.top_, rect.width_, inter.top_ - rect.top_);
+    }
+    if (inter.GetBottom() < rect.GetBottom()) {
+        result.emplace_back(rect.left_, inter.GetBottom(), rect.width_, rect.GetBottom() - inter.GetBottom());
+    }
+    if (inter.left_ > rect.left_) {
+        result.emplace_back(rect.left_, inter.top_, inter.left_ - rect.left_, inter.height_);
+    }
+    if (inter.GetRight() < rect.GetRight()) {
+        result.emplace_back(inter.GetRight(), inter.top_, rect.GetRight() - inter.GetRight(), inter.height_);
+    }
+}
+
+bool IsCoveredBy(const RectI& rect, const std::vector<RectI>& occluders)
+{
+    std::vector<RectI> uncovered = { rect };
+    std::vector<RectI> remains;
+    for (const auto& occluder : occluders) {
+        remains.clear();
+        for (const auto& fragment : uncovered) {
+            SubtractRect(fragment, occluder, remains);
+        }
+        if (remains.empty()) {
+            return true;
+        }
+        if (remains.size() > MAX_UNCOVERED_FRAGMENTS) {
+            return false;
+        }
+        uncovered.swap(remains);
+    }
+    return false;
+}
+} // namespace
 
 RSRenderServiceVisitor::RSRenderServiceVisitor() {}
 
@@ -84,8 +131,8 @@ void RSRenderServiceVisitor::ProcessDisplayRenderNode(RSDisplayRenderNode& node)
         RS_LOGE("RSRenderServiceVisitor::ProcessDisplayRenderNode ScreenManager is nullptr");
         return;
     }
-    ScreenState state = screenManager->QueryScreenInfo(node.GetScreenId()).state;
-    switch (state) {
+    ScreenInfo screenInfo = screenManager->QueryScreenInfo(node.GetScreenId());
+    switch (screenInfo.state) {
         case ScreenState::PRODUCER_SURFACE_ENABLE:
             node.SetCompositeType(RSDisplayRenderNode::CompositeType::SOFTWARE_COMPOSITE);
             break;
@@ -97,12 +144,13 @@ void RSRenderServiceVisitor::ProcessDisplayRenderNode(RSDisplayRenderNode& node)
             RS_LOGE("RSRenderServiceVisitor::ProcessDisplayRenderNode State is unusual");
             return;
     }
-    processor_ = RSProcessorFactory::CreateProcessor(node.GetCompositeType());
+    processor_ = RSMainThread::Instance()->GetOrCreateProcessor(node.GetScreenId(), node.GetCompositeType(),
+        screenInfo, node.GetDisplayOffsetX(), node.GetDisplayOffsetY());
     if (processor_ == nullptr) {
         RS_LOGE("RSRenderServiceVisitor::ProcessDisplayRenderNode: RSProcessor is null!");
         return;
     }
-    processor_->Init(node.GetScreenId(), node.GetDisplayOffsetX(), node.GetDisplayOffsetY());
+    processor_->PreProcess(screenInfo, node.GetDisplayOffsetX(), node.GetDisplayOffsetY());
 
     if (node.IsMirrorDisplay()) {
         auto mirrorSource = node.GetMirrorSource();
@@ -111,8 +159,10 @@ void RSRenderServiceVisitor::ProcessDisplayRenderNode(RSDisplayRenderNode& node)
             RS_LOGI("RSRenderServiceVisitor::ProcessDisplayRenderNode mirrorSource haven't existed");
             return;
         }
+        RSMainThread::Instance()->UpdateOcclusionStats(node.GetScreenId(), CalcOcclusion(*existingSource));
         ProcessBaseRenderNode(*existingSource);
     } else {
+        RSMainThread::Instance()->UpdateOcclusionStats(node.GetScreenId(), CalcOcclusion(node));
         ProcessBaseRenderNode(node);
     }
     processor_->PostProcess();
@@ -174,11 +224,112 @@ void RSRenderServiceVisitor::ProcessSurfaceRenderNode(RSSurfaceRenderNode& node)
         return;
     }
     ProcessBaseRenderNode(node);
+    if (IsOccluded(node.GetId())) {
+        RS_LOGD("RSRenderServiceVisitor::ProcessSurfaceRenderNode node : %llu is occluded", node.GetId());
+        processor_->SkipSurface(node);
+        return;
+    }
     node.SetGlobalZOrder(globalZOrder_);
     globalZOrder_ = globalZOrder_ + 1;
     processor_->ProcessSurface(node);
 }
 
+void RSRenderServiceVisitor::CollectSurfaces(RSBaseRenderNode& node, const OcclusionInfo& parentInfo,
+    std::vector<OcclusionInfo>& surfaces)
+{
+    // same order as processing: children of a surface are composed below it
+    for (auto& child : node.GetSortedChildren()) {
+        if (!child) {
+            continue;
+        }
+        auto surfaceChild = child->ReinterpretCastTo<RSSurfaceRenderNode>();
+        if (!surfaceChild) {
+            if (!child->IsInstanceOf<RSCanvasRenderNode>()) {
+                CollectSurfaces(*child, parentInfo, surfaces);
+            }
+            continue;
+        }
+        if ((isSecurityDisplay_ && surfaceChild->GetSecurityLayer()) ||
+            !surfaceChild->GetRenderProperties().GetVisible()) {
+            continue;
+        }
+        // alpha and transition of a surface are applied to the surfaces below it in the tree too
+        OcclusionInfo info;
+        info.node = surfaceChild.get();
+        info.alpha = parentInfo.alpha * surfaceChild->GetAlpha() * surfaceChild->GetRenderProperties().GetAlpha();
+        info.hasTransition = parentInfo.hasTransition || surfaceChild->GetAnimationManager().HasTransition();
+        CollectSurfaces(*surfaceChild, info, surfaces);
+        surfaces.push_back(info);
+    }
+}
+
+bool RSRenderServiceVisitor::IsOpaqueSurface(const OcclusionInfo& info)
+{
+    if (!ROSEN_EQ(info.alpha, 1.0f) || info.hasTransition) {
+        return false;
+    }
+    auto& node = *info.node;
+    const Vector4f& clipRegion = node.GetClipRegion();
+    if (!RectI(clipRegion.x_, clipRegion.y_, clipRegion.z_, clipRegion.w_).IsEmpty()) {
+        return false;
+    }
+    auto geoPtr = std::static_pointer_cast<RSObjAbsGeometry>(node.GetRenderProperties().GetBoundsGeometry());
+    // a rotated surface covers less than its bounding rect
+    if (geoPtr == nullptr || !geoPtr->GetAbsMatrix().rectStaysRect()) {
+        return false;
+    }
+    const auto& buffer = node.GetBuffer();
+    if (buffer == nullptr) {
+        return false;
+    }
+    auto blendType = node.GetBlendType();
+    if (blendType == BLEND_NONE || blendType == BLEND_SRC) {
+        return true;
+    }
+    switch (buffer->GetFormat()) {
+        case PIXEL_FMT_RGBX_8888:
+        case PIXEL_FMT_BGRX_8888:
+        case PIXEL_FMT_RGB_565:
+        case PIXEL_FMT_RGB_888:
+        case PIXEL_FMT_YCBCR_420_SP:
+        case PIXEL_FMT_YCRCB_420_SP:
+            return true;
+        default:
+            return false;
+    }
+}
+
+uint32_t RSRenderServiceVisitor::CalcOcclusion(RSBaseRenderNode& rootNode)
+{
+    occludedSurfaces_.clear();
+    std::vector<OcclusionInfo> surfaces;
+    CollectSurfaces(rootNode, OcclusionInfo(), surfaces);
+
+    std::vector<RectI> occluders;
+    for (auto iter = surfaces.rbegin(); iter != surfaces.rend(); ++iter) {
+        auto& surface = *iter->node;
+        auto geoPtr = std::static_pointer_cast<RSObjAbsGeometry>(surface.GetRenderProperties().GetBoundsGeometry());
+        if (geoPtr == nullptr) {
+            continue;
+        }
+        const RectI& absRect = geoPtr->GetAbsRect();
+        // transitions move the surface in composition, it's not where its geometry says
+        if (!iter->hasTransition && !absRect.IsEmpty() && IsCoveredBy(absRect, occluders)) {
+            occludedSurfaces_.insert(surface.GetId());
+            continue;
+        }
+        if (IsOpaqueSurface(*iter) && !absRect.IsEmpty()) {
+            occluders.push_back(absRect);
+        }
+    }
+    return static_cast<uint32_t>(occludedSurfaces_.size());
+}
+
+bool RSRenderServiceVisitor::IsOccluded(NodeId id) const
+{
+    return occludedSurfaces_.count(id) != 0;
+}
+
 void RSRenderServiceVisitor::UpdateGeometry(RSBaseRenderNode& displayNode)
 {
     static const auto updateGeometryFunc = [&](const std::shared_ptr<RSBaseRenderNode>& child) {
@@ -17,6 +17,8 @@
 #define RENDER_SERVICE_CLIENT_CORE_RENDER_RS_RENDER_SERVICE_VISITOR_H
 
 #include <memory>
+#include <unordered_set>
+#include <vector>
 
 #include "include/core/SkCanvas.h"
 #include "pipeline/rs_processor.h"
@@ -44,10 +46,27 @@ public:
 
     void UpdateGeometry(RSBaseRenderNode &displayNode);
 
+    // Walk the surfaces under [rootNode] front to back and record the ones fully covered by opaque surfaces above
+    // them, these are skipped in composition. Returns the number of occluded surfaces.
+    uint32_t CalcOcclusion(RSBaseRenderNode& rootNode);
+    bool IsOccluded(NodeId id) const;
+
 private:
+    struct OcclusionInfo {
+        RSSurfaceRenderNode* node = nullptr;
+        // product of the alphas of the surface and its ancestor surfaces
+        float alpha = 1.0f;
+        // the surface or one of its ancestor surfaces is in a transition
+        bool hasTransition = false;
+    };
+    void CollectSurfaces(RSBaseRenderNode& node, const OcclusionInfo& parentInfo,
+        std::vector<OcclusionInfo>& surfaces);
+    static bool IsOpaqueSurface(const OcclusionInfo& info);
+
     float globalZOrder_ = 0.0f;
     bool isSecurityDisplay_ = false;
     std::shared_ptr<RSProcessor> processor_ = nullptr;
+    std::unordered_set<NodeId> occludedSurfaces_;
 };
 } // namespace Rosen
 } // namespace OHOS
@@ -35,18 +35,32 @@ void RSSoftwareProcessor::Init(ScreenId id, int32_t offsetX, int32_t offsetY)
 {
     offsetX_ = offsetX;
     offsetY_ = offsetY;
-    sptr<RSScreenManager> screenManager = CreateOrGetScreenManager();
-    if (screenManager == nullptr) {
+    screenId_ = id;
+    screenManager_ = CreateOrGetScreenManager();
+    if (screenManager_ == nullptr) {
         RS_LOGE("RSSoftwareProcessor::Init: failed to get screen manager!");
         return;
     }
+    currScreenInfo_ = screenManager_->QueryScreenInfo(id);
+}
 
-    producerSurface_ = screenManager->GetProducerSurface(id);
+void RSSoftwareProcessor::PreProcess(const ScreenInfo& screenInfo, int32_t offsetX, int32_t offsetY)
+{
+    offsetX_ = offsetX;
+    offsetY_ = offsetY;
+    currScreenInfo_ = screenInfo;
+    canvas_ = nullptr;
+    if (screenManager_ == nullptr) {
+        RS_LOGE("RSSoftwareProcessor::PreProcess: screen manager is null!");
+        return;
+    }
+    // the surface of a virtual screen can be replaced at any time, so it is not kept from Init
+    producerSurface_ = screenManager_->GetProducerSurface(screenId_);
     if (producerSurface_ == nullptr) {
-        RS_LOGE("RSSoftwareProcessor::Init for Screen(id %{public}" PRIu64 "): ProducerSurface is null!", id);
+        RS_LOGE("RSSoftwareProcessor::PreProcess for Screen(id %{public}" PRIu64 "): ProducerSurface is null!",
+            screenId_);
         return;
     }
-    currScreenInfo_ = screenManager->QueryScreenInfo(id);
     BufferRequestConfig requestConfig = {
         .width = currScreenInfo_.width,
         .height = currScreenInfo_.height,
@@ -56,20 +70,19 @@ void RSSoftwareProcessor::Init(ScreenId id, int32_t offsetX, int32_t offsetY)
         .timeout = 0,
     };
     canvas_ = CreateCanvas(producerSurface_, requestConfig);
+    BeginDamageFrame(currScreenInfo_.width, currScreenInfo_.height);
 }
 
 void RSSoftwareProcessor::PostProcess()
 {
-    BufferFlushConfig flushConfig = {
-        .damage = {
-            .x = 0,
-            .y = 0,
-            .w = currScreenInfo_.width,
-            .h = currScreenInfo_.height,
-        },
-    };
+    if (!canvas_) {
+        RS_LOGE("RSSoftwareProcessor::PostProcess: Canvas is null!");
+        // give back the requested buffer, if any
+        FlushBuffer(producerSurface_, {});
+        return;
+    }
     SetBufferTimeStamp();
-    FlushBuffer(producerSurface_, flushConfig);
+    DrawAndFlushDamage(*canvas_, producerSurface_, {});
 }
 
 void RSSoftwareProcessor::ProcessSurface(RSSurfaceRenderNode& node)
@@ -86,6 +99,7 @@ void RSSoftwareProcessor::ProcessSurface(RSSurfaceRenderNode& node)
 
     OHOS::sptr<SurfaceBuffer> cbuffer;
     Rect damage;
+    bool hasNewBuffer = false;
     if (node.GetAvailableBufferCount() > 0) {
         sptr<SyncFence> acquireFence = SyncFence::INVALID_FENCE;
         int64_t timestamp = 0;
@@ -105,6 +119,8 @@ void RSSoftwareProcessor::ProcessSurface(RSSurfaceRenderNode& node)
 
         node.SetBuffer(cbuffer);
         node.SetFence(acquireFence);
+        node.SetDamageRegion(damage);
+        hasNewBuffer = true;
 
         if (node.ReduceAvailableBuffer() > 0) {
             if (auto mainThread = RSMainThread::Instance()) {
@@ -127,9 +143,7 @@ void RSSoftwareProcessor::ProcessSurface(RSSurfaceRenderNode& node)
     }
     node.SetDstRect({geoPtr->GetAbsRect().left_ - offsetX_, geoPtr->GetAbsRect().top_ - offsetY_,
         geoPtr->GetAbsRect().width_, geoPtr->GetAbsRect().height_});
-
-    auto params = RsRenderServiceUtil::CreateBufferDrawParam(node);
-    RsRenderServiceUtil::DrawBuffer(*canvas_, params);
+    AddSurfaceToRedraw(node, hasNewBuffer);
 }
 } // namespace Rosen
 } // namespace OHOS
@@ -28,9 +28,12 @@ public:
     ~RSSoftwareProcessor() override;
     void ProcessSurface(RSSurfaceRenderNode& node) override;
     void Init(ScreenId id, int32_t offsetX, int32_t offsetY) override;
+    void PreProcess(const ScreenInfo& screenInfo, int32_t offsetX, int32_t offsetY) override;
     void PostProcess() override;
 
 private:
+    sptr<RSScreenManager> screenManager_;
+    ScreenId screenId_ = INVALID_SCREEN_ID;
     sptr<Surface> producerSurface_;
     std::unique_ptr<SkCanvas> canvas_;
     ScreenInfo currScreenInfo_;
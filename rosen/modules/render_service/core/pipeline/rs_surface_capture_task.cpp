@@ -19,6 +19,7 @@
 
 #include "include/core/SkCanvas.h"
 #include "include/core/SkMatrix.h"
+#include "include/core/SkPictureRecorder.h"
 #include "include/core/SkRect.h"
 #include "pipeline/rs_base_render_node.h"
 #include "pipeline/rs_display_render_node.h"
@@ -35,79 +36,113 @@ namespace OHOS {
 namespace Rosen {
 std::unique_ptr<Media::PixelMap> RSSurfaceCaptureTask::Run()
 {
-    if (ROSEN_EQ(scaleX_, 0.f) || ROSEN_EQ(scaleY_, 0.f) || scaleX_ < 0.f || scaleY_ < 0.f) {
-        RS_LOGE("RSSurfaceCaptureTask::Run: SurfaceCapture scale is invalid.");
+    if (!Snapshot()) {
         return nullptr;
     }
+    return Render();
+}
+
+bool RSSurfaceCaptureTask::Snapshot()
+{
+    picture_ = nullptr;
+    if (ROSEN_EQ(scaleX_, 0.f) || ROSEN_EQ(scaleY_, 0.f) || scaleX_ < 0.f || scaleY_ < 0.f) {
+        RS_LOGE("RSSurfaceCaptureTask::Snapshot: SurfaceCapture scale is invalid.");
+        return false;
+    }
     auto node = RSMainThread::Instance()->GetContext().GetNodeMap().GetRenderNode(nodeId_);
     if (node == nullptr) {
-        RS_LOGE("RSSurfaceCaptureTask::Run: node is nullptr");
-        return nullptr;
+        RS_LOGE("RSSurfaceCaptureTask::Snapshot: node is nullptr");
+        return false;
     }
-    std::unique_ptr<Media::PixelMap> pixelmap;
+    bool sizeValid = false;
     std::shared_ptr<RSSurfaceCaptureVisitor> visitor = std::make_shared<RSSurfaceCaptureVisitor>();
     if (auto surfaceNode = node->ReinterpretCastTo<RSSurfaceRenderNode>()) {
-        RS_LOGI("RSSurfaceCaptureTask::Run: Into SURFACE_NODE SurfaceRenderNodeId:[%llu]", node->GetId());
-        pixelmap = CreatePixelMapBySurfaceNode(surfaceNode);
+        RS_LOGI("RSSurfaceCaptureTask::Snapshot: Into SURFACE_NODE SurfaceRenderNodeId:[%llu]", node->GetId());
+        sizeValid = GetPixelMapSizeBySurfaceNode(surfaceNode);
         visitor->IsDisplayNode(false);
     } else if (auto displayNode = node->ReinterpretCastTo<RSDisplayRenderNode>()) {
-        RS_LOGI("RSSurfaceCaptureTask::Run: Into DISPLAY_NODE DisplayRenderNodeId:[%llu]", node->GetId());
-        pixelmap = CreatePixelMapByDisplayNode(displayNode);
+        RS_LOGI("RSSurfaceCaptureTask::Snapshot: Into DISPLAY_NODE DisplayRenderNodeId:[%llu]", node->GetId());
+        sizeValid = GetPixelMapSizeByDisplayNode(displayNode);
         visitor->IsDisplayNode(true);
     } else {
-        RS_LOGE("RSSurfaceCaptureTask::Run: Invalid RSRenderNodeType!");
+        RS_LOGE("RSSurfaceCaptureTask::Snapshot: Invalid RSRenderNodeType!");
+        return false;
+    }
+    if (!sizeValid || pixelmapWidth_ <= 0 || pixelmapHeight_ <= 0) {
+        RS_LOGE("RSSurfaceCaptureTask::Snapshot: pixelmap size is invalid!");
+        return false;
+    }
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(pixelmapWidth_, pixelmapHeight_);
+    if (canvas == nullptr) {
+        RS_LOGE("RSSurfaceCaptureTask::Snapshot: canvas is nullptr!");
+        return false;
+    }
+    visitor->SetCanvas(canvas);
+    visitor->SetScale(scaleX_, scaleY_);
+    node->Process(visitor);
+    picture_ = recorder.finishRecordingAsPicture();
+    return picture_ != nullptr;
+}
+
+std::unique_ptr<Media::PixelMap> RSSurfaceCaptureTask::Render(std::unique_ptr<Media::PixelMap> pixelmap) const
+{
+    if (picture_ == nullptr) {
+        RS_LOGE("RSSurfaceCaptureTask::Render: no snapshot!");
         return nullptr;
     }
+    if (pixelmap == nullptr || pixelmap->GetWidth() != pixelmapWidth_ || pixelmap->GetHeight() != pixelmapHeight_) {
+        Media::InitializationOptions opts;
+        opts.size.width = pixelmapWidth_;
+        opts.size.height = pixelmapHeight_;
+        pixelmap = Media::PixelMap::Create(opts);
+    }
     if (pixelmap == nullptr) {
-        RS_LOGE("RSSurfaceCaptureTask::Run: pixelmap == nullptr!");
+        RS_LOGE("RSSurfaceCaptureTask::Render: pixelmap == nullptr!");
         return nullptr;
     }
     std::unique_ptr<SkCanvas> canvas = CreateCanvas(pixelmap);
     if (canvas == nullptr) {
-        RS_LOGE("RSSurfaceCaptureTask::Run: canvas is nullptr!");
+        RS_LOGE("RSSurfaceCaptureTask::Render: canvas is nullptr!");
         return nullptr;
     }
-    visitor->SetCanvas(std::move(canvas));
-    visitor->SetScale(scaleX_, scaleY_);
-    node->Process(visitor);
+    // a reused pixelmap still holds the previous capture
+    canvas->clear(SK_ColorTRANSPARENT);
+    canvas->drawPicture(picture_);
     return pixelmap;
 }
 
-std::unique_ptr<Media::PixelMap> RSSurfaceCaptureTask::CreatePixelMapBySurfaceNode(
-    std::shared_ptr<RSSurfaceRenderNode> node)
+bool RSSurfaceCaptureTask::GetPixelMapSizeBySurfaceNode(std::shared_ptr<RSSurfaceRenderNode> node)
 {
     if (node == nullptr) {
-        RS_LOGE("CreatePixelMapBySurfaceNode: node == nullptr");
-        return nullptr;
+        RS_LOGE("GetPixelMapSizeBySurfaceNode: node == nullptr");
+        return false;
     }
     if (node->GetBuffer() == nullptr) {
-        RS_LOGE("CreatePixelMapBySurfaceNode: node GetBuffer == nullptr");
-        return nullptr;
+        RS_LOGE("GetPixelMapSizeBySurfaceNode: node GetBuffer == nullptr");
+        return false;
     }
     int pixmapWidth = node->GetRenderProperties().GetBoundsWidth();
     int pixmapHeight = node->GetRenderProperties().GetBoundsHeight();
-    Media::InitializationOptions opts;
-    opts.size.width = ceil(pixmapWidth * scaleX_);
-    opts.size.height = ceil(pixmapHeight * scaleY_);
-    RS_LOGD("RSSurfaceCaptureTask::CreatePixelMapBySurfaceNode: origin pixelmap width is [%u], height is [%u], "\
+    pixelmapWidth_ = ceil(pixmapWidth * scaleX_);
+    pixelmapHeight_ = ceil(pixmapHeight * scaleY_);
+    RS_LOGD("RSSurfaceCaptureTask::GetPixelMapSizeBySurfaceNode: origin pixelmap width is [%u], height is [%u], "\
         "created pixelmap width is [%u], height is [%u], the scale is scaleY:[%f], scaleY:[%f]",
-        pixmapWidth, pixmapHeight, opts.size.width, opts.size.height, scaleX_, scaleY_);
-    return Media::PixelMap::Create(opts);
+        pixmapWidth, pixmapHeight, pixelmapWidth_, pixelmapHeight_, scaleX_, scaleY_);
+    return true;
 }
 
-std::unique_ptr<Media::PixelMap> RSSurfaceCaptureTask::CreatePixelMapByDisplayNode(
-    std::shared_ptr<RSDisplayRenderNode> node)
+bool RSSurfaceCaptureTask::GetPixelMapSizeByDisplayNode(std::shared_ptr<RSDisplayRenderNode> node)
 {
     if (node == nullptr) {
-        RS_LOGE("RSSurfaceCaptureTask::CreatePixelMapByDisplayNode: node is nullptr");
-        return nullptr;
+        RS_LOGE("RSSurfaceCaptureTask::GetPixelMapSizeByDisplayNode: node is nullptr");
+        return false;
     }
     uint64_t screenId = node->GetScreenId();
-    RSScreenModeInfo screenModeInfo;
     sptr<RSScreenManager> screenManager = CreateOrGetScreenManager();
     if (!screenManager) {
-        RS_LOGE("RSSurfaceCaptureTask::CreatePixelMapByDisplayNode: screenManager is nullptr!");
-        return nullptr;
+        RS_LOGE("RSSurfaceCaptureTask::GetPixelMapSizeByDisplayNode: screenManager is nullptr!");
+        return false;
     }
     auto screenInfo = screenManager->QueryScreenInfo(screenId);
     uint32_t pixmapWidth = screenInfo.width;
@@ -116,16 +151,15 @@ std::unique_ptr<Media::PixelMap> RSSurfaceCaptureTask::CreatePixelMapByDisplayNo
     if (rotation == ScreenRotation::ROTATION_90 || rotation == ScreenRotation::ROTATION_270) {
         std::swap(pixmapWidth, pixmapHeight);
     }
-    Media::InitializationOptions opts;
-    opts.size.width = ceil(pixmapWidth * scaleX_);
-    opts.size.height = ceil(pixmapHeight * scaleY_);
-    RS_LOGD("RSSurfaceCaptureTask::CreatePixelMapByDisplayNode: origin pixelmap width is [%u], height is [%u], "\
+    pixelmapWidth_ = ceil(pixmapWidth * scaleX_);
+    pixelmapHeight_ = ceil(pixmapHeight * scaleY_);
+    RS_LOGD("RSSurfaceCaptureTask::GetPixelMapSizeByDisplayNode: origin pixelmap width is [%u], height is [%u], "\
         "created pixelmap width is [%u], height is [%u], the scale is scaleY:[%f], scaleY:[%f]",
-        pixmapWidth, pixmapHeight, opts.size.width, opts.size.height, scaleX_, scaleY_);
-    return Media::PixelMap::Create(opts);
+        pixmapWidth, pixmapHeight, pixelmapWidth_, pixelmapHeight_, scaleX_, scaleY_);
+    return true;
 }
 
-std::unique_ptr<SkCanvas> RSSurfaceCaptureTask::CreateCanvas(const std::unique_ptr<Media::PixelMap>& pixelmap)
+std::unique_ptr<SkCanvas> RSSurfaceCaptureTask::CreateCanvas(const std::unique_ptr<Media::PixelMap>& pixelmap) const
 {
     if (pixelmap == nullptr) {
         RS_LOGE("RSSurfaceCaptureTask::CreateCanvas: pixelmap == nullptr");
@@ -141,13 +175,13 @@ std::unique_ptr<SkCanvas> RSSurfaceCaptureTask::CreateCanvas(const std::unique_p
     return SkCanvas::MakeRasterDirect(info, address, pixelmap->GetRowBytes());
 }
 
-void RSSurfaceCaptureTask::RSSurfaceCaptureVisitor::SetCanvas(std::unique_ptr<SkCanvas> canvas)
+void RSSurfaceCaptureTask::RSSurfaceCaptureVisitor::SetCanvas(SkCanvas* canvas)
 {
     if (canvas == nullptr) {
         RS_LOGE("RSSurfaceCaptureTask::RSSurfaceCaptureVisitor::SetCanvas: address == nullptr");
         return;
     }
-    canvas_ = std::move(canvas);
+    canvas_ = canvas;
 }
 
 void RSSurfaceCaptureTask::RSSurfaceCaptureVisitor::ProcessDisplayRenderNode(RSDisplayRenderNode &node)
@@ -195,6 +229,10 @@ void RSSurfaceCaptureTask::RSSurfaceCaptureVisitor::ProcessSurfaceRenderNode(RSS
             process RSSurfaceRenderNode(id:[%llu]) paused, because surfaceNode is the security layer.", node.GetId());
         return;
     }
+    if (canvas_ == nullptr) {
+        RS_LOGE("RSSurfaceCaptureTask::RSSurfaceCaptureVisitor::ProcessSurfaceRenderNode: canvas is nullptr!");
+        return;
+    }
     if (node.GetBuffer() == nullptr) {
         RS_LOGD("RSSurfaceCaptureTask::RSSurfaceCaptureVisitor::ProcessSurfaceRenderNode: node Buffer is nullptr!");
         return;
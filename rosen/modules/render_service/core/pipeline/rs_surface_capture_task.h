@@ -18,6 +18,7 @@
 
 #include "common/rs_common_def.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkPicture.h"
 #include "pipeline/rs_display_render_node.h"
 #include "pipeline/rs_surface_render_node.h"
 #include "pixel_map.h"
@@ -31,8 +32,17 @@ public:
         : nodeId_(nodeId), scaleX_(scaleX), scaleY_(scaleY) {}
     ~RSSurfaceCaptureTask() = default;
 
+    // Snapshot and Render in place, on the main thread.
     std::unique_ptr<Media::PixelMap> Run();
 
+    // Must run on the main thread: records how the node is drawn. The YUV and color gamut conversion of the surface
+    // buffers happens here and the converted pixels are copied into the recording, so the buffers can be released
+    // before the capture is rendered.
+    bool Snapshot();
+    // Can run on any thread once Snapshot succeeded: replays and scales the recording into [pixelmap], which is
+    // reused if it has the size of the capture, or into a new pixelmap otherwise.
+    std::unique_ptr<Media::PixelMap> Render(std::unique_ptr<Media::PixelMap> pixelmap = nullptr) const;
+
 private:
     class RSSurfaceCaptureVisitor : public RSNodeVisitor {
     public:
@@ -49,7 +59,7 @@ private:
 
         virtual void ProcessDisplayRenderNode(RSDisplayRenderNode &node) override;
         virtual void ProcessSurfaceRenderNode(RSSurfaceRenderNode &node) override;
-        void SetCanvas(std::unique_ptr<SkCanvas> canvas);
+        void SetCanvas(SkCanvas* canvas);
         void IsDisplayNode(bool isDisplayNode)
         {
             isDisplayNode_ = isDisplayNode;
@@ -62,25 +72,31 @@ private:
 
     private:
         void DrawSurface(RSSurfaceRenderNode &node);
-        std::unique_ptr<SkCanvas> canvas_ = nullptr;
+        SkCanvas* canvas_ = nullptr;
         bool isDisplayNode_ = false;
         float scaleX_ = 1.0f;
         float scaleY_ = 1.0f;
     };
 
-    std::unique_ptr<SkCanvas> CreateCanvas(const std::unique_ptr<Media::PixelMap>& pixelmap);
+    std::unique_ptr<SkCanvas> CreateCanvas(const std::unique_ptr<Media::PixelMap>& pixelmap) const;
 
-    std::unique_ptr<Media::PixelMap> CreatePixelMapBySurfaceNode(std::shared_ptr<RSSurfaceRenderNode> node);
+    bool GetPixelMapSizeBySurfaceNode(std::shared_ptr<RSSurfaceRenderNode> node);
 
-    std::unique_ptr<Media::PixelMap> CreatePixelMapByDisplayNode(std::shared_ptr<RSDisplayRenderNode> node);
+    bool GetPixelMapSizeByDisplayNode(std::shared_ptr<RSDisplayRenderNode> node);
 
     NodeId nodeId_;
 
     float scaleX_;
 
     float scaleY_;
+
+    int32_t pixelmapWidth_ = 0;
+
+    int32_t pixelmapHeight_ = 0;
+
+    sk_sp<SkPicture> picture_;
 };
 } // namespace Rosen
 } // namespace OHOS
 
-#endif // RS_SURFACE_CAPTURE_TASK
\ No newline at end of file
+#endif // RS_SURFACE_CAPTURE_TASK
\ No newline at end of file
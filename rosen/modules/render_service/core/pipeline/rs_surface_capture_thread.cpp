@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/rs_surface_capture_thread.h"
+
+#include "platform/common/rs_log.h"
+
+namespace OHOS {
+namespace Rosen {
+RSSurfaceCaptureThread& RSSurfaceCaptureThread::Instance()
+{
+    static RSSurfaceCaptureThread instance;
+    return instance;
+}
+
+RSSurfaceCaptureThread::RSSurfaceCaptureThread() : thread_(&RSSurfaceCaptureThread::ThreadLoop, this) {}
+
+RSSurfaceCaptureThread::~RSSurfaceCaptureThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    cond_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void RSSurfaceCaptureThread::PostTask(Task task)
+{
+    if (!task) {
+        RS_LOGE("RSSurfaceCaptureThread::PostTask: task is empty");
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push(std::move(task));
+    }
+    cond_.notify_one();
+}
+
+void RSSurfaceCaptureThread::ThreadLoop()
+{
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cond_.wait(lock, [this]() { return !running_ || !tasks_.empty(); });
+            if (!running_) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop();
+        }
+        task();
+    }
+}
+} // namespace Rosen
+} // namespace OHOS
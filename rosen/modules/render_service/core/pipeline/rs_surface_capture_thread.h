@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RS_SURFACE_CAPTURE_THREAD_H
+#define RS_SURFACE_CAPTURE_THREAD_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace OHOS {
+namespace Rosen {
+// Worker thread rendering surface captures, so that pixel conversion and scaling don't block the main thread.
+class RSSurfaceCaptureThread final {
+public:
+    using Task = std::function<void()>;
+
+    static RSSurfaceCaptureThread& Instance();
+
+    void PostTask(Task task);
+
+private:
+    RSSurfaceCaptureThread();
+    ~RSSurfaceCaptureThread();
+    RSSurfaceCaptureThread(const RSSurfaceCaptureThread&) = delete;
+    RSSurfaceCaptureThread(const RSSurfaceCaptureThread&&) = delete;
+    RSSurfaceCaptureThread& operator=(const RSSurfaceCaptureThread&) = delete;
+    RSSurfaceCaptureThread& operator=(const RSSurfaceCaptureThread&&) = delete;
+
+    void ThreadLoop();
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::queue<Task> tasks_;
+    bool running_ = true;
+    std::thread thread_;
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // RS_SURFACE_CAPTURE_THREAD_H
@@ -119,6 +119,7 @@ void RSScreenManager::ProcessScreenHotPlugEvents()
     mipiCheckInFirstHotPlugEvent_ = true;
     pendingHotPlugEvents_.clear();
     connectedIds_.clear();
+    PublishSnapshotLocked();
 }
 
 void RSScreenManager::ProcessScreenConnectedLocked(std::shared_ptr<HdiOutput> &output)
@@ -167,6 +168,7 @@ void RSScreenManager::ProcessScreenDisConnectedLocked(std::shared_ptr<HdiOutput>
             cb->OnScreenChanged(id, ScreenEvent::DISCONNECTED);
         }
         screens_.erase(id);
+        RSMainThread::Instance()->RemoveProcessor(id);
         HiLog::Info(LOG_LABEL, "%{public}s: Screen(id %{public}" PRIu64 ") disconnected.", __func__, id);
     }
 
@@ -200,6 +202,7 @@ void RSScreenManager::SetDefaultScreenId(ScreenId id)
 {
     std::lock_guard<std::mutex> lock(mutex_);
     defaultScreenId_ = id;
+    PublishSnapshotLocked();
 }
 
 void RSScreenManager::SetScreenMirror(ScreenId id, ScreenId toMirror)
@@ -353,12 +356,14 @@ ScreenId RSScreenManager::CreateVirtualScreen(
     configs.flags = flags;
 
     screens_[newId] = std::make_unique<RSScreen>(configs);
+    PublishSnapshotLocked();
     HiLog::Debug(LOG_LABEL, "%{public}s: create virtual screen(id %{public}" PRIu64 ").\n", __func__, newId);
     return newId;
 }
 
 int32_t RSScreenManager::SetVirtualScreenSurface(ScreenId id, sptr<Surface> surface)
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     uint64_t surfaceId = surface->GetUniqueId();
     for (auto &[screenId, screen] : screens_) {
         if (!screen->IsVirtual() || screenId == id) {
@@ -374,6 +379,7 @@ int32_t RSScreenManager::SetVirtualScreenSurface(ScreenId id, sptr<Surface> surf
         }
     }
     screens_.at(id)->SetProducerSurface(surface);
+    PublishSnapshotLocked();
     HiLog::Debug(LOG_LABEL, "%{public}s:  set virtual screen surface success! \n", __func__);
     return SUCCESS;
 }
@@ -393,6 +399,9 @@ void RSScreenManager::RemoveVirtualScreenLocked(ScreenId id)
     }
 
     screens_.erase(id);
+    RSMainThread::Instance()->PostTask([id]() {
+        RSMainThread::Instance()->RemoveProcessor(id);
+    });
 
     // Update other screens' mirrorId.
     for (auto &[id, screen] : screens_) {
@@ -403,6 +412,7 @@ void RSScreenManager::RemoveVirtualScreenLocked(ScreenId id)
     HiLog::Debug(LOG_LABEL, "%{public}s: remove virtual screen(id %{public}" PRIu64 ").\n", __func__, id);
 
     ReuseVirtualScreenIdLocked(id);
+    PublishSnapshotLocked();
 }
 
 void RSScreenManager::SetScreenActiveMode(ScreenId id, uint32_t modeId)
@@ -414,6 +424,7 @@ void RSScreenManager::SetScreenActiveMode(ScreenId id, uint32_t modeId)
         return;
     }
     screens_.at(id)->SetActiveMode(modeId);
+    PublishSnapshotLocked();
 }
 
 void RSScreenManager::SetScreenPowerStatus(ScreenId id, ScreenPowerStatus status)
@@ -425,6 +436,7 @@ void RSScreenManager::SetScreenPowerStatus(ScreenId id, ScreenPowerStatus status
         return;
     }
     screens_.at(id)->SetPowerStatus(static_cast<uint32_t>(status));
+    PublishSnapshotLocked();
 
     /*
      * If app adds the first frame when power on the screen, delete the code
@@ -441,9 +453,17 @@ void RSScreenManager::SetScreenPowerStatus(ScreenId id, ScreenPowerStatus status
 
 void RSScreenManager::GetScreenActiveMode(ScreenId id, RSScreenModeInfo& screenModeInfo) const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    GetScreenActiveModeLocked(id, screenModeInfo);
+    auto snapshot = GetSnapshot();
+    auto screen = FindScreen(*snapshot, id);
+    if (screen == nullptr) {
+        HiLog::Error(LOG_LABEL, "%{public}s: There is no screen for id %{public}" PRIu64 ".", __func__, id);
+        return;
+    }
+    if (!screen->hasActiveMode) {
+        HiLog::Error(LOG_LABEL, "%{public}s: Failed to get active mode for screen %{public}" PRIu64 ".", __func__, id);
+        return;
+    }
+    screenModeInfo = screen->activeMode;
 }
 
 std::vector<RSScreenModeInfo> RSScreenManager::GetScreenSupportedModes(ScreenId id) const
@@ -462,9 +482,13 @@ RSScreenCapability RSScreenManager::GetScreenCapability(ScreenId id) const
 
 ScreenPowerStatus RSScreenManager::GetScreenPowerStatus(ScreenId id) const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    return GetScreenPowerStatuslocked(id);
+    auto snapshot = GetSnapshot();
+    auto screen = FindScreen(*snapshot, id);
+    if (screen == nullptr) {
+        HiLog::Error(LOG_LABEL, "%{public}s: There is no screen for id %{public}" PRIu64 ".\n", __func__, id);
+        return INVALID_POWER_STATUS;
+    }
+    return screen->powerStatus;
 }
 
 RSScreenData RSScreenManager::GetScreenData(ScreenId id) const
@@ -516,46 +540,69 @@ void RSScreenManager::SetScreenBacklight(ScreenId id, uint32_t level)
 
 ScreenInfo RSScreenManager::QueryScreenInfo(ScreenId id) const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    ScreenInfo info;
-    if (screens_.count(id) == 0) {
+    auto snapshot = GetSnapshot();
+    auto screen = FindScreen(*snapshot, id);
+    if (screen == nullptr) {
         HiLog::Error(LOG_LABEL, "%{public}s: There is no screen for id %{public}" PRIu64 ".", __func__, id);
-        return info;
+        return ScreenInfo();
     }
-
-    const auto &screen = screens_.at(id);
-
-    info.width = screen->Width();
-    info.height = screen->Height();
-    (void)screen->GetScreenColorGamut(info.colorGamut);
-
-    if (!screen->IsEnable()) {
-        info.state = ScreenState::DISABLED;
-    } else if (!screen->IsVirtual()) {
-        info.state = ScreenState::HDI_OUTPUT_ENABLE;
-    } else {
-        info.state = ScreenState::PRODUCER_SURFACE_ENABLE;
-    }
-    info.rotationMatrix = screen->GetRotationMatrix();
-
-    return info;
+    return screen->info;
 }
 
 sptr<Surface> RSScreenManager::GetProducerSurface(ScreenId id) const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    // assert screens_.count(id) == 1
-    return screens_.at(id)->GetProducerSurface();
+    auto snapshot = GetSnapshot();
+    auto screen = FindScreen(*snapshot, id);
+    return screen != nullptr ? screen->producerSurface : nullptr;
 }
 
 std::shared_ptr<HdiOutput> RSScreenManager::GetOutput(ScreenId id) const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    auto snapshot = GetSnapshot();
+    auto screen = FindScreen(*snapshot, id);
+    return screen != nullptr ? screen->output : nullptr;
+}
 
-    // assert screens_.count(id) == 1
-    return screens_.at(id)->GetOutput();
+const RSScreenManager::ScreenSnapshot::Screen* RSScreenManager::FindScreen(const ScreenSnapshot& snapshot, ScreenId id)
+{
+    auto iter = snapshot.screens.find(id);
+    return iter != snapshot.screens.end() ? &iter->second : nullptr;
+}
+
+void RSScreenManager::PublishSnapshotLocked()
+{
+    auto snapshot = std::make_shared<ScreenSnapshot>();
+    snapshot->defaultScreenId = defaultScreenId_;
+    for (const auto &[id, screen] : screens_) {
+        auto &entry = snapshot->screens[id];
+        entry.info.width = screen->Width();
+        entry.info.height = screen->Height();
+        (void)screen->GetScreenColorGamut(entry.info.colorGamut);
+        if (!screen->IsEnable()) {
+            entry.info.state = ScreenState::DISABLED;
+        } else if (!screen->IsVirtual()) {
+            entry.info.state = ScreenState::HDI_OUTPUT_ENABLE;
+        } else {
+            entry.info.state = ScreenState::PRODUCER_SURFACE_ENABLE;
+        }
+        entry.info.rotationMatrix = screen->GetRotationMatrix();
+        entry.rotation = screen->GetRotation();
+        entry.producerSurface = screen->GetProducerSurface();
+        entry.output = screen->GetOutput();
+        // virtual screens have neither modes nor power status
+        if (!screen->IsVirtual()) {
+            auto modeInfo = screen->GetActiveMode();
+            if (modeInfo) {
+                entry.hasActiveMode = true;
+                entry.activeMode.SetScreenWidth(modeInfo->width);
+                entry.activeMode.SetScreenHeight(modeInfo->height);
+                entry.activeMode.SetScreenRefreshRate(modeInfo->freshRate);
+                entry.activeMode.SetScreenModeId(screen->GetActiveModePosByModeId(modeInfo->id));
+            }
+            entry.powerStatus = GetScreenPowerStatuslocked(id);
+        }
+    }
+    std::atomic_store(&snapshot_, std::shared_ptr<const ScreenSnapshot>(std::move(snapshot)));
 }
 
 int32_t RSScreenManager::AddScreenChangeCallback(const sptr<RSIScreenChangeCallback> &callback)
@@ -672,16 +719,6 @@ bool RSScreenManager::RequestRotationLocked(ScreenId id, ScreenRotation rotation
     return iter->second->SetRotation(rotation);
 }
 
-ScreenRotation RSScreenManager::GetRotationLocked(ScreenId id) const
-{
-    auto iter = screens_.find(id);
-    if (iter == screens_.end()) {
-        HiLog::Error(LOG_LABEL, "%{public}s: There is no screen for id %{public}" PRIu64 ".\n", __func__, id);
-        return ScreenRotation::INVALID_SCREEN_ROTATION;
-    }
-    return iter->second->GetRotation();
-}
-
 int32_t RSScreenManager::GetScreenHDRCapabilityLocked(ScreenId id, RSScreenHDRCapability& screenHdrCapability) const
 {
     if (screens_.count(id) == 0) {
@@ -728,7 +765,9 @@ int32_t RSScreenManager::GetScreenColorGamut(ScreenId id, ScreenColorGamut &mode
 int32_t RSScreenManager::SetScreenColorGamut(ScreenId id, int32_t modeIdx)
 {
     std::lock_guard<std::mutex> lock(mutex_);
-    return SetScreenColorGamutLocked(id, modeIdx);
+    int32_t ret = SetScreenColorGamutLocked(id, modeIdx);
+    PublishSnapshotLocked();
+    return ret;
 }
 
 int32_t RSScreenManager::SetScreenGamutMap(ScreenId id, ScreenGamutMap mode)
@@ -746,13 +785,20 @@ int32_t RSScreenManager::GetScreenGamutMap(ScreenId id, ScreenGamutMap &mode) co
 bool RSScreenManager::RequestRotation(ScreenId id, ScreenRotation rotation)
 {
     std::lock_guard<std::mutex> lock(mutex_);
-    return RequestRotationLocked(id, rotation);
+    bool ret = RequestRotationLocked(id, rotation);
+    PublishSnapshotLocked();
+    return ret;
 }
 
 ScreenRotation RSScreenManager::GetRotation(ScreenId id) const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return GetRotationLocked(id);
+    auto snapshot = GetSnapshot();
+    auto screen = FindScreen(*snapshot, id);
+    if (screen == nullptr) {
+        HiLog::Error(LOG_LABEL, "%{public}s: There is no screen for id %{public}" PRIu64 ".\n", __func__, id);
+        return ScreenRotation::INVALID_SCREEN_ROTATION;
+    }
+    return screen->rotation;
 }
 
 int32_t RSScreenManager::GetScreenHDRCapability(ScreenId id, RSScreenHDRCapability& screenHdrCapability) const
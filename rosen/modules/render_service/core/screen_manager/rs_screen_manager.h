@@ -16,6 +16,7 @@
 #ifndef RS_SCREEN_MANAGER
 #define RS_SCREEN_MANAGER
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <mutex>
@@ -157,7 +158,7 @@ public:
 
     ScreenId GetDefaultScreenId() const override
     {
-        return defaultScreenId_;
+        return GetSnapshot()->defaultScreenId;
     }
 
     void SetDefaultScreenId(ScreenId id) override;
@@ -236,6 +237,30 @@ private:
     // [PLANNING]: fixme -- domain 0 only for debug.
     static constexpr HiviewDFX::HiLogLabel LOG_LABEL = { LOG_CORE, 0, "RSScreenManager" };
 
+    // State of the screens read every frame and by binder queries. Readers take the current snapshot without
+    // locking mutex_, writers change screens_ under mutex_ and then publish a new snapshot.
+    struct ScreenSnapshot {
+        struct Screen {
+            ScreenInfo info;
+            bool hasActiveMode = false;
+            RSScreenModeInfo activeMode;
+            ScreenPowerStatus powerStatus = INVALID_POWER_STATUS;
+            ScreenRotation rotation = ScreenRotation::INVALID_SCREEN_ROTATION;
+            sptr<Surface> producerSurface;
+            std::shared_ptr<HdiOutput> output;
+        };
+        ScreenId defaultScreenId = INVALID_SCREEN_ID;
+        std::unordered_map<ScreenId, Screen> screens;
+    };
+
+    std::shared_ptr<const ScreenSnapshot> GetSnapshot() const
+    {
+        return std::atomic_load(&snapshot_);
+    }
+    // the snapshot screen of [id], nullptr if there is none
+    static const ScreenSnapshot::Screen* FindScreen(const ScreenSnapshot& snapshot, ScreenId id);
+    void PublishSnapshotLocked();
+
     static void OnHotPlug(std::shared_ptr<HdiOutput> &output, bool connected, void *data);
     void OnHotPlugEvent(std::shared_ptr<HdiOutput> &output, bool connected);
     void ProcessScreenConnectedLocked(std::shared_ptr<HdiOutput> &output);
@@ -259,7 +284,6 @@ private:
     int32_t SetScreenGamutMapLocked(ScreenId id, ScreenGamutMap mode);
     int32_t GetScreenGamutMapLocked(ScreenId id, ScreenGamutMap& mode) const;
     bool RequestRotationLocked(ScreenId id, ScreenRotation rotation);
-    ScreenRotation GetRotationLocked(ScreenId id) const;
     int32_t GetScreenHDRCapabilityLocked(ScreenId id, RSScreenHDRCapability& screenHdrCapability) const;
     int32_t GetScreenTypeLocked(ScreenId id, RSScreenType& type) const;
 
@@ -272,6 +296,7 @@ private:
     std::vector<sptr<RSIScreenChangeCallback>> screenChangeCallbacks_;
     bool mipiCheckInFirstHotPlugEvent_ = false;
     std::vector<ScreenId> connectedIds_;
+    std::shared_ptr<const ScreenSnapshot> snapshot_ = std::make_shared<ScreenSnapshot>();
 
     static std::once_flag createFlag_;
     static sptr<OHOS::Rosen::RSScreenManager> instance_;
@@ -15,6 +15,9 @@
 
 #include "screen_manager_test.h"
 
+#include <atomic>
+#include <thread>
+
 namespace OHOS {
 namespace Rosen {
 using namespace HiviewDFX;
@@ -50,6 +53,46 @@ HWTEST_F(RSScreenManagerTest, CreateVirtualScreen, testing::ext::TestSize.Level1
     screenManager->RemoveVirtualScreen(virtualScreenId);
 }
 
+HWTEST_F(RSScreenManagerTest, QueryVirtualScreenInfo, testing::ext::TestSize.Level1)
+{
+    ScreenId virtualScreenId = screenManager->CreateVirtualScreen("testVirtualScreen", 100, 200, pSurface, 0, 0);
+    ASSERT_NE(virtualScreenId,  OHOS::Rosen::INVALID_SCREEN_ID);
+    ScreenInfo info = screenManager->QueryScreenInfo(virtualScreenId);
+    ASSERT_EQ(info.width, 100u);
+    ASSERT_EQ(info.height, 200u);
+    ASSERT_EQ(info.state, ScreenState::PRODUCER_SURFACE_ENABLE);
+    ASSERT_EQ(screenManager->GetProducerSurface(virtualScreenId), pSurface);
+    screenManager->RemoveVirtualScreen(virtualScreenId);
+    ASSERT_EQ(screenManager->QueryScreenInfo(virtualScreenId).state, ScreenState::UNKNOWN);
+    ASSERT_EQ(screenManager->GetProducerSurface(virtualScreenId), nullptr);
+    ASSERT_EQ(screenManager->GetOutput(virtualScreenId), nullptr);
+}
+
+HWTEST_F(RSScreenManagerTest, ConcurrentQueryScreenInfo, testing::ext::TestSize.Level1)
+{
+    constexpr int loopCount = 200;
+    ScreenId defaultScreenId = screenManager->GetDefaultScreenId();
+    ScreenInfo defaultInfo = screenManager->QueryScreenInfo(defaultScreenId);
+    std::atomic<bool> done = false;
+    std::atomic<int> mismatchCount = 0;
+    std::thread reader([&]() {
+        while (!done) {
+            ScreenInfo info = screenManager->QueryScreenInfo(defaultScreenId);
+            if (info.width != defaultInfo.width || info.height != defaultInfo.height) {
+                mismatchCount++;
+            }
+        }
+    });
+    for (int i = 0; i < loopCount; i++) {
+        ScreenId virtualScreenId = screenManager->CreateVirtualScreen("testVirtualScreen", 100, 100, nullptr, 0, 0);
+        EXPECT_NE(virtualScreenId,  OHOS::Rosen::INVALID_SCREEN_ID);
+        screenManager->RemoveVirtualScreen(virtualScreenId);
+    }
+    done = true;
+    reader.join();
+    ASSERT_EQ(mismatchCount, 0);
+}
+
 HWTEST_F(RSScreenManagerTest, GetScreenActiveMode, testing::ext::TestSize.Level1)
 {
     RSScreenModeInfo screenModeInfo0;
@@ -159,6 +159,35 @@ int RSRenderServiceConnectionStub::OnRemoteRequest(
             TakeSurfaceCapture(id, cb, scaleX, scaleY);
             break;
         }
+        case START_CONTINUOUS_SURFACE_CAPTURE: {
+            auto token = data.ReadInterfaceToken();
+            if (token != RSIRenderServiceConnection::GetDescriptor()) {
+                ret = ERR_INVALID_STATE;
+                break;
+            }
+            NodeId id = data.ReadUint64();
+            auto remoteObject = data.ReadRemoteObject();
+            if (remoteObject == nullptr) {
+                ret = ERR_NULL_OBJECT;
+                break;
+            }
+            sptr<RSISurfaceCaptureCallback> cb = iface_cast<RSISurfaceCaptureCallback>(remoteObject);
+            float scaleX = data.ReadFloat();
+            float scaleY = data.ReadFloat();
+            uint32_t fps = data.ReadUint32();
+            StartContinuousSurfaceCapture(id, cb, scaleX, scaleY, fps);
+            break;
+        }
+        case STOP_CONTINUOUS_SURFACE_CAPTURE: {
+            auto token = data.ReadInterfaceToken();
+            if (token != RSIRenderServiceConnection::GetDescriptor()) {
+                ret = ERR_INVALID_STATE;
+                break;
+            }
+            NodeId id = data.ReadUint64();
+            StopContinuousSurfaceCapture(id);
+            break;
+        }
         case REGISTER_APPLICATION_RENDER_THREAD: {
             uint32_t pid = data.ReadUint32();
             auto remoteObject = data.ReadRemoteObject();
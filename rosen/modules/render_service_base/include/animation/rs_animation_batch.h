@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RENDER_SERVICE_CLIENT_CORE_ANIMATION_RS_ANIMATION_BATCH_H
+#define RENDER_SERVICE_CLIENT_CORE_ANIMATION_RS_ANIMATION_BATCH_H
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "common/rs_common_def.h"
+#include "common/rs_vector2.h"
+#include "common/rs_vector4.h"
+
+namespace OHOS {
+namespace Rosen {
+class RSInterpolator;
+class RSRenderAnimation;
+
+// Evaluates the running curve animations of a frame together instead of one by one. Animations are grouped by
+// interpolator kind and value type, their fractions and start/end values are kept in contiguous arrays (one array
+// per value component) so that interpolation and value estimation run as flat loops, and the results are written
+// back to the animated properties in a single pass.
+// Only float, Vector2f and Vector4f values are batched, Add returns false for every other value type and the
+// animation has to be evaluated directly.
+// The finish callbacks of animations which finished in the step are collected as well, so that a batch filled on a
+// worker thread leaves the sending of messages to the thread owning the message processor.
+class RSAnimationBatch {
+public:
+    RSAnimationBatch() = default;
+    ~RSAnimationBatch() = default;
+
+    bool Add(RSRenderAnimation* animation, const RSInterpolator* interpolator, float fraction, float startValue,
+        float endValue);
+    bool Add(RSRenderAnimation* animation, const RSInterpolator* interpolator, float fraction,
+        const Vector2f& startValue, const Vector2f& endValue);
+    bool Add(RSRenderAnimation* animation, const RSInterpolator* interpolator, float fraction,
+        const Vector4f& startValue, const Vector4f& endValue);
+    template<typename T>
+    bool Add(RSRenderAnimation* animation, const RSInterpolator* interpolator, float fraction, const T& startValue,
+        const T& endValue)
+    {
+        return false;
+    }
+
+    // evaluate all queued animations and write the values back, the batch is empty afterwards. Queued animations
+    // and their targets must stay alive until then.
+    void Evaluate();
+    void Clear();
+
+    void AddFinishCallback(NodeId targetId, AnimationId animationId);
+    // send the collected finish callbacks in the order the animations finished
+    void SendFinishCallbacks();
+
+    bool IsEmpty() const
+    {
+        return size_ == 0;
+    }
+
+    size_t GetSize() const
+    {
+        return size_;
+    }
+
+    // convert batch results back to the animated value type
+    static void FromComponents(const float* components, float& value)
+    {
+        value = components[0];
+    }
+    static void FromComponents(const float* components, Vector2f& value)
+    {
+        value = Vector2f(components[0], components[1]);
+    }
+    static void FromComponents(const float* components, Vector4f& value)
+    {
+        value = Vector4f(components[0], components[1], components[2], components[3]);
+    }
+    template<typename T>
+    static void FromComponents(const float* components, T& value)
+    {}
+
+private:
+    template<size_t N>
+    struct Group {
+        std::vector<RSRenderAnimation*> animations;
+        std::vector<const RSInterpolator*> interpolators;
+        std::vector<float> fractions;
+        std::array<std::vector<float>, N> startValues;
+        std::array<std::vector<float>, N> endValues;
+
+        void Add(RSRenderAnimation* animation, const RSInterpolator* interpolator, float fraction,
+            const float* startValue, const float* endValue);
+        void Evaluate(bool isLinear);
+        void Clear();
+    };
+
+    // one group per interpolator type for each value type
+    static constexpr size_t INTERPOLATOR_TYPE_COUNT = 4;
+    template<size_t N>
+    using GroupSet = std::array<Group<N>, INTERPOLATOR_TYPE_COUNT>;
+
+    template<size_t N>
+    bool AddToGroup(GroupSet<N>& groups, RSRenderAnimation* animation, const RSInterpolator* interpolator,
+        float fraction, const float* startValue, const float* endValue);
+    template<size_t N>
+    static void EvaluateGroups(GroupSet<N>& groups);
+
+    GroupSet<1> floatGroups_;
+    GroupSet<2> vector2fGroups_;
+    GroupSet<4> vector4fGroups_;
+    size_t size_ = 0;
+    std::vector<std::pair<NodeId, AnimationId>> finishCallbacks_;
+};
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // RENDER_SERVICE_CLIENT_CORE_ANIMATION_RS_ANIMATION_BATCH_H
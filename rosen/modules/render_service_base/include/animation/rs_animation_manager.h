@@ -16,6 +16,7 @@
 #ifndef RENDER_SERVICE_CLIENT_CORE_ANIMATION_RS_ANIMATION_MANAGER_H
 #define RENDER_SERVICE_CLIENT_CORE_ANIMATION_RS_ANIMATION_MANAGER_H
 
+#include <functional>
 #include <list>
 #include <memory>
 #include <unordered_map>
@@ -25,6 +26,7 @@
 
 namespace OHOS {
 namespace Rosen {
+class RSAnimationBatch;
 class RSDirtyRegionManager;
 class RSPaintFilterCanvas;
 class RSProperties;
@@ -43,16 +45,24 @@ public:
     const std::shared_ptr<RSRenderAnimation> GetAnimation(AnimationId id) const;
 
     bool Animate(int64_t time);
+    // running curve animations are queued into [batch] instead of being evaluated directly and finish callbacks are
+    // collected in it, the caller has to call RSAnimationBatch::Evaluate before the animated properties are used and
+    // RSAnimationBatch::SendFinishCallbacks afterwards
+    bool Animate(int64_t time, RSAnimationBatch& batch);
 
     void RegisterTransition(AnimationId id, const TransitionCallback& transition);
     void UnregisterTransition(AnimationId id);
     std::unique_ptr<RSTransitionProperties> GetTransitionProperties();
     bool HasTransition() const;
 
+    // notify the client of [animationId] that the animation finished
+    static void SendFinishCallback(NodeId targetId, AnimationId animationId);
+
 private:
+    bool AnimateInner(int64_t time, RSAnimationBatch* batch);
     void OnAnimationRemove(const std::shared_ptr<RSRenderAnimation>& animation);
     void OnAnimationAdd(const std::shared_ptr<RSRenderAnimation>& animation);
-    void OnAnimationFinished(const std::shared_ptr<RSRenderAnimation>& animation);
+    void OnAnimationFinished(const std::shared_ptr<RSRenderAnimation>& animation, RSAnimationBatch* batch);
     void ClearTransition(AnimationId id);
 
     std::unordered_map<AnimationId, std::shared_ptr<RSRenderAnimation>> animations_;
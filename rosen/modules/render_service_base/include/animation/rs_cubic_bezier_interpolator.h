@@ -32,6 +32,11 @@ public:
     {
         return GetCubicBezierValue(SEARCH_STEP * BinarySearch(input), controlly1_, controlly2_);
     }
+
+    InterpolatorType GetType() const override
+    {
+        return InterpolatorType::CUBIC_BEZIER;
+    }
 #ifdef ROSEN_OHOS
     bool Marshalling(Parcel& parcel) const override
     {
@@ -52,6 +52,7 @@ public:
 #endif
 
     virtual float Interpolate(float input) const = 0;
+    virtual InterpolatorType GetType() const = 0;
 };
 
 class LinearInterpolator : public RSInterpolator {
@@ -73,6 +74,11 @@ public:
     {
         return input;
     }
+
+    InterpolatorType GetType() const override
+    {
+        return InterpolatorType::LINEAR;
+    }
 };
 
 class RSCustomInterpolator : public RSInterpolator {
@@ -82,6 +88,11 @@ public:
 
     float Interpolate(float input) const override;
 
+    InterpolatorType GetType() const override
+    {
+        return InterpolatorType::CUSTOM;
+    }
+
 #ifdef ROSEN_OHOS
     bool Marshalling(Parcel& parcel) const override
     {
@@ -97,9 +108,12 @@ public:
 private:
     RSCustomInterpolator(const std::vector<float>&& times, const std::vector<float>&& values);
     void Convert(int duration);
+    // whether times_ are evenly spaced over [0, 1], Interpolate then finds the sample by index instead of searching
+    void CheckUniformTimes();
 
     std::vector<float> times_;
     std::vector<float> values_;
+    bool isUniform_ { false };
     std::function<float(float)> interpolateFunc_;
 };
 } // namespace Rosen
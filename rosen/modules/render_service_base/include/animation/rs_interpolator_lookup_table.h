@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RENDER_SERVICE_CLIENT_CORE_ANIMATION_RS_INTERPOLATOR_LOOKUP_TABLE_H
+#define RENDER_SERVICE_CLIENT_CORE_ANIMATION_RS_INTERPOLATOR_LOOKUP_TABLE_H
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace OHOS {
+namespace Rosen {
+// Samples of an interpolator curve taken at a fixed resolution over [0, 1], evaluated by linear interpolation
+// between the two nearest samples. Tables are shared between all interpolators created with the same parameters,
+// a table lives as long as one of them.
+class RSInterpolatorLookupTable {
+public:
+    // the sample count is chosen by the caller from the error it accepts, above this the curve is evaluated directly
+    static constexpr size_t MAX_SAMPLE_COUNT = 4096;
+    static constexpr size_t MIN_SAMPLE_COUNT = 2;
+
+    // [key] identifies the curve, [sampler] is only called when no table with this key is alive
+    static std::shared_ptr<const RSInterpolatorLookupTable> GetOrCreate(
+        const std::vector<float>& key, size_t sampleCount, const std::function<float(float)>& sampler);
+
+    explicit RSInterpolatorLookupTable(std::vector<float>&& samples);
+    ~RSInterpolatorLookupTable() = default;
+
+    // [input] has to be in [0, 1]
+    float Lookup(float input) const
+    {
+        float position = input * lastIndex_;
+        size_t index = static_cast<size_t>(position);
+        if (index >= lastIndex_) {
+            return samples_[lastIndex_];
+        }
+        float fraction = position - index;
+        return samples_[index] + (samples_[index + 1] - samples_[index]) * fraction;
+    }
+
+    size_t GetSampleCount() const
+    {
+        return samples_.size();
+    }
+
+private:
+    std::vector<float> samples_;
+    size_t lastIndex_ { 0 };
+
+    static std::mutex cacheMutex_;
+    static std::map<std::vector<float>, std::weak_ptr<const RSInterpolatorLookupTable>> cache_;
+};
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // RENDER_SERVICE_CLIENT_CORE_ANIMATION_RS_INTERPOLATOR_LOOKUP_TABLE_H
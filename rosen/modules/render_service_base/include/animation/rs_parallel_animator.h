@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RENDER_SERVICE_CLIENT_CORE_ANIMATION_RS_PARALLEL_ANIMATOR_H
+#define RENDER_SERVICE_CLIENT_CORE_ANIMATION_RS_PARALLEL_ANIMATOR_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "animation/rs_animation_batch.h"
+#include "common/rs_common_def.h"
+
+namespace OHOS {
+namespace Rosen {
+class RSBaseRenderNode;
+
+// Steps the animations of all animating nodes of a frame. Animations only write to the node they are attached to,
+// so when there are enough animating nodes they are split into contiguous ranges which are animated and evaluated by
+// a small pool of worker threads, the calling thread taking the first range. Finish callbacks and the removal of
+// nodes with no running animation left are applied on the calling thread afterwards, in node order, so the result
+// does not depend on thread scheduling. Workers are only started the first time a frame is animated in parallel.
+class RSParallelAnimator final {
+public:
+    using AnimatingNodeList = std::unordered_map<NodeId, std::weak_ptr<RSBaseRenderNode>>;
+
+    RSParallelAnimator();
+    ~RSParallelAnimator();
+
+    // animate all nodes of [nodeList] to [timestamp], expired nodes and nodes with no running animation left are
+    // removed from the list.
+    void Animate(AnimatingNodeList& nodeList, int64_t timestamp);
+
+    // timing of the animate phase of the last frames
+    void Dump(std::string& dumpString) const;
+
+private:
+    struct Range {
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    RSParallelAnimator(const RSParallelAnimator&) = delete;
+    RSParallelAnimator(const RSParallelAnimator&&) = delete;
+    RSParallelAnimator& operator=(const RSParallelAnimator&) = delete;
+    RSParallelAnimator& operator=(const RSParallelAnimator&&) = delete;
+
+    size_t SplitRanges(size_t nodeCount);
+    void StartWorkers();
+    void WorkerLoop(size_t index, uint64_t frameSeq);
+    void AnimateRange(size_t index);
+    void UpdateStats(int64_t durationNs, size_t nodeCount, size_t rangeCount);
+
+    size_t maxWorkerCount_ = 0;
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable taskCond_;
+    std::condition_variable doneCond_;
+    uint64_t frameSeq_ = 0;
+    size_t pendingWorkers_ = 0;
+    bool running_ = true;
+
+    // state of the frame being animated, written before the workers are woken up
+    int64_t timestamp_ = 0;
+    std::vector<NodeId> nodeIds_;
+    std::vector<std::shared_ptr<RSBaseRenderNode>> nodes_;
+    std::vector<uint8_t> hasRunningAnimation_;
+    std::vector<Range> ranges_;
+    std::vector<RSAnimationBatch> batches_;
+
+    // statistics, only accessed by the thread calling Animate
+    std::deque<int64_t> frameDurations_;
+    int64_t maxFrameDuration_ = 0;
+    size_t lastNodeCount_ = 0;
+    size_t lastRangeCount_ = 0;
+    uint64_t parallelFrameCount_ = 0;
+    uint64_t frameCount_ = 0;
+};
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // RENDER_SERVICE_CLIENT_CORE_ANIMATION_RS_PARALLEL_ANIMATOR_H
@@ -26,6 +26,7 @@
 
 namespace OHOS {
 namespace Rosen {
+class RSAnimationBatch;
 class RSRenderNode;
 
 enum class AnimationState {
@@ -53,6 +54,9 @@ public:
     virtual bool Marshalling(Parcel& parcel) const override;
 #endif
     bool Animate(int64_t time);
+    // same as Animate, but the evaluation of a running animation may be queued into [batch] and only applied
+    // by RSAnimationBatch::Evaluate
+    bool Animate(int64_t time, RSAnimationBatch& batch);
 
     bool IsStarted() const;
     bool IsRunning() const;
@@ -153,7 +157,18 @@ protected:
 
     virtual void OnRemoveOnCompletion() {}
 
+    // queue the evaluation at [fraction] into [batch], returns false if the animation has to be evaluated directly
+    virtual bool OnAnimateBatch(float fraction, RSAnimationBatch& batch)
+    {
+        return false;
+    }
+
+    // apply the value computed by RSAnimationBatch, given as its float components
+    virtual void OnBatchEvaluated(const float* value) {}
+
 private:
+    bool AnimateInner(int64_t time, RSAnimationBatch* batch);
+
     void ProcessFillModeOnStart(float startFraction);
 
     void ProcessFillModeOnFinish(float endFraction);
@@ -163,6 +178,8 @@ private:
     AnimationState state_ { AnimationState::INITIALIZED };
     bool firstToRunning_ { false };
     RSRenderNode* target_ { nullptr };
+
+    friend class RSAnimationBatch;
 };
 } // namespace Rosen
 } // namespace OHOS
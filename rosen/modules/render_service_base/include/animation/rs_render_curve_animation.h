@@ -16,6 +16,7 @@
 #ifndef RENDER_SERVICE_CLIENT_CORE_ANIMATION_RS_RENDER_CURVE_ANIMATION_H
 #define RENDER_SERVICE_CLIENT_CORE_ANIMATION_RS_RENDER_CURVE_ANIMATION_H
 
+#include "animation/rs_animation_batch.h"
 #include "animation/rs_interpolator.h"
 #include "animation/rs_render_property_animation.h"
 #include "animation/rs_value_estimator.h"
@@ -82,6 +83,21 @@ protected:
         OnAnimateInner(fraction, interpolator_);
     }
 
+    bool OnAnimateBatch(float fraction, RSAnimationBatch& batch) override
+    {
+        if (RSRenderPropertyAnimation<T>::GetProperty() == RSAnimatableProperty::INVALID) {
+            return true;
+        }
+        return batch.Add(this, interpolator_.get(), fraction, startValue_, endValue_);
+    }
+
+    void OnBatchEvaluated(const float* value) override
+    {
+        T interpolationValue {};
+        RSAnimationBatch::FromComponents(value, interpolationValue);
+        RSRenderPropertyAnimation<T>::SetAnimationValue(interpolationValue);
+    }
+
 private:
 #ifdef ROSEN_OHOS
     bool ParseParam(Parcel& parcel) override
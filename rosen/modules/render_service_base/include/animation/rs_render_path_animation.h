@@ -18,6 +18,7 @@
 
 #include "animation/rs_interpolator.h"
 #include "animation/rs_render_property_animation.h"
+#include "render/rs_path_arc_length_table.h"
 
 namespace OHOS {
 namespace Rosen {
@@ -68,6 +69,9 @@ private:
     RotationMode rotationMode_ { RotationMode::ROTATE_NONE };
     std::shared_ptr<RSInterpolator> interpolator_ { RSInterpolator::DEFAULT };
     std::shared_ptr<RSPath> animationPath_;
+    // built from animationPath_ on the first frame, the path does not change while animating
+    RSPathArcLengthTable arcLengthTable_;
+    bool isArcLengthTableBuilt_ { false };
 };
 } // namespace Rosen
 } // namespace OHOS
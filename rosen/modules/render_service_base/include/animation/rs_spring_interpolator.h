@@ -16,7 +16,10 @@
 #ifndef ROSEN_ENGINE_CORE_ANIMATION_RS_SPRING_INTERPOLATOR_H
 #define ROSEN_ENGINE_CORE_ANIMATION_RS_SPRING_INTERPOLATOR_H
 
+#include <memory>
+
 #include "animation/rs_interpolator.h"
+#include "animation/rs_interpolator_lookup_table.h"
 
 namespace OHOS {
 namespace Rosen {
@@ -25,14 +28,24 @@ public:
     RSSpringInterpolator(float response, float dampingRatio, float initialVelocity)
         // initialOffset: 1, minimumAmplitude: 0.001
         : RSSpringInterpolator(response, dampingRatio, 1, 0.001, initialVelocity, 0)
-    {}
+    {
+        BuildLookupTable();
+    }
 
     ~RSSpringInterpolator() override {};
 
     float Interpolate(float input) const override
     {
+        if (lookupTable_ != nullptr && input > 0 && input < 1) {
+            return lookupTable_->Lookup(input);
+        }
         return InterpolateImpl(input * duration_);
     }
+
+    InterpolatorType GetType() const override
+    {
+        return InterpolatorType::SPRING;
+    }
     bool Marshalling(Parcel& parcel) const override;
 #ifdef ROSEN_OHOS
     static RSSpringInterpolator* Unmarshalling(Parcel& parcel);
@@ -53,6 +66,9 @@ protected:
 private:
     void EstimateDuration();
     double CalculateDisplacement(double mappedTime) const;
+    // samples the curve once so that Interpolate does not evaluate exp/sin/cos per call, the resolution is chosen
+    // to keep the error of the linear interpolation below minimumAmplitude_
+    void BuildLookupTable();
 
     // common intermediate coefficient
     float coeffDecay_ { 0.0f };
@@ -62,6 +78,8 @@ private:
     // only for over-damped systems
     float coeffScaleMinus_ { 0.0f };
     float coeffDecayMinus_ { 0.0f };
+
+    std::shared_ptr<const RSInterpolatorLookupTable> lookupTable_;
 };
 
 class RSValueSpringInterpolator : public RSSpringInterpolator {
@@ -24,6 +24,7 @@ namespace Rosen {
 enum RSCanvasNodeCommandType : uint16_t {
     CANVAS_NODE_CREATE,
     CANVAS_NODE_UPDATE_RECORDING,
+    CANVAS_NODE_SET_CACHE_ENABLED,
 };
 
 class DrawCmdList;
@@ -33,12 +34,15 @@ public:
     static void Create(RSContext& context, NodeId id);
     static void UpdateRecording(
         RSContext& context, NodeId id, std::shared_ptr<DrawCmdList> drawCmds, bool drawContentLast);
+    static void SetCacheEnabled(RSContext& context, NodeId id, bool enabled);
 };
 
 ADD_COMMAND(RSCanvasNodeCreate, ARG(CANVAS_NODE, CANVAS_NODE_CREATE, RSCanvasNodeCommandHelper::Create, NodeId))
 ADD_COMMAND(RSCanvasNodeUpdateRecording,
     ARG(CANVAS_NODE, CANVAS_NODE_UPDATE_RECORDING, RSCanvasNodeCommandHelper::UpdateRecording, NodeId,
         std::shared_ptr<DrawCmdList>, bool))
+ADD_COMMAND(RSCanvasNodeSetCacheEnabled,
+    ARG(CANVAS_NODE, CANVAS_NODE_SET_CACHE_ENABLED, RSCanvasNodeCommandHelper::SetCacheEnabled, NodeId, bool))
 
 } // namespace Rosen
 } // namespace OHOS
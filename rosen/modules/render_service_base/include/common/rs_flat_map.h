@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RENDER_SERVICE_BASE_COMMON_RS_FLAT_MAP_H
+#define RENDER_SERVICE_BASE_COMMON_RS_FLAT_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace OHOS {
+namespace Rosen {
+// Open addressing hash map for integer keys such as node ids. Entries live in one array and are found with linear
+// probing, so a lookup touches one or two cache lines instead of following the bucket list of an unordered_map.
+// Erasing shifts the following entries back instead of leaving tombstones, lookups stay short after many erases.
+// Pointers to values are invalidated by Emplace and Erase.
+template<typename Key, typename Value>
+class RSFlatMap final {
+    static_assert(std::is_integral_v<Key>, "RSFlatMap only supports integer keys");
+
+public:
+    RSFlatMap() = default;
+    ~RSFlatMap() = default;
+
+    size_t Size() const
+    {
+        return size_;
+    }
+
+    bool Empty() const
+    {
+        return size_ == 0;
+    }
+
+    // the value of [key], nullptr if there is none
+    Value* Find(Key key)
+    {
+        size_t index = 0;
+        return FindIndex(key, index) ? &slots_[index].value : nullptr;
+    }
+
+    const Value* Find(Key key) const
+    {
+        size_t index = 0;
+        return FindIndex(key, index) ? &slots_[index].value : nullptr;
+    }
+
+    bool Contains(Key key) const
+    {
+        size_t index = 0;
+        return FindIndex(key, index);
+    }
+
+    // inserts [value] if there is no value for [key] yet, returns whether it was inserted
+    template<typename... Args>
+    bool Emplace(Key key, Args&&... args)
+    {
+        size_t index = 0;
+        if (FindIndex(key, index)) {
+            return false;
+        }
+        if ((size_ + 1) * MAX_LOAD_DENOMINATOR > slots_.size() * MAX_LOAD_NUMERATOR) {
+            Rehash(slots_.empty() ? MIN_CAPACITY : slots_.size() * 2);
+            FindIndex(key, index);
+        }
+        Slot& slot = slots_[index];
+        slot.key = key;
+        slot.value = Value(std::forward<Args>(args)...);
+        slot.used = true;
+        ++size_;
+        return true;
+    }
+
+    // returns whether there was a value for [key]
+    bool Erase(Key key)
+    {
+        size_t index = 0;
+        if (!FindIndex(key, index)) {
+            return false;
+        }
+        size_t mask = slots_.size() - 1;
+        size_t hole = index;
+        for (size_t next = (hole + 1) & mask; slots_[next].used; next = (next + 1) & mask) {
+            // entries whose probe sequence passes the hole move into it
+            size_t home = Home(slots_[next].key);
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                slots_[hole].key = slots_[next].key;
+                slots_[hole].value = std::move(slots_[next].value);
+                hole = next;
+            }
+        }
+        slots_[hole].used = false;
+        slots_[hole].value = Value();
+        --size_;
+        return true;
+    }
+
+    void Clear()
+    {
+        slots_.clear();
+        size_ = 0;
+    }
+
+    // calls [func] with the key and value of every entry, the map must not be changed by [func]
+    template<typename Func>
+    void ForEach(Func&& func) const
+    {
+        for (const auto& slot : slots_) {
+            if (slot.used) {
+                func(slot.key, slot.value);
+            }
+        }
+    }
+
+private:
+    struct Slot {
+        Key key {};
+        Value value {};
+        bool used = false;
+    };
+
+    static constexpr size_t MIN_CAPACITY = 16;
+    // at most 3/4 of the slots are used
+    static constexpr size_t MAX_LOAD_NUMERATOR = 3;
+    static constexpr size_t MAX_LOAD_DENOMINATOR = 4;
+    static constexpr uint64_t HASH_MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+
+    // ids differ in their low bits within a process and in their high bits across processes, mix both
+    size_t Home(Key key) const
+    {
+        uint64_t hash = static_cast<uint64_t>(key) * HASH_MULTIPLIER;
+        return static_cast<size_t>(hash ^ (hash >> 32)) & (slots_.size() - 1);
+    }
+
+    // the slot of [key] if found, otherwise the free slot it would be inserted at
+    bool FindIndex(Key key, size_t& index) const
+    {
+        if (slots_.empty()) {
+            return false;
+        }
+        size_t mask = slots_.size() - 1;
+        for (index = Home(key); slots_[index].used; index = (index + 1) & mask) {
+            if (slots_[index].key == key) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Rehash(size_t capacity)
+    {
+        std::vector<Slot> oldSlots(capacity);
+        oldSlots.swap(slots_);
+        size_t mask = capacity - 1;
+        for (auto& slot : oldSlots) {
+            if (!slot.used) {
+                continue;
+            }
+            size_t index = Home(slot.key);
+            while (slots_[index].used) {
+                index = (index + 1) & mask;
+            }
+            slots_[index].key = slot.key;
+            slots_[index].value = std::move(slot.value);
+            slots_[index].used = true;
+        }
+    }
+
+    std::vector<Slot> slots_;
+    size_t size_ = 0;
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // RENDER_SERVICE_BASE_COMMON_RS_FLAT_MAP_H
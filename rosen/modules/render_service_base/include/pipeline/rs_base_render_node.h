@@ -22,6 +22,7 @@
 
 namespace OHOS {
 namespace Rosen {
+class RSAnimationBatch;
 class RSContext;
 class RSNodeVisitor;
 
@@ -47,6 +48,11 @@ public:
     {
         return false;
     }
+    // same as Animate, running curve animations are evaluated later by RSAnimationBatch::Evaluate
+    virtual bool Animate(int64_t timestamp, RSAnimationBatch& batch)
+    {
+        return Animate(timestamp);
+    }
 
     WeakPtr GetParent() const;
     void ResetParent();
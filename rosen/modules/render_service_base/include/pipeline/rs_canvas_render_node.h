@@ -35,6 +35,13 @@ public:
 
     void UpdateRecording(std::shared_ptr<DrawCmdList> drawCmds, bool drawContentLast);
 
+    // cache the recorded contents across frames until they are updated, see RSRenderNodeCache
+    void SetCacheEnabled(bool enabled);
+    bool IsCacheEnabled() const
+    {
+        return cacheEnabled_;
+    }
+
     void ProcessRenderBeforeChildren(RSPaintFilterCanvas& canvas) override;
     void ProcessRenderContents(RSPaintFilterCanvas& canvas) override;
     void ProcessRenderAfterChildren(RSPaintFilterCanvas& canvas) override;
@@ -50,6 +57,9 @@ public:
 private:
     std::shared_ptr<DrawCmdList> drawCmdList_ { nullptr };
     bool drawContentLast_ = false;
+    bool cacheEnabled_ = false;
+    uint64_t contentVersion_ = 0;
+    Gravity cachedGravity_ = Gravity::DEFAULT;
 
     friend class RSRenderTransition;
 };
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RENDER_SERVICE_BASE_PIPELINE_RS_FILTER_RESULT_CACHE_H
+#define RENDER_SERVICE_BASE_PIPELINE_RS_FILTER_RESULT_CACHE_H
+
+#ifdef ROSEN_OHOS
+#include <cstdint>
+#include <list>
+#include <mutex>
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageFilter.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPixmap.h"
+
+namespace OHOS {
+namespace Rosen {
+// Filtered contents of offscreen filter layers, reused while the contents of the layer (usually the static content
+// behind a background blur) do not change. An entry keeps a copy of the layer it was filtered from and is only reused
+// for a layer with exactly the same pixels, the comparison stops at the first differing row so that changing
+// contents cost little. A layer keeps at most one entry, entries are evicted in LRU order.
+class RSFilterResultCache final {
+public:
+    struct Key {
+        sk_sp<SkImageFilter> filter;
+        SkMatrix matrix;
+        SkISize size = SkISize::MakeEmpty();
+        // visible part of the layer, relative to the layer
+        SkIRect clipBounds = SkIRect::MakeEmpty();
+
+        bool operator==(const Key& other) const
+        {
+            return filter == other.filter && matrix == other.matrix && size == other.size &&
+                clipBounds == other.clipBounds;
+        }
+    };
+
+    struct Result {
+        sk_sp<SkImage> image;
+        SkIRect subset = SkIRect::MakeEmpty();
+        SkIPoint offset = SkIPoint::Make(0, 0);
+    };
+
+    static RSFilterResultCache& Instance();
+
+    // [pixels] are the contents of the layer, [key].size of them are used
+    bool Get(const Key& key, const SkPixmap& pixels, Result& result);
+    void Put(const Key& key, const SkPixmap& pixels, const Result& result);
+    void Clear();
+
+    size_t GetEntryCount() const;
+    uint64_t GetHitCount() const;
+
+private:
+    struct Entry {
+        Key key;
+        // copy of the layer [result] was filtered from
+        SkBitmap source;
+        Result result;
+        size_t bytes = 0;
+    };
+
+    static bool SamePixels(const SkBitmap& source, const SkPixmap& pixels);
+
+    RSFilterResultCache() = default;
+    ~RSFilterResultCache() = default;
+    RSFilterResultCache(const RSFilterResultCache&) = delete;
+    RSFilterResultCache(const RSFilterResultCache&&) = delete;
+    RSFilterResultCache& operator=(const RSFilterResultCache&) = delete;
+    RSFilterResultCache& operator=(const RSFilterResultCache&&) = delete;
+
+    mutable std::mutex mutex_;
+    // most recently used first
+    std::list<Entry> entries_;
+    size_t bytes_ = 0;
+    uint64_t hitCount_ = 0;
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // ROSEN_OHOS
+#endif // RENDER_SERVICE_BASE_PIPELINE_RS_FILTER_RESULT_CACHE_H
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RENDER_SERVICE_BASE_PIPELINE_RS_IMAGE_CACHE_H
+#define RENDER_SERVICE_BASE_PIPELINE_RS_IMAGE_CACHE_H
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkPixmap.h"
+
+namespace OHOS {
+namespace Rosen {
+// Images shared by the draw commands of all nodes and frames of a process. Images are identified by their contents
+// (a hash of the encoded data or of the pixels, checked against the cached image on a hit) or by an id assigned by
+// the caller, so the same icon recorded by many nodes or on every content update is decoded, stored and uploaded only
+// once. The cache does not keep images alive: once the draw command lists using an image are gone, the image is
+// released by the next ReleaseUnusedImages, called once per frame, or by an insertion into a grown cache.
+class RSImageCache final {
+public:
+    static RSImageCache& Instance();
+
+    // the shared image with the contents of [image], [image] itself if there is none yet
+    sk_sp<SkImage> GetOrCache(const sk_sp<SkImage>& image);
+    // the shared image of the pixels of [bitmap], pixels are only copied again once the bitmap was changed
+    sk_sp<SkImage> GetOrCache(const SkBitmap& bitmap);
+
+    // images identified by the caller, [uniqueId] must be below CALLER_ID_LIMIT
+    void CacheImage(uint64_t uniqueId, const sk_sp<SkImage>& image);
+    sk_sp<SkImage> GetImage(uint64_t uniqueId) const;
+    // id of a shared image, 0 if [image] is not cached. Lets an image be sent only once across processes.
+    uint64_t GetImageId(const sk_sp<SkImage>& image) const;
+
+    // drops the images no draw command uses any more
+    void ReleaseUnusedImages();
+    void Clear();
+
+    size_t GetImageCount() const;
+    size_t GetMemoryUsage() const;
+    uint64_t GetHitCount() const;
+
+    // ids of images identified by their contents are above
+    static constexpr uint64_t CALLER_ID_LIMIT = 1ULL << 63;
+    // insertions release the unused images once the cache holds this many, or twice as many as after the last release
+    static constexpr size_t MIN_SWEEP_IMAGE_COUNT = 64;
+
+private:
+    struct Entry {
+        sk_sp<SkImage> image;
+        size_t bytes = 0;
+        // unique ids of the SkImages known to have these contents
+        std::vector<uint32_t> imageIds;
+    };
+
+    RSImageCache() = default;
+    ~RSImageCache() = default;
+    RSImageCache(const RSImageCache&) = delete;
+    RSImageCache(const RSImageCache&&) = delete;
+    RSImageCache& operator=(const RSImageCache&) = delete;
+    RSImageCache& operator=(const RSImageCache&&) = delete;
+
+    // the shared image of [id], nullptr if there is none
+    sk_sp<SkImage> UseLocked(uint64_t id);
+    void InsertLocked(uint64_t id, const sk_sp<SkImage>& image);
+    void AddImageIdLocked(uint64_t id, const SkImage& image);
+    void ReleaseUnusedImagesLocked();
+    void EraseLocked(std::unordered_map<uint64_t, Entry>::iterator iter);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, Entry> entries_;
+    // SkImage::uniqueID() to the id of its contents, skips hashing images that were seen before
+    std::unordered_map<uint32_t, uint64_t> imageIds_;
+    size_t bytes_ = 0;
+    uint64_t hitCount_ = 0;
+    size_t sweepImageCount_ = MIN_SWEEP_IMAGE_COUNT;
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // RENDER_SERVICE_BASE_PIPELINE_RS_IMAGE_CACHE_H
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RENDER_SERVICE_BASE_PIPELINE_RS_OFFSCREEN_SURFACE_POOL_H
+#define RENDER_SERVICE_BASE_PIPELINE_RS_OFFSCREEN_SURFACE_POOL_H
+
+#ifdef ROSEN_OHOS
+#include <mutex>
+#include <vector>
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkSurface.h"
+
+namespace OHOS {
+namespace Rosen {
+// Surfaces reused by offscreen layers from frame to frame, created on the same device as the canvas the layer is
+// drawn onto (raster or GPU). Sizes are rounded up so that a layer whose bounds change slightly (e.g. while
+// animating) keeps getting the same surface, a surface may therefore be larger than requested and only its top-left
+// part is used. Surfaces that are not used for a few frames are freed by OnFrameEnd, Clear frees all of them once
+// the render thread goes idle.
+class RSOffscreenSurfacePool final {
+public:
+    static RSOffscreenSurfacePool& Instance();
+
+    // a surface compatible with [target] of at least [width] x [height]
+    sk_sp<SkSurface> Acquire(SkCanvas* target, int width, int height);
+    void Release(sk_sp<SkSurface> surface);
+    void OnFrameEnd();
+    void Clear();
+
+    size_t GetSurfaceCount() const;
+
+private:
+    RSOffscreenSurfacePool() = default;
+    ~RSOffscreenSurfacePool() = default;
+    RSOffscreenSurfacePool(const RSOffscreenSurfacePool&) = delete;
+    RSOffscreenSurfacePool(const RSOffscreenSurfacePool&&) = delete;
+    RSOffscreenSurfacePool& operator=(const RSOffscreenSurfacePool&) = delete;
+    RSOffscreenSurfacePool& operator=(const RSOffscreenSurfacePool&&) = delete;
+
+    struct Entry {
+        sk_sp<SkSurface> surface;
+        // only used to match surfaces with their target, nullptr for raster surfaces
+        const GrContext* context = nullptr;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    mutable std::mutex mutex_;
+    std::vector<Entry> surfaces_;
+    uint64_t frameCount_ = 0;
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // ROSEN_OHOS
+#endif // RENDER_SERVICE_BASE_PIPELINE_RS_OFFSCREEN_SURFACE_POOL_H
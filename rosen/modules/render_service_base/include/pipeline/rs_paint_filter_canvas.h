@@ -17,8 +17,10 @@
 #define RENDER_SERVICE_CLIENT_CORE_PIPELINE_RS_PAINT_FILTER_CANVAS_H
 
 #ifdef ROSEN_OHOS
+#include <include/core/SkSurface.h>
 #include <include/utils/SkPaintFilterCanvas.h>
 #include <stack>
+#include <vector>
 
 #include "common/rs_macros.h"
 
@@ -29,20 +31,52 @@ namespace Rosen {
 class RSPaintFilterCanvas : public SkPaintFilterCanvas {
 public:
     RSPaintFilterCanvas(SkCanvas* canvas, float alpha = 1.0f);
-    ~RSPaintFilterCanvas() override {};
+    ~RSPaintFilterCanvas() override;
 
     void MultiplyAlpha(float alpha);
     void SaveAlpha();
     void RestoreAlpha();
     float GetAlpha() { return alpha_; }
 
+    // When enabled, layers with an image filter are drawn into a pooled surface covering only the filter bounds, on
+    // the same device as the wrapped canvas, and filtered there, the result is drawn back onto the wrapped canvas
+    // when the layer is restored. The rest of the frame keeps being drawn onto the wrapped canvas.
+    void EnableOffscreenFilterLayer(bool enable)
+    {
+        offscreenFilterLayerEnabled_ = enable;
+    }
+
 protected:
     bool onFilter(SkPaint& paint) const override;
     void onDrawPicture(const SkPicture* picture, const SkMatrix* matrix, const SkPaint* paint) override;
+    SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec& rec) override;
+    void willRestore() override;
+    void didSetMatrix(const SkMatrix& matrix) override;
 
 private:
+    struct OffscreenLayer {
+        SkCanvas* canvas = nullptr;
+        sk_sp<SkSurface> surface;
+        // device bounds of the layer on [canvas] and of the filtered result
+        SkIRect bounds = SkIRect::MakeEmpty();
+        SkIRect outputBounds = SkIRect::MakeEmpty();
+        // top-left of the layer on the wrapped canvas of this RSPaintFilterCanvas
+        SkIPoint origin = SkIPoint::Make(0, 0);
+        SkPaint paint;
+        SkMatrix filterMatrix;
+        int saveCount = 0;
+    };
+
+    bool BeginOffscreenLayer(const SaveLayerRec& rec);
+    static bool InitWithPrevious(SkCanvas* target, SkSurface* surface, const SkIRect& bounds);
+    void EndOffscreenLayer();
+
     std::stack<float> alphaStack_;
     float alpha_ = 1.0f;
+
+    bool offscreenFilterLayerEnabled_ = false;
+    SkCanvas* canvas_ = nullptr;
+    std::vector<OffscreenLayer> offscreenLayers_;
 };
 
 } // namespace Rosen
@@ -37,6 +37,7 @@ public:
     virtual ~RSRenderNode();
 
     bool Animate(int64_t timestamp) override;
+    bool Animate(int64_t timestamp, RSAnimationBatch& batch) override;
     bool Update(RSDirtyRegionManager& dirtyManager, const RSProperties* parent, bool parentDirty);
 
     RSProperties& GetMutableRenderProperties();
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RENDER_SERVICE_BASE_PIPELINE_RS_RENDER_NODE_CACHE_H
+#define RENDER_SERVICE_BASE_PIPELINE_RS_RENDER_NODE_CACHE_H
+
+#ifdef ROSEN_OHOS
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "include/core/SkImage.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPicture.h"
+
+#include "common/rs_common_def.h"
+
+namespace OHOS {
+namespace Rosen {
+class RSPaintFilterCanvas;
+
+// Cache of the recorded contents of static canvas render nodes. Contents are first kept as an SkPicture and,
+// once the node is drawn at a stable matrix scale, rasterized into an SkImage. Entries are evicted in LRU order
+// when the memory budget is exceeded.
+class RSRenderNodeCache final {
+public:
+    using Recorder = std::function<void(RSPaintFilterCanvas&)>;
+
+    static RSRenderNodeCache& Instance();
+
+    // Draw the cached contents of node [id] onto canvas, re-recording with [recorder] if [version] or [bounds] do
+    // not match the cached entry. Contents are only rasterized if [clipToBounds] guarantees nothing is drawn outside
+    // of bounds. The matrix the recorder leaves on its canvas is left on [canvas] too, as drawing directly would.
+    // Returns false if nothing could be cached and the caller should draw directly.
+    bool Draw(NodeId id, uint64_t version, const SkRect& bounds, bool clipToBounds, RSPaintFilterCanvas& canvas,
+        const Recorder& recorder);
+    void Purge(NodeId id);
+    void Clear();
+
+    void SetMemoryBudget(size_t bytes);
+    size_t GetMemoryBudget() const;
+    size_t GetMemoryUsage() const;
+    size_t GetEntryCount() const;
+
+    void Dump(std::string& dumpString) const;
+
+private:
+    struct Entry {
+        NodeId id = 0;
+        uint64_t version = 0;
+        SkRect bounds = SkRect::MakeEmpty();
+        sk_sp<SkPicture> picture;
+        // the matrix left on the recording canvas
+        SkMatrix matrix = SkMatrix::I();
+        sk_sp<SkImage> image;
+        SkScalar imageScaleX = 0.f;
+        SkScalar imageScaleY = 0.f;
+        SkScalar lastScaleX = 0.f;
+        SkScalar lastScaleY = 0.f;
+        bool clipToBounds = false;
+        size_t bytes = 0;
+    };
+    using EntryList = std::list<Entry>;
+
+    RSRenderNodeCache();
+    ~RSRenderNodeCache() = default;
+    RSRenderNodeCache(const RSRenderNodeCache&) = delete;
+    RSRenderNodeCache(const RSRenderNodeCache&&) = delete;
+    RSRenderNodeCache& operator=(const RSRenderNodeCache&) = delete;
+    RSRenderNodeCache& operator=(const RSRenderNodeCache&&) = delete;
+
+    EntryList::iterator FindOrCreate(NodeId id);
+    void Record(Entry& entry, uint64_t version, const SkRect& bounds, const Recorder& recorder);
+    void Rasterize(Entry& entry, SkScalar scaleX, SkScalar scaleY);
+    void UpdateSize(Entry& entry);
+    void EvictIfNeeded();
+
+    mutable std::mutex mutex_;
+    EntryList lruList_; // most recently used first
+    std::unordered_map<NodeId, EntryList::iterator> entries_;
+    size_t memoryBudget_;
+    size_t memoryUsage_ = 0;
+    uint64_t hitCount_ = 0;
+    uint64_t missCount_ = 0;
+    uint64_t evictCount_ = 0;
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // ROSEN_OHOS
+#endif // RENDER_SERVICE_BASE_PIPELINE_RS_RENDER_NODE_CACHE_H
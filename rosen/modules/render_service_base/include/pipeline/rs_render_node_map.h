@@ -17,8 +17,10 @@
 
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "common/rs_common_def.h"
+#include "common/rs_flat_map.h"
 #include "pipeline/rs_base_render_node.h"
 
 namespace OHOS {
@@ -41,7 +43,12 @@ public:
 
     const std::shared_ptr<RSRenderNode> GetAnimationFallbackNode() const;
 
+    // removes all nodes of [pid], takes time proportional to the number of nodes of [pid]
     void FilterNodeByPid(pid_t pid);
+    size_t GetNodeCount() const
+    {
+        return renderNodeMap_.Size();
+    }
 
     void DumpNodeNotOnTree(std::string& dumpString) const;
     void DumpAllNodeMemSize(std::string& dumpString) const;
@@ -54,7 +61,15 @@ private:
     RSRenderNodeMap& operator=(const RSRenderNodeMap&&) = delete;
 
 private:
-    std::unordered_map<NodeId, std::shared_ptr<RSBaseRenderNode>> renderNodeMap_;
+    static pid_t ExtractPid(NodeId id)
+    {
+        // the higher 32 bits of node ids are the pid of the process that created the node
+        return static_cast<pid_t>(id >> 32);
+    }
+
+    RSFlatMap<NodeId, std::shared_ptr<RSBaseRenderNode>> renderNodeMap_;
+    // ids of the nodes of each pid
+    std::unordered_map<pid_t, std::unordered_set<NodeId>> pidNodes_;
 
     friend class RSContext;
     friend class RSMainThread;
@@ -75,6 +75,8 @@ public:
         GET_ROTATION,
         GET_SCREEN_HDR_CAPABILITY,
         GET_SCREEN_TYPE,
+        START_CONTINUOUS_SURFACE_CAPTURE,
+        STOP_CONTINUOUS_SURFACE_CAPTURE,
     };
 
     virtual void CommitTransaction(std::unique_ptr<RSTransactionData>& transactionData) = 0;
@@ -109,6 +111,12 @@ public:
     virtual void TakeSurfaceCapture(
         NodeId id, sptr<RSISurfaceCaptureCallback> callback, float scaleX, float scaleY) = 0;
 
+    // deliver captures of node [id] to callback until stopped, at most [fps] frames per second.
+    virtual void StartContinuousSurfaceCapture(
+        NodeId id, sptr<RSISurfaceCaptureCallback> callback, float scaleX, float scaleY, uint32_t fps) = 0;
+
+    virtual void StopContinuousSurfaceCapture(NodeId id) = 0;
+
     virtual void RegisterApplicationRenderThread(uint32_t pid, sptr<IApplicationRenderThread> app) = 0;
 
     virtual RSScreenModeInfo GetScreenActiveMode(ScreenId id) = 0;
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RENDER_SERVICE_BASE_PROPERTY_RS_SHADOW_CACHE_H
+#define RENDER_SERVICE_BASE_PROPERTY_RS_SHADOW_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "include/core/SkColor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPoint.h"
+
+namespace OHOS {
+namespace Rosen {
+// Pre-blurred shadows of RSPropertiesPainter::DrawShadow. Shadows are rendered once for a device space path moved to
+// the origin and blitted at the position of the node afterwards, so nodes that only move (e.g. cards in a scrolling
+// list) draw their shadow with a single image blit. Entries are evicted in LRU order within a memory budget.
+class RSShadowCache final {
+public:
+    enum class ShadowType : uint8_t {
+        // SkMaskFilter blur of the path, alpha only, drawn with the shadow color
+        BLUR,
+        // ambient and spot parts of SkShadowUtils::DrawShadow
+        AMBIENT,
+        SPOT,
+    };
+
+    struct Key {
+        ShadowType type = ShadowType::BLUR;
+        // device space path, its bounds start at the origin
+        SkPath path;
+        // blur sigma in device space, or elevation of the occluder
+        float param = 0.f;
+        SkColor color = SK_ColorTRANSPARENT;
+        uint64_t hash = 0;
+
+        bool operator==(const Key& other) const
+        {
+            return hash == other.hash && type == other.type && param == other.param && color == other.color &&
+                path == other.path;
+        }
+    };
+
+    struct Shadow {
+        sk_sp<SkImage> image;
+        // position of the top-left corner of the image relative to the key path
+        SkPoint offset = SkPoint::Make(0.f, 0.f);
+    };
+
+    static RSShadowCache& Instance();
+
+    // fills in the hash of [key], must be called once its other fields are set
+    static void UpdateHash(Key& key);
+
+    bool Get(const Key& key, Shadow& shadow);
+    void Put(const Key& key, const Shadow& shadow);
+    void Clear();
+
+    size_t GetEntryCount() const;
+    size_t GetMemoryUsage() const;
+    uint64_t GetHitCount() const;
+
+    // shadows larger than a quarter of the budget are not cached
+    static constexpr size_t MAX_BYTES = 16 * 1024 * 1024;
+
+private:
+    struct Entry {
+        Key key;
+        Shadow shadow;
+        size_t bytes = 0;
+    };
+
+    RSShadowCache() = default;
+    ~RSShadowCache() = default;
+    RSShadowCache(const RSShadowCache&) = delete;
+    RSShadowCache(const RSShadowCache&&) = delete;
+    RSShadowCache& operator=(const RSShadowCache&) = delete;
+    RSShadowCache& operator=(const RSShadowCache&&) = delete;
+
+    void Erase(std::list<Entry>::iterator iter);
+
+    mutable std::mutex mutex_;
+    // most recently used first
+    std::list<Entry> entries_;
+    // entries by the hash of their key, a key whose hash collides with another one replaces it
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> index_;
+    size_t bytes_ = 0;
+    uint64_t hitCount_ = 0;
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // RENDER_SERVICE_BASE_PROPERTY_RS_SHADOW_CACHE_H
@@ -30,7 +30,14 @@ public:
     std::shared_ptr<RSFilter> Sub(const std::shared_ptr<RSFilter>& rhs) override;
     std::shared_ptr<RSFilter> Multiply(float rhs) override;
     std::shared_ptr<RSFilter> Negate() override;
+
+    // radii are drawn at the nearest of a few levels per octave, so that animated blurs share the same filters
+    static float QuantizeRadius(float radius);
+
 private:
+    static sk_sp<SkImageFilter> GetImageFilter(float blurRadiusX, float blurRadiusY);
+    static sk_sp<SkImageFilter> CreateImageFilter(float blurRadiusX, float blurRadiusY);
+
     float blurRadiusX_;
     float blurRadiusY_;
 };
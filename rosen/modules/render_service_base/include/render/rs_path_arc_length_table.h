@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RENDER_SERVICE_CLIENT_CORE_RENDER_RS_PATH_ARC_LENGTH_TABLE_H
+#define RENDER_SERVICE_CLIENT_CORE_RENDER_RS_PATH_ARC_LENGTH_TABLE_H
+
+#include <vector>
+
+#include "include/core/SkPoint.h"
+
+#include "common/rs_vector2.h"
+
+namespace OHOS {
+namespace Rosen {
+class RSPath;
+
+// Arc-length parameterization of a path for animations which query positions along it every frame. The first
+// contour of the path (the one measured by RSPath::GetDistance and RSPath::GetPosTan) is flattened once into line
+// segments, with the cumulative length and the direction of the path at each point. Queries are answered by a
+// binary search over the segments instead of measuring the whole path again.
+class RSPathArcLengthTable {
+public:
+    RSPathArcLengthTable() = default;
+    ~RSPathArcLengthTable() = default;
+
+    void Build(const RSPath& path);
+    void Clear();
+
+    bool IsEmpty() const
+    {
+        return distances_.size() < 2;
+    }
+
+    float GetDistance() const
+    {
+        return IsEmpty() ? 0.0f : distances_.back();
+    }
+
+    // same as RSPath::GetPosTan, [distance] is clamped to the length of the contour
+    bool GetPosTan(float distance, Vector2f& pos, float& degrees) const;
+
+private:
+    // appends a segment to [point], the tangents are the directions of the path at its start and end
+    void AddPoint(const SkPoint& point, SkVector startTangent, SkVector endTangent);
+
+    // cumulative length at each point
+    std::vector<float> distances_;
+    std::vector<Vector2f> points_;
+    // direction in degrees of the path at each point, corners have their point twice, once with each direction
+    std::vector<float> degrees_;
+};
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // RENDER_SERVICE_CLIENT_CORE_RENDER_RS_PATH_ARC_LENGTH_TABLE_H
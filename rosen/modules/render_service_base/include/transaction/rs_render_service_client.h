@@ -67,6 +67,11 @@ public:
 
     bool TakeSurfaceCapture(NodeId id, std::shared_ptr<SurfaceCaptureCallback> callback, float scaleX, float scaleY);
 
+    bool StartContinuousSurfaceCapture(NodeId id, std::shared_ptr<SurfaceCaptureCallback> callback,
+        float scaleX, float scaleY, uint32_t fps);
+
+    void StopContinuousSurfaceCapture(NodeId id);
+
     ScreenId GetDefaultScreenId();
 
     ScreenId CreateVirtualScreen(const std::string& name, uint32_t width, uint32_t height, sptr<Surface> surface,
@@ -119,12 +124,15 @@ public:
     int32_t GetScreenType(ScreenId id, RSScreenType& screenType);
 private:
     void TriggerSurfaceCaptureCallback(NodeId id, Media::PixelMap* pixelmap);
+    void TriggerContinuousSurfaceCaptureCallback(NodeId id, Media::PixelMap* pixelmap);
     std::mutex mutex_;
     std::map<NodeId, sptr<RSIBufferAvailableCallback>> bufferAvailableCbRTMap_;
     std::map<NodeId, sptr<RSIBufferAvailableCallback>> bufferAvailableCbUIMap_;
     sptr<RSIScreenChangeCallback> screenChangeCb_;
     sptr<RSISurfaceCaptureCallback> surfaceCaptureCbDirector_;
     std::map<NodeId, std::shared_ptr<SurfaceCaptureCallback>> surfaceCaptureCbMap_;
+    sptr<RSISurfaceCaptureCallback> continuousCaptureCbDirector_;
+    std::map<NodeId, std::shared_ptr<SurfaceCaptureCallback>> continuousCaptureCbMap_;
 
     friend class SurfaceCaptureCallbackDirector;
 };
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "animation/rs_animation_batch.h"
+
+#include "animation/rs_animation_manager.h"
+#include "animation/rs_interpolator.h"
+#include "animation/rs_render_animation.h"
+
+namespace OHOS {
+namespace Rosen {
+template<size_t N>
+void RSAnimationBatch::Group<N>::Add(RSRenderAnimation* animation, const RSInterpolator* interpolator,
+    float fraction, const float* startValue, const float* endValue)
+{
+    animations.push_back(animation);
+    interpolators.push_back(interpolator);
+    fractions.push_back(fraction);
+    for (size_t c = 0; c < N; ++c) {
+        startValues[c].push_back(startValue[c]);
+        endValues[c].push_back(endValue[c]);
+    }
+}
+
+template<size_t N>
+void RSAnimationBatch::Group<N>::Evaluate(bool isLinear)
+{
+    size_t count = animations.size();
+    if (count == 0) {
+        return;
+    }
+    float* fraction = fractions.data();
+    if (!isLinear) {
+        // all interpolators of a group are of the same type, so the virtual calls always hit the same target
+        for (size_t i = 0; i < count; ++i) {
+            fraction[i] = interpolators[i]->Interpolate(fraction[i]);
+        }
+    }
+    // same estimation as RSValueEstimator::Estimate, the results are stored in place of the start values
+    for (size_t c = 0; c < N; ++c) {
+        float* value = startValues[c].data();
+        const float* endValue = endValues[c].data();
+        for (size_t i = 0; i < count; ++i) {
+            value[i] = value[i] * (1.0f - fraction[i]) + endValue[i] * fraction[i];
+        }
+    }
+    float result[N];
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t c = 0; c < N; ++c) {
+            result[c] = startValues[c][i];
+        }
+        animations[i]->OnBatchEvaluated(result);
+    }
+}
+
+template<size_t N>
+void RSAnimationBatch::Group<N>::Clear()
+{
+    // keep the capacity, the batch is reused frame after frame
+    animations.clear();
+    interpolators.clear();
+    fractions.clear();
+    for (size_t c = 0; c < N; ++c) {
+        startValues[c].clear();
+        endValues[c].clear();
+    }
+}
+
+template<size_t N>
+bool RSAnimationBatch::AddToGroup(GroupSet<N>& groups, RSRenderAnimation* animation,
+    const RSInterpolator* interpolator, float fraction, const float* startValue, const float* endValue)
+{
+    if (animation == nullptr || interpolator == nullptr) {
+        return false;
+    }
+    size_t index = static_cast<size_t>(interpolator->GetType()) - InterpolatorType::LINEAR;
+    if (index >= INTERPOLATOR_TYPE_COUNT) {
+        return false;
+    }
+    groups[index].Add(animation, interpolator, fraction, startValue, endValue);
+    ++size_;
+    return true;
+}
+
+template<size_t N>
+void RSAnimationBatch::EvaluateGroups(GroupSet<N>& groups)
+{
+    // LINEAR is the first interpolator type, its group needs no interpolation
+    for (size_t i = 0; i < INTERPOLATOR_TYPE_COUNT; ++i) {
+        groups[i].Evaluate(i == 0);
+        groups[i].Clear();
+    }
+}
+
+bool RSAnimationBatch::Add(RSRenderAnimation* animation, const RSInterpolator* interpolator, float fraction,
+    float startValue, float endValue)
+{
+    return AddToGroup(floatGroups_, animation, interpolator, fraction, &startValue, &endValue);
+}
+
+bool RSAnimationBatch::Add(RSRenderAnimation* animation, const RSInterpolator* interpolator, float fraction,
+    const Vector2f& startValue, const Vector2f& endValue)
+{
+    return AddToGroup(vector2fGroups_, animation, interpolator, fraction, startValue.data_, endValue.data_);
+}
+
+bool RSAnimationBatch::Add(RSRenderAnimation* animation, const RSInterpolator* interpolator, float fraction,
+    const Vector4f& startValue, const Vector4f& endValue)
+{
+    return AddToGroup(vector4fGroups_, animation, interpolator, fraction, startValue.data_, endValue.data_);
+}
+
+void RSAnimationBatch::Evaluate()
+{
+    if (size_ == 0) {
+        return;
+    }
+    EvaluateGroups(floatGroups_);
+    EvaluateGroups(vector2fGroups_);
+    EvaluateGroups(vector4fGroups_);
+    size_ = 0;
+}
+
+void RSAnimationBatch::Clear()
+{
+    for (size_t i = 0; i < INTERPOLATOR_TYPE_COUNT; ++i) {
+        floatGroups_[i].Clear();
+        vector2fGroups_[i].Clear();
+        vector4fGroups_[i].Clear();
+    }
+    size_ = 0;
+    finishCallbacks_.clear();
+}
+
+void RSAnimationBatch::AddFinishCallback(NodeId targetId, AnimationId animationId)
+{
+    finishCallbacks_.emplace_back(targetId, animationId);
+}
+
+void RSAnimationBatch::SendFinishCallbacks()
+{
+    for (const auto& [targetId, animationId] : finishCallbacks_) {
+        RSAnimationManager::SendFinishCallback(targetId, animationId);
+    }
+    finishCallbacks_.clear();
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <string>
 
+#include "animation/rs_animation_batch.h"
 #include "animation/rs_render_animation.h"
 #include "command/rs_animation_command.h"
 #include "command/rs_message_processor.h"
@@ -54,16 +55,26 @@ void RSAnimationManager::RemoveAnimation(AnimationId keyId)
 }
 
 bool RSAnimationManager::Animate(int64_t time)
+{
+    return AnimateInner(time, nullptr);
+}
+
+bool RSAnimationManager::Animate(int64_t time, RSAnimationBatch& batch)
+{
+    return AnimateInner(time, &batch);
+}
+
+bool RSAnimationManager::AnimateInner(int64_t time, RSAnimationBatch* batch)
 {
     // process animation
     bool hasRunningAnimation = false;
 
     // iterate and execute all animations, remove finished animations
-    std::__libcpp_erase_if_container(animations_, [this, &hasRunningAnimation, time](auto& iter) -> bool {
+    std::__libcpp_erase_if_container(animations_, [this, &hasRunningAnimation, time, batch](auto& iter) -> bool {
         auto& animation = iter.second;
-        bool isFinished = animation->Animate(time);
+        bool isFinished = batch != nullptr ? animation->Animate(time, *batch) : animation->Animate(time);
         if (isFinished) {
-            OnAnimationFinished(animation);
+            OnAnimationFinished(animation, batch);
         } else {
             hasRunningAnimation = animation->IsRunning() || hasRunningAnimation ;
         }
@@ -100,14 +111,24 @@ namespace {
     }
 }
 
-void RSAnimationManager::OnAnimationFinished(const std::shared_ptr<RSRenderAnimation>& animation)
+void RSAnimationManager::SendFinishCallback(NodeId targetId, AnimationId animationId)
 {
-    NodeId targetId = animation->GetTarget() ? animation->GetTarget()->GetId() : 0;
-    AnimationId animationId = animation->GetAnimationId();
-
     std::unique_ptr<RSCommand> command =
         std::make_unique<RSAnimationFinishCallback>(targetId, animationId);
     RSMessageProcessor::Instance().AddUIMessage(ExtractPid(animationId), command);
+}
+
+void RSAnimationManager::OnAnimationFinished(const std::shared_ptr<RSRenderAnimation>& animation,
+    RSAnimationBatch* batch)
+{
+    NodeId targetId = animation->GetTarget() ? animation->GetTarget()->GetId() : 0;
+    AnimationId animationId = animation->GetAnimationId();
+
+    if (batch != nullptr) {
+        batch->AddFinishCallback(targetId, animationId);
+    } else {
+        SendFinishCallback(targetId, animationId);
+    }
     OnAnimationRemove(animation);
     animation->Detach();
 }
@@ -64,7 +64,9 @@ RSCustomInterpolator* RSCustomInterpolator::Unmarshalling(Parcel& parcel)
 
 RSCustomInterpolator::RSCustomInterpolator(const std::vector<float>&& times, const std::vector<float>&& values)
     : times_(times), values_(values)
-{}
+{
+    CheckUniformTimes();
+}
 
 RSCustomInterpolator::RSCustomInterpolator(const std::function<float(float)>& func, int duration)
     : interpolateFunc_(func)
@@ -90,6 +92,22 @@ void RSCustomInterpolator::Convert(int duration)
         times_.push_back(time);
         values_.push_back(value);
     }
+    CheckUniformTimes();
+}
+
+void RSCustomInterpolator::CheckUniformTimes()
+{
+    isUniform_ = false;
+    if (times_.size() < 2 || times_.size() != values_.size()) {
+        return;
+    }
+    float lastIndex = times_.size() - 1;
+    for (size_t i = 0; i < times_.size(); i++) {
+        if (std::abs(times_[i] - i / lastIndex) > EPSILON) {
+            return;
+        }
+    }
+    isUniform_ = true;
 }
 
 float RSCustomInterpolator::Interpolate(float input) const
@@ -100,6 +118,12 @@ float RSCustomInterpolator::Interpolate(float input) const
     if (input > times_[times_.size() - 1] - EPSILON) {
         return times_[times_.size() - 1];
     }
+    if (isUniform_) {
+        float position = input * (times_.size() - 1);
+        size_t startIndex = std::min(static_cast<size_t>(position), times_.size() - 2);
+        float fraction = position - startIndex;
+        return fraction * (values_[startIndex + 1] - values_[startIndex]) + values_[startIndex];
+    }
     auto firstGreatValue = upper_bound(times_.begin(), times_.end(), input);
     int endLocation = firstGreatValue - times_.begin();
     int startLocation = endLocation - 1;
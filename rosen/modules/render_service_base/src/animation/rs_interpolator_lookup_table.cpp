@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "animation/rs_interpolator_lookup_table.h"
+
+#include <algorithm>
+
+#include "platform/common/rs_log.h"
+
+namespace OHOS {
+namespace Rosen {
+std::mutex RSInterpolatorLookupTable::cacheMutex_;
+std::map<std::vector<float>, std::weak_ptr<const RSInterpolatorLookupTable>> RSInterpolatorLookupTable::cache_;
+
+RSInterpolatorLookupTable::RSInterpolatorLookupTable(std::vector<float>&& samples) : samples_(std::move(samples))
+{
+    lastIndex_ = samples_.empty() ? 0 : samples_.size() - 1;
+}
+
+std::shared_ptr<const RSInterpolatorLookupTable> RSInterpolatorLookupTable::GetOrCreate(
+    const std::vector<float>& key, size_t sampleCount, const std::function<float(float)>& sampler)
+{
+    if (sampler == nullptr || sampleCount < MIN_SAMPLE_COUNT || sampleCount > MAX_SAMPLE_COUNT) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    auto iter = cache_.find(key);
+    if (iter != cache_.end()) {
+        auto table = iter->second.lock();
+        if (table != nullptr && table->GetSampleCount() == sampleCount) {
+            return table;
+        }
+    }
+
+    std::vector<float> samples(sampleCount);
+    float lastIndex = static_cast<float>(sampleCount - 1);
+    for (size_t i = 0; i < sampleCount; ++i) {
+        samples[i] = sampler(i / lastIndex);
+    }
+    auto table = std::make_shared<const RSInterpolatorLookupTable>(std::move(samples));
+
+    // drop the entries of tables no interpolator uses anymore before adding a new one
+    for (auto it = cache_.begin(); it != cache_.end();) {
+        if (it->second.expired()) {
+            it = cache_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    cache_[key] = table;
+    ROSEN_LOGD("RSInterpolatorLookupTable::GetOrCreate, created table of %zu samples, %zu tables alive", sampleCount,
+        cache_.size());
+    return table;
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "animation/rs_parallel_animator.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "pipeline/rs_base_render_node.h"
+#include "platform/common/rs_log.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+// below this number of animating nodes waking up the workers costs more than it saves
+constexpr size_t PARALLEL_THRESHOLD = 64;
+constexpr size_t MIN_NODES_PER_RANGE = 32;
+constexpr size_t MAX_WORKER_COUNT = 3;
+constexpr size_t STATS_FRAME_COUNT = 60;
+constexpr int64_t NS_PER_US = 1000;
+} // namespace
+
+RSParallelAnimator::RSParallelAnimator()
+{
+    unsigned int cpuCount = std::thread::hardware_concurrency();
+    maxWorkerCount_ = cpuCount > 1 ? std::min(static_cast<size_t>(cpuCount - 1), MAX_WORKER_COUNT) : 0;
+}
+
+RSParallelAnimator::~RSParallelAnimator()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    taskCond_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void RSParallelAnimator::Animate(AnimatingNodeList& nodeList, int64_t timestamp)
+{
+    auto startTime = std::chrono::steady_clock::now();
+
+    nodeIds_.clear();
+    nodes_.clear();
+    for (auto iter = nodeList.begin(); iter != nodeList.end();) {
+        auto node = iter->second.lock();
+        if (node == nullptr) {
+            ROSEN_LOGD("RSParallelAnimator::Animate removing expired animating node");
+            iter = nodeList.erase(iter);
+            continue;
+        }
+        nodeIds_.push_back(iter->first);
+        nodes_.push_back(std::move(node));
+        ++iter;
+    }
+    timestamp_ = timestamp;
+    hasRunningAnimation_.assign(nodes_.size(), 0);
+
+    size_t rangeCount = SplitRanges(nodes_.size());
+    if (batches_.size() < rangeCount) {
+        batches_.resize(rangeCount);
+    }
+    if (rangeCount > 1) {
+        StartWorkers();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pendingWorkers_ = workers_.size();
+            ++frameSeq_;
+        }
+        taskCond_.notify_all();
+        AnimateRange(0);
+        std::unique_lock<std::mutex> lock(mutex_);
+        doneCond_.wait(lock, [this]() { return pendingWorkers_ == 0; });
+    } else if (rangeCount == 1) {
+        AnimateRange(0);
+    }
+
+    // write back in node order, independent of which worker finished first
+    for (size_t i = 0; i < rangeCount; ++i) {
+        batches_[i].SendFinishCallbacks();
+    }
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        if (hasRunningAnimation_[i] == 0) {
+            ROSEN_LOGD("RSParallelAnimator::Animate removing finished animating node %llu", nodeIds_[i]);
+            nodeList.erase(nodeIds_[i]);
+        }
+    }
+    nodes_.clear();
+
+    auto duration = std::chrono::steady_clock::now() - startTime;
+    UpdateStats(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(), nodeIds_.size(), rangeCount);
+}
+
+size_t RSParallelAnimator::SplitRanges(size_t nodeCount)
+{
+    ranges_.clear();
+    if (nodeCount == 0) {
+        return 0;
+    }
+    size_t rangeCount = 1;
+    if (nodeCount >= PARALLEL_THRESHOLD && maxWorkerCount_ > 0) {
+        rangeCount = std::min(maxWorkerCount_ + 1, nodeCount / MIN_NODES_PER_RANGE);
+    }
+    size_t rangeSize = nodeCount / rangeCount;
+    size_t remainder = nodeCount % rangeCount;
+    size_t begin = 0;
+    for (size_t i = 0; i < rangeCount; ++i) {
+        size_t end = begin + rangeSize + (i < remainder ? 1 : 0);
+        ranges_.push_back({ begin, end });
+        begin = end;
+    }
+    return rangeCount;
+}
+
+void RSParallelAnimator::StartWorkers()
+{
+    if (!workers_.empty()) {
+        return;
+    }
+    for (size_t i = 0; i < maxWorkerCount_; ++i) {
+        workers_.emplace_back(&RSParallelAnimator::WorkerLoop, this, i, frameSeq_);
+    }
+}
+
+void RSParallelAnimator::WorkerLoop(size_t index, uint64_t frameSeq)
+{
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            taskCond_.wait(lock, [this, frameSeq]() { return !running_ || frameSeq_ != frameSeq; });
+            if (!running_) {
+                return;
+            }
+            frameSeq = frameSeq_;
+        }
+        // the calling thread animates the first range
+        if (index + 1 < ranges_.size()) {
+            AnimateRange(index + 1);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --pendingWorkers_;
+        }
+        doneCond_.notify_one();
+    }
+}
+
+void RSParallelAnimator::AnimateRange(size_t index)
+{
+    auto& batch = batches_[index];
+    const auto& range = ranges_[index];
+    for (size_t i = range.begin; i < range.end; ++i) {
+        hasRunningAnimation_[i] = nodes_[i]->Animate(timestamp_, batch) ? 1 : 0;
+    }
+    // values are written to the nodes of this range only
+    batch.Evaluate();
+}
+
+void RSParallelAnimator::UpdateStats(int64_t durationNs, size_t nodeCount, size_t rangeCount)
+{
+    frameDurations_.push_back(durationNs);
+    if (frameDurations_.size() > STATS_FRAME_COUNT) {
+        frameDurations_.pop_front();
+    }
+    maxFrameDuration_ = std::max(maxFrameDuration_, durationNs);
+    lastNodeCount_ = nodeCount;
+    lastRangeCount_ = rangeCount;
+    ++frameCount_;
+    if (rangeCount > 1) {
+        ++parallelFrameCount_;
+    }
+}
+
+void RSParallelAnimator::Dump(std::string& dumpString) const
+{
+    dumpString.append("\n");
+    dumpString.append("-- Animation\n");
+    dumpString += "animated frames: " + std::to_string(frameCount_) + ", animated in parallel: " +
+        std::to_string(parallelFrameCount_) + ", workers: " + std::to_string(workers_.size()) + "\n";
+    dumpString += "animating nodes in last frame: " + std::to_string(lastNodeCount_) + ", ranges: " +
+        std::to_string(lastRangeCount_) + "\n";
+    if (frameDurations_.empty()) {
+        return;
+    }
+    int64_t total = 0;
+    for (auto duration : frameDurations_) {
+        total += duration;
+    }
+    int64_t average = total / static_cast<int64_t>(frameDurations_.size());
+    dumpString += "animate time of last frame: " + std::to_string(frameDurations_.back() / NS_PER_US) +
+        " us, average of last " + std::to_string(frameDurations_.size()) + " frames: " +
+        std::to_string(average / NS_PER_US) + " us, max: " + std::to_string(maxFrameDuration_ / NS_PER_US) + " us\n";
+}
+} // namespace Rosen
+} // namespace OHOS
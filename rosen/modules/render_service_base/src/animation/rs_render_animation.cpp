@@ -209,6 +209,16 @@ void RSRenderAnimation::ProcessFillModeOnFinish(float endFraction)
 }
 
 bool RSRenderAnimation::Animate(int64_t time)
+{
+    return AnimateInner(time, nullptr);
+}
+
+bool RSRenderAnimation::Animate(int64_t time, RSAnimationBatch& batch)
+{
+    return AnimateInner(time, &batch);
+}
+
+bool RSRenderAnimation::AnimateInner(int64_t time, RSAnimationBatch* batch)
 {
     if (!IsRunning()) {
         ROSEN_LOGI("RSRenderAnimation::Animate, IsRunning is false!");
@@ -229,13 +239,17 @@ bool RSRenderAnimation::Animate(int64_t time)
         return false;
     }
 
-    OnAnimate(fraction);
     if (isFinished) {
+        // the fill mode is applied right after, so the last frame is never deferred
+        OnAnimate(fraction);
         ProcessFillModeOnFinish(fraction);
         ROSEN_LOGI("RSRenderAnimation::Animate, isFinished is true");
         return true;
     }
-    return isFinished;
+    if (batch == nullptr || !OnAnimateBatch(fraction, *batch)) {
+        OnAnimate(fraction);
+    }
+    return false;
 }
 } // namespace Rosen
 } // namespace OHOS
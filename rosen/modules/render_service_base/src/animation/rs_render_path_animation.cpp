@@ -73,6 +73,7 @@ bool RSRenderPathAnimation::ParseParam(Parcel& parcel)
         ROSEN_LOGE("RSRenderPathAnimation::ParseParam, Unmarshalling interpolator failed");
         return false;
     }
+    animationPath_ = path;
     SetInterpolator(interpolator);
     SetRotationMode(static_cast<RotationMode>(rotationMode));
     return true;
@@ -151,11 +152,15 @@ void RSRenderPathAnimation::OnAnimate(float fraction)
     }
 
 #ifdef ROSEN_OHOS
-    float distance = animationPath_->GetDistance();
+    if (!isArcLengthTableBuilt_) {
+        arcLengthTable_.Build(*animationPath_);
+        isArcLengthTableBuilt_ = true;
+    }
+    float distance = arcLengthTable_.GetDistance();
     float progress = GetBeginFraction() * (FRACTION_MAX - fraction) + GetEndFraction() * fraction;
     Vector2f position;
     float tangent = 0;
-    animationPath_->GetPosTan(distance * progress, position, tangent);
+    arcLengthTable_.GetPosTan(distance * progress, position, tangent);
     SetPathValue(position + RSRenderPropertyAnimation::GetOriginValue(), tangent);
 #endif
 }
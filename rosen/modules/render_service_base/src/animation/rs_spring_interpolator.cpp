@@ -29,6 +29,8 @@ constexpr float MAX_DURATION = 300.0f;
 constexpr float SECONDS_TO_MICROSECONDS = 1e6f;
 constexpr float MIN_RESPONSE = 1e-8;
 constexpr float MIN_AMPLITUDE = 0.001f;
+// the error of a linear interpolation between samples [step] apart is at most step^2 / 8 * max|f''|
+constexpr float LINEAR_ERROR_FACTOR = 8.0f;
 
 RSSpringInterpolator::RSSpringInterpolator(float response, float dampingRatio, float initialOffset,
     float minimumAmplitude, float initialVelocity, float duration)
@@ -66,6 +68,7 @@ RSSpringInterpolator* RSSpringInterpolator::Unmarshalling(Parcel& parcel)
     }
     auto ret =
         new RSSpringInterpolator(response, dampingRatio, initialOffset, minimumAmplitude, initialVelocity, duration);
+    ret->BuildLookupTable();
     return ret;
 }
 
@@ -164,6 +167,42 @@ void RSSpringInterpolator::EstimateDuration()
     duration_ = std::clamp(duration_, MIN_DURATION, MAX_DURATION);
 }
 
+void RSSpringInterpolator::BuildLookupTable()
+{
+    // bound of the second derivative of the displacement: every term is decaying or oscillating at most at [rate]
+    float rate = 0.0f;
+    float amplitude = 0.0f;
+    if (dampingRatio_ < 1) {
+        rate = std::abs(coeffDecay_) + dampedAngularVelocity_;
+        amplitude = std::abs(initialOffset_) + std::abs(coeffScale_);
+    } else if (dampingRatio_ == 1) {
+        rate = std::abs(coeffDecay_);
+        amplitude = std::abs(initialOffset_) + (rate > 0 ? 2 * std::abs(coeffScale_) / rate : 0.0f);
+    } else {
+        rate = std::max(std::abs(coeffDecay_), std::abs(coeffDecayMinus_));
+        amplitude = std::abs(coeffScale_) + std::abs(coeffScaleMinus_);
+    }
+    float maxCurvature = rate * rate * amplitude;
+    float tolerance = minimumAmplitude_ > 0 ? minimumAmplitude_ : MIN_AMPLITUDE;
+    size_t sampleCount = RSInterpolatorLookupTable::MIN_SAMPLE_COUNT;
+    if (maxCurvature > 0) {
+        float step = std::sqrt(LINEAR_ERROR_FACTOR * tolerance / maxCurvature);
+        float count = std::ceil(duration_ / step) + 1;
+        if (!(count <= RSInterpolatorLookupTable::MAX_SAMPLE_COUNT)) {
+            // too stiff for a table of bounded size, keep evaluating it directly
+            ROSEN_LOGD("RSSpringInterpolator::BuildLookupTable, %.0f samples needed, evaluating directly", count);
+            return;
+        }
+        sampleCount = std::max(sampleCount, static_cast<size_t>(count));
+    }
+
+    std::vector<float> key = { response_, dampingRatio_, initialVelocity_, initialOffset_, minimumAmplitude_,
+        duration_ };
+    // sample the continuous curve, the jump to initialOffset_ at the end is left to InterpolateImpl
+    lookupTable_ = RSInterpolatorLookupTable::GetOrCreate(key, sampleCount,
+        [this](float input) { return initialOffset_ - CalculateDisplacement(input * duration_); });
+}
+
 void RSValueSpringInterpolator::UpdateParameters(
     float response, float dampingRatio, float initialVelocity, float initialOffset, float minimumAmplitude)
 {
@@ -34,5 +34,12 @@ void RSCanvasNodeCommandHelper::UpdateRecording(
     }
 }
 
+void RSCanvasNodeCommandHelper::SetCacheEnabled(RSContext& context, NodeId id, bool enabled)
+{
+    if (auto node = context.GetNodeMap().GetRenderNode<RSCanvasRenderNode>(id)) {
+        node->SetCacheEnabled(enabled);
+    }
+}
+
 } // namespace Rosen
 } // namespace OHOS
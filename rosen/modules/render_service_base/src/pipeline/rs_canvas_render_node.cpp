@@ -21,6 +21,7 @@
 #include "common/rs_obj_abs_geometry.h"
 #include "include/core/SkCanvas.h"
 #include "pipeline/rs_paint_filter_canvas.h"
+#include "pipeline/rs_render_node_cache.h"
 #include "property/rs_properties_painter.h"
 #include "render/rs_blur_filter.h"
 #endif
@@ -32,12 +33,34 @@ namespace Rosen {
 
 RSCanvasRenderNode::RSCanvasRenderNode(NodeId id, std::weak_ptr<RSContext> context) : RSRenderNode(id, context) {}
 
-RSCanvasRenderNode::~RSCanvasRenderNode() {}
+RSCanvasRenderNode::~RSCanvasRenderNode()
+{
+#ifdef ROSEN_OHOS
+    if (cacheEnabled_) {
+        RSRenderNodeCache::Instance().Purge(GetId());
+    }
+#endif
+}
 
 void RSCanvasRenderNode::UpdateRecording(std::shared_ptr<DrawCmdList> drawCmds, bool drawContentLast)
 {
     drawCmdList_ = drawCmds;
     drawContentLast_ = drawContentLast;
+    ++contentVersion_;
+    SetDirty();
+}
+
+void RSCanvasRenderNode::SetCacheEnabled(bool enabled)
+{
+    if (cacheEnabled_ == enabled) {
+        return;
+    }
+    cacheEnabled_ = enabled;
+#ifdef ROSEN_OHOS
+    if (!cacheEnabled_) {
+        RSRenderNodeCache::Instance().Purge(GetId());
+    }
+#endif
     SetDirty();
 }
 
@@ -54,6 +77,23 @@ void RSCanvasRenderNode::Process(const std::shared_ptr<RSNodeVisitor>& visitor)
 void RSCanvasRenderNode::ProcessRenderContents(RSPaintFilterCanvas& canvas)
 {
 #ifdef ROSEN_OHOS
+    if (cacheEnabled_ && drawCmdList_ != nullptr) {
+        const auto& properties = GetRenderProperties();
+        // gravity is applied while recording, a change of it invalidates the cached contents
+        if (cachedGravity_ != properties.GetFrameGravity()) {
+            cachedGravity_ = properties.GetFrameGravity();
+            ++contentVersion_;
+        }
+        auto frameRect = properties.GetFrameRect();
+        auto bounds = SkRect::MakeXYWH(frameRect.left_, frameRect.top_, frameRect.width_, frameRect.height_);
+        bool cached = RSRenderNodeCache::Instance().Draw(GetId(), contentVersion_, bounds,
+            properties.GetClipToFrame(), canvas, [this](RSPaintFilterCanvas& recordingCanvas) {
+                RSPropertiesPainter::DrawFrame(GetRenderProperties(), recordingCanvas, drawCmdList_);
+            });
+        if (cached) {
+            return;
+        }
+    }
     RSPropertiesPainter::DrawFrame(GetRenderProperties(), canvas, drawCmdList_);
 #endif
 }
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/rs_filter_result_cache.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+constexpr size_t MAX_ENTRIES = 8;
+constexpr size_t MAX_BYTES = 32 * 1024 * 1024;
+} // namespace
+
+RSFilterResultCache& RSFilterResultCache::Instance()
+{
+    static RSFilterResultCache instance;
+    return instance;
+}
+
+bool RSFilterResultCache::SamePixels(const SkBitmap& source, const SkPixmap& pixels)
+{
+    if (pixels.width() < source.width() || pixels.height() < source.height() ||
+        pixels.colorType() != source.colorType() || pixels.alphaType() != source.alphaType()) {
+        return false;
+    }
+    size_t rowBytes = source.info().minRowBytes();
+    for (int y = 0; y < source.height(); ++y) {
+        if (memcmp(source.getAddr(0, y), pixels.addr(0, y), rowBytes) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RSFilterResultCache::Get(const Key& key, const SkPixmap& pixels, Result& result)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = std::find_if(entries_.begin(), entries_.end(), [&key](const Entry& entry) { return entry.key == key; });
+    if (iter == entries_.end() || !SamePixels(iter->source, pixels)) {
+        return false;
+    }
+    entries_.splice(entries_.begin(), entries_, iter);
+    result = entries_.front().result;
+    ++hitCount_;
+    return true;
+}
+
+void RSFilterResultCache::Put(const Key& key, const SkPixmap& pixels, const Result& result)
+{
+    if (result.image == nullptr) {
+        return;
+    }
+    SkPixmap layerPixels;
+    if (!pixels.extractSubset(&layerPixels, SkIRect::MakeSize(key.size))) {
+        return;
+    }
+    Entry entry;
+    entry.key = key;
+    entry.result = result;
+    entry.bytes = result.image->imageInfo().computeMinByteSize() + layerPixels.computeByteSize();
+    if (entry.bytes > MAX_BYTES || !entry.source.tryAllocPixels(layerPixels.info()) ||
+        !entry.source.writePixels(layerPixels)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // the previous contents of the same layer are not coming back
+    auto iter = std::find_if(entries_.begin(), entries_.end(), [&key](const Entry& other) { return other.key == key; });
+    if (iter != entries_.end()) {
+        bytes_ -= iter->bytes;
+        entries_.erase(iter);
+    }
+    bytes_ += entry.bytes;
+    entries_.push_front(std::move(entry));
+    while (entries_.size() > MAX_ENTRIES || bytes_ > MAX_BYTES) {
+        bytes_ -= entries_.back().bytes;
+        entries_.pop_back();
+    }
+}
+
+void RSFilterResultCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    bytes_ = 0;
+    hitCount_ = 0;
+}
+
+size_t RSFilterResultCache::GetEntryCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+uint64_t RSFilterResultCache::GetHitCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hitCount_;
+}
+} // namespace Rosen
+} // namespace OHOS
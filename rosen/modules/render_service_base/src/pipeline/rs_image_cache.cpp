@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/rs_image_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include "include/core/SkData.h"
+#include "platform/common/rs_log.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+constexpr uint64_t CONTENT_ID_FLAG = 1ULL << 63;
+constexpr uint64_t HASH_SEED = 0x9e3779b97f4a7c15ULL;
+constexpr uint64_t MIX_MULTIPLIER_1 = 0xbf58476d1ce4e5b9ULL;
+constexpr uint64_t MIX_MULTIPLIER_2 = 0x94d049bb133111ebULL;
+constexpr int MIX_SHIFT_1 = 30;
+constexpr int MIX_SHIFT_2 = 27;
+constexpr int MIX_SHIFT_3 = 31;
+
+// splitmix64 finalizer, every bit of [value] affects every bit of the result
+uint64_t Mix(uint64_t value)
+{
+    value = (value ^ (value >> MIX_SHIFT_1)) * MIX_MULTIPLIER_1;
+    value = (value ^ (value >> MIX_SHIFT_2)) * MIX_MULTIPLIER_2;
+    return value ^ (value >> MIX_SHIFT_3);
+}
+
+uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, bytes + i, sizeof(word));
+        hash = Mix(hash ^ word);
+    }
+    if (i < size) {
+        uint64_t word = 0;
+        memcpy(&word, bytes + i, size - i);
+        hash = Mix(hash ^ word);
+    }
+    return Mix(hash ^ size);
+}
+
+// content ids keep the flag apart from the 63 bits of the hash
+uint64_t MakeContentId(uint64_t hash)
+{
+    return (hash >> 1) | CONTENT_ID_FLAG;
+}
+
+uint64_t HashPixels(const SkPixmap& pixmap)
+{
+    const int32_t header[] = { pixmap.width(), pixmap.height(), pixmap.colorType(), pixmap.alphaType() };
+    uint64_t hash = HashBytes(HASH_SEED, header, sizeof(header));
+    size_t rowBytes = pixmap.info().minRowBytes();
+    for (int y = 0; y < pixmap.height(); ++y) {
+        hash = HashBytes(hash, pixmap.addr(0, y), rowBytes);
+    }
+    return MakeContentId(hash);
+}
+
+// id of the contents of [image], 0 if they can not be read without decoding or downloading the image
+uint64_t HashContents(const SkImage& image)
+{
+    sk_sp<SkData> encoded = image.refEncodedData();
+    if (encoded != nullptr) {
+        return MakeContentId(HashBytes(HASH_SEED, encoded->data(), encoded->size()));
+    }
+    SkPixmap pixmap;
+    if (!image.peekPixels(&pixmap)) {
+        return 0;
+    }
+    return HashPixels(pixmap);
+}
+
+bool SamePixels(const SkPixmap& lhs, const SkPixmap& rhs)
+{
+    if (lhs.info() != rhs.info()) {
+        return false;
+    }
+    size_t rowBytes = lhs.info().minRowBytes();
+    for (int y = 0; y < lhs.height(); ++y) {
+        if (memcmp(lhs.addr(0, y), rhs.addr(0, y), rowBytes) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// a hash match is only a candidate, the contents are compared before [cached] replaces [image]
+bool SameContents(const SkImage& cached, const SkImage& image)
+{
+    if (cached.width() != image.width() || cached.height() != image.height()) {
+        return false;
+    }
+    sk_sp<SkData> cachedEncoded = cached.refEncodedData();
+    sk_sp<SkData> encoded = image.refEncodedData();
+    if (cachedEncoded != nullptr && encoded != nullptr) {
+        return cachedEncoded->equals(encoded.get());
+    }
+    SkPixmap cachedPixels;
+    SkPixmap pixels;
+    return cached.peekPixels(&cachedPixels) && image.peekPixels(&pixels) && SamePixels(cachedPixels, pixels);
+}
+} // namespace
+
+RSImageCache& RSImageCache::Instance()
+{
+    static RSImageCache instance;
+    return instance;
+}
+
+sk_sp<SkImage> RSImageCache::GetOrCache(const sk_sp<SkImage>& image)
+{
+    if (image == nullptr || image->isTextureBacked()) {
+        return image;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = imageIds_.find(image->uniqueID());
+        if (iter != imageIds_.end()) {
+            auto cached = UseLocked(iter->second);
+            if (cached != nullptr) {
+                return cached;
+            }
+        }
+    }
+    uint64_t id = HashContents(*image);
+    if (id == 0) {
+        return image;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(id);
+    if (iter == entries_.end()) {
+        InsertLocked(id, image);
+    } else if (SameContents(*iter->second.image, *image)) {
+        ++hitCount_;
+    } else {
+        // another image has the same hash, this one is left out of the cache
+        return image;
+    }
+    // the next time this image is recorded it is found without hashing it
+    AddImageIdLocked(id, *image);
+    return entries_[id].image;
+}
+
+sk_sp<SkImage> RSImageCache::GetOrCache(const SkBitmap& bitmap)
+{
+    SkPixmap pixmap;
+    if (bitmap.isImmutable() || !bitmap.peekPixels(&pixmap)) {
+        // images of immutable bitmaps share their pixels and generation id
+        return GetOrCache(SkImage::MakeFromBitmap(bitmap));
+    }
+    // mutable bitmaps are copied into a new image each time, only copy the ones that are not cached yet
+    uint64_t id = HashPixels(pixmap);
+    bool collided = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = entries_.find(id);
+        if (iter != entries_.end()) {
+            SkPixmap cachedPixels;
+            if (iter->second.image->peekPixels(&cachedPixels) && SamePixels(cachedPixels, pixmap)) {
+                ++hitCount_;
+                return iter->second.image;
+            }
+            collided = true;
+        }
+    }
+    auto image = SkImage::MakeFromBitmap(bitmap);
+    if (image == nullptr || collided) {
+        return image;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.find(id) == entries_.end()) {
+        InsertLocked(id, image);
+    }
+    return image;
+}
+
+void RSImageCache::CacheImage(uint64_t uniqueId, const sk_sp<SkImage>& image)
+{
+    if (image == nullptr || uniqueId >= CALLER_ID_LIMIT) {
+        ROSEN_LOGE("RSImageCache::CacheImage, invalid image or id %llu", static_cast<unsigned long long>(uniqueId));
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(uniqueId);
+    if (iter != entries_.end()) {
+        EraseLocked(iter);
+    }
+    InsertLocked(uniqueId, image);
+    AddImageIdLocked(uniqueId, *image);
+}
+
+sk_sp<SkImage> RSImageCache::GetImage(uint64_t uniqueId) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(uniqueId);
+    return iter != entries_.end() ? iter->second.image : nullptr;
+}
+
+uint64_t RSImageCache::GetImageId(const sk_sp<SkImage>& image) const
+{
+    if (image == nullptr) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = imageIds_.find(image->uniqueID());
+    return iter != imageIds_.end() ? iter->second : 0;
+}
+
+void RSImageCache::ReleaseUnusedImages()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ReleaseUnusedImagesLocked();
+}
+
+void RSImageCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    imageIds_.clear();
+    bytes_ = 0;
+    hitCount_ = 0;
+    sweepImageCount_ = MIN_SWEEP_IMAGE_COUNT;
+}
+
+size_t RSImageCache::GetImageCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+size_t RSImageCache::GetMemoryUsage() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_;
+}
+
+uint64_t RSImageCache::GetHitCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hitCount_;
+}
+
+sk_sp<SkImage> RSImageCache::UseLocked(uint64_t id)
+{
+    auto iter = entries_.find(id);
+    if (iter == entries_.end()) {
+        return nullptr;
+    }
+    ++hitCount_;
+    return iter->second.image;
+}
+
+void RSImageCache::InsertLocked(uint64_t id, const sk_sp<SkImage>& image)
+{
+    // a full scan on every insertion costs more than the images it finds, only processes without a per-frame
+    // release rely on this one
+    if (entries_.size() >= sweepImageCount_) {
+        ReleaseUnusedImagesLocked();
+    }
+    Entry& entry = entries_[id];
+    entry.image = image;
+    entry.bytes = image->imageInfo().computeMinByteSize();
+    bytes_ += entry.bytes;
+}
+
+void RSImageCache::AddImageIdLocked(uint64_t id, const SkImage& image)
+{
+    auto iter = entries_.find(id);
+    if (iter != entries_.end() && imageIds_.emplace(image.uniqueID(), id).second) {
+        iter->second.imageIds.push_back(image.uniqueID());
+    }
+}
+
+void RSImageCache::ReleaseUnusedImagesLocked()
+{
+    for (auto iter = entries_.begin(); iter != entries_.end();) {
+        auto next = std::next(iter);
+        // no one can take a new reference without going through the cache
+        if (iter->second.image->unique()) {
+            EraseLocked(iter);
+        }
+        iter = next;
+    }
+    // the images still in use are not scanned again before as many new ones were inserted
+    sweepImageCount_ = std::max(MIN_SWEEP_IMAGE_COUNT, entries_.size() * 2);
+}
+
+void RSImageCache::EraseLocked(std::unordered_map<uint64_t, Entry>::iterator iter)
+{
+    for (auto imageId : iter->second.imageIds) {
+        imageIds_.erase(imageId);
+    }
+    bytes_ -= iter->second.bytes;
+    entries_.erase(iter);
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/rs_offscreen_surface_pool.h"
+
+#include <algorithm>
+
+#include "platform/common/rs_log.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+constexpr int SIZE_ALIGNMENT = 64;
+constexpr size_t MAX_POOLED_SURFACES = 4;
+// a surface not used by the last frames is likely not needed any more (e.g. the blurred panel went away)
+constexpr uint64_t MAX_IDLE_FRAMES = 3;
+
+int AlignSize(int size)
+{
+    return (size + SIZE_ALIGNMENT - 1) / SIZE_ALIGNMENT * SIZE_ALIGNMENT;
+}
+} // namespace
+
+RSOffscreenSurfacePool& RSOffscreenSurfacePool::Instance()
+{
+    static RSOffscreenSurfacePool instance;
+    return instance;
+}
+
+sk_sp<SkSurface> RSOffscreenSurfacePool::Acquire(SkCanvas* target, int width, int height)
+{
+    if (target == nullptr || width <= 0 || height <= 0) {
+        return nullptr;
+    }
+    const GrContext* context = target->getGrContext();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // the smallest pooled surface the layer fits in
+        auto best = surfaces_.end();
+        for (auto iter = surfaces_.begin(); iter != surfaces_.end(); ++iter) {
+            if (iter->context != context || iter->surface->width() < width || iter->surface->height() < height) {
+                continue;
+            }
+            if (best == surfaces_.end() || iter->surface->width() * iter->surface->height() <
+                best->surface->width() * best->surface->height()) {
+                best = iter;
+            }
+        }
+        if (best != surfaces_.end()) {
+            auto surface = std::move(best->surface);
+            surfaces_.erase(best);
+            return surface;
+        }
+    }
+    // on a GPU canvas the layer stays on the GPU, its contents are neither read back nor uploaded
+    auto info = SkImageInfo::MakeN32Premul(AlignSize(width), AlignSize(height), target->imageInfo().refColorSpace());
+    auto surface = target->makeSurface(info);
+    if (surface == nullptr && context == nullptr) {
+        surface = SkSurface::MakeRaster(info);
+    }
+    if (surface == nullptr) {
+        ROSEN_LOGE("RSOffscreenSurfacePool::Acquire, failed to create surface of [%d %d]", width, height);
+    }
+    return surface;
+}
+
+void RSOffscreenSurfacePool::Release(sk_sp<SkSurface> surface)
+{
+    if (surface == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (surfaces_.size() >= MAX_POOLED_SURFACES) {
+        // keep the most recently used ones
+        surfaces_.erase(surfaces_.begin());
+    }
+    Entry entry;
+    entry.context = surface->getCanvas()->getGrContext();
+    entry.surface = std::move(surface);
+    entry.lastUsedFrame = frameCount_;
+    surfaces_.push_back(std::move(entry));
+}
+
+void RSOffscreenSurfacePool::OnFrameEnd()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++frameCount_;
+    surfaces_.erase(std::remove_if(surfaces_.begin(), surfaces_.end(),
+        [this](const Entry& entry) { return frameCount_ - entry.lastUsedFrame > MAX_IDLE_FRAMES; }),
+        surfaces_.end());
+}
+
+void RSOffscreenSurfacePool::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    surfaces_.clear();
+}
+
+size_t RSOffscreenSurfacePool::GetSurfaceCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return surfaces_.size();
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -15,13 +15,28 @@
 
 #include "pipeline/rs_paint_filter_canvas.h"
 
+#include "include/core/SkImage.h"
+#include "include/core/SkImageFilter.h"
+
+#include "pipeline/rs_filter_result_cache.h"
+#include "pipeline/rs_offscreen_surface_pool.h"
+#include "platform/common/rs_log.h"
+
 namespace OHOS {
 namespace Rosen {
 
 RSPaintFilterCanvas::RSPaintFilterCanvas(SkCanvas* canvas, float alpha)
-    : SkPaintFilterCanvas(canvas), alpha_(std::clamp(alpha, 0.f, 1.f))
+    : SkPaintFilterCanvas(canvas), alpha_(std::clamp(alpha, 0.f, 1.f)), canvas_(canvas)
 {}
 
+RSPaintFilterCanvas::~RSPaintFilterCanvas()
+{
+    // draw back the layers left open, SkCanvas does not call our willRestore once we are destroyed
+    if (!offscreenLayers_.empty()) {
+        restoreToCount(offscreenLayers_.front().saveCount - 1);
+    }
+}
+
 bool RSPaintFilterCanvas::onFilter(SkPaint& paint) const
 {
     if (alpha_ >= 1.f) {
@@ -42,6 +57,168 @@ void RSPaintFilterCanvas::onDrawPicture(const SkPicture* picture, const SkMatrix
     }
 }
 
+SkCanvas::SaveLayerStrategy RSPaintFilterCanvas::getSaveLayerStrategy(const SaveLayerRec& rec)
+{
+    if (offscreenFilterLayerEnabled_ && rec.fPaint != nullptr && rec.fPaint->getImageFilter() != nullptr &&
+        BeginOffscreenLayer(rec)) {
+        // the layer is kept by us, SkCanvas only saves the state
+        return kNoLayer_SaveLayerStrategy;
+    }
+    return SkPaintFilterCanvas::getSaveLayerStrategy(rec);
+}
+
+void RSPaintFilterCanvas::willRestore()
+{
+    // getSaveCount is decremented after willRestore
+    if (!offscreenLayers_.empty() && offscreenLayers_.back().saveCount == getSaveCount()) {
+        EndOffscreenLayer();
+        return;
+    }
+    SkPaintFilterCanvas::willRestore();
+}
+
+void RSPaintFilterCanvas::didSetMatrix(const SkMatrix& matrix)
+{
+    if (offscreenLayers_.empty()) {
+        SkPaintFilterCanvas::didSetMatrix(matrix);
+        return;
+    }
+    // [matrix] is relative to the wrapped canvas, the layer surface starts at the layer bounds
+    const auto& layer = offscreenLayers_.back();
+    SkMatrix layerMatrix = matrix;
+    layerMatrix.postTranslate(-layer.origin.x(), -layer.origin.y());
+    layer.surface->getCanvas()->setMatrix(layerMatrix);
+}
+
+bool RSPaintFilterCanvas::BeginOffscreenLayer(const SaveLayerRec& rec)
+{
+    if (rec.fBackdrop != nullptr || rec.fClipMask != nullptr) {
+        return false;
+    }
+    SkCanvas* target = offscreenLayers_.empty() ? canvas_ : offscreenLayers_.back().surface->getCanvas();
+    SkMatrix matrix = target->getTotalMatrix();
+    SkMatrix filterMatrix;
+    // the filter runs in device space, other transforms are left to the skia layer
+    if (!matrix.isScaleTranslate()) {
+        return false;
+    }
+    filterMatrix.setScale(matrix.getScaleX(), matrix.getScaleY());
+
+    SkIRect outputBounds = target->getDeviceClipBounds();
+    if (rec.fBounds != nullptr && !outputBounds.intersect(matrix.mapRect(*rec.fBounds).roundOut())) {
+        outputBounds.setEmpty();
+    }
+    if (outputBounds.isEmpty()) {
+        // nothing is visible, the skia layer is cheap
+        return false;
+    }
+    // same bounds as a skia layer: what the filter reads to produce the visible part
+    SkIRect bounds = rec.fPaint->getImageFilter()->filterBounds(
+        outputBounds, filterMatrix, SkImageFilter::kReverse_MapDirection, nullptr);
+    if (!bounds.intersect(SkIRect::MakeSize(target->getBaseLayerSize()))) {
+        return false;
+    }
+
+    auto surface = RSOffscreenSurfacePool::Instance().Acquire(target, bounds.width(), bounds.height());
+    if (surface == nullptr) {
+        return false;
+    }
+    SkCanvas* layerCanvas = surface->getCanvas();
+    layerCanvas->clear(SK_ColorTRANSPARENT);
+    if ((rec.fSaveLayerFlags & kInitWithPrevious_SaveLayerFlag) && !InitWithPrevious(target, surface.get(), bounds)) {
+        ROSEN_LOGE("RSPaintFilterCanvas::BeginOffscreenLayer, failed to read previous content");
+    }
+    layerCanvas->save();
+    layerCanvas->translate(-bounds.x(), -bounds.y());
+    layerCanvas->clipRect(SkRect::Make(outputBounds));
+    layerCanvas->concat(matrix);
+
+    OffscreenLayer layer;
+    layer.canvas = target;
+    layer.surface = std::move(surface);
+    layer.bounds = bounds;
+    layer.outputBounds = outputBounds;
+    layer.origin = offscreenLayers_.empty() ? bounds.topLeft() : offscreenLayers_.back().origin + bounds.topLeft();
+    layer.paint = *rec.fPaint;
+    layer.filterMatrix = filterMatrix;
+    // SkCanvas increments the save count once the strategy is chosen
+    layer.saveCount = getSaveCount() + 1;
+    offscreenLayers_.push_back(std::move(layer));
+
+    // draws until the matching restore go to the layer
+    removeAll();
+    addCanvas(layerCanvas);
+    return true;
+}
+
+bool RSPaintFilterCanvas::InitWithPrevious(SkCanvas* target, SkSurface* surface, const SkIRect& bounds)
+{
+    // copied on the device of [target], reading a GPU canvas back would stall until the GPU caught up
+    if (target->getSurface() != nullptr) {
+        auto previous = target->getSurface()->makeImageSnapshot(bounds);
+        if (previous == nullptr) {
+            return false;
+        }
+        SkPaint paint;
+        paint.setBlendMode(SkBlendMode::kSrc);
+        surface->getCanvas()->drawImage(previous, 0, 0, &paint);
+        return true;
+    }
+    SkPixmap pixmap;
+    return target->getGrContext() == nullptr && surface->peekPixels(&pixmap) &&
+        target->readPixels(pixmap.info().makeWH(bounds.width(), bounds.height()), pixmap.writable_addr(),
+            pixmap.rowBytes(), bounds.x(), bounds.y());
+}
+
+void RSPaintFilterCanvas::EndOffscreenLayer()
+{
+    OffscreenLayer layer = std::move(offscreenLayers_.back());
+    offscreenLayers_.pop_back();
+    removeAll();
+    addCanvas(layer.canvas);
+
+    SkCanvas* layerCanvas = layer.surface->getCanvas();
+    layerCanvas->restoreToCount(1);
+
+    // static contents (e.g. behind a background blur) are filtered once
+    RSFilterResultCache::Key key;
+    key.filter = sk_ref_sp(layer.paint.getImageFilter());
+    key.matrix = layer.filterMatrix;
+    key.size = layer.bounds.size();
+    key.clipBounds = layer.outputBounds.makeOffset(-layer.bounds.x(), -layer.bounds.y());
+    // only raster layers, the pixels of a GPU layer would have to be read back to be compared
+    SkPixmap pixmap;
+    bool cacheable = layer.surface->peekPixels(&pixmap);
+    RSFilterResultCache::Result result;
+    if (!cacheable || !RSFilterResultCache::Instance().Get(key, pixmap, result)) {
+        sk_sp<SkImage> image = layer.surface->makeImageSnapshot();
+        sk_sp<SkImageFilter> filter = key.filter->makeWithLocalMatrix(layer.filterMatrix);
+        if (image != nullptr) {
+            result.image = image->makeWithFilter(filter.get(), SkIRect::MakeSize(key.size), key.clipBounds,
+                &result.subset, &result.offset);
+        }
+        if (cacheable) {
+            RSFilterResultCache::Instance().Put(key, pixmap, result);
+        }
+    }
+    if (result.image != nullptr) {
+        SkPaint paint(layer.paint);
+        paint.setImageFilter(nullptr);
+        SkRect dst = SkRect::MakeXYWH(layer.bounds.x() + result.offset.x(), layer.bounds.y() + result.offset.y(),
+            result.subset.width(), result.subset.height());
+        layer.canvas->save();
+        layer.canvas->resetMatrix();
+        layer.canvas->drawImageRect(result.image, result.subset, dst, &paint);
+        layer.canvas->restore();
+    } else {
+        ROSEN_LOGE("RSPaintFilterCanvas::EndOffscreenLayer, failed to filter layer of [%d %d]",
+            layer.bounds.width(), layer.bounds.height());
+    }
+    // release the snapshot first so that the surface is not copied on its next use
+    result.image = nullptr;
+    RSOffscreenSurfacePool::Instance().Release(std::move(layer.surface));
+}
+
 void RSPaintFilterCanvas::MultiplyAlpha(float alpha)
 {
     alpha_ = alpha_ * std::clamp(alpha, 0.f, 1.f);
@@ -17,9 +17,23 @@
 
 #include "platform/common/rs_log.h"
 #include "pipeline/rs_draw_cmd.h"
+#include "pipeline/rs_image_cache.h"
 
 namespace OHOS {
 namespace Rosen {
+namespace {
+// nodes and frames drawing the same contents share one image
+sk_sp<SkImage> GetSharedImage(const sk_sp<SkImage>& image)
+{
+    return RSImageCache::Instance().GetOrCache(image);
+}
+
+sk_sp<SkImage> GetSharedImage(const SkBitmap& bitmap)
+{
+    return RSImageCache::Instance().GetOrCache(bitmap);
+}
+} // namespace
+
 RSRecordingCanvas::RSRecordingCanvas(int width, int height) : SkCanvasVirtualEnforcer<SkNoDrawCanvas>(width, height)
 {
     drawCmdList_ = std::make_shared<DrawCmdList>(width, height);
@@ -135,14 +149,15 @@ void RSRecordingCanvas::onDrawPaint(const SkPaint& paint)
 void RSRecordingCanvas::DrawImageWithParm(const sk_sp<SkImage>img, int fitNum, int repeatNum, float radius,
     const SkPaint& paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<ImageWithParmOpItem>(img, fitNum, repeatNum, radius, paint);
+    std::unique_ptr<OpItem> op =
+        std::make_unique<ImageWithParmOpItem>(GetSharedImage(img), fitNum, repeatNum, radius, paint);
     AddOp(std::move(op));
 }
 
 void RSRecordingCanvas::DrawImageWithParm(const sk_sp<SkImage>img, const Rosen::RsImageInfo& rsimageInfo,
     const SkPaint& paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<ImageWithParmOpItem>(img, rsimageInfo, paint);
+    std::unique_ptr<OpItem> op = std::make_unique<ImageWithParmOpItem>(GetSharedImage(img), rsimageInfo, paint);
     AddOp(std::move(op));
 }
 
@@ -221,56 +236,56 @@ void RSRecordingCanvas::onDrawTextBlob(const SkTextBlob* blob, SkScalar x, SkSca
 
 void RSRecordingCanvas::onDrawBitmap(const SkBitmap& bm, SkScalar x, SkScalar y, const SkPaint* paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<BitmapOpItem>(SkImage::MakeFromBitmap(bm), x, y, paint);
+    std::unique_ptr<OpItem> op = std::make_unique<BitmapOpItem>(GetSharedImage(bm), x, y, paint);
     AddOp(std::move(op));
 }
 
 void RSRecordingCanvas::onDrawBitmapNine(
     const SkBitmap& bm, const SkIRect& center, const SkRect& dst, const SkPaint* paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<BitmapNineOpItem>(SkImage::MakeFromBitmap(bm), center, dst, paint);
+    std::unique_ptr<OpItem> op = std::make_unique<BitmapNineOpItem>(GetSharedImage(bm), center, dst, paint);
     AddOp(std::move(op));
 }
 
 void RSRecordingCanvas::onDrawBitmapRect(
     const SkBitmap& bm, const SkRect* src, const SkRect& dst, const SkPaint* paint, SrcRectConstraint constraint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<BitmapRectOpItem>(SkImage::MakeFromBitmap(bm), src, dst, paint);
+    std::unique_ptr<OpItem> op = std::make_unique<BitmapRectOpItem>(GetSharedImage(bm), src, dst, paint);
     AddOp(std::move(op));
 }
 
 void RSRecordingCanvas::onDrawBitmapLattice(
     const SkBitmap& bm, const SkCanvas::Lattice& lattice, const SkRect& dst, const SkPaint* paint)
 {
-    std::unique_ptr<OpItem> op =
-        std::make_unique<BitmapLatticeOpItem>(SkImage::MakeFromBitmap(bm), lattice, dst, paint);
+    std::unique_ptr<OpItem> op = std::make_unique<BitmapLatticeOpItem>(GetSharedImage(bm), lattice, dst, paint);
     AddOp(std::move(op));
 }
 
 void RSRecordingCanvas::onDrawImage(const SkImage* img, SkScalar x, SkScalar y, const SkPaint* paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<BitmapOpItem>(sk_ref_sp(img), x, y, paint);
+    std::unique_ptr<OpItem> op = std::make_unique<BitmapOpItem>(GetSharedImage(sk_ref_sp(img)), x, y, paint);
     AddOp(std::move(op));
 }
 
 void RSRecordingCanvas::onDrawImageNine(
     const SkImage* img, const SkIRect& center, const SkRect& dst, const SkPaint* paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<BitmapNineOpItem>(sk_ref_sp(img), center, dst, paint);
+    std::unique_ptr<OpItem> op = std::make_unique<BitmapNineOpItem>(GetSharedImage(sk_ref_sp(img)), center, dst, paint);
     AddOp(std::move(op));
 }
 
 void RSRecordingCanvas::onDrawImageRect(
     const SkImage* img, const SkRect* src, const SkRect& dst, const SkPaint* paint, SrcRectConstraint constraint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<BitmapRectOpItem>(sk_ref_sp(img), src, dst, paint);
+    std::unique_ptr<OpItem> op = std::make_unique<BitmapRectOpItem>(GetSharedImage(sk_ref_sp(img)), src, dst, paint);
     AddOp(std::move(op));
 }
 
 void RSRecordingCanvas::onDrawImageLattice(
     const SkImage* img, const SkCanvas::Lattice& lattice, const SkRect& dst, const SkPaint* paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<BitmapLatticeOpItem>(sk_ref_sp(img), lattice, dst, paint);
+    std::unique_ptr<OpItem> op =
+        std::make_unique<BitmapLatticeOpItem>(GetSharedImage(sk_ref_sp(img)), lattice, dst, paint);
     AddOp(std::move(op));
 }
 
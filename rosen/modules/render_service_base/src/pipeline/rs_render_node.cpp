@@ -69,6 +69,11 @@ bool RSRenderNode::Animate(int64_t timestamp)
     return animationManager_.Animate(timestamp);
 }
 
+bool RSRenderNode::Animate(int64_t timestamp, RSAnimationBatch& batch)
+{
+    return animationManager_.Animate(timestamp, batch);
+}
+
 bool RSRenderNode::Update(RSDirtyRegionManager& dirtyManager, const RSProperties* parent, bool parentDirty)
 {
     if (!renderProperties_.GetVisible()) {
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/rs_render_node_cache.h"
+
+#include <cmath>
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkSurface.h"
+
+#include "pipeline/rs_paint_filter_canvas.h"
+#include "platform/common/rs_log.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+constexpr size_t DEFAULT_MEMORY_BUDGET = 32 * 1024 * 1024; // 32MB
+// a single raster entry may not take more than 1/4 of the budget
+constexpr size_t RASTER_BUDGET_DIVISOR = 4;
+// pictures with fewer ops are cheap enough to replay, rasterizing them only costs memory
+constexpr int RASTER_OP_THRESHOLD = 8;
+constexpr size_t BYTES_PER_PIXEL = 4;
+} // namespace
+
+RSRenderNodeCache& RSRenderNodeCache::Instance()
+{
+    static RSRenderNodeCache instance;
+    return instance;
+}
+
+RSRenderNodeCache::RSRenderNodeCache() : memoryBudget_(DEFAULT_MEMORY_BUDGET) {}
+
+bool RSRenderNodeCache::Draw(NodeId id, uint64_t version, const SkRect& bounds, bool clipToBounds,
+    RSPaintFilterCanvas& canvas, const Recorder& recorder)
+{
+    if (bounds.isEmpty() || !recorder) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& entry = *FindOrCreate(id);
+    if (entry.picture == nullptr || entry.version != version || entry.bounds != bounds) {
+        ++missCount_;
+        Record(entry, version, bounds, recorder);
+    } else {
+        ++hitCount_;
+    }
+    entry.clipToBounds = clipToBounds;
+    if (entry.picture == nullptr) {
+        return false;
+    }
+
+    const SkMatrix matrix = canvas.getTotalMatrix();
+    // an image drawn at a fractional offset or under rotation would be resampled, blurring the contents
+    bool axisAligned = matrix.isScaleTranslate() && matrix.getScaleX() > 0.f && matrix.getScaleY() > 0.f;
+    SkScalar scaleX = SkVector::Length(matrix.getScaleX(), matrix.getSkewY());
+    SkScalar scaleY = SkVector::Length(matrix.getSkewX(), matrix.getScaleY());
+    bool stableScale = ROSEN_EQ(scaleX, entry.lastScaleX) && ROSEN_EQ(scaleY, entry.lastScaleY);
+    entry.lastScaleX = scaleX;
+    entry.lastScaleY = scaleY;
+
+    bool imageMatched = entry.image != nullptr && ROSEN_EQ(scaleX, entry.imageScaleX) &&
+        ROSEN_EQ(scaleY, entry.imageScaleY);
+    if (!imageMatched) {
+        entry.image = nullptr;
+        // only rasterize once the scale settled, scaling animations would rasterize on every frame otherwise
+        if (stableScale && entry.clipToBounds && axisAligned &&
+            entry.picture->approximateOpCount() >= RASTER_OP_THRESHOLD) {
+            Rasterize(entry, scaleX, scaleY);
+        }
+    }
+
+    if (entry.image != nullptr && axisAligned) {
+        // the image has the scale of the matrix, draw it 1:1 at whole device pixels
+        SkPoint origin;
+        matrix.mapXY(entry.bounds.left(), entry.bounds.top(), &origin);
+        canvas.save();
+        canvas.resetMatrix();
+        canvas.drawImage(entry.image, std::round(origin.x()), std::round(origin.y()));
+        canvas.restore();
+    } else {
+        canvas.drawPicture(entry.picture);
+    }
+    canvas.concat(entry.matrix);
+    UpdateSize(entry);
+    EvictIfNeeded();
+    return true;
+}
+
+RSRenderNodeCache::EntryList::iterator RSRenderNodeCache::FindOrCreate(NodeId id)
+{
+    auto iter = entries_.find(id);
+    if (iter != entries_.end()) {
+        // move to the front of lru list
+        lruList_.splice(lruList_.begin(), lruList_, iter->second);
+        return iter->second;
+    }
+    lruList_.emplace_front();
+    lruList_.front().id = id;
+    entries_.emplace(id, lruList_.begin());
+    return lruList_.begin();
+}
+
+void RSRenderNodeCache::Record(Entry& entry, uint64_t version, const SkRect& bounds, const Recorder& recorder)
+{
+    SkPictureRecorder pictureRecorder;
+    SkCanvas* recordingCanvas = pictureRecorder.beginRecording(bounds);
+    if (recordingCanvas == nullptr) {
+        ROSEN_LOGE("RSRenderNodeCache::Record beginRecording failed, node %llu", entry.id);
+        entry.picture = nullptr;
+        entry.image = nullptr;
+        return;
+    }
+    RSPaintFilterCanvas filterCanvas(recordingCanvas);
+    recorder(filterCanvas);
+    entry.matrix = filterCanvas.getTotalMatrix();
+    entry.picture = pictureRecorder.finishRecordingAsPicture();
+    entry.image = nullptr;
+    entry.version = version;
+    entry.bounds = bounds;
+}
+
+void RSRenderNodeCache::Rasterize(Entry& entry, SkScalar scaleX, SkScalar scaleY)
+{
+    if (scaleX <= 0.f || scaleY <= 0.f) {
+        return;
+    }
+    int width = static_cast<int>(std::ceil(entry.bounds.width() * scaleX));
+    int height = static_cast<int>(std::ceil(entry.bounds.height() * scaleY));
+    if (width <= 0 || height <= 0 ||
+        static_cast<size_t>(width) * static_cast<size_t>(height) * BYTES_PER_PIXEL >
+            memoryBudget_ / RASTER_BUDGET_DIVISOR) {
+        return;
+    }
+    auto surface = SkSurface::MakeRasterN32Premul(width, height);
+    if (surface == nullptr) {
+        ROSEN_LOGE("RSRenderNodeCache::Rasterize create surface [%d %d] failed", width, height);
+        return;
+    }
+    auto rasterCanvas = surface->getCanvas();
+    rasterCanvas->scale(scaleX, scaleY);
+    rasterCanvas->translate(-entry.bounds.left(), -entry.bounds.top());
+    rasterCanvas->drawPicture(entry.picture);
+    entry.image = surface->makeImageSnapshot();
+    entry.imageScaleX = scaleX;
+    entry.imageScaleY = scaleY;
+}
+
+void RSRenderNodeCache::UpdateSize(Entry& entry)
+{
+    size_t bytes = entry.picture ? entry.picture->approximateBytesUsed() : 0;
+    if (entry.image != nullptr) {
+        bytes += static_cast<size_t>(entry.image->width()) * static_cast<size_t>(entry.image->height()) *
+            BYTES_PER_PIXEL;
+    }
+    memoryUsage_ = memoryUsage_ - entry.bytes + bytes;
+    entry.bytes = bytes;
+}
+
+void RSRenderNodeCache::EvictIfNeeded()
+{
+    while (memoryUsage_ > memoryBudget_ && !lruList_.empty()) {
+        auto& victim = lruList_.back();
+        memoryUsage_ -= victim.bytes;
+        entries_.erase(victim.id);
+        lruList_.pop_back();
+        ++evictCount_;
+    }
+}
+
+void RSRenderNodeCache::Purge(NodeId id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(id);
+    if (iter == entries_.end()) {
+        return;
+    }
+    memoryUsage_ -= iter->second->bytes;
+    lruList_.erase(iter->second);
+    entries_.erase(iter);
+}
+
+void RSRenderNodeCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    lruList_.clear();
+    entries_.clear();
+    memoryUsage_ = 0;
+}
+
+void RSRenderNodeCache::SetMemoryBudget(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    memoryBudget_ = bytes;
+    EvictIfNeeded();
+}
+
+size_t RSRenderNodeCache::GetMemoryBudget() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return memoryBudget_;
+}
+
+size_t RSRenderNodeCache::GetMemoryUsage() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return memoryUsage_;
+}
+
+size_t RSRenderNodeCache::GetEntryCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+void RSRenderNodeCache::Dump(std::string& dumpString) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    dumpString.append("\n");
+    dumpString.append("-- RenderNodeCache\n");
+    dumpString += "entries: " + std::to_string(entries_.size()) + ", memory: " + std::to_string(memoryUsage_) +
+        "/" + std::to_string(memoryBudget_) + " bytes\n";
+    dumpString += "hit: " + std::to_string(hitCount_) + ", miss: " + std::to_string(missCount_) +
+        ", evict: " + std::to_string(evictCount_) + "\n";
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -25,52 +25,68 @@ namespace Rosen {
 RSRenderNodeMap::RSRenderNodeMap()
 {
     // add animation fallback node
-    renderNodeMap_.emplace(0, new RSCanvasRenderNode(0));
+    RegisterRenderNode(std::make_shared<RSCanvasRenderNode>(0));
 }
 
 bool RSRenderNodeMap::RegisterRenderNode(const std::shared_ptr<RSBaseRenderNode>& nodePtr)
 {
     NodeId id = nodePtr->GetId();
-    if (renderNodeMap_.find(id) != renderNodeMap_.end()) {
+    if (!renderNodeMap_.Emplace(id, nodePtr)) {
         return false;
     }
-    renderNodeMap_.emplace(id, nodePtr);
+    pidNodes_[ExtractPid(id)].insert(id);
     return true;
 }
 
 void RSRenderNodeMap::UnregisterRenderNode(NodeId id)
 {
-    renderNodeMap_.erase(id);
+    if (!renderNodeMap_.Erase(id)) {
+        return;
+    }
+    auto iter = pidNodes_.find(ExtractPid(id));
+    if (iter == pidNodes_.end()) {
+        return;
+    }
+    iter->second.erase(id);
+    if (iter->second.empty()) {
+        pidNodes_.erase(iter);
+    }
 }
 
 void RSRenderNodeMap::FilterNodeByPid(pid_t pid)
 {
     ROSEN_LOGI("RSRenderNodeMap::FilterNodeByPid removing all nodes belong to pid %d", pid);
-    // remove all nodes belong to given pid (by matching higher 32 bits of node id)
-    std::__libcpp_erase_if_container(renderNodeMap_, [pid](const auto& pair) -> bool {
-        if (static_cast<pid_t>(pair.first >> 32) != pid) {
-            return false;
+    auto iter = pidNodes_.find(pid);
+    if (iter == pidNodes_.end()) {
+        return;
+    }
+    for (auto id : iter->second) {
+        auto node = GetRenderNode<RSBaseRenderNode>(id);
+        if (node == nullptr) {
+            continue;
         }
-        pair.second->RemoveFromTree();
-        return true;
-    });
+        renderNodeMap_.Erase(id);
+        node->RemoveFromTree();
+    }
+    pidNodes_.erase(iter);
 }
 
 void RSRenderNodeMap::DumpNodeNotOnTree(std::string& dumpString) const
 {
     dumpString.append("\n");
     dumpString.append("-- Node Not On Tree\n");
-    for (auto it = renderNodeMap_.begin(); it != renderNodeMap_.end(); it++) {
-        if ((*it).second->GetType() == RSRenderNodeType::SURFACE_NODE && !(*it).second->IsOnTheTree()) {
-            dumpString += "\n node Id[" + std::to_string((*it).first) + "]:\n";
-            auto node = RSBaseRenderNode::ReinterpretCast<RSSurfaceRenderNode>((*it).second);
-            auto& surfaceConsumer = node->GetConsumer();
-            if (surfaceConsumer == nullptr) {
-                continue;
-            }
-            surfaceConsumer->Dump(dumpString);
+    renderNodeMap_.ForEach([&dumpString](NodeId id, const std::shared_ptr<RSBaseRenderNode>& renderNode) {
+        if (renderNode->GetType() != RSRenderNodeType::SURFACE_NODE || renderNode->IsOnTheTree()) {
+            return;
         }
-    }
+        dumpString += "\n node Id[" + std::to_string(id) + "]:\n";
+        auto node = RSBaseRenderNode::ReinterpretCast<RSSurfaceRenderNode>(renderNode);
+        auto& surfaceConsumer = node->GetConsumer();
+        if (surfaceConsumer == nullptr) {
+            return;
+        }
+        surfaceConsumer->Dump(dumpString);
+    });
 }
 
 void RSRenderNodeMap::DumpAllNodeMemSize(std::string& dumpString) const
@@ -79,35 +95,36 @@ void RSRenderNodeMap::DumpAllNodeMemSize(std::string& dumpString) const
     dumpString.append("-- All Surfaces Memory Size\n");
     dumpString.append("the memory size of all surfaces buffer is : dumpend");
 
-    for (auto it = renderNodeMap_.begin(); it != renderNodeMap_.end(); it++) {
-        if ((*it).second->GetType() != RSRenderNodeType::SURFACE_NODE) {
-            continue;
+    bool dumped = false;
+    renderNodeMap_.ForEach([&dumpString, &dumped](NodeId, const std::shared_ptr<RSBaseRenderNode>& renderNode) {
+        if (dumped || renderNode->GetType() != RSRenderNodeType::SURFACE_NODE) {
+            return;
         }
-        auto node = RSBaseRenderNode::ReinterpretCast<RSSurfaceRenderNode>((*it).second);
+        auto node = RSBaseRenderNode::ReinterpretCast<RSSurfaceRenderNode>(renderNode);
         auto& surfaceConsumer = node->GetConsumer();
         surfaceConsumer->Dump(dumpString);
-        break;
-    }
+        dumped = true;
+    });
 }
 
 
 template<>
 const std::shared_ptr<RSBaseRenderNode> RSRenderNodeMap::GetRenderNode(NodeId id) const
 {
-    auto itr = renderNodeMap_.find(id);
-    if (itr == renderNodeMap_.end()) {
+    auto node = renderNodeMap_.Find(id);
+    if (node == nullptr) {
         return nullptr;
     }
-    return itr->second;
+    return *node;
 }
 
 const std::shared_ptr<RSRenderNode> RSRenderNodeMap::GetAnimationFallbackNode() const
 {
-    auto itr = renderNodeMap_.find(0);
-    if (itr == renderNodeMap_.end()) {
+    auto node = renderNodeMap_.Find(0);
+    if (node == nullptr) {
         return nullptr;
     }
-    return std::static_pointer_cast<RSRenderNode>(renderNodeMap_.at(0));
+    return std::static_pointer_cast<RSRenderNode>(*node);
 }
 
 } // namespace Rosen
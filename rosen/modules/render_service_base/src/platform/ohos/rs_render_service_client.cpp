@@ -99,18 +99,44 @@ void RSRenderServiceClient::TriggerSurfaceCaptureCallback(NodeId id, Media::Pixe
     callback->OnSurfaceCapture(surfaceCapture);
 }
 
+void RSRenderServiceClient::TriggerContinuousSurfaceCaptureCallback(NodeId id, Media::PixelMap* pixelmap)
+{
+    std::shared_ptr<Media::PixelMap> surfaceCapture(pixelmap);
+    std::shared_ptr<SurfaceCaptureCallback> callback = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = continuousCaptureCbMap_.find(id);
+        if (iter != continuousCaptureCbMap_.end()) {
+            callback = iter->second;
+        }
+    }
+    if (callback == nullptr) {
+        // frames may still arrive after the capture was stopped
+        ROSEN_LOGD("RSRenderServiceClient::TriggerContinuousSurfaceCaptureCallback: callback is nullptr!");
+        return;
+    }
+    callback->OnSurfaceCapture(surfaceCapture);
+}
+
+// One-shot and continuous captures of the same node are told apart by the director they are delivered to.
 class SurfaceCaptureCallbackDirector : public RSSurfaceCaptureCallbackStub
 {
 public:
-    explicit SurfaceCaptureCallbackDirector(RSRenderServiceClient* client) : client_(client) {}
+    SurfaceCaptureCallbackDirector(RSRenderServiceClient* client, bool continuous)
+        : client_(client), continuous_(continuous) {}
     ~SurfaceCaptureCallbackDirector() override {};
     void OnSurfaceCapture(NodeId id, Media::PixelMap* pixelmap) override
     {
-        client_->TriggerSurfaceCaptureCallback(id, pixelmap);
+        if (continuous_) {
+            client_->TriggerContinuousSurfaceCaptureCallback(id, pixelmap);
+        } else {
+            client_->TriggerSurfaceCaptureCallback(id, pixelmap);
+        }
     };
 
 private:
     RSRenderServiceClient* client_;
+    bool continuous_;
 };
 
 bool RSRenderServiceClient::TakeSurfaceCapture(NodeId id, std::shared_ptr<SurfaceCaptureCallback> callback,
@@ -135,12 +161,56 @@ bool RSRenderServiceClient::TakeSurfaceCapture(NodeId id, std::shared_ptr<Surfac
     }
 
     if (surfaceCaptureCbDirector_ == nullptr) {
-        surfaceCaptureCbDirector_ = new SurfaceCaptureCallbackDirector(this);
+        surfaceCaptureCbDirector_ = new SurfaceCaptureCallbackDirector(this, false);
     }
     renderService->TakeSurfaceCapture(id, surfaceCaptureCbDirector_, scaleX, scaleY);
     return true;
 }
 
+bool RSRenderServiceClient::StartContinuousSurfaceCapture(NodeId id, std::shared_ptr<SurfaceCaptureCallback> callback,
+    float scaleX, float scaleY, uint32_t fps)
+{
+    auto renderService = RSRenderServiceConnectHub::GetRenderService();
+    if (renderService == nullptr) {
+        ROSEN_LOGE("RSRenderServiceClient::StartContinuousSurfaceCapture renderService == nullptr!");
+        return false;
+    }
+    if (callback == nullptr) {
+        ROSEN_LOGE("RSRenderServiceClient::StartContinuousSurfaceCapture callback == nullptr!");
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (continuousCaptureCbMap_.count(id) != 0) {
+            ROSEN_LOGW("RSRenderServiceClient::StartContinuousSurfaceCapture node is captured already");
+            return false;
+        }
+        continuousCaptureCbMap_.emplace(id, callback);
+    }
+
+    if (continuousCaptureCbDirector_ == nullptr) {
+        continuousCaptureCbDirector_ = new SurfaceCaptureCallbackDirector(this, true);
+    }
+    renderService->StartContinuousSurfaceCapture(id, continuousCaptureCbDirector_, scaleX, scaleY, fps);
+    return true;
+}
+
+void RSRenderServiceClient::StopContinuousSurfaceCapture(NodeId id)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (continuousCaptureCbMap_.erase(id) == 0) {
+            return;
+        }
+    }
+    auto renderService = RSRenderServiceConnectHub::GetRenderService();
+    if (renderService == nullptr) {
+        ROSEN_LOGE("RSRenderServiceClient::StopContinuousSurfaceCapture renderService == nullptr!");
+        return;
+    }
+    renderService->StopContinuousSurfaceCapture(id);
+}
+
 ScreenId RSRenderServiceClient::GetDefaultScreenId()
 {
     auto renderService = RSRenderServiceConnectHub::GetRenderService();
@@ -323,6 +323,52 @@ void RSRenderServiceConnectionProxy::TakeSurfaceCapture(NodeId id, sptr<RSISurfa
     }
 }
 
+void RSRenderServiceConnectionProxy::StartContinuousSurfaceCapture(NodeId id,
+    sptr<RSISurfaceCaptureCallback> callback, float scaleX, float scaleY, uint32_t fps)
+{
+    if (callback == nullptr) {
+        ROSEN_LOGE("RSRenderServiceProxy: callback == nullptr\n");
+        return;
+    }
+
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+    if (!data.WriteInterfaceToken(RSIRenderServiceConnection::GetDescriptor())) {
+        return;
+    }
+    option.SetFlags(MessageOption::TF_ASYNC);
+    data.WriteUint64(id);
+    data.WriteRemoteObject(callback->AsObject());
+    data.WriteFloat(scaleX);
+    data.WriteFloat(scaleY);
+    data.WriteUint32(fps);
+    int32_t err = Remote()->SendRequest(
+        RSIRenderServiceConnection::START_CONTINUOUS_SURFACE_CAPTURE, data, reply, option);
+    if (err != NO_ERROR) {
+        ROSEN_LOGE("RSRenderServiceProxy: Remote()->SendRequest() error.\n");
+        return;
+    }
+}
+
+void RSRenderServiceConnectionProxy::StopContinuousSurfaceCapture(NodeId id)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+    if (!data.WriteInterfaceToken(RSIRenderServiceConnection::GetDescriptor())) {
+        return;
+    }
+    option.SetFlags(MessageOption::TF_ASYNC);
+    data.WriteUint64(id);
+    int32_t err = Remote()->SendRequest(
+        RSIRenderServiceConnection::STOP_CONTINUOUS_SURFACE_CAPTURE, data, reply, option);
+    if (err != NO_ERROR) {
+        ROSEN_LOGE("RSRenderServiceProxy: Remote()->SendRequest() error.\n");
+        return;
+    }
+}
+
 RSScreenModeInfo RSRenderServiceConnectionProxy::GetScreenActiveMode(ScreenId id)
 {
     MessageParcel data;
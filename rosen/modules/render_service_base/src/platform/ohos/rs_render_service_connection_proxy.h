@@ -59,6 +59,11 @@ public:
 
     void TakeSurfaceCapture(NodeId id, sptr<RSISurfaceCaptureCallback> callback, float scaleX, float scaleY) override;
 
+    void StartContinuousSurfaceCapture(NodeId id, sptr<RSISurfaceCaptureCallback> callback,
+        float scaleX, float scaleY, uint32_t fps) override;
+
+    void StopContinuousSurfaceCapture(NodeId id) override;
+
     RSScreenModeInfo GetScreenActiveMode(ScreenId id) override;
 
     std::vector<RSScreenModeInfo> GetScreenSupportedModes(ScreenId id) override;
@@ -15,6 +15,8 @@
 
 #include "property/rs_properties_painter.h"
 
+#include <functional>
+
 #include "common/rs_obj_abs_geometry.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorFilter.h"
@@ -22,14 +24,15 @@
 #include "include/core/SkPaint.h"
 #include "include/core/SkPoint3.h"
 #include "include/core/SkRRect.h"
+#include "include/core/SkSurface.h"
 #include "include/effects/Sk1DPathEffect.h"
 #include "include/effects/SkDashPathEffect.h"
 #include "include/effects/SkLumaColorFilter.h"
 #include "include/utils/SkShadowUtils.h"
 #include "pipeline/rs_draw_cmd_list.h"
 #include "pipeline/rs_paint_filter_canvas.h"
-#include "pipeline/rs_root_render_node.h"
 #include "platform/common/rs_log.h"
+#include "property/rs_shadow_cache.h"
 #include "property/rs_transition_properties.h"
 #include "render/rs_blur_filter.h"
 #include "render/rs_image.h"
@@ -42,6 +45,154 @@ namespace OHOS {
 namespace Rosen {
 namespace {
 constexpr int PARAM_DOUBLE = 2;
+// the blur mask filter reaches 3 sigma past the path
+constexpr float BLUR_SIGMA_EXTENT = 3.f;
+// SkShadowUtils blurs ambient shadows by half the elevation, the extent is kept generous
+constexpr float AMBIENT_BLUR_EXTENT = 1.f;
+constexpr size_t MAX_CACHED_SHADOW_BYTES = RSShadowCache::MAX_BYTES / 4;
+
+// draws the shadow, the origin of the key path is at [origin] on the canvas
+using ShadowDrawer = std::function<void(SkCanvas&, const SkPoint& origin)>;
+
+bool GetShadow(RSShadowCache::Key& key, const SkRect& shadowBounds, SkColorType colorType, const ShadowDrawer& draw,
+    RSShadowCache::Shadow& shadow)
+{
+    RSShadowCache::UpdateHash(key);
+    auto& cache = RSShadowCache::Instance();
+    if (cache.Get(key, shadow)) {
+        return true;
+    }
+    SkIRect bounds = shadowBounds.roundOut();
+    auto info = SkImageInfo::Make(bounds.width(), bounds.height(), colorType, kPremul_SkAlphaType);
+    if (bounds.isEmpty() || info.computeMinByteSize() > MAX_CACHED_SHADOW_BYTES) {
+        return false;
+    }
+    auto surface = SkSurface::MakeRaster(info);
+    if (surface == nullptr) {
+        ROSEN_LOGE("RSPropertiesPainter::GetShadow, failed to create surface of [%d %d]", bounds.width(),
+            bounds.height());
+        return false;
+    }
+    surface->getCanvas()->clear(SK_ColorTRANSPARENT);
+    draw(*surface->getCanvas(), SkPoint::Make(-bounds.left(), -bounds.top()));
+    shadow.image = surface->makeImageSnapshot();
+    shadow.offset = SkPoint::Make(bounds.left(), bounds.top());
+    cache.Put(key, shadow);
+    return shadow.image != nullptr;
+}
+
+void BlitShadow(SkCanvas& canvas, const RSShadowCache::Shadow& shadow, const SkPoint& origin, const SkPaint& paint)
+{
+    canvas.save();
+    canvas.resetMatrix();
+    canvas.drawImage(shadow.image, origin.x() + shadow.offset.x(), origin.y() + shadow.offset.y(), &paint);
+    canvas.restore();
+}
+
+// Shadows of a path only depend on its position through a translation, they are cached in device space for the path
+// moved to the origin. Spot shadows of SkShadowUtils are the path scaled by lightHeight / (lightHeight - elevation)
+// around the light, so they move faster than the path and are cached with the light at the origin of the path.
+bool DrawCachedShadow(const RSProperties& properties, bool hardwareAcceleration, const SkPath& path,
+    SkColor spotColor, SkCanvas& canvas)
+{
+    const SkMatrix& matrix = canvas.getTotalMatrix();
+    if (!matrix.isScaleTranslate() || matrix.getScaleX() <= 0.f || matrix.getScaleY() <= 0.f) {
+        return false;
+    }
+    RSShadowCache::Key key;
+    path.transform(matrix, &key.path);
+    SkPoint origin = SkPoint::Make(key.path.getBounds().left(), key.path.getBounds().top());
+    key.path.offset(-origin.x(), -origin.y());
+    SkRect pathBounds = key.path.getBounds();
+    RSShadowCache::Shadow shadow;
+    SkPaint paint;
+    paint.setFilterQuality(kLow_SkFilterQuality);
+
+    if (!hardwareAcceleration) {
+        float sigma = matrix.mapRadius(properties.GetShadowRadius());
+        key.type = RSShadowCache::ShadowType::BLUR;
+        key.param = sigma;
+        float extent = sigma * BLUR_SIGMA_EXTENT + 1.f;
+        auto draw = [&key, sigma](SkCanvas& shadowCanvas, const SkPoint& keyOrigin) {
+            SkPaint blurPaint;
+            blurPaint.setAntiAlias(true);
+            blurPaint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, sigma));
+            shadowCanvas.translate(keyOrigin.x(), keyOrigin.y());
+            shadowCanvas.drawPath(key.path, blurPaint);
+        };
+        if (!GetShadow(key, pathBounds.makeOutset(extent, extent), kAlpha_8_SkColorType, draw, shadow)) {
+            return false;
+        }
+        // alpha only images are drawn in the color of the paint
+        paint.setColor(spotColor);
+        BlitShadow(canvas, shadow, origin, paint);
+        return true;
+    }
+
+    float elevation = properties.GetShadowElevation();
+    if (elevation <= 0.f || elevation >= DEFAULT_LIGHT_HEIGHT) {
+        return false;
+    }
+    float zRatio = elevation / (DEFAULT_LIGHT_HEIGHT - elevation);
+    float spotScale = 1.f + zRatio;
+    SkPoint3 planeParams = { 0.0f, 0.0f, elevation };
+    key.param = elevation;
+
+    key.type = RSShadowCache::ShadowType::AMBIENT;
+    key.color = DEFAULT_AMBIENT_COLOR;
+    float ambientExtent = elevation * AMBIENT_BLUR_EXTENT + 1.f;
+    auto drawAmbient = [&key, &planeParams](SkCanvas& shadowCanvas, const SkPoint& keyOrigin) {
+        SkPath shadowPath;
+        key.path.offset(keyOrigin.x(), keyOrigin.y(), &shadowPath);
+        SkPoint3 lightPos = { keyOrigin.x(), keyOrigin.y(), DEFAULT_LIGHT_HEIGHT };
+        SkShadowUtils::DrawShadow(&shadowCanvas, shadowPath, planeParams, lightPos, DEFAULT_LIGHT_RADIUS,
+            DEFAULT_AMBIENT_COLOR, SK_ColorTRANSPARENT, SkShadowFlags::kTransparentOccluder_ShadowFlag);
+    };
+    RSShadowCache::Shadow ambient;
+    if (!GetShadow(key, pathBounds.makeOutset(ambientExtent, ambientExtent), kN32_SkColorType, drawAmbient,
+        ambient)) {
+        return false;
+    }
+
+    key.type = RSShadowCache::ShadowType::SPOT;
+    key.color = spotColor;
+    float spotExtent = DEFAULT_LIGHT_RADIUS * zRatio + 1.f;
+    auto drawSpot = [&key, &planeParams, spotColor](SkCanvas& shadowCanvas, const SkPoint& keyOrigin) {
+        SkPath shadowPath;
+        key.path.offset(keyOrigin.x(), keyOrigin.y(), &shadowPath);
+        SkPoint3 lightPos = { keyOrigin.x(), keyOrigin.y(), DEFAULT_LIGHT_HEIGHT };
+        SkShadowUtils::DrawShadow(&shadowCanvas, shadowPath, planeParams, lightPos, DEFAULT_LIGHT_RADIUS,
+            SK_ColorTRANSPARENT, spotColor, SkShadowFlags::kTransparentOccluder_ShadowFlag);
+    };
+    SkRect spotBounds = SkRect::MakeWH(pathBounds.width() * spotScale, pathBounds.height() * spotScale);
+    if (!GetShadow(key, spotBounds.makeOutset(spotExtent, spotExtent), kN32_SkColorType, drawSpot, shadow)) {
+        return false;
+    }
+
+    BlitShadow(canvas, ambient, origin, paint);
+    SkPoint spotOrigin = SkPoint::Make(origin.x() * spotScale - DEFAULT_LIGHT_POSITION_X * zRatio,
+        origin.y() * spotScale - DEFAULT_LIGHT_POSITION_Y * zRatio);
+    BlitShadow(canvas, shadow, spotOrigin, paint);
+    return true;
+}
+
+void DrawShadowDirectly(const RSProperties& properties, bool hardwareAcceleration, const SkPath& path,
+    SkColor spotColor, SkCanvas& canvas)
+{
+    if (hardwareAcceleration) {
+        SkPoint3 planeParams = { 0.0f, 0.0f, properties.GetShadowElevation() };
+        SkPoint3 lightPos = { DEFAULT_LIGHT_POSITION_X, DEFAULT_LIGHT_POSITION_Y, DEFAULT_LIGHT_HEIGHT };
+        SkColor ambientColor = DEFAULT_AMBIENT_COLOR;
+        SkShadowUtils::DrawShadow(&canvas, path, planeParams, lightPos, DEFAULT_LIGHT_RADIUS, ambientColor,
+            spotColor, SkShadowFlags::kTransparentOccluder_ShadowFlag);
+    } else {
+        SkPaint paint;
+        paint.setColor(spotColor);
+        paint.setAntiAlias(true);
+        paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, properties.GetShadowRadius()));
+        canvas.drawPath(path, paint);
+    }
+}
 } // namespace
 
 SkRect Rect2SkRect(const RectF& r)
@@ -148,18 +299,9 @@ void RSPropertiesPainter::DrawShadow(const RSProperties& properties, SkCanvas& c
         }
         skPath.offset(properties.GetShadowOffsetX(), properties.GetShadowOffsetY());
         SkColor spotColor = properties.GetShadowColor().AsArgbInt();
-        if (properties.shadow_->GetHardwareAcceleration()) {
-            SkPoint3 planeParams = { 0.0f, 0.0f, properties.GetShadowElevation() };
-            SkPoint3 lightPos = { DEFAULT_LIGHT_POSITION_X, DEFAULT_LIGHT_POSITION_Y, DEFAULT_LIGHT_HEIGHT };
-            SkColor ambientColor = DEFAULT_AMBIENT_COLOR;
-            SkShadowUtils::DrawShadow(&canvas, skPath, planeParams, lightPos, DEFAULT_LIGHT_RADIUS, ambientColor,
-                spotColor, SkShadowFlags::kTransparentOccluder_ShadowFlag);
-        } else {
-            SkPaint paint;
-            paint.setColor(spotColor);
-            paint.setAntiAlias(true);
-            paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, properties.GetShadowRadius()));
-            canvas.drawPath(skPath, paint);
+        bool hardwareAcceleration = properties.shadow_->GetHardwareAcceleration();
+        if (!DrawCachedShadow(properties, hardwareAcceleration, skPath, spotColor, canvas)) {
+            DrawShadowDirectly(properties, hardwareAcceleration, skPath, spotColor, canvas);
         }
         canvas.restore();
     }
@@ -180,7 +322,6 @@ void RSPropertiesPainter::SaveLayerForFilter(const RSProperties& properties, SkC
     }
     SkCanvas::SaveLayerRec slr(nullptr, &paint, SkCanvas::kInitWithPrevious_SaveLayerFlag);
     canvas.saveLayer(slr);
-    RSRootRenderNode::MarkForceRaster();
 }
 
 void RSPropertiesPainter::RestoreForFilter(SkCanvas& canvas)
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "property/rs_shadow_cache.h"
+
+#include <iterator>
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+constexpr size_t MAX_ENTRY_BYTES = RSShadowCache::MAX_BYTES / 4;
+constexpr uint64_t HASH_SEED = 0xcbf29ce484222325ULL;
+constexpr uint64_t HASH_PRIME = 0x100000001b3ULL;
+
+uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * HASH_PRIME;
+    }
+    return hash;
+}
+
+// points of a verb returned by SkPath::RawIter, the first one is the last point of the previous verb
+int CountVerbPoints(SkPath::Verb verb)
+{
+    switch (verb) {
+        case SkPath::kMove_Verb:
+            return 1;
+        case SkPath::kLine_Verb:
+            return 2; // 2 points: start and end
+        case SkPath::kQuad_Verb:
+        case SkPath::kConic_Verb:
+            return 3; // 3 points: start, control and end
+        case SkPath::kCubic_Verb:
+            return 4; // 4 points: start, 2 controls and end
+        default:
+            return 0;
+    }
+}
+} // namespace
+
+RSShadowCache& RSShadowCache::Instance()
+{
+    static RSShadowCache instance;
+    return instance;
+}
+
+void RSShadowCache::UpdateHash(Key& key)
+{
+    uint64_t hash = HASH_SEED;
+    hash = HashBytes(hash, &key.type, sizeof(key.type));
+    hash = HashBytes(hash, &key.param, sizeof(key.param));
+    hash = HashBytes(hash, &key.color, sizeof(key.color));
+    auto fillType = key.path.getFillType();
+    hash = HashBytes(hash, &fillType, sizeof(fillType));
+    // walk the path in place, shadows are looked up for every node with a shadow on every frame
+    SkPath::RawIter iter(key.path);
+    SkPoint points[4]; // 4: at most 4 points per verb
+    SkPath::Verb verb;
+    while ((verb = iter.next(points)) != SkPath::kDone_Verb) {
+        hash = HashBytes(hash, &verb, sizeof(verb));
+        hash = HashBytes(hash, points, CountVerbPoints(verb) * sizeof(SkPoint));
+        if (verb == SkPath::kConic_Verb) {
+            float weight = iter.conicWeight();
+            hash = HashBytes(hash, &weight, sizeof(weight));
+        }
+    }
+    key.hash = hash;
+}
+
+bool RSShadowCache::Get(const Key& key, Shadow& shadow)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = index_.find(key.hash);
+    if (found == index_.end() || !(found->second->key == key)) {
+        return false;
+    }
+    entries_.splice(entries_.begin(), entries_, found->second);
+    shadow = entries_.front().shadow;
+    ++hitCount_;
+    return true;
+}
+
+void RSShadowCache::Put(const Key& key, const Shadow& shadow)
+{
+    if (shadow.image == nullptr) {
+        return;
+    }
+    Entry entry;
+    entry.key = key;
+    entry.shadow = shadow;
+    entry.bytes = shadow.image->imageInfo().computeMinByteSize();
+    if (entry.bytes > MAX_ENTRY_BYTES) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = index_.find(key.hash);
+    if (found != index_.end()) {
+        Erase(found->second);
+    }
+    bytes_ += entry.bytes;
+    entries_.push_front(std::move(entry));
+    index_[key.hash] = entries_.begin();
+    while (bytes_ > MAX_BYTES) {
+        Erase(std::prev(entries_.end()));
+    }
+}
+
+void RSShadowCache::Erase(std::list<Entry>::iterator iter)
+{
+    bytes_ -= iter->bytes;
+    index_.erase(iter->key.hash);
+    entries_.erase(iter);
+}
+
+void RSShadowCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    index_.clear();
+    bytes_ = 0;
+    hitCount_ = 0;
+}
+
+size_t RSShadowCache::GetEntryCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+size_t RSShadowCache::GetMemoryUsage() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_;
+}
+
+uint64_t RSShadowCache::GetHitCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hitCount_;
+}
+} // namespace Rosen
+} // namespace OHOS
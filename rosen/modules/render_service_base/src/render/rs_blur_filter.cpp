@@ -15,16 +15,82 @@
 
 #include "render/rs_blur_filter.h"
 
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <mutex>
+#include <utility>
+
 #include "include/effects/SkBlurImageFilter.h"
+
 namespace OHOS {
 namespace Rosen {
+namespace {
+constexpr float LEVELS_PER_OCTAVE = 8.0f;
+// below this radius the blur is cheap enough at full resolution
+constexpr float MIN_DOWNSAMPLED_RADIUS = 3.0f;
+constexpr int MAX_DOWNSAMPLE_SHIFT = 3;
+constexpr size_t MAX_CACHED_FILTERS = 32;
+
+std::mutex g_filterCacheMutex;
+// most recently used first
+std::list<std::pair<std::pair<float, float>, sk_sp<SkImageFilter>>> g_filterCache;
+} // namespace
+
 RSBlurFilter::RSBlurFilter(float blurRadiusX, float blurRadiusY)
-    : RSSkiaFilter(SkBlurImageFilter::Make(blurRadiusX, blurRadiusY, nullptr)), blurRadiusX_(blurRadiusX),
-      blurRadiusY_(blurRadiusY)
+    : RSSkiaFilter(GetImageFilter(blurRadiusX, blurRadiusY)), blurRadiusX_(blurRadiusX), blurRadiusY_(blurRadiusY)
 {
     type_ = FilterType::BLUR;
 }
 
+float RSBlurFilter::QuantizeRadius(float radius)
+{
+    if (!(radius > 0.0f)) {
+        return 0.0f;
+    }
+    float level = std::round(std::log2(1.0f + radius) * LEVELS_PER_OCTAVE);
+    return std::exp2(level / LEVELS_PER_OCTAVE) - 1.0f;
+}
+
+sk_sp<SkImageFilter> RSBlurFilter::GetImageFilter(float blurRadiusX, float blurRadiusY)
+{
+    auto key = std::make_pair(QuantizeRadius(blurRadiusX), QuantizeRadius(blurRadiusY));
+    if (key.first <= 0.0f && key.second <= 0.0f) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(g_filterCacheMutex);
+    auto iter = std::find_if(
+        g_filterCache.begin(), g_filterCache.end(), [&key](const auto& entry) { return entry.first == key; });
+    if (iter != g_filterCache.end()) {
+        g_filterCache.splice(g_filterCache.begin(), g_filterCache, iter);
+        return g_filterCache.front().second;
+    }
+    auto filter = CreateImageFilter(key.first, key.second);
+    g_filterCache.emplace_front(key, filter);
+    if (g_filterCache.size() > MAX_CACHED_FILTERS) {
+        g_filterCache.pop_back();
+    }
+    return filter;
+}
+
+sk_sp<SkImageFilter> RSBlurFilter::CreateImageFilter(float blurRadiusX, float blurRadiusY)
+{
+    // large blurs run on a downsampled image and are scaled back, the lost details are blurred away anyway
+    float minRadius = std::min(blurRadiusX, blurRadiusY);
+    int shift = 0;
+    while (shift < MAX_DOWNSAMPLE_SHIFT && minRadius / (1 << (shift + 1)) >= MIN_DOWNSAMPLED_RADIUS) {
+        ++shift;
+    }
+    if (shift == 0) {
+        return SkBlurImageFilter::Make(blurRadiusX, blurRadiusY, nullptr);
+    }
+    float scale = static_cast<float>(1 << shift);
+    auto downsample = SkImageFilter::MakeMatrixFilter(
+        SkMatrix::MakeScale(1.0f / scale, 1.0f / scale), kMedium_SkFilterQuality, nullptr);
+    auto blur = SkBlurImageFilter::Make(blurRadiusX / scale, blurRadiusY / scale, std::move(downsample));
+    return SkImageFilter::MakeMatrixFilter(SkMatrix::MakeScale(scale, scale), kLow_SkFilterQuality, std::move(blur));
+}
+
 RSBlurFilter::~RSBlurFilter() {}
 
 float RSBlurFilter::GetBlurRadiusX()
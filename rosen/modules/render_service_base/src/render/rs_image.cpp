@@ -15,8 +15,12 @@
 
 #include "render/rs_image.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "include/core/SkPaint.h"
 #include "include/core/SkRRect.h"
+#include "include/core/SkShader.h"
 
 namespace OHOS {
 namespace Rosen {
@@ -94,41 +98,42 @@ void RSImage::ApplyCanvasClip(SkCanvas& canvas)
 
 void RSImage::DrawImageRepeatRect(const SkPaint& paint, SkCanvas& canvas)
 {
+    if (image_ == nullptr || dstRect_.IsEmpty()) {
+        return;
+    }
+    auto src = Rect2SkRect(srcRect_);
+    auto dst = Rect2SkRect(dstRect_);
+    if (imageRepeat_ == ImageRepeat::NO_REPEAT) {
+        canvas.drawImageRect(image_, src, dst, &paint, SkCanvas::kFast_SrcRectConstraint);
+        return;
+    }
+    // the tiles covering the frame, [minX, maxX] x [minY, maxY] relative to the dst rect
     int minX = 0;
     int minY = 0;
     int maxX = 0;
     int maxY = 0;
-    float left = frameRect_.left_;
-    float right = frameRect_.GetRight();
-    float top = frameRect_.top_;
-    float bottom = frameRect_.GetBottom();
-    // calculate REPEAT_XY
     float eps = 0.01; // set epsilon
+    const float tileW = dstRect_.width_;
+    const float tileH = dstRect_.height_;
     if (ImageRepeat::REPEAT_X == imageRepeat_ || ImageRepeat::REPEAT == imageRepeat_) {
-        while (dstRect_.left_ + minX * dstRect_.width_ > left + eps) {
-            --minX;
-        }
-        while (dstRect_.left_ + maxX * dstRect_.width_ < right - eps) {
-            ++maxX;
-        }
+        minX = std::min(0, static_cast<int>(std::floor((frameRect_.left_ + eps - dstRect_.left_) / tileW)));
+        maxX = std::max(0, static_cast<int>(std::ceil((frameRect_.GetRight() - eps - dstRect_.left_) / tileW)));
     }
     if (ImageRepeat::REPEAT_Y == imageRepeat_ || ImageRepeat::REPEAT == imageRepeat_) {
-        while (dstRect_.top_ + minY * dstRect_.height_ > top + eps) {
-            --minY;
-        }
-        while (dstRect_.top_ + maxY * dstRect_.height_ < bottom - eps) {
-            ++maxY;
-        }
-    }
-    // draw repeat rect
-    auto src = Rect2SkRect(srcRect_);
-    for (int i = minX; i <= maxX; ++i) {
-        for (int j = minY; j <= maxY; ++j) {
-            auto dst = SkRect::MakeXYWH(dstRect_.left_ + i * dstRect_.width_, dstRect_.top_ + j * dstRect_.height_,
-                dstRect_.width_, dstRect_.height_);
-            canvas.drawImageRect(image_, src, dst, &paint, SkCanvas::kFast_SrcRectConstraint);
-        }
+        minY = std::min(0, static_cast<int>(std::floor((frameRect_.top_ + eps - dstRect_.top_) / tileH)));
+        maxY = std::max(0, static_cast<int>(std::ceil((frameRect_.GetBottom() - eps - dstRect_.top_) / tileH)));
     }
+    // one rect filled with the image repeated from the dst rect instead of one draw per tile, the axis that is not
+    // repeated is only as large as the dst rect
+    SkMatrix matrix;
+    matrix.setRectToRect(src, dst, SkMatrix::kFill_ScaleToFit);
+    SkTileMode tileModeX = minX == maxX ? SkTileMode::kClamp : SkTileMode::kRepeat;
+    SkTileMode tileModeY = minY == maxY ? SkTileMode::kClamp : SkTileMode::kRepeat;
+    SkPaint shaderPaint(paint);
+    shaderPaint.setShader(image_->makeShader(tileModeX, tileModeY, &matrix));
+    auto rect = SkRect::MakeLTRB(dstRect_.left_ + minX * tileW, dstRect_.top_ + minY * tileH,
+        dstRect_.left_ + (maxX + 1) * tileW, dstRect_.top_ + (maxY + 1) * tileH);
+    canvas.drawRect(rect, shaderPaint);
 }
 
 void RSImage::SetImage(const sk_sp<SkImage> image)
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "render/rs_path_arc_length_table.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "include/core/SkPath.h"
+
+#include "render/rs_path.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+// curves are flattened into chords of about this length, far below a pixel away from the curve
+constexpr float CHORD_LENGTH = 2.0f;
+constexpr int MAX_CURVE_SUBDIVISIONS = 256;
+
+int GetSubdivisions(const SkPoint* pts, int count)
+{
+    // the length of the control polygon is an upper bound of the length of the curve
+    float length = 0.0f;
+    for (int i = 1; i < count; ++i) {
+        length += SkPoint::Distance(pts[i - 1], pts[i]);
+    }
+    return std::clamp(static_cast<int>(std::ceil(length / CHORD_LENGTH)), 1, MAX_CURVE_SUBDIVISIONS);
+}
+
+SkPoint EvalQuad(const SkPoint* pts, float t)
+{
+    float mt = 1.0f - t;
+    float a = mt * mt;
+    float b = 2.0f * mt * t;
+    float c = t * t;
+    return SkPoint::Make(a * pts[0].x() + b * pts[1].x() + c * pts[2].x(),
+        a * pts[0].y() + b * pts[1].y() + c * pts[2].y());
+}
+
+// the tangents are derivatives, their length doesn't matter
+SkVector EvalQuadTangent(const SkPoint* pts, float t)
+{
+    float mt = 1.0f - t;
+    return (pts[1] - pts[0]) * mt + (pts[2] - pts[1]) * t;
+}
+
+SkPoint EvalConic(const SkPoint* pts, float weight, float t)
+{
+    float mt = 1.0f - t;
+    float a = mt * mt;
+    float b = 2.0f * weight * mt * t;
+    float c = t * t;
+    float denominator = a + b + c;
+    return SkPoint::Make((a * pts[0].x() + b * pts[1].x() + c * pts[2].x()) / denominator,
+        (a * pts[0].y() + b * pts[1].y() + c * pts[2].y()) / denominator);
+}
+
+SkVector EvalConicTangent(const SkPoint* pts, float weight, float t)
+{
+    // (N / D)' has the direction of N' * D - N * D'
+    float mt = 1.0f - t;
+    float a = mt * mt;
+    float b = 2.0f * weight * mt * t;
+    float c = t * t;
+    float da = -2.0f * mt;
+    float db = 2.0f * weight * (1.0f - 2.0f * t);
+    float dc = 2.0f * t;
+    SkVector numerator = pts[0] * a + pts[1] * b + pts[2] * c;
+    SkVector derivative = pts[0] * da + pts[1] * db + pts[2] * dc;
+    return derivative * (a + b + c) - numerator * (da + db + dc);
+}
+
+SkPoint EvalCubic(const SkPoint* pts, float t)
+{
+    float mt = 1.0f - t;
+    float a = mt * mt * mt;
+    float b = 3.0f * mt * mt * t;
+    float c = 3.0f * mt * t * t;
+    float d = t * t * t;
+    return SkPoint::Make(a * pts[0].x() + b * pts[1].x() + c * pts[2].x() + d * pts[3].x(),
+        a * pts[0].y() + b * pts[1].y() + c * pts[2].y() + d * pts[3].y());
+}
+
+SkVector EvalCubicTangent(const SkPoint* pts, float t)
+{
+    float mt = 1.0f - t;
+    return (pts[1] - pts[0]) * (mt * mt) + (pts[2] - pts[1]) * (2.0f * mt * t) + (pts[3] - pts[2]) * (t * t);
+}
+} // namespace
+
+void RSPathArcLengthTable::Build(const RSPath& path)
+{
+    Clear();
+    SkPath::Iter iter(path.GetSkiaPath(), false);
+    SkPoint pts[4];
+    SkPath::Verb verb;
+    while ((verb = iter.next(pts)) != SkPath::kDone_Verb) {
+        switch (verb) {
+            case SkPath::kMove_Verb:
+                // like SkPathMeasure, only the first contour with a length is measured
+                if (!IsEmpty()) {
+                    return;
+                }
+                Clear();
+                distances_.push_back(0.0f);
+                points_.emplace_back(pts[0].x(), pts[0].y());
+                break;
+            case SkPath::kLine_Verb:
+                AddPoint(pts[1], pts[1] - pts[0], pts[1] - pts[0]);
+                break;
+            case SkPath::kQuad_Verb: {
+                int count = GetSubdivisions(pts, 3);
+                for (int i = 1; i <= count; ++i) {
+                    float t = static_cast<float>(i) / count;
+                    AddPoint(EvalQuad(pts, t), EvalQuadTangent(pts, static_cast<float>(i - 1) / count),
+                        EvalQuadTangent(pts, t));
+                }
+                break;
+            }
+            case SkPath::kConic_Verb: {
+                int count = GetSubdivisions(pts, 3);
+                float weight = iter.conicWeight();
+                for (int i = 1; i <= count; ++i) {
+                    float t = static_cast<float>(i) / count;
+                    AddPoint(EvalConic(pts, weight, t),
+                        EvalConicTangent(pts, weight, static_cast<float>(i - 1) / count),
+                        EvalConicTangent(pts, weight, t));
+                }
+                break;
+            }
+            case SkPath::kCubic_Verb: {
+                int count = GetSubdivisions(pts, 4);
+                for (int i = 1; i <= count; ++i) {
+                    float t = static_cast<float>(i) / count;
+                    AddPoint(EvalCubic(pts, t), EvalCubicTangent(pts, static_cast<float>(i - 1) / count),
+                        EvalCubicTangent(pts, t));
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+void RSPathArcLengthTable::Clear()
+{
+    distances_.clear();
+    points_.clear();
+    degrees_.clear();
+}
+
+void RSPathArcLengthTable::AddPoint(const SkPoint& point, SkVector startTangent, SkVector endTangent)
+{
+    if (points_.empty()) {
+        return;
+    }
+    const Vector2f last = points_.back();
+    SkVector chord = SkVector::Make(point.x() - last.x_, point.y() - last.y_);
+    float length = chord.length();
+    // zero length segments have no direction and would break the interpolation
+    if (length <= 0.0f) {
+        return;
+    }
+    // curves may stand still at their ends, their chord points the same way there
+    if (SkScalarNearlyZero(startTangent.length())) {
+        startTangent = chord;
+    }
+    if (SkScalarNearlyZero(endTangent.length())) {
+        endTangent = chord;
+    }
+    float startDegrees = SkRadiansToDegrees(std::atan2(startTangent.y(), startTangent.x()));
+    if (degrees_.size() < points_.size()) {
+        // the first segment gives the first point its direction
+        degrees_.push_back(startDegrees);
+    } else if (degrees_.back() != startDegrees) {
+        // a corner, the point is added again with the direction the segment leaves it in
+        distances_.push_back(distances_.back());
+        points_.push_back(last);
+        degrees_.push_back(startDegrees);
+    }
+    distances_.push_back(distances_.back() + length);
+    points_.emplace_back(point.x(), point.y());
+    degrees_.push_back(SkRadiansToDegrees(std::atan2(endTangent.y(), endTangent.x())));
+}
+
+bool RSPathArcLengthTable::GetPosTan(float distance, Vector2f& pos, float& degrees) const
+{
+    if (IsEmpty()) {
+        return false;
+    }
+    distance = std::clamp(distance, 0.0f, distances_.back());
+    // the segment containing [distance] ends at the first point further than it
+    auto iter = std::upper_bound(distances_.begin() + 1, distances_.end() - 1, distance);
+    size_t index = static_cast<size_t>(iter - distances_.begin()) - 1;
+    float t = (distance - distances_[index]) / (distances_[index + 1] - distances_[index]);
+    const Vector2f& start = points_[index];
+    const Vector2f& end = points_[index + 1];
+    pos.data_[0] = start.x_ + (end.x_ - start.x_) * t;
+    pos.data_[1] = start.y_ + (end.y_ - start.y_) * t;
+    // turn the shorter way from the direction at the start of the segment to the one at its end
+    float turn = std::remainder(degrees_[index + 1] - degrees_[index], 360.0f);
+    degrees = degrees_[index] + turn * t;
+    if (degrees > 180.0f) {
+        degrees -= 360.0f;
+    } else if (degrees <= -180.0f) {
+        degrees += 360.0f;
+    }
+    return true;
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -20,6 +20,7 @@
 #include "base/hiviewdfx/hisysevent/interfaces/native/innerkits/hisysevent/include/hisysevent.h"
 
 #include "pipeline/rs_frame_report.h"
+#include "pipeline/rs_image_cache.h"
 #include "pipeline/rs_render_node_map.h"
 #include "pipeline/rs_root_render_node.h"
 #include "platform/common/rs_log.h"
@@ -30,6 +31,7 @@
 #include <sys/prctl.h>
 #include <unistd.h>
 
+#include "pipeline/rs_offscreen_surface_pool.h"
 #include "platform/ohos/rs_render_service_connect_hub.h"
 #endif
 
@@ -43,6 +45,11 @@ static void SystemCallSetThreadName(const std::string& name)
 }
 
 namespace {
+#ifdef ROSEN_OHOS
+const std::string TRIM_OFFSCREEN_SURFACES_TASK = "TrimOffscreenSurfaces";
+constexpr int64_t TRIM_OFFSCREEN_SURFACES_DELAY_MS = 1000;
+#endif
+
 void DrawEventReport(float frameLength)
 {
     int32_t pid = getpid();
@@ -269,18 +276,7 @@ void RSRenderThread::Animate(uint64_t timestamp)
     }
 
     // iterate and animate all animating nodes, remove if animation finished
-    std::__libcpp_erase_if_container(context_.animatingNodeList_, [timestamp](const auto& iter) -> bool {
-        auto node = iter.second.lock();
-        if (node == nullptr) {
-            ROSEN_LOGD("RSRenderThread::Animate removing expired animating node");
-            return true;
-        }
-        bool animationFinished = !node->Animate(timestamp);
-        if (animationFinished) {
-            ROSEN_LOGD("RSRenderThread::Animate removing finished animating node %llu", node->GetId());
-        }
-        return animationFinished;
-    });
+    animator_.Animate(context_.animatingNodeList_, timestamp);
 
     RSRenderThread::Instance().RequestNextVSync();
 }
@@ -302,9 +298,29 @@ void RSRenderThread::Render()
     }
     rootNode->Prepare(visitor_);
     rootNode->Process(visitor_);
+    // images of the draw commands replaced since the last frame
+    RSImageCache::Instance().ReleaseUnusedImages();
+#ifdef ROSEN_OHOS
+    TrimOffscreenSurfaces();
+#endif
     ROSEN_TRACE_END(BYTRACE_TAG_GRAPHIC_AGP);
 }
 
+#ifdef ROSEN_OHOS
+void RSRenderThread::TrimOffscreenSurfaces()
+{
+    auto& pool = RSOffscreenSurfacePool::Instance();
+    pool.OnFrameEnd();
+    if (handler_ == nullptr || pool.GetSurfaceCount() == 0) {
+        return;
+    }
+    // no frame is drawn while nothing changes, the surfaces left are freed once no frame came for a while
+    handler_->RemoveTask(TRIM_OFFSCREEN_SURFACES_TASK);
+    handler_->PostTask([]() { RSOffscreenSurfacePool::Instance().Clear(); }, TRIM_OFFSCREEN_SURFACES_TASK,
+        TRIM_OFFSCREEN_SURFACES_DELAY_MS);
+}
+#endif
+
 void RSRenderThread::SendCommands()
 {
     ROSEN_TRACE_BEGIN(BYTRACE_TAG_GRAPHIC_AGP, "RSRenderThread::SendCommands");
@@ -24,6 +24,7 @@
 #include <vector>
 #include <vsync_helper.h>
 
+#include "animation/rs_parallel_animator.h"
 #include "common/rs_thread_handler.h"
 #include "common/rs_thread_looper.h"
 #include "ipc_callbacks/rs_application_render_thread_stub.h"
@@ -85,6 +86,9 @@ private:
     void ProcessCommands();
     void Animate(uint64_t timestamp);
     void Render();
+#ifdef ROSEN_OHOS
+    void TrimOffscreenSurfaces();
+#endif
     void SendCommands();
 
     std::atomic_bool running_ = false;
@@ -109,6 +113,7 @@ private:
     uint64_t mValue = 0;
 
     RSContext context_;
+    RSParallelAnimator animator_;
 
     RenderContext* renderContext_ = nullptr;
 };
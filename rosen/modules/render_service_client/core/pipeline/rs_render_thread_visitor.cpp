@@ -136,35 +136,15 @@ void RSRenderThreadVisitor::ProcessRootRenderNode(RSRootRenderNode& node)
         return;
     }
 
-    sk_sp<SkSurface> skSurface = nullptr;
-    auto iter = forceRasterNodes.find(node.GetId());
-    if (iter != forceRasterNodes.end()) {
-        ROSEN_LOGD("Force Raster draw");
-        forceRasterNodes.erase(iter);
-        SkImageInfo imageInfo = SkImageInfo::Make(node.GetSurfaceWidth(), node.GetSurfaceHeight(),
-            kRGBA_8888_SkColorType, kOpaque_SkAlphaType, SkColorSpace::MakeSRGB());
-        skSurface = SkSurface::MakeRaster(imageInfo);
-        canvas_ = new RSPaintFilterCanvas(skSurface->getCanvas());
-    } else {
-        canvas_ = new RSPaintFilterCanvas(surfaceFrame->GetCanvas());
-    }
+    canvas_ = new RSPaintFilterCanvas(surfaceFrame->GetCanvas());
+#ifdef ACE_ENABLE_GL
+    // filters are applied on the CPU, only over the bounds of the filtered nodes
+    canvas_->EnableOffscreenFilterLayer(true);
+#endif
     canvas_->clear(SK_ColorTRANSPARENT);
     isIdle_ = false;
     ProcessCanvasRenderNode(node);
 
-    if (skSurface) {
-        canvas_->flush();
-        surfaceFrame->GetCanvas()->clear(SK_ColorTRANSPARENT);
-        skSurface->draw(surfaceFrame->GetCanvas(), 0.f, 0.f, nullptr);
-    }
-    if (RSRootRenderNode::NeedForceRaster()) {
-        RSRootRenderNode::MarkForceRaster(false);
-        forceRasterNodes.insert(node.GetId());
-        if (!skSurface) {
-            RSRenderThread::Instance().RequestNextVSync();
-        }
-    }
-
     RS_TRACE_BEGIN("rsSurface->FlushFrame");
     rsSurface->FlushFrame(surfaceFrame);
     RS_TRACE_END();
@@ -74,6 +74,17 @@ bool RSInterfaces::TakeSurfaceCapture(std::shared_ptr<RSDisplayNode> node,
     return renderServiceClient_->TakeSurfaceCapture(node->GetId(), callback, scaleX, scaleY);
 }
 
+bool RSInterfaces::StartContinuousSurfaceCapture(std::shared_ptr<RSDisplayNode> node,
+    std::shared_ptr<SurfaceCaptureCallback> callback, uint32_t fps, float scaleX, float scaleY)
+{
+    return renderServiceClient_->StartContinuousSurfaceCapture(node->GetId(), callback, scaleX, scaleY, fps);
+}
+
+void RSInterfaces::StopContinuousSurfaceCapture(std::shared_ptr<RSDisplayNode> node)
+{
+    renderServiceClient_->StopContinuousSurfaceCapture(node->GetId());
+}
+
 void RSInterfaces::SetScreenActiveMode(ScreenId id, uint32_t modeId)
 {
     renderServiceClient_->SetScreenActiveMode(id, modeId);
@@ -53,6 +53,12 @@ public:
     bool TakeSurfaceCapture(std::shared_ptr<RSDisplayNode> node,
         std::shared_ptr<SurfaceCaptureCallback> callback, float scaleX = 1.0f, float scaleY = 1.0f);
 
+    // capture the display until stopped, at most [fps] frames per second. Frames are delivered when it changes.
+    bool StartContinuousSurfaceCapture(std::shared_ptr<RSDisplayNode> node,
+        std::shared_ptr<SurfaceCaptureCallback> callback, uint32_t fps, float scaleX = 1.0f, float scaleY = 1.0f);
+
+    void StopContinuousSurfaceCapture(std::shared_ptr<RSDisplayNode> node);
+
     void SetScreenActiveMode(ScreenId id, uint32_t modeId);
 
     void SetScreenPowerStatus(ScreenId id, ScreenPowerStatus status);
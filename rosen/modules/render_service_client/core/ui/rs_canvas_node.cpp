@@ -79,5 +79,14 @@ void RSCanvasNode::FinishRecording()
 #endif
 }
 
+void RSCanvasNode::SetCacheEnabled(bool enabled)
+{
+    std::unique_ptr<RSCommand> command = std::make_unique<RSCanvasNodeSetCacheEnabled>(GetId(), enabled);
+    auto transactionProxy = RSTransactionProxy::GetInstance();
+    if (transactionProxy != nullptr) {
+        transactionProxy->AddCommand(command, IsRenderServiceNode());
+    }
+}
+
 } // namespace Rosen
 } // namespace OHOS
@@ -37,6 +37,9 @@ public:
     bool IsRecording() const;
     void FinishRecording();
 
+    // opt-in caching of the recorded contents on the render side, for static contents such as icons or backgrounds
+    void SetCacheEnabled(bool enabled);
+
     RSUINodeType GetType() const override
     {
         return RSUINodeType::CANVAS_NODE;
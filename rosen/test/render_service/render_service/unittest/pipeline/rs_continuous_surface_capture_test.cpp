@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "ipc_callbacks/surface_capture_callback_stub.h"
+#include "pipeline/rs_continuous_surface_capture.h"
+#include "pipeline/rs_main_thread.h"
+#include "pipeline/rs_surface_capture_task.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+namespace {
+constexpr pid_t PID = 1000;
+constexpr pid_t OTHER_PID = 1001;
+constexpr NodeId NODE_ID = 0x7fff0001;
+constexpr uint32_t FPS = 30;
+constexpr uint64_t NS_PER_SECOND = 1000000000;
+constexpr int FRAME_COUNT = 10;
+
+class CountingSurfaceCaptureCallback : public RSSurfaceCaptureCallbackStub {
+public:
+    void OnSurfaceCapture(NodeId id, Media::PixelMap* pixelmap) override
+    {
+        ++count;
+    }
+
+    int count = 0;
+};
+} // namespace
+
+class RSContinuousSurfaceCaptureTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+
+    static std::shared_ptr<RSContinuousSurfaceCapture> CreateCapture(sptr<RSISurfaceCaptureCallback> callback)
+    {
+        return std::make_shared<RSContinuousSurfaceCapture>(NODE_ID, callback, 1.f, 1.f, FPS);
+    }
+};
+
+void RSContinuousSurfaceCaptureTest::SetUpTestCase() {}
+void RSContinuousSurfaceCaptureTest::TearDownTestCase() {}
+void RSContinuousSurfaceCaptureTest::SetUp() {}
+void RSContinuousSurfaceCaptureTest::TearDown()
+{
+    RSMainThread::Instance()->RemoveContinuousSurfaceCapture(PID, NODE_ID);
+    RSMainThread::Instance()->RemoveContinuousSurfaceCapture(OTHER_PID, NODE_ID);
+}
+
+/**
+ * @tc.name: PerClient001
+ * @tc.desc: captures of the same node by two clients neither replace nor stop each other
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSContinuousSurfaceCaptureTest, PerClient001, TestSize.Level1)
+{
+    auto mainThread = RSMainThread::Instance();
+    mainThread->AddContinuousSurfaceCapture(PID, NODE_ID, CreateCapture(new CountingSurfaceCaptureCallback()));
+    mainThread->AddContinuousSurfaceCapture(OTHER_PID, NODE_ID, CreateCapture(new CountingSurfaceCaptureCallback()));
+    ASSERT_TRUE(mainThread->HasContinuousSurfaceCapture(PID, NODE_ID));
+    ASSERT_TRUE(mainThread->HasContinuousSurfaceCapture(OTHER_PID, NODE_ID));
+
+    mainThread->RemoveContinuousSurfaceCapture(PID, NODE_ID);
+    ASSERT_FALSE(mainThread->HasContinuousSurfaceCapture(PID, NODE_ID));
+    ASSERT_TRUE(mainThread->HasContinuousSurfaceCapture(OTHER_PID, NODE_ID));
+
+    // stopping a capture the client does not have leaves the others alone
+    mainThread->RemoveContinuousSurfaceCapture(PID, NODE_ID);
+    ASSERT_TRUE(mainThread->HasContinuousSurfaceCapture(OTHER_PID, NODE_ID));
+}
+
+/**
+ * @tc.name: Snapshot001
+ * @tc.desc: nothing is snapshotted for invalid scales or unknown nodes, nothing is rendered without a snapshot
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSContinuousSurfaceCaptureTest, Snapshot001, TestSize.Level1)
+{
+    RSSurfaceCaptureTask invalidScale(NODE_ID, 0.f, 1.f);
+    ASSERT_FALSE(invalidScale.Snapshot());
+    ASSERT_EQ(invalidScale.Render(), nullptr);
+
+    RSSurfaceCaptureTask unknownNode(NODE_ID, 1.f, 1.f);
+    ASSERT_FALSE(unknownNode.Snapshot());
+    ASSERT_EQ(unknownNode.Run(), nullptr);
+}
+
+/**
+ * @tc.name: OnFrame001
+ * @tc.desc: frames of a node that can not be snapshotted are not delivered
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSContinuousSurfaceCaptureTest, OnFrame001, TestSize.Level1)
+{
+    sptr<CountingSurfaceCaptureCallback> callback = new CountingSurfaceCaptureCallback();
+    auto capture = CreateCapture(callback);
+    for (int i = 0; i < FRAME_COUNT; i++) {
+        capture->OnFrame(i * NS_PER_SECOND);
+    }
+    ASSERT_EQ(callback->count, 0);
+
+    // a capture without a callback ignores frames
+    auto noCallback = CreateCapture(nullptr);
+    noCallback->OnFrame(0);
+}
+} // namespace OHOS::Rosen
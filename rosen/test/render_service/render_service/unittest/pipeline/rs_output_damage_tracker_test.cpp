@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "pipeline/rs_output_damage_tracker.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+namespace {
+constexpr int32_t SCREEN_WIDTH = 1000;
+constexpr int32_t SCREEN_HEIGHT = 800;
+constexpr int32_t BUFFER_A = 1;
+constexpr int32_t BUFFER_B = 2;
+}
+
+class RSOutputDamageTrackerTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+};
+
+void RSOutputDamageTrackerTest::SetUpTestCase() {}
+void RSOutputDamageTrackerTest::TearDownTestCase() {}
+void RSOutputDamageTrackerTest::SetUp() {}
+void RSOutputDamageTrackerTest::TearDown() {}
+
+/**
+ * @tc.name: FirstFrame001
+ * @tc.desc: new buffers are redrawn entirely
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSOutputDamageTrackerTest, FirstFrame001, TestSize.Level1)
+{
+    RSOutputDamageTracker tracker;
+    tracker.BeginFrame(SCREEN_WIDTH, SCREEN_HEIGHT);
+    tracker.AddSurface(1, RectI(0, 0, 100, 100), 1.0f);
+    RectI redrawRect = tracker.EndFrame(BUFFER_A);
+    EXPECT_EQ(redrawRect, RectI(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT));
+    EXPECT_EQ(tracker.GetFrameDamage(), RectI(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT));
+}
+
+/**
+ * @tc.name: BufferAge001
+ * @tc.desc: the redraw rect of a recycled buffer contains the damages of all frames since it was drawn
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSOutputDamageTrackerTest, BufferAge001, TestSize.Level1)
+{
+    RSOutputDamageTracker tracker;
+    tracker.BeginFrame(SCREEN_WIDTH, SCREEN_HEIGHT);
+    tracker.AddSurface(1, RectI(0, 0, 100, 100), 1.0f);
+    tracker.EndFrame(BUFFER_A);
+
+    tracker.BeginFrame(SCREEN_WIDTH, SCREEN_HEIGHT);
+    tracker.AddSurface(1, RectI(0, 0, 100, 100), 1.0f);
+    tracker.AddDamage(RectI(10, 10, 10, 10));
+    // never drawn into buffer B before
+    EXPECT_EQ(tracker.EndFrame(BUFFER_B), RectI(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT));
+    EXPECT_EQ(tracker.GetFrameDamage(), RectI(10, 10, 10, 10));
+
+    tracker.BeginFrame(SCREEN_WIDTH, SCREEN_HEIGHT);
+    tracker.AddSurface(1, RectI(0, 0, 100, 100), 1.0f);
+    tracker.AddDamage(RectI(50, 50, 10, 10));
+    // buffer A misses the damage of the previous frame too
+    EXPECT_EQ(tracker.EndFrame(BUFFER_A), RectI(10, 10, 50, 50));
+    EXPECT_EQ(tracker.GetFrameDamage(), RectI(50, 50, 10, 10));
+}
+
+/**
+ * @tc.name: SurfaceChanges001
+ * @tc.desc: moved and removed surfaces damage their old and new rects
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSOutputDamageTrackerTest, SurfaceChanges001, TestSize.Level1)
+{
+    RSOutputDamageTracker tracker;
+    tracker.BeginFrame(SCREEN_WIDTH, SCREEN_HEIGHT);
+    tracker.AddSurface(1, RectI(0, 0, 100, 100), 1.0f);
+    tracker.AddSurface(2, RectI(200, 200, 100, 100), 1.0f);
+    tracker.EndFrame(BUFFER_A);
+
+    tracker.BeginFrame(SCREEN_WIDTH, SCREEN_HEIGHT);
+    tracker.AddSurface(1, RectI(0, 0, 100, 100), 1.0f);
+    tracker.AddSurface(2, RectI(250, 200, 100, 100), 1.0f);
+    tracker.EndFrame(BUFFER_A);
+    EXPECT_EQ(tracker.GetFrameDamage(), RectI(200, 200, 150, 100));
+
+    tracker.BeginFrame(SCREEN_WIDTH, SCREEN_HEIGHT);
+    tracker.AddSurface(1, RectI(0, 0, 100, 100), 1.0f);
+    tracker.EndFrame(BUFFER_A);
+    EXPECT_EQ(tracker.GetFrameDamage(), RectI(250, 200, 100, 100));
+
+    tracker.BeginFrame(SCREEN_WIDTH, SCREEN_HEIGHT);
+    tracker.AddSurface(1, RectI(0, 0, 100, 100), 1.0f);
+    EXPECT_TRUE(tracker.EndFrame(BUFFER_A).IsEmpty());
+    EXPECT_TRUE(tracker.GetFrameDamage().IsEmpty());
+}
+
+/**
+ * @tc.name: MapBufferDamage001
+ * @tc.desc: buffer damage is scaled to the dst rect, an empty damage covers the whole dst rect
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSOutputDamageTrackerTest, MapBufferDamage001, TestSize.Level1)
+{
+    RectI dstRect(100, 100, 200, 200);
+    Rect damage = { 10, 10, 20, 20 };
+    EXPECT_EQ(RSOutputDamageTracker::MapBufferDamage(damage, 100, 100, dstRect), RectI(120, 120, 40, 40));
+    Rect emptyDamage = { 0, 0, 0, 0 };
+    EXPECT_EQ(RSOutputDamageTracker::MapBufferDamage(emptyDamage, 100, 100, dstRect), dstRect);
+}
+} // namespace OHOS::Rosen
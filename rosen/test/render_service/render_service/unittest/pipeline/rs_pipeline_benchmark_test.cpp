@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "hdi_backend.h"
+#include "mock_hdi_device.h"
+#include "parcel.h"
+
+#include "animation/rs_render_curve_animation.h"
+#include "command/rs_animation_command.h"
+#include "command/rs_base_node_command.h"
+#include "command/rs_canvas_node_command.h"
+#include "command/rs_display_node_command.h"
+#include "command/rs_node_command.h"
+#include "command/rs_surface_node_command.h"
+#include "pipeline/rs_main_thread.h"
+#include "screen_manager/rs_screen_manager.h"
+#include "transaction/rs_transaction_data.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace {
+// allocations of the whole process, read around the parts of a frame to count theirs
+std::atomic<uint64_t> g_allocationCount { 0 };
+} // namespace
+
+void* operator new(size_t size)
+{
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace OHOS::Rosen {
+namespace {
+constexpr uint64_t PID = 1000;
+constexpr uint32_t SCREEN_COUNT = 2;
+constexpr uint32_t SCREEN_WIDTH = 720;
+constexpr uint32_t SCREEN_HEIGHT = 1280;
+constexpr uint32_t SURFACE_COUNT = 8;
+constexpr uint32_t CANVAS_COUNT = 16;
+constexpr uint32_t FRAME_COUNT = 120;
+// a new batch of animations is started every ANIMATION_INTERVAL frames and runs for ANIMATION_DURATION_MS
+constexpr uint32_t ANIMATION_INTERVAL = 10;
+constexpr int ANIMATION_DURATION_MS = 300;
+constexpr uint64_t FRAME_INTERVAL_NS = 16666667;
+constexpr float CANVAS_HEIGHT = 64.f;
+
+NodeId MakeNodeId(uint32_t index)
+{
+    return (PID << 32) | index;
+}
+
+// ids of the nodes of a screen, one display with surfaces of canvas nodes
+NodeId DisplayNodeId(uint32_t screen)
+{
+    return MakeNodeId(1 + screen * (1 + SURFACE_COUNT * (1 + CANVAS_COUNT)));
+}
+
+NodeId SurfaceNodeId(uint32_t screen, uint32_t surface)
+{
+    return DisplayNodeId(screen) + 1 + surface * (1 + CANVAS_COUNT);
+}
+
+NodeId CanvasNodeId(uint32_t screen, uint32_t surface, uint32_t canvas)
+{
+    return SurfaceNodeId(screen, surface) + 1 + canvas;
+}
+
+// acquires and releases the frames composed into a virtual screen right away
+class BufferConsumer : public IBufferConsumerListener {
+public:
+    explicit BufferConsumer(const sptr<Surface>& surface) : surface_(surface) {}
+    ~BufferConsumer() noexcept override = default;
+
+    void OnBufferAvailable() override
+    {
+        sptr<SurfaceBuffer> buffer;
+        sptr<SyncFence> fence = SyncFence::INVALID_FENCE;
+        int64_t timestamp = 0;
+        Rect damage;
+        if (surface_->AcquireBuffer(buffer, fence, timestamp, damage) != SURFACE_ERROR_OK || buffer == nullptr) {
+            return;
+        }
+        surface_->ReleaseBuffer(buffer, SyncFence::INVALID_FENCE);
+    }
+
+private:
+    sptr<Surface> surface_;
+};
+
+struct PhaseTotals {
+    int64_t processCommand = 0;
+    int64_t animate = 0;
+    int64_t prepare = 0;
+    int64_t process = 0;
+    int64_t sendCommands = 0;
+    int64_t frame = 0;
+    uint64_t unmarshallingAllocations = 0;
+    uint64_t frameAllocations = 0;
+};
+} // namespace
+
+class RSPipelineBenchmarkTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+
+    // commands of one frame in the form they arrive from the client
+    class RecordedFrame {
+    public:
+        template<typename Command, typename... Args>
+        void Add(Args&&... args)
+        {
+            Command command(std::forward<Args>(args)...);
+            command.Marshalling(parcel_);
+        }
+
+        std::unique_ptr<RSTransactionData> Unmarshalling()
+        {
+            Parcel parcel;
+            parcel.WriteBuffer(reinterpret_cast<const void*>(parcel_.GetData()), parcel_.GetDataSize());
+            return std::unique_ptr<RSTransactionData>(RSTransactionData::Unmarshalling(parcel));
+        }
+
+    private:
+        Parcel parcel_;
+    };
+
+    static void RecordCreation(RecordedFrame& frame)
+    {
+        for (uint32_t screen = 0; screen < SCREEN_COUNT; screen++) {
+            RSDisplayNodeConfig config = { screenIds_[screen], false, 0 };
+            frame.Add<RSDisplayNodeCreate>(DisplayNodeId(screen), config);
+            for (uint32_t surface = 0; surface < SURFACE_COUNT; surface++) {
+                NodeId surfaceId = SurfaceNodeId(screen, surface);
+                frame.Add<RSSurfaceNodeCreate>(surfaceId);
+                frame.Add<RSNodeSetBounds>(surfaceId,
+                    Vector4f(0.f, surface * CANVAS_HEIGHT, SCREEN_WIDTH, SCREEN_HEIGHT - surface * CANVAS_HEIGHT));
+                frame.Add<RSBaseNodeAddChild>(DisplayNodeId(screen), surfaceId, -1);
+                for (uint32_t canvas = 0; canvas < CANVAS_COUNT; canvas++) {
+                    NodeId canvasId = CanvasNodeId(screen, surface, canvas);
+                    frame.Add<RSCanvasNodeCreate>(canvasId);
+                    frame.Add<RSNodeSetBounds>(canvasId,
+                        Vector4f(0.f, canvas * CANVAS_HEIGHT, SCREEN_WIDTH, CANVAS_HEIGHT));
+                    auto shade = static_cast<int16_t>(canvas * 16);
+                    frame.Add<RSNodeSetBackgroundColor>(canvasId, Color(shade, 128, 255 - shade, 255));
+                    frame.Add<RSBaseNodeAddChild>(surfaceId, canvasId, -1);
+                }
+            }
+        }
+    }
+
+    // property updates on every frame, animations of translation and alpha on a part of the canvas nodes
+    static void RecordUpdate(RecordedFrame& frame, uint32_t index)
+    {
+        for (uint32_t screen = 0; screen < SCREEN_COUNT; screen++) {
+            for (uint32_t surface = 0; surface < SURFACE_COUNT; surface++) {
+                NodeId canvasId = CanvasNodeId(screen, surface, index % CANVAS_COUNT);
+                frame.Add<RSNodeSetAlpha>(canvasId, 0.5f + (index % 2) * 0.5f);
+                if (index % ANIMATION_INTERVAL != 0) {
+                    continue;
+                }
+                for (uint32_t canvas = surface % 2; canvas < CANVAS_COUNT; canvas += 2) {
+                    NodeId targetId = CanvasNodeId(screen, surface, canvas);
+                    AnimationId translateId = (static_cast<AnimationId>(index) << 32) | (targetId & 0xFFFFFFFF);
+                    auto translate = std::make_shared<RSRenderCurveAnimation<float>>(
+                        translateId, RSAnimatableProperty::TRANSLATE_X, 0.f, 0.f, static_cast<float>(canvas * 8));
+                    translate->SetDuration(ANIMATION_DURATION_MS);
+                    frame.Add<RSAnimationCreateCurveFloat>(targetId, translate);
+                    auto alpha = std::make_shared<RSRenderCurveAnimation<float>>(
+                        translateId + 1, RSAnimatableProperty::ALPHA, 1.f, 1.f, 0.5f);
+                    alpha->SetDuration(ANIMATION_DURATION_MS);
+                    frame.Add<RSAnimationCreateCurveFloat>(targetId, alpha);
+                }
+            }
+        }
+    }
+
+    static void RecordDestruction(RecordedFrame& frame)
+    {
+        for (uint32_t screen = 0; screen < SCREEN_COUNT; screen++) {
+            for (uint32_t surface = 0; surface < SURFACE_COUNT; surface++) {
+                for (uint32_t canvas = 0; canvas < CANVAS_COUNT; canvas++) {
+                    frame.Add<RSBaseNodeDestroy>(CanvasNodeId(screen, surface, canvas));
+                }
+                frame.Add<RSBaseNodeDestroy>(SurfaceNodeId(screen, surface));
+            }
+            frame.Add<RSBaseNodeDestroy>(DisplayNodeId(screen));
+        }
+    }
+
+    // replays [frame] through the main thread as if it arrived right before vsync [timestamp]
+    static void ReplayFrame(RecordedFrame& frame, uint64_t timestamp, PhaseTotals& totals)
+    {
+        auto mainThread = RSMainThread::Instance();
+        uint64_t allocations = g_allocationCount.load(std::memory_order_relaxed);
+        auto transactionData = frame.Unmarshalling();
+        totals.unmarshallingAllocations += g_allocationCount.load(std::memory_order_relaxed) - allocations;
+        ASSERT_NE(transactionData, nullptr);
+        mainThread->RecvRSTransactionData(transactionData);
+
+        allocations = g_allocationCount.load(std::memory_order_relaxed);
+        auto start = std::chrono::steady_clock::now();
+        mainThread->DoComposition(timestamp);
+        totals.frame +=
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        totals.frameAllocations += g_allocationCount.load(std::memory_order_relaxed) - allocations;
+
+        const auto& timings = mainThread->GetLastFrameTimings();
+        totals.processCommand += timings.processCommand;
+        totals.animate += timings.animate;
+        totals.prepare += timings.prepare;
+        totals.process += timings.process;
+        totals.sendCommands += timings.sendCommands;
+    }
+
+    static inline ScreenId screenIds_[SCREEN_COUNT] = {};
+    static inline sptr<Surface> consumerSurfaces_[SCREEN_COUNT] = {};
+};
+
+void RSPipelineBenchmarkTest::SetUpTestCase()
+{
+    // no display hardware is needed, hotplug is registered on a mock device that never reports a screen
+    auto device = Mock::HdiDevice::GetInstance();
+    EXPECT_CALL(*device, RegHotPlugCallback(_, _)).WillRepeatedly(Return(DISPLAY_SUCCESS));
+    HdiBackend::GetInstance()->SetHdiBackendDevice(device);
+    auto screenManager = CreateOrGetScreenManager();
+    ASSERT_NE(screenManager, nullptr);
+    EXPECT_TRUE(screenManager->Init());
+
+    for (uint32_t i = 0; i < SCREEN_COUNT; i++) {
+        consumerSurfaces_[i] = Surface::CreateSurfaceAsConsumer("RSPipelineBenchmark" + std::to_string(i));
+        ASSERT_NE(consumerSurfaces_[i], nullptr);
+        sptr<IBufferConsumerListener> listener = new BufferConsumer(consumerSurfaces_[i]);
+        consumerSurfaces_[i]->RegisterConsumerListener(listener);
+        auto producer = consumerSurfaces_[i]->GetProducer();
+        auto producerSurface = Surface::CreateSurfaceAsProducer(producer);
+        screenIds_[i] = screenManager->CreateVirtualScreen(
+            "RSPipelineBenchmark" + std::to_string(i), SCREEN_WIDTH, SCREEN_HEIGHT, producerSurface);
+        ASSERT_NE(screenIds_[i], INVALID_SCREEN_ID);
+    }
+}
+
+void RSPipelineBenchmarkTest::TearDownTestCase()
+{
+    auto screenManager = CreateOrGetScreenManager();
+    for (uint32_t i = 0; i < SCREEN_COUNT; i++) {
+        RSMainThread::Instance()->RemoveProcessor(screenIds_[i]);
+        if (screenManager != nullptr) {
+            screenManager->RemoveVirtualScreen(screenIds_[i]);
+        }
+        consumerSurfaces_[i] = nullptr;
+    }
+}
+
+void RSPipelineBenchmarkTest::SetUp() {}
+void RSPipelineBenchmarkTest::TearDown() {}
+
+/**
+ * @tc.name: Benchmark001
+ * @tc.desc: replays a stream of transactions creating, updating and animating nodes on virtual screens through the
+ *           main thread and reports the time and allocations of each phase of a frame
+ * @tc.type: PERF
+ */
+HWTEST_F(RSPipelineBenchmarkTest, Benchmark001, TestSize.Level2)
+{
+    std::vector<RecordedFrame> frames(FRAME_COUNT + 1);
+    RecordCreation(frames[0]);
+    for (uint32_t i = 1; i < FRAME_COUNT; i++) {
+        RecordUpdate(frames[i], i);
+    }
+    RecordDestruction(frames[FRAME_COUNT]);
+
+    PhaseTotals totals;
+    uint64_t timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    ReplayFrame(frames[0], timestamp, totals);
+    auto& nodeMap = RSMainThread::Instance()->GetContext().GetNodeMap();
+    for (uint32_t screen = 0; screen < SCREEN_COUNT; screen++) {
+        EXPECT_NE(nodeMap.GetRenderNode<RSBaseRenderNode>(DisplayNodeId(screen)), nullptr);
+        auto lastNodeId = CanvasNodeId(screen, SURFACE_COUNT - 1, CANVAS_COUNT - 1);
+        EXPECT_NE(nodeMap.GetRenderNode<RSBaseRenderNode>(lastNodeId), nullptr);
+    }
+    // only the steady state frames are measured
+    totals = PhaseTotals();
+    for (uint32_t i = 1; i < FRAME_COUNT; i++) {
+        timestamp += FRAME_INTERVAL_NS;
+        ReplayFrame(frames[i], timestamp, totals);
+    }
+    // the last batch of animations is still running
+    auto animatedNode = nodeMap.GetRenderNode<RSRenderNode>(CanvasNodeId(0, 0, 2));
+    ASSERT_NE(animatedNode, nullptr);
+    EXPECT_GT(animatedNode->GetRenderProperties().GetTranslateX(), 0.f);
+
+    constexpr double frameCount = FRAME_COUNT - 1;
+    printf("RSPipelineBenchmarkTest %u screens, %u nodes, %u frames, us/frame: processCommand %.1f animate %.1f "
+        "prepare %.1f process %.1f sendCommands %.1f total %.1f\n", SCREEN_COUNT,
+        SCREEN_COUNT * (1 + SURFACE_COUNT * (1 + CANVAS_COUNT)), FRAME_COUNT - 1, totals.processCommand / frameCount,
+        totals.animate / frameCount, totals.prepare / frameCount, totals.process / frameCount,
+        totals.sendCommands / frameCount, totals.frame / frameCount);
+    printf("RSPipelineBenchmarkTest allocations/frame: unmarshalling %.1f composition %.1f\n",
+        totals.unmarshallingAllocations / frameCount, totals.frameAllocations / frameCount);
+
+    timestamp += FRAME_INTERVAL_NS;
+    ReplayFrame(frames[FRAME_COUNT], timestamp, totals);
+    for (uint32_t screen = 0; screen < SCREEN_COUNT; screen++) {
+        EXPECT_EQ(nodeMap.GetRenderNode<RSBaseRenderNode>(DisplayNodeId(screen)), nullptr);
+    }
+}
+} // namespace OHOS::Rosen
@@ -16,6 +16,7 @@
 #include "gtest/gtest.h"
 #include "limit_number.h"
 #include "pipeline/rs_render_service_visitor.h"
+#include "surface_buffer_impl.h"
 
 #include "pipeline/rs_base_render_node.h"
 #include "pipeline/rs_display_render_node.h"
@@ -33,6 +34,16 @@ public:
     static void TearDownTestCase();
     void SetUp() override;
     void TearDown() override;
+
+    // an opaque surface at [bounds] with a buffer, blended with SRC
+    static std::shared_ptr<RSSurfaceRenderNode> CreateOpaqueSurface(NodeId id, const Vector4f& bounds)
+    {
+        auto node = std::make_shared<RSSurfaceRenderNode>(id);
+        node->GetMutableRenderProperties().SetBounds(bounds);
+        node->SetBuffer(new SurfaceBufferImpl());
+        node->SetBlendType(BLEND_SRC);
+        return node;
+    }
 };
 
 void RSRenderServiceVisitorTest::SetUpTestCase() {}
@@ -1267,4 +1278,56 @@ HWTEST_F(RSRenderServiceVisitorTest, ProcessRootRenderNode008, TestSize.Level1)
     RSRootRenderNode node(nodeId);
     rsRenderServiceVisitor.ProcessRootRenderNode(node);
 }
+/**
+ * @tc.name: CalcOcclusion001
+ * @tc.desc: an opaque surface covering a surface behind it occludes it
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSRenderServiceVisitorTest, CalcOcclusion001, TestSize.Level1)
+{
+    auto visitor = std::make_shared<RSRenderServiceVisitor>();
+    RSDisplayNodeConfig config;
+    auto display = std::make_shared<RSDisplayRenderNode>(TestSrc::limitNumber::Uint64[1], config);
+    auto sibling = CreateOpaqueSurface(TestSrc::limitNumber::Uint64[2], { 0.f, 0.f, 100.f, 100.f });
+    auto parent = CreateOpaqueSurface(TestSrc::limitNumber::Uint64[3], { 0.f, 0.f, 200.f, 200.f });
+    auto child = CreateOpaqueSurface(TestSrc::limitNumber::Uint64[4], { 0.f, 0.f, 200.f, 200.f });
+    // the sibling is composed first, below the parent and its child
+    display->AddChild(sibling);
+    display->AddChild(parent);
+    parent->AddChild(child);
+
+    visitor->PrepareDisplayRenderNode(*display);
+    EXPECT_EQ(visitor->CalcOcclusion(*display), 2u);
+    EXPECT_TRUE(visitor->IsOccluded(sibling->GetId()));
+    EXPECT_TRUE(visitor->IsOccluded(child->GetId()));
+    EXPECT_FALSE(visitor->IsOccluded(parent->GetId()));
+}
+
+/**
+ * @tc.name: CalcOcclusion002
+ * @tc.desc: the child of a translucent surface is translucent too and occludes nothing
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(RSRenderServiceVisitorTest, CalcOcclusion002, TestSize.Level1)
+{
+    auto visitor = std::make_shared<RSRenderServiceVisitor>();
+    RSDisplayNodeConfig config;
+    auto display = std::make_shared<RSDisplayRenderNode>(TestSrc::limitNumber::Uint64[1], config);
+    auto sibling = CreateOpaqueSurface(TestSrc::limitNumber::Uint64[2], { 0.f, 0.f, 100.f, 100.f });
+    auto parent = CreateOpaqueSurface(TestSrc::limitNumber::Uint64[3], { 0.f, 0.f, 200.f, 200.f });
+    auto child = CreateOpaqueSurface(TestSrc::limitNumber::Uint64[4], { 0.f, 0.f, 200.f, 200.f });
+    parent->GetMutableRenderProperties().SetAlpha(0.5f);
+    display->AddChild(sibling);
+    display->AddChild(parent);
+    parent->AddChild(child);
+
+    visitor->PrepareDisplayRenderNode(*display);
+    EXPECT_EQ(visitor->CalcOcclusion(*display), 0u);
+    EXPECT_FALSE(visitor->IsOccluded(sibling->GetId()));
+    EXPECT_FALSE(visitor->IsOccluded(child->GetId()));
+}
 } // namespace OHOS::Rosen
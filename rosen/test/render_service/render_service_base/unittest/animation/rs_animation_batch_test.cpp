@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/animation/rs_animation_batch.h"
+#include "include/animation/rs_cubic_bezier_interpolator.h"
+#include "include/animation/rs_render_curve_animation.h"
+#include "include/animation/rs_spring_interpolator.h"
+#include "include/pipeline/rs_canvas_render_node.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+namespace {
+constexpr int64_t FRAME_INTERVAL_NS = 16666667;
+constexpr int ANIMATION_DURATION_MS = 1000;
+constexpr int FRAME_COUNT = 30;
+constexpr int BENCHMARK_FRAME_COUNT = 10;
+} // namespace
+
+class RSAnimationBatchTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+
+    // one node per animation, animations cycle through value types and interpolators
+    static std::vector<std::shared_ptr<RSCanvasRenderNode>> CreateAnimatingNodes(int count)
+    {
+        std::vector<std::shared_ptr<RSCanvasRenderNode>> nodes;
+        for (int i = 0; i < count; i++) {
+            auto node = std::make_shared<RSCanvasRenderNode>(i + 1);
+            std::shared_ptr<RSRenderAnimation> animation;
+            std::shared_ptr<RSInterpolator> interpolator;
+            switch (i % 3) {
+                case 0:
+                    interpolator = std::make_shared<LinearInterpolator>();
+                    break;
+                case 1:
+                    interpolator = std::make_shared<RSCubicBezierInterpolator>(0.42f, 0.0f, 0.58f, 1.0f);
+                    break;
+                default:
+                    interpolator = std::make_shared<RSSpringInterpolator>(0.5f, 0.8f, 0.0f);
+                    break;
+            }
+            AnimationId id = static_cast<AnimationId>(i + 1);
+            switch (i % 4) {
+                case 0: {
+                    auto curve = std::make_shared<RSRenderCurveAnimation<float>>(
+                        id, RSAnimatableProperty::ALPHA, 1.0f, 0.0f, 1.0f);
+                    curve->SetInterpolator(interpolator);
+                    animation = curve;
+                    break;
+                }
+                case 1: {
+                    auto curve = std::make_shared<RSRenderCurveAnimation<Vector2f>>(id,
+                        RSAnimatableProperty::TRANSLATE, Vector2f(0.f, 0.f), Vector2f(0.f, 0.f), Vector2f(i, -i));
+                    curve->SetInterpolator(interpolator);
+                    animation = curve;
+                    break;
+                }
+                case 2: {
+                    auto curve = std::make_shared<RSRenderCurveAnimation<Vector4f>>(id, RSAnimatableProperty::BOUNDS,
+                        Vector4f(0.f), Vector4f(0.f, 0.f, 10.f, 10.f), Vector4f(i, i, 100.f, 200.f));
+                    curve->SetInterpolator(interpolator);
+                    animation = curve;
+                    break;
+                }
+                default: {
+                    // not batched, evaluated directly
+                    auto curve = std::make_shared<RSRenderCurveAnimation<Quaternion>>(id,
+                        RSAnimatableProperty::ROTATION_3D, Quaternion(), Quaternion(), Quaternion(0.f, 0.f, 1.f, 0.f));
+                    curve->SetInterpolator(interpolator);
+                    animation = curve;
+                    break;
+                }
+            }
+            animation->SetDuration(ANIMATION_DURATION_MS);
+            node->GetAnimationManager().AddAnimation(animation);
+            animation->Attach(node.get());
+            animation->Start();
+            nodes.push_back(node);
+        }
+        return nodes;
+    }
+
+    static void AnimateDirect(const std::vector<std::shared_ptr<RSCanvasRenderNode>>& nodes, int64_t time)
+    {
+        for (auto& node : nodes) {
+            node->Animate(time);
+        }
+    }
+
+    static void AnimateBatched(
+        const std::vector<std::shared_ptr<RSCanvasRenderNode>>& nodes, int64_t time, RSAnimationBatch& batch)
+    {
+        for (auto& node : nodes) {
+            node->Animate(time, batch);
+        }
+        batch.Evaluate();
+    }
+
+    static void ExpectSameProperties(const RSProperties& lhs, const RSProperties& rhs)
+    {
+        EXPECT_EQ(lhs.GetAlpha(), rhs.GetAlpha());
+        EXPECT_EQ(lhs.GetTranslate(), rhs.GetTranslate());
+        EXPECT_EQ(lhs.GetBounds(), rhs.GetBounds());
+        EXPECT_EQ(lhs.GetQuaternion(), rhs.GetQuaternion());
+    }
+
+    static double MeasureFrameTime(int count, bool batched)
+    {
+        auto nodes = CreateAnimatingNodes(count);
+        RSAnimationBatch batch;
+        // the first frame only records the start time of the animations
+        int64_t time = 0;
+        batched ? AnimateBatched(nodes, time, batch) : AnimateDirect(nodes, time);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < BENCHMARK_FRAME_COUNT; i++) {
+            time += FRAME_INTERVAL_NS;
+            batched ? AnimateBatched(nodes, time, batch) : AnimateDirect(nodes, time);
+        }
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / BENCHMARK_FRAME_COUNT;
+    }
+};
+
+void RSAnimationBatchTest::SetUpTestCase() {}
+void RSAnimationBatchTest::TearDownTestCase() {}
+void RSAnimationBatchTest::SetUp() {}
+void RSAnimationBatchTest::TearDown() {}
+
+/**
+ * @tc.name: Evaluate001
+ * @tc.desc: batched animations produce the same property values as animations evaluated one by one
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSAnimationBatchTest, Evaluate001, TestSize.Level1)
+{
+    constexpr int animationCount = 24;
+    auto directNodes = CreateAnimatingNodes(animationCount);
+    auto batchedNodes = CreateAnimatingNodes(animationCount);
+    RSAnimationBatch batch;
+    for (int frame = 0; frame < FRAME_COUNT; frame++) {
+        int64_t time = frame * FRAME_INTERVAL_NS;
+        AnimateDirect(directNodes, time);
+        AnimateBatched(batchedNodes, time, batch);
+        EXPECT_TRUE(batch.IsEmpty());
+        for (int i = 0; i < animationCount; i++) {
+            ExpectSameProperties(directNodes[i]->GetRenderProperties(), batchedNodes[i]->GetRenderProperties());
+        }
+    }
+}
+
+/**
+ * @tc.name: Add001
+ * @tc.desc: only float, Vector2f and Vector4f values are queued
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSAnimationBatchTest, Add001, TestSize.Level1)
+{
+    RSAnimationBatch batch;
+    auto nodes = CreateAnimatingNodes(8);
+    // the first frame only records the start time of the animations
+    AnimateBatched(nodes, 0, batch);
+    for (auto& node : nodes) {
+        node->Animate(FRAME_INTERVAL_NS, batch);
+    }
+    EXPECT_EQ(batch.GetSize(), 6u);
+    batch.Clear();
+    EXPECT_TRUE(batch.IsEmpty());
+}
+
+/**
+ * @tc.name: Finish001
+ * @tc.desc: finishing animations are applied directly and removed
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSAnimationBatchTest, Finish001, TestSize.Level1)
+{
+    RSAnimationBatch batch;
+    auto nodes = CreateAnimatingNodes(1);
+    AnimateBatched(nodes, 0, batch);
+    EXPECT_FALSE(nodes[0]->Animate(ANIMATION_DURATION_MS * 1000000LL, batch));
+    EXPECT_TRUE(batch.IsEmpty());
+    EXPECT_EQ(nodes[0]->GetRenderProperties().GetAlpha(), 1.0f);
+}
+
+/**
+ * @tc.name: Benchmark001
+ * @tc.desc: time of an animation frame with 1k and 10k animations, evaluated one by one and batched
+ * @tc.type: PERF
+ */
+HWTEST_F(RSAnimationBatchTest, Benchmark001, TestSize.Level2)
+{
+    for (int count : { 1000, 10000 }) {
+        double direct = MeasureFrameTime(count, false);
+        double batched = MeasureFrameTime(count, true);
+        printf("RSAnimationBatchTest %d animations: direct %.1f us/frame, batched %.1f us/frame\n",
+            count, direct, batched);
+        EXPECT_GT(direct, 0.0);
+        EXPECT_GT(batched, 0.0);
+    }
+}
+} // namespace OHOS::Rosen
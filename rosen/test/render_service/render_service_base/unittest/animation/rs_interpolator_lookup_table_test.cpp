@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "include/animation/rs_interpolator.h"
+#include "include/animation/rs_interpolator_lookup_table.h"
+#include "include/animation/rs_spring_interpolator.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+namespace {
+constexpr int SAMPLE_COUNT = 1000;
+constexpr float MINIMUM_AMPLITUDE = 0.001f;
+constexpr float SECONDS_TO_MICROSECONDS = 1e6f;
+} // namespace
+
+class RSInterpolatorLookupTableTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+};
+
+void RSInterpolatorLookupTableTest::SetUpTestCase() {}
+void RSInterpolatorLookupTableTest::TearDownTestCase() {}
+void RSInterpolatorLookupTableTest::SetUp() {}
+void RSInterpolatorLookupTableTest::TearDown() {}
+
+/**
+ * @tc.name: Lookup001
+ * @tc.desc: lookups interpolate linearly between the samples and tables are shared by key
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSInterpolatorLookupTableTest, Lookup001, TestSize.Level1)
+{
+    auto sampler = [](float input) { return input * input; };
+    auto table = RSInterpolatorLookupTable::GetOrCreate({ 1.f, 2.f }, 3, sampler);
+    ASSERT_NE(table, nullptr);
+    EXPECT_EQ(table->GetSampleCount(), 3u);
+    EXPECT_FLOAT_EQ(table->Lookup(0.f), 0.f);
+    EXPECT_FLOAT_EQ(table->Lookup(0.25f), 0.125f);
+    EXPECT_FLOAT_EQ(table->Lookup(0.5f), 0.25f);
+    EXPECT_FLOAT_EQ(table->Lookup(1.f), 1.f);
+
+    EXPECT_EQ(RSInterpolatorLookupTable::GetOrCreate({ 1.f, 2.f }, 3, sampler), table);
+    EXPECT_NE(RSInterpolatorLookupTable::GetOrCreate({ 1.f, 3.f }, 3, sampler), table);
+    EXPECT_EQ(RSInterpolatorLookupTable::GetOrCreate({ 1.f, 2.f }, 1, sampler), nullptr);
+    EXPECT_EQ(RSInterpolatorLookupTable::GetOrCreate(
+        { 1.f, 2.f }, RSInterpolatorLookupTable::MAX_SAMPLE_COUNT + 1, sampler), nullptr);
+}
+
+/**
+ * @tc.name: Spring001
+ * @tc.desc: spring curves read from the table stay within the minimum amplitude of the evaluated curve
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSInterpolatorLookupTableTest, Spring001, TestSize.Level1)
+{
+    // response, damping ratio: under-damped, critically damped and over-damped springs
+    float springs[][2] = { { 0.55f, 0.825f }, { 0.2f, 0.05f }, { 1.f, 1.f }, { 0.5f, 1.5f } };
+    for (auto& spring : springs) {
+        RSSpringInterpolator interpolator(spring[0], spring[1], 0.f);
+        // same curve, evaluated directly
+        RSValueSpringInterpolator reference(spring[0], spring[1], 1.f, MINIMUM_AMPLITUDE);
+        float duration = reference.GetEstimatedDuration() / SECONDS_TO_MICROSECONDS;
+        for (int i = 0; i <= SAMPLE_COUNT; i++) {
+            float input = static_cast<float>(i) / SAMPLE_COUNT;
+            int64_t microseconds = static_cast<int64_t>(std::round(input * duration * SECONDS_TO_MICROSECONDS));
+            EXPECT_NEAR(interpolator.Interpolate(input), reference.InterpolateValue(microseconds),
+                MINIMUM_AMPLITUDE * 2);
+        }
+    }
+}
+
+/**
+ * @tc.name: Custom001
+ * @tc.desc: custom curves sampled at even times are read by index
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSInterpolatorLookupTableTest, Custom001, TestSize.Level1)
+{
+    RSCustomInterpolator interpolator([](float input) { return input * input; }, 1000);
+    for (int i = 1; i < SAMPLE_COUNT; i++) {
+        float input = static_cast<float>(i) / SAMPLE_COUNT;
+        EXPECT_NEAR(interpolator.Interpolate(input), input * input, 0.001f);
+    }
+    EXPECT_FLOAT_EQ(interpolator.Interpolate(0.f), 0.f);
+    EXPECT_FLOAT_EQ(interpolator.Interpolate(1.f), 1.f);
+}
+} // namespace OHOS::Rosen
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/animation/rs_parallel_animator.h"
+#include "include/animation/rs_render_curve_animation.h"
+#include "include/pipeline/rs_canvas_render_node.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+namespace {
+constexpr int64_t FRAME_INTERVAL_NS = 16666667;
+constexpr int ANIMATION_DURATION_MS = 100;
+// enough nodes to be split across the workers
+constexpr int NODE_COUNT = 256;
+} // namespace
+
+class RSParallelAnimatorTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+
+    static std::shared_ptr<RSCanvasRenderNode> CreateAnimatingNode(NodeId id)
+    {
+        auto node = std::make_shared<RSCanvasRenderNode>(id);
+        auto animation = std::make_shared<RSRenderCurveAnimation<float>>(
+            id, RSAnimatableProperty::TRANSLATE_X, 0.f, 0.f, static_cast<float>(id));
+        // nodes finish at different frames
+        animation->SetDuration(ANIMATION_DURATION_MS * (1 + id % 3));
+        node->GetAnimationManager().AddAnimation(animation);
+        animation->Attach(node.get());
+        animation->Start();
+        return node;
+    }
+};
+
+void RSParallelAnimatorTest::SetUpTestCase() {}
+void RSParallelAnimatorTest::TearDownTestCase() {}
+void RSParallelAnimatorTest::SetUp() {}
+void RSParallelAnimatorTest::TearDown() {}
+
+/**
+ * @tc.name: Animate001
+ * @tc.desc: nodes animated by the parallel animator end in the same state as nodes animated one by one, and are
+ *           removed from the list once their animations finished
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSParallelAnimatorTest, Animate001, TestSize.Level1)
+{
+    std::vector<std::shared_ptr<RSCanvasRenderNode>> directNodes;
+    std::vector<std::shared_ptr<RSCanvasRenderNode>> parallelNodes;
+    RSParallelAnimator::AnimatingNodeList nodeList;
+    for (NodeId id = 1; id <= NODE_COUNT; id++) {
+        directNodes.push_back(CreateAnimatingNode(id));
+        parallelNodes.push_back(CreateAnimatingNode(id));
+        nodeList.emplace(id, parallelNodes.back());
+    }
+    // expired nodes are removed as well
+    nodeList.emplace(NODE_COUNT + 1, std::weak_ptr<RSBaseRenderNode>());
+
+    RSParallelAnimator animator;
+    int64_t time = 0;
+    while (!nodeList.empty()) {
+        animator.Animate(nodeList, time);
+        for (int i = 0; i < NODE_COUNT; i++) {
+            directNodes[i]->Animate(time);
+            EXPECT_EQ(directNodes[i]->GetRenderProperties().GetTranslateX(),
+                parallelNodes[i]->GetRenderProperties().GetTranslateX());
+        }
+        time += FRAME_INTERVAL_NS;
+        ASSERT_LT(time, ANIMATION_DURATION_MS * 4 * 1000000LL);
+    }
+
+    std::string dumpString;
+    animator.Dump(dumpString);
+    EXPECT_NE(dumpString.find("animate time"), std::string::npos);
+}
+} // namespace OHOS::Rosen
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkImage.h"
+#include "include/pipeline/rs_image_cache.h"
+#include "include/pipeline/rs_recording_canvas.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+namespace {
+constexpr int IMAGE_SIZE = 64;
+} // namespace
+
+class RSImageCacheTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+
+    static sk_sp<SkImage> CreateImage(SkColor color, int size = IMAGE_SIZE)
+    {
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(size, size);
+        bitmap.eraseColor(color);
+        bitmap.setImmutable();
+        return SkImage::MakeFromBitmap(bitmap);
+    }
+};
+
+void RSImageCacheTest::SetUpTestCase() {}
+void RSImageCacheTest::TearDownTestCase() {}
+void RSImageCacheTest::SetUp()
+{
+    RSImageCache::Instance().Clear();
+}
+void RSImageCacheTest::TearDown()
+{
+    RSImageCache::Instance().Clear();
+}
+
+/**
+ * @tc.name: SharedImage001
+ * @tc.desc: images with the same pixels are replaced by the first one
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSImageCacheTest, SharedImage001, TestSize.Level1)
+{
+    auto& cache = RSImageCache::Instance();
+    auto image = CreateImage(SK_ColorRED);
+    auto copy = CreateImage(SK_ColorRED);
+    ASSERT_NE(image, nullptr);
+    ASSERT_NE(copy, nullptr);
+    EXPECT_NE(image->uniqueID(), copy->uniqueID());
+
+    EXPECT_EQ(cache.GetOrCache(image), image);
+    EXPECT_EQ(cache.GetOrCache(copy), image);
+    EXPECT_EQ(cache.GetOrCache(copy), image);
+    EXPECT_EQ(cache.GetImageCount(), 1u);
+    EXPECT_EQ(cache.GetHitCount(), 2u);
+    EXPECT_NE(cache.GetImageId(image), 0u);
+    EXPECT_EQ(cache.GetImageId(copy), cache.GetImageId(image));
+    EXPECT_EQ(cache.GetMemoryUsage(), image->imageInfo().computeMinByteSize());
+
+    auto other = CreateImage(SK_ColorGREEN);
+    EXPECT_EQ(cache.GetOrCache(other), other);
+    EXPECT_EQ(cache.GetImageCount(), 2u);
+}
+
+/**
+ * @tc.name: Bitmap001
+ * @tc.desc: unchanged mutable bitmaps are copied once, changed ones are copied again
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSImageCacheTest, Bitmap001, TestSize.Level1)
+{
+    auto& cache = RSImageCache::Instance();
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(IMAGE_SIZE, IMAGE_SIZE);
+    bitmap.eraseColor(SK_ColorBLUE);
+    auto image = cache.GetOrCache(bitmap);
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(cache.GetOrCache(bitmap), image);
+
+    bitmap.eraseColor(SK_ColorYELLOW);
+    auto changed = cache.GetOrCache(bitmap);
+    ASSERT_NE(changed, nullptr);
+    EXPECT_NE(changed, image);
+    EXPECT_EQ(cache.GetImageCount(), 2u);
+    // the first copy is not affected by the change
+    SkBitmap pixels;
+    pixels.allocN32Pixels(IMAGE_SIZE, IMAGE_SIZE);
+    ASSERT_TRUE(image->readPixels(pixels.pixmap(), 0, 0));
+    EXPECT_EQ(pixels.getColor(0, 0), SK_ColorBLUE);
+}
+
+/**
+ * @tc.name: RecordingCanvas001
+ * @tc.desc: images recorded by canvas nodes go through the cache
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSImageCacheTest, RecordingCanvas001, TestSize.Level1)
+{
+    auto& cache = RSImageCache::Instance();
+    for (int i = 0; i < 3; i++) {
+        RSRecordingCanvas canvas(IMAGE_SIZE, IMAGE_SIZE);
+        canvas.drawImage(CreateImage(SK_ColorRED), 0, 0);
+        canvas.drawImageRect(CreateImage(SK_ColorRED), SkRect::MakeWH(IMAGE_SIZE, IMAGE_SIZE), nullptr);
+    }
+    EXPECT_EQ(cache.GetImageCount(), 1u);
+    EXPECT_EQ(cache.GetHitCount(), 5u);
+    EXPECT_GT(cache.GetMemoryUsage(), 0u);
+}
+
+/**
+ * @tc.name: Release001
+ * @tc.desc: images are released once no draw command uses them
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSImageCacheTest, Release001, TestSize.Level1)
+{
+    auto& cache = RSImageCache::Instance();
+    auto image = CreateImage(SK_ColorRED);
+    {
+        RSRecordingCanvas canvas(IMAGE_SIZE, IMAGE_SIZE);
+        canvas.drawImage(CreateImage(SK_ColorGREEN), 0, 0);
+        canvas.drawImage(image, 0, 0);
+        EXPECT_EQ(cache.GetImageCount(), 2u);
+        cache.ReleaseUnusedImages();
+        EXPECT_EQ(cache.GetImageCount(), 2u);
+    }
+    // the draw commands are gone, [image] is still used
+    cache.ReleaseUnusedImages();
+    EXPECT_EQ(cache.GetImageCount(), 1u);
+    EXPECT_EQ(cache.GetMemoryUsage(), image->imageInfo().computeMinByteSize());
+    EXPECT_NE(cache.GetImageId(image), 0u);
+
+    image = nullptr;
+    cache.ReleaseUnusedImages();
+    EXPECT_EQ(cache.GetImageCount(), 0u);
+    EXPECT_EQ(cache.GetMemoryUsage(), 0u);
+}
+
+/**
+ * @tc.name: Release002
+ * @tc.desc: insertions only release unused images once the cache has grown
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSImageCacheTest, Release002, TestSize.Level1)
+{
+    auto& cache = RSImageCache::Instance();
+    auto count = static_cast<int>(RSImageCache::MIN_SWEEP_IMAGE_COUNT);
+    // every image is dropped right after it was cached
+    for (int i = 0; i < count; i++) {
+        cache.GetOrCache(CreateImage(SkColorSetRGB(i, 0, 0)));
+    }
+    EXPECT_EQ(cache.GetImageCount(), RSImageCache::MIN_SWEEP_IMAGE_COUNT);
+
+    auto image = CreateImage(SK_ColorGREEN);
+    EXPECT_EQ(cache.GetOrCache(image), image);
+    EXPECT_EQ(cache.GetImageCount(), 1u);
+    EXPECT_EQ(cache.GetMemoryUsage(), image->imageInfo().computeMinByteSize());
+}
+
+/**
+ * @tc.name: Collision001
+ * @tc.desc: images are only shared when their contents are equal
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSImageCacheTest, Collision001, TestSize.Level1)
+{
+    auto& cache = RSImageCache::Instance();
+    // same pixels, different dimensions
+    auto wide = CreateImage(SK_ColorRED);
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(IMAGE_SIZE * 2, IMAGE_SIZE / 2);
+    bitmap.eraseColor(SK_ColorRED);
+    EXPECT_EQ(cache.GetOrCache(wide), wide);
+    auto other = cache.GetOrCache(bitmap);
+    ASSERT_NE(other, nullptr);
+    EXPECT_NE(other, wide);
+    EXPECT_EQ(other->width(), IMAGE_SIZE * 2);
+
+    // a single differing pixel
+    bitmap.allocN32Pixels(IMAGE_SIZE, IMAGE_SIZE);
+    bitmap.eraseColor(SK_ColorRED);
+    *bitmap.getAddr32(IMAGE_SIZE - 1, IMAGE_SIZE - 1) = 0;
+    other = cache.GetOrCache(bitmap);
+    ASSERT_NE(other, nullptr);
+    EXPECT_NE(other, wide);
+    EXPECT_EQ(cache.GetHitCount(), 0u);
+}
+
+/**
+ * @tc.name: UniqueId001
+ * @tc.desc: images cached under an id of the caller
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSImageCacheTest, UniqueId001, TestSize.Level1)
+{
+    auto& cache = RSImageCache::Instance();
+    constexpr uint64_t id = 42;
+    auto image = CreateImage(SK_ColorRED);
+    cache.CacheImage(id, image);
+    EXPECT_EQ(cache.GetImage(id), image);
+    EXPECT_EQ(cache.GetImageId(image), id);
+    EXPECT_EQ(cache.GetOrCache(image), image);
+
+    cache.CacheImage(RSImageCache::CALLER_ID_LIMIT, CreateImage(SK_ColorGREEN));
+    EXPECT_EQ(cache.GetImage(RSImageCache::CALLER_ID_LIMIT), nullptr);
+    EXPECT_EQ(cache.GetImageCount(), 1u);
+}
+} // namespace OHOS::Rosen
@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <functional>
+
+#include "gtest/gtest.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkSurface.h"
+#include "include/pipeline/rs_filter_result_cache.h"
+#include "include/pipeline/rs_offscreen_surface_pool.h"
+#include "include/pipeline/rs_paint_filter_canvas.h"
+#include "include/render/rs_blur_filter.h"
+#include "rs_pixel_test_utils.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+namespace {
+constexpr int CANVAS_SIZE = 200;
+constexpr int CELL_SIZE = 10;
+constexpr float BLUR_SIGMA = 4.f;
+} // namespace
+
+class RSPaintFilterCanvasTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+
+    using Scene = std::function<void(RSPaintFilterCanvas&)>;
+
+    // same layer as RSPropertiesPainter::SaveLayerForFilter
+    static void SaveBlurLayer(RSPaintFilterCanvas& canvas, const SkRect& clip)
+    {
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        RSBlurFilter(BLUR_SIGMA, BLUR_SIGMA).ApplyTo(paint);
+        canvas.clipRect(clip, true);
+        SkCanvas::SaveLayerRec slr(nullptr, &paint, SkCanvas::kInitWithPrevious_SaveLayerFlag);
+        canvas.saveLayer(slr);
+    }
+
+    // largest difference of a color channel between [scene] drawn through skia layers and [offscreenScene], or
+    // [scene] if not given, drawn through offscreen layers
+    static int CompareOffscreenLayer(const Scene& scene, const Scene& offscreenScene = nullptr)
+    {
+        SkBitmap expected;
+        SkBitmap actual;
+        for (bool offscreen : { false, true }) {
+            auto surface = RSPixelTestUtils::MakeSurface(CANVAS_SIZE, CANVAS_SIZE);
+            if (surface == nullptr) {
+                return -1;
+            }
+            RSPixelTestUtils::DrawCheckerboard(*surface->getCanvas(), CANVAS_SIZE, CANVAS_SIZE, CELL_SIZE,
+                SK_ColorYELLOW, SK_ColorBLUE);
+            {
+                RSPaintFilterCanvas canvas(surface->getCanvas());
+                canvas.EnableOffscreenFilterLayer(offscreen);
+                (offscreen && offscreenScene ? offscreenScene : scene)(canvas);
+            }
+            if (!RSPixelTestUtils::ReadPixels(*surface, offscreen ? actual : expected)) {
+                return -1;
+            }
+        }
+        return RSPixelTestUtils::MaxChannelDifference(expected, actual, true);
+    }
+};
+
+void RSPaintFilterCanvasTest::SetUpTestCase() {}
+void RSPaintFilterCanvasTest::TearDownTestCase() {}
+void RSPaintFilterCanvasTest::SetUp()
+{
+    RSOffscreenSurfacePool::Instance().Clear();
+    RSFilterResultCache::Instance().Clear();
+}
+void RSPaintFilterCanvasTest::TearDown()
+{
+    RSOffscreenSurfacePool::Instance().Clear();
+    RSFilterResultCache::Instance().Clear();
+}
+
+/**
+ * @tc.name: OffscreenFilterLayer001
+ * @tc.desc: a blurred layer drawn offscreen matches the skia layer, the frame outside of it is left untouched
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSPaintFilterCanvasTest, OffscreenFilterLayer001, TestSize.Level1)
+{
+    int difference = CompareOffscreenLayer([](RSPaintFilterCanvas& canvas) {
+        canvas.save();
+        SaveBlurLayer(canvas, SkRect::MakeXYWH(40, 40, 100, 80));
+        SkPaint paint;
+        paint.setColor(SK_ColorRED);
+        canvas.drawRect(SkRect::MakeXYWH(60, 60, 30, 30), paint);
+        canvas.restore();
+        canvas.restore();
+        // drawn on the wrapped canvas again
+        paint.setColor(SK_ColorGREEN);
+        canvas.drawRect(SkRect::MakeXYWH(0, 0, 20, 20), paint);
+    });
+    EXPECT_GE(difference, 0);
+    EXPECT_LE(difference, RSPixelTestUtils::MAX_CHANNEL_DIFFERENCE);
+    // the surface is kept for the next frame
+    EXPECT_EQ(RSOffscreenSurfacePool::Instance().GetSurfaceCount(), 1u);
+}
+
+/**
+ * @tc.name: OffscreenFilterLayer002
+ * @tc.desc: scaled, nested and alpha blended layers match the skia layers
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSPaintFilterCanvasTest, OffscreenFilterLayer002, TestSize.Level1)
+{
+    int difference = CompareOffscreenLayer([](RSPaintFilterCanvas& canvas) {
+        canvas.save();
+        canvas.translate(10, 20);
+        canvas.scale(1.5f, 1.5f);
+        SaveBlurLayer(canvas, SkRect::MakeXYWH(10, 10, 80, 80));
+        SkPaint paint;
+        paint.setColor(SK_ColorRED);
+        canvas.drawRect(SkRect::MakeXYWH(20, 20, 20, 20), paint);
+        canvas.save();
+        SaveBlurLayer(canvas, SkRect::MakeXYWH(40, 40, 30, 30));
+        paint.setColor(SK_ColorGREEN);
+        canvas.drawCircle(55, 55, 10, paint);
+        canvas.restore();
+        canvas.restore();
+        canvas.restore();
+        canvas.restore();
+
+        canvas.SaveAlpha();
+        canvas.MultiplyAlpha(0.5f);
+        canvas.save();
+        SaveBlurLayer(canvas, SkRect::MakeXYWH(120, 120, 60, 60));
+        paint.setColor(SK_ColorBLACK);
+        canvas.drawRect(SkRect::MakeXYWH(130, 130, 20, 40), paint);
+        canvas.restore();
+        canvas.restore();
+        canvas.RestoreAlpha();
+    });
+    EXPECT_GE(difference, 0);
+    EXPECT_LE(difference, RSPixelTestUtils::MAX_CHANNEL_DIFFERENCE);
+}
+
+/**
+ * @tc.name: OffscreenFilterLayer003
+ * @tc.desc: rotated layers stay skia layers, layers left open are drawn when the canvas is destroyed
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSPaintFilterCanvasTest, OffscreenFilterLayer003, TestSize.Level1)
+{
+    auto drawRotatedLayer = [](RSPaintFilterCanvas& canvas) {
+        canvas.save();
+        canvas.rotate(10);
+        SaveBlurLayer(canvas, SkRect::MakeXYWH(50, 20, 60, 60));
+        SkPaint paint;
+        paint.setColor(SK_ColorRED);
+        canvas.drawRect(SkRect::MakeXYWH(60, 30, 20, 20), paint);
+        canvas.restore();
+        canvas.restore();
+    };
+    int difference = CompareOffscreenLayer(drawRotatedLayer);
+    EXPECT_GE(difference, 0);
+    EXPECT_LE(difference, RSPixelTestUtils::MAX_CHANNEL_DIFFERENCE);
+
+    auto drawLayer = [](RSPaintFilterCanvas& canvas) {
+        canvas.save();
+        SaveBlurLayer(canvas, SkRect::MakeXYWH(100, 100, 50, 50));
+        SkPaint paint;
+        paint.setColor(SK_ColorRED);
+        canvas.drawRect(SkRect::MakeXYWH(110, 110, 20, 20), paint);
+    };
+    difference = CompareOffscreenLayer(
+        [&drawLayer](RSPaintFilterCanvas& canvas) {
+            drawLayer(canvas);
+            canvas.restore();
+            canvas.restore();
+        },
+        drawLayer);
+    EXPECT_GE(difference, 0);
+    EXPECT_LE(difference, RSPixelTestUtils::MAX_CHANNEL_DIFFERENCE);
+}
+
+/**
+ * @tc.name: OffscreenSurfacePool001
+ * @tc.desc: pooled surfaces match the device of the target and are freed once unused for a few frames
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSPaintFilterCanvasTest, OffscreenSurfacePool001, TestSize.Level1)
+{
+    auto& pool = RSOffscreenSurfacePool::Instance();
+    auto target = RSPixelTestUtils::MakeSurface(CANVAS_SIZE, CANVAS_SIZE);
+    ASSERT_NE(target, nullptr);
+    auto surface = pool.Acquire(target->getCanvas(), 30, 70);
+    ASSERT_NE(surface, nullptr);
+    EXPECT_GE(surface->width(), 30);
+    EXPECT_GE(surface->height(), 70);
+    SkPixmap pixmap;
+    EXPECT_TRUE(surface->peekPixels(&pixmap));
+    auto surfacePtr = surface.get();
+    pool.Release(std::move(surface));
+    EXPECT_EQ(pool.Acquire(target->getCanvas(), 20, 20).get(), surfacePtr);
+
+    pool.Release(pool.Acquire(target->getCanvas(), 20, 20));
+    pool.OnFrameEnd();
+    pool.Release(pool.Acquire(target->getCanvas(), 20, 20));
+    for (int i = 0; i < 3; i++) {
+        pool.OnFrameEnd();
+    }
+    EXPECT_EQ(pool.GetSurfaceCount(), 1u);
+    pool.OnFrameEnd();
+    EXPECT_EQ(pool.GetSurfaceCount(), 0u);
+}
+
+/**
+ * @tc.name: FilterResultCache001
+ * @tc.desc: layers with unchanged contents reuse the filtered result, changed contents are filtered again
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSPaintFilterCanvasTest, FilterResultCache001, TestSize.Level1)
+{
+    auto drawLayer = [](RSPaintFilterCanvas& canvas, SkColor color) {
+        canvas.save();
+        SaveBlurLayer(canvas, SkRect::MakeXYWH(40, 40, 100, 80));
+        SkPaint paint;
+        paint.setColor(color);
+        canvas.drawRect(SkRect::MakeXYWH(60, 60, 30, 30), paint);
+        canvas.restore();
+        canvas.restore();
+    };
+    auto scene = [&drawLayer](RSPaintFilterCanvas& canvas) { drawLayer(canvas, SK_ColorRED); };
+    int difference = CompareOffscreenLayer(scene);
+    EXPECT_GE(difference, 0);
+    EXPECT_LE(difference, RSPixelTestUtils::MAX_CHANNEL_DIFFERENCE);
+    auto& cache = RSFilterResultCache::Instance();
+    EXPECT_EQ(cache.GetEntryCount(), 1u);
+    EXPECT_EQ(cache.GetHitCount(), 0u);
+
+    // same contents and blur filter in the next frame
+    difference = CompareOffscreenLayer(scene);
+    EXPECT_GE(difference, 0);
+    EXPECT_LE(difference, RSPixelTestUtils::MAX_CHANNEL_DIFFERENCE);
+    EXPECT_EQ(cache.GetHitCount(), 1u);
+
+    // changed contents replace the entry of the layer
+    auto changedScene = [&drawLayer](RSPaintFilterCanvas& canvas) { drawLayer(canvas, SK_ColorGREEN); };
+    difference = CompareOffscreenLayer(changedScene);
+    EXPECT_GE(difference, 0);
+    EXPECT_LE(difference, RSPixelTestUtils::MAX_CHANNEL_DIFFERENCE);
+    EXPECT_EQ(cache.GetHitCount(), 1u);
+    EXPECT_EQ(cache.GetEntryCount(), 1u);
+
+    difference = CompareOffscreenLayer(changedScene);
+    EXPECT_GE(difference, 0);
+    EXPECT_LE(difference, RSPixelTestUtils::MAX_CHANNEL_DIFFERENCE);
+    EXPECT_EQ(cache.GetHitCount(), 2u);
+}
+
+/**
+ * @tc.name: FilterResultCache002
+ * @tc.desc: an entry is only reused for exactly the same pixels
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSPaintFilterCanvasTest, FilterResultCache002, TestSize.Level1)
+{
+    SkBitmap layer;
+    layer.allocN32Pixels(CELL_SIZE, CELL_SIZE);
+    layer.eraseColor(SK_ColorRED);
+    RSFilterResultCache::Key key;
+    key.size = SkISize::Make(CELL_SIZE, CELL_SIZE);
+    key.clipBounds = SkIRect::MakeSize(key.size);
+    RSFilterResultCache::Result result;
+    result.image = SkImage::MakeFromBitmap(layer);
+    result.subset = key.clipBounds;
+
+    auto& cache = RSFilterResultCache::Instance();
+    cache.Put(key, layer.pixmap(), result);
+    EXPECT_EQ(cache.GetEntryCount(), 1u);
+    RSFilterResultCache::Result cached;
+    EXPECT_TRUE(cache.Get(key, layer.pixmap(), cached));
+    EXPECT_EQ(cached.image, result.image);
+
+    // a single differing pixel is a miss
+    *layer.getAddr32(CELL_SIZE - 1, CELL_SIZE - 1) = SK_ColorBLUE;
+    EXPECT_FALSE(cache.Get(key, layer.pixmap(), cached));
+    EXPECT_EQ(cache.GetHitCount(), 1u);
+}
+} // namespace OHOS::Rosen
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkSurface.h"
+#include "include/pipeline/rs_paint_filter_canvas.h"
+#include "include/pipeline/rs_render_node_cache.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+namespace {
+constexpr int CANVAS_SIZE = 100;
+constexpr int RECT_COUNT = 16;
+} // namespace
+
+class RSRenderNodeCacheTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+
+    static void DrawRects(RSPaintFilterCanvas& canvas)
+    {
+        SkPaint paint;
+        paint.setColor(SK_ColorRED);
+        for (int i = 0; i < RECT_COUNT; i++) {
+            canvas.drawRect(SkRect::MakeXYWH(i, i, 1, 1), paint);
+        }
+    }
+};
+
+void RSRenderNodeCacheTest::SetUpTestCase() {}
+void RSRenderNodeCacheTest::TearDownTestCase() {}
+void RSRenderNodeCacheTest::SetUp()
+{
+    RSRenderNodeCache::Instance().Clear();
+}
+void RSRenderNodeCacheTest::TearDown()
+{
+    RSRenderNodeCache::Instance().Clear();
+}
+
+/**
+ * @tc.name: DrawCached001
+ * @tc.desc: contents are recorded once and replayed until the version changes
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSRenderNodeCacheTest, DrawCached001, TestSize.Level1)
+{
+    auto surface = SkSurface::MakeRasterN32Premul(CANVAS_SIZE, CANVAS_SIZE);
+    ASSERT_TRUE(surface != nullptr);
+    RSPaintFilterCanvas canvas(surface->getCanvas());
+    auto bounds = SkRect::MakeWH(CANVAS_SIZE, CANVAS_SIZE);
+    int recordCount = 0;
+    auto recorder = [&recordCount](RSPaintFilterCanvas& recordingCanvas) {
+        ++recordCount;
+        DrawRects(recordingCanvas);
+    };
+
+    auto& cache = RSRenderNodeCache::Instance();
+    ASSERT_TRUE(cache.Draw(1, 1, bounds, true, canvas, recorder));
+    ASSERT_TRUE(cache.Draw(1, 1, bounds, true, canvas, recorder));
+    ASSERT_TRUE(cache.Draw(1, 1, bounds, true, canvas, recorder));
+    ASSERT_EQ(recordCount, 1);
+    ASSERT_EQ(cache.GetEntryCount(), 1u);
+
+    ASSERT_TRUE(cache.Draw(1, 2, bounds, true, canvas, recorder));
+    ASSERT_EQ(recordCount, 2);
+
+    cache.Purge(1);
+    ASSERT_EQ(cache.GetEntryCount(), 0u);
+    ASSERT_EQ(cache.GetMemoryUsage(), 0u);
+}
+
+/**
+ * @tc.name: DrawCached002
+ * @tc.desc: empty bounds are not cached
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSRenderNodeCacheTest, DrawCached002, TestSize.Level1)
+{
+    auto surface = SkSurface::MakeRasterN32Premul(CANVAS_SIZE, CANVAS_SIZE);
+    ASSERT_TRUE(surface != nullptr);
+    RSPaintFilterCanvas canvas(surface->getCanvas());
+    ASSERT_FALSE(RSRenderNodeCache::Instance().Draw(1, 1, SkRect::MakeEmpty(), true, canvas, DrawRects));
+    ASSERT_EQ(RSRenderNodeCache::Instance().GetEntryCount(), 0u);
+}
+
+/**
+ * @tc.name: Evict001
+ * @tc.desc: least recently used entries are evicted when over budget, kept as pictures only
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSRenderNodeCacheTest, Evict001, TestSize.Level1)
+{
+    auto surface = SkSurface::MakeRasterN32Premul(CANVAS_SIZE, CANVAS_SIZE);
+    ASSERT_TRUE(surface != nullptr);
+    RSPaintFilterCanvas canvas(surface->getCanvas());
+    auto bounds = SkRect::MakeWH(CANVAS_SIZE, CANVAS_SIZE);
+
+    auto& cache = RSRenderNodeCache::Instance();
+    auto budget = cache.GetMemoryBudget();
+    cache.Draw(1, 1, bounds, false, canvas, DrawRects);
+    size_t entrySize = cache.GetMemoryUsage();
+    ASSERT_GT(entrySize, 0u);
+
+    cache.SetMemoryBudget(entrySize * 2);
+    cache.Draw(2, 1, bounds, false, canvas, DrawRects);
+    cache.Draw(1, 1, bounds, false, canvas, DrawRects);
+    cache.Draw(3, 1, bounds, false, canvas, DrawRects);
+    ASSERT_LE(cache.GetMemoryUsage(), entrySize * 2);
+
+    int recordCount = 0;
+    cache.Draw(1, 1, bounds, false, canvas, [&recordCount](RSPaintFilterCanvas& recordingCanvas) {
+        ++recordCount;
+        DrawRects(recordingCanvas);
+    });
+    // node 1 was used more recently than node 2 and must have survived
+    ASSERT_EQ(recordCount, 0);
+    cache.SetMemoryBudget(budget);
+}
+
+/**
+ * @tc.name: Matrix001
+ * @tc.desc: the matrix the recorder leaves on its canvas is left on the canvas, cached or not
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSRenderNodeCacheTest, Matrix001, TestSize.Level1)
+{
+    auto surface = SkSurface::MakeRasterN32Premul(CANVAS_SIZE, CANVAS_SIZE);
+    ASSERT_TRUE(surface != nullptr);
+    RSPaintFilterCanvas canvas(surface->getCanvas());
+    auto bounds = SkRect::MakeWH(CANVAS_SIZE, CANVAS_SIZE);
+    constexpr SkScalar offset = 5.f;
+    auto recorder = [](RSPaintFilterCanvas& recordingCanvas) {
+        recordingCanvas.translate(offset, offset);
+        DrawRects(recordingCanvas);
+    };
+
+    auto& cache = RSRenderNodeCache::Instance();
+    for (int i = 0; i < RECT_COUNT; i++) {
+        canvas.save();
+        ASSERT_TRUE(cache.Draw(1, 1, bounds, true, canvas, recorder));
+        ASSERT_EQ(canvas.getTotalMatrix(), SkMatrix::MakeTrans(offset, offset));
+        canvas.restore();
+    }
+}
+
+/**
+ * @tc.name: PixelAligned001
+ * @tc.desc: rasterized contents are drawn at whole pixels, not resampled at a fractional offset
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSRenderNodeCacheTest, PixelAligned001, TestSize.Level1)
+{
+    auto surface = SkSurface::MakeRasterN32Premul(CANVAS_SIZE, CANVAS_SIZE);
+    ASSERT_TRUE(surface != nullptr);
+    RSPaintFilterCanvas canvas(surface->getCanvas());
+    auto bounds = SkRect::MakeWH(RECT_COUNT, RECT_COUNT);
+    constexpr SkScalar offset = 10.4f;
+    constexpr int pixel = 10;
+
+    auto& cache = RSRenderNodeCache::Instance();
+    canvas.translate(offset, offset);
+    // the second draw at the same scale rasterizes the contents
+    ASSERT_TRUE(cache.Draw(1, 1, bounds, true, canvas, DrawRects));
+    ASSERT_TRUE(cache.Draw(1, 1, bounds, true, canvas, DrawRects));
+    surface->getCanvas()->clear(SK_ColorTRANSPARENT);
+    ASSERT_TRUE(cache.Draw(1, 1, bounds, true, canvas, DrawRects));
+
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(CANVAS_SIZE, CANVAS_SIZE);
+    ASSERT_TRUE(surface->readPixels(bitmap, 0, 0));
+    ASSERT_EQ(bitmap.getColor(pixel, pixel), SK_ColorRED);
+    ASSERT_EQ(bitmap.getColor(pixel + 1, pixel), SK_ColorTRANSPARENT);
+}
+} // namespace OHOS::Rosen
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+
+#include "gtest/gtest.h"
+#include "include/common/rs_flat_map.h"
+#include "include/pipeline/rs_canvas_render_node.h"
+#include "include/pipeline/rs_context.h"
+#include "include/pipeline/rs_render_node_map.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+namespace {
+constexpr pid_t PID = 100;
+constexpr pid_t OTHER_PID = 101;
+constexpr uint32_t NODE_COUNT = 32;
+constexpr int RANDOM_OPERATION_COUNT = 100000;
+constexpr uint32_t RANDOM_KEY_RANGE = 1000;
+constexpr pid_t BENCHMARK_PID_COUNT = 64;
+constexpr uint32_t BENCHMARK_NODE_COUNT = 1000;
+
+NodeId MakeNodeId(pid_t pid, uint32_t index)
+{
+    return (static_cast<NodeId>(pid) << 32) | index;
+}
+} // namespace
+
+class RSRenderNodeMapTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+
+    // [count] canvas nodes of [pid] registered and added under [parent]
+    static void AddNodes(RSContext& context, const std::shared_ptr<RSBaseRenderNode>& parent, pid_t pid,
+        uint32_t count)
+    {
+        for (uint32_t i = 1; i <= count; i++) {
+            auto node = std::make_shared<RSCanvasRenderNode>(MakeNodeId(pid, i));
+            context.GetMutableNodeMap().RegisterRenderNode(node);
+            parent->AddChild(node);
+        }
+    }
+};
+
+void RSRenderNodeMapTest::SetUpTestCase() {}
+void RSRenderNodeMapTest::TearDownTestCase() {}
+void RSRenderNodeMapTest::SetUp() {}
+void RSRenderNodeMapTest::TearDown() {}
+
+/**
+ * @tc.name: RegisterRenderNode001
+ * @tc.desc: nodes are found by id until they are unregistered, ids are registered only once
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSRenderNodeMapTest, RegisterRenderNode001, TestSize.Level1)
+{
+    auto context = std::make_shared<RSContext>();
+    auto& nodeMap = context->GetMutableNodeMap();
+    // only the animation fallback node
+    EXPECT_EQ(nodeMap.GetNodeCount(), 1u);
+    EXPECT_NE(nodeMap.GetAnimationFallbackNode(), nullptr);
+
+    auto node = std::make_shared<RSCanvasRenderNode>(MakeNodeId(PID, 1));
+    EXPECT_TRUE(nodeMap.RegisterRenderNode(node));
+    EXPECT_FALSE(nodeMap.RegisterRenderNode(std::make_shared<RSCanvasRenderNode>(MakeNodeId(PID, 1))));
+    EXPECT_EQ(nodeMap.GetRenderNode<RSCanvasRenderNode>(MakeNodeId(PID, 1)), node);
+    EXPECT_EQ(nodeMap.GetRenderNode(MakeNodeId(OTHER_PID, 1)), nullptr);
+
+    nodeMap.UnregisterRenderNode(MakeNodeId(PID, 1));
+    EXPECT_EQ(nodeMap.GetRenderNode(MakeNodeId(PID, 1)), nullptr);
+    EXPECT_EQ(nodeMap.GetNodeCount(), 1u);
+    // nothing left to remove for the pid
+    nodeMap.FilterNodeByPid(PID);
+    EXPECT_EQ(nodeMap.GetNodeCount(), 1u);
+}
+
+/**
+ * @tc.name: FilterNodeByPid001
+ * @tc.desc: all nodes of a pid are unregistered and removed from the tree, nodes of other pids stay
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSRenderNodeMapTest, FilterNodeByPid001, TestSize.Level1)
+{
+    auto context = std::make_shared<RSContext>();
+    auto& nodeMap = context->GetMutableNodeMap();
+    auto root = context->GetGlobalRootRenderNode();
+    AddNodes(*context, root, PID, NODE_COUNT);
+    AddNodes(*context, root, OTHER_PID, NODE_COUNT);
+    nodeMap.UnregisterRenderNode(MakeNodeId(PID, 1));
+    EXPECT_EQ(nodeMap.GetNodeCount(), 1u + NODE_COUNT * 2 - 1);
+
+    nodeMap.FilterNodeByPid(PID);
+    EXPECT_EQ(nodeMap.GetNodeCount(), 1u + NODE_COUNT);
+    EXPECT_EQ(root->GetChildrenCount(), NODE_COUNT + 1);
+    for (uint32_t i = 2; i <= NODE_COUNT; i++) {
+        EXPECT_EQ(nodeMap.GetRenderNode(MakeNodeId(PID, i)), nullptr);
+        auto node = nodeMap.GetRenderNode(MakeNodeId(OTHER_PID, i));
+        ASSERT_NE(node, nullptr);
+        EXPECT_EQ(node->GetParent().lock(), root);
+    }
+    EXPECT_NE(nodeMap.GetAnimationFallbackNode(), nullptr);
+}
+
+/**
+ * @tc.name: FlatMap001
+ * @tc.desc: random insertions, erases and lookups give the same results as an unordered_map
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSRenderNodeMapTest, FlatMap001, TestSize.Level1)
+{
+    RSFlatMap<NodeId, uint32_t> flatMap;
+    std::unordered_map<NodeId, uint32_t> reference;
+    std::mt19937 random(0);
+    for (int i = 0; i < RANDOM_OPERATION_COUNT; i++) {
+        NodeId id = MakeNodeId(PID + random() % 4, random() % RANDOM_KEY_RANGE);
+        uint32_t value = random();
+        switch (random() % 3) {
+            case 0:
+                EXPECT_EQ(flatMap.Emplace(id, value), reference.emplace(id, value).second);
+                break;
+            case 1:
+                EXPECT_EQ(flatMap.Erase(id), reference.erase(id) != 0);
+                break;
+            default: {
+                auto iter = reference.find(id);
+                auto found = flatMap.Find(id);
+                ASSERT_EQ(found != nullptr, iter != reference.end());
+                if (found != nullptr) {
+                    EXPECT_EQ(*found, iter->second);
+                }
+                break;
+            }
+        }
+        ASSERT_EQ(flatMap.Size(), reference.size());
+    }
+    size_t count = 0;
+    flatMap.ForEach([&reference, &count](NodeId id, uint32_t value) {
+        EXPECT_EQ(reference[id], value);
+        count++;
+    });
+    EXPECT_EQ(count, reference.size());
+}
+
+/**
+ * @tc.name: Benchmark001
+ * @tc.desc: time to remove the nodes of one of many pids and to look up nodes by id
+ * @tc.type: PERF
+ */
+HWTEST_F(RSRenderNodeMapTest, Benchmark001, TestSize.Level2)
+{
+    auto context = std::make_shared<RSContext>();
+    auto& nodeMap = context->GetMutableNodeMap();
+    for (pid_t pid = 1; pid <= BENCHMARK_PID_COUNT; pid++) {
+        AddNodes(*context, context->GetGlobalRootRenderNode(), pid, BENCHMARK_NODE_COUNT);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    uint32_t found = 0;
+    for (pid_t pid = 1; pid <= BENCHMARK_PID_COUNT; pid++) {
+        for (uint32_t i = 1; i <= BENCHMARK_NODE_COUNT; i++) {
+            found += nodeMap.GetRenderNode(MakeNodeId(pid, i)) != nullptr ? 1 : 0;
+        }
+    }
+    std::chrono::duration<double, std::nano> lookup = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(found, BENCHMARK_PID_COUNT * BENCHMARK_NODE_COUNT);
+
+    start = std::chrono::steady_clock::now();
+    nodeMap.FilterNodeByPid(BENCHMARK_PID_COUNT / 2);
+    std::chrono::duration<double, std::micro> filter = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(nodeMap.GetNodeCount(), 1u + (BENCHMARK_PID_COUNT - 1) * BENCHMARK_NODE_COUNT);
+
+    printf("RSRenderNodeMapTest %d pids of %u nodes: lookup %.1f ns/node, removing one pid %.1f us\n",
+        BENCHMARK_PID_COUNT, BENCHMARK_NODE_COUNT, lookup.count() / found, filter.count());
+}
+} // namespace OHOS::Rosen
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkSurface.h"
+#include "include/effects/SkBlurImageFilter.h"
+#include "include/render/rs_blur_filter.h"
+#include "rs_pixel_test_utils.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+namespace {
+constexpr float MAX_QUANTIZATION_ERROR = 0.05f;
+constexpr int IMAGE_SIZE = 300;
+constexpr int CELL_SIZE = 10;
+constexpr float LARGE_RADIUS = 20.f;
+// the image border is not compared, blurs of a downsampled image fade out slightly differently there
+constexpr int BORDER = 60;
+constexpr double MAX_MEAN_DIFFERENCE = 2.0;
+// a few pixels of the downsampled blur stand out more
+constexpr int MAX_DOWNSAMPLE_CHANNEL_DIFFERENCE = 16;
+} // namespace
+
+class RSBlurFilterTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+
+    static sk_sp<SkImage> MakeCheckerboard()
+    {
+        auto surface = RSPixelTestUtils::MakeSurface(IMAGE_SIZE, IMAGE_SIZE);
+        if (surface == nullptr) {
+            return nullptr;
+        }
+        RSPixelTestUtils::DrawCheckerboard(*surface->getCanvas(), IMAGE_SIZE, IMAGE_SIZE, CELL_SIZE, SK_ColorWHITE,
+            SK_ColorBLUE);
+        return surface->makeImageSnapshot();
+    }
+
+    static bool Filter(const sk_sp<SkImage>& image, const SkImageFilter* filter, SkBitmap& bitmap)
+    {
+        auto bounds = SkIRect::MakeWH(IMAGE_SIZE, IMAGE_SIZE);
+        SkIRect subset;
+        SkIPoint offset;
+        auto filtered = image->makeWithFilter(filter, bounds, bounds, &subset, &offset);
+        if (filtered == nullptr) {
+            return false;
+        }
+        auto surface = RSPixelTestUtils::MakeSurface(IMAGE_SIZE, IMAGE_SIZE);
+        if (surface == nullptr) {
+            return false;
+        }
+        auto dst = SkRect::MakeXYWH(offset.x(), offset.y(), subset.width(), subset.height());
+        surface->getCanvas()->drawImageRect(filtered, subset, dst, nullptr);
+        return RSPixelTestUtils::ReadPixels(*surface, bitmap);
+    }
+};
+
+void RSBlurFilterTest::SetUpTestCase() {}
+void RSBlurFilterTest::TearDownTestCase() {}
+void RSBlurFilterTest::SetUp() {}
+void RSBlurFilterTest::TearDown() {}
+
+/**
+ * @tc.name: QuantizeRadius001
+ * @tc.desc: radii are rounded to close levels and filters of the same level are shared
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSBlurFilterTest, QuantizeRadius001, TestSize.Level1)
+{
+    EXPECT_EQ(RSBlurFilter::QuantizeRadius(0.f), 0.f);
+    EXPECT_EQ(RSBlurFilter::QuantizeRadius(-3.f), 0.f);
+    float lastLevel = 0.f;
+    for (float radius = 1.f; radius < 200.f; radius += 0.1f) {
+        float level = RSBlurFilter::QuantizeRadius(radius);
+        EXPECT_NEAR(level, radius, radius * MAX_QUANTIZATION_ERROR);
+        EXPECT_GE(level, lastLevel);
+        lastLevel = level;
+    }
+
+    SkPaint paint;
+    SkPaint otherPaint;
+    RSBlurFilter(30.f, 30.f).ApplyTo(paint);
+    RSBlurFilter(30.1f, 30.1f).ApplyTo(otherPaint);
+    EXPECT_NE(paint.getImageFilter(), nullptr);
+    EXPECT_EQ(paint.getImageFilter(), otherPaint.getImageFilter());
+    // intermediate values of animations
+    auto filter = RSFilter::CreateBlurFilter(10.f, 10.f);
+    auto step = filter * 0.5f;
+    ASSERT_NE(step, nullptr);
+    std::static_pointer_cast<RSBlurFilter>(step)->ApplyTo(otherPaint);
+    EXPECT_NE(paint.getImageFilter(), otherPaint.getImageFilter());
+    EXPECT_EQ(std::static_pointer_cast<RSBlurFilter>(step)->GetBlurRadiusX(), 5.f);
+}
+
+/**
+ * @tc.name: Downsample001
+ * @tc.desc: large blurs run on a downsampled image and stay close to the full resolution blur
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSBlurFilterTest, Downsample001, TestSize.Level1)
+{
+    auto image = MakeCheckerboard();
+    ASSERT_NE(image, nullptr);
+    SkPaint paint;
+    RSBlurFilter(LARGE_RADIUS, LARGE_RADIUS).ApplyTo(paint);
+    float radius = RSBlurFilter::QuantizeRadius(LARGE_RADIUS);
+    auto reference = SkBlurImageFilter::Make(radius, radius, nullptr);
+
+    SkBitmap expected;
+    SkBitmap actual;
+    ASSERT_TRUE(Filter(image, reference.get(), expected));
+    ASSERT_TRUE(Filter(image, paint.getImageFilter(), actual));
+    auto difference = RSPixelTestUtils::Compare(expected, actual,
+        SkIRect::MakeLTRB(BORDER, BORDER, IMAGE_SIZE - BORDER, IMAGE_SIZE - BORDER));
+    EXPECT_GE(difference.max, 0);
+    EXPECT_LE(difference.mean, MAX_MEAN_DIFFERENCE);
+    EXPECT_LE(difference.max, MAX_DOWNSAMPLE_CHANNEL_DIFFERENCE);
+}
+} // namespace OHOS::Rosen
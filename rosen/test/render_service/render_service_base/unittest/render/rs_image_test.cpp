@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdio>
+
+#include "gtest/gtest.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkSurface.h"
+#include "include/utils/SkNoDrawCanvas.h"
+#include "include/render/rs_image.h"
+#include "rs_pixel_test_utils.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+namespace {
+constexpr int FRAME_WIDTH = 200;
+constexpr int FRAME_HEIGHT = 120;
+constexpr int TILE_SIZE = 16;
+// tiles are pixel aligned, closer than other scenes drawn in two ways
+constexpr int MAX_TILE_CHANNEL_DIFFERENCE = 1;
+constexpr int BENCHMARK_WIDTH = 720;
+constexpr int BENCHMARK_HEIGHT = 1280;
+constexpr int BENCHMARK_FRAME_COUNT = 5;
+} // namespace
+
+class RSImageTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+
+    // counts the draws that reach the canvas
+    class DrawCountCanvas : public SkNoDrawCanvas {
+    public:
+        DrawCountCanvas(int width, int height) : SkNoDrawCanvas(width, height) {}
+        int GetDrawCount() const
+        {
+            return drawCount_;
+        }
+
+    protected:
+        void onDrawRect(const SkRect&, const SkPaint&) override
+        {
+            ++drawCount_;
+        }
+        void onDrawImageRect(const SkImage*, const SkRect*, const SkRect&, const SkPaint*, SrcRectConstraint) override
+        {
+            ++drawCount_;
+        }
+
+    private:
+        int drawCount_ = 0;
+    };
+
+    static sk_sp<SkImage> CreateTileImage(int size)
+    {
+        auto surface = RSPixelTestUtils::MakeSurface(size, size);
+        if (surface == nullptr) {
+            return nullptr;
+        }
+        auto canvas = surface->getCanvas();
+        canvas->clear(SK_ColorYELLOW);
+        SkPaint paint;
+        paint.setColor(SK_ColorBLUE);
+        canvas->drawRect(SkRect::MakeWH(size / 2, size / 2), paint);
+        paint.setColor(SK_ColorRED);
+        canvas->drawRect(SkRect::MakeXYWH(size / 2, size / 2, size / 2, size / 2), paint);
+        return surface->makeImageSnapshot();
+    }
+
+    static void DrawImage(SkCanvas& canvas, const sk_sp<SkImage>& image, ImageRepeat repeat, int width, int height)
+    {
+        RSImage rsImage;
+        rsImage.SetImage(image);
+        rsImage.SetImageFit(static_cast<int>(ImageFit::NONE));
+        rsImage.SetImageRepeat(static_cast<int>(repeat));
+        SkPaint paint;
+        rsImage.CanvasDrawImage(canvas, SkRect::MakeWH(width, height), paint);
+    }
+
+    // one draw per tile of an image of ImageFit::NONE centered in the frame, as RSImage used to draw them
+    static void DrawTiles(SkCanvas& canvas, const sk_sp<SkImage>& image, ImageRepeat repeat, int width, int height)
+    {
+        SkRect dst = SkRect::MakeXYWH((width - image->width()) / 2.f, (height - image->height()) / 2.f,
+            image->width(), image->height());
+        bool repeatX = repeat == ImageRepeat::REPEAT_X || repeat == ImageRepeat::REPEAT;
+        bool repeatY = repeat == ImageRepeat::REPEAT_Y || repeat == ImageRepeat::REPEAT;
+        int minX = 0;
+        int maxX = 0;
+        int minY = 0;
+        int maxY = 0;
+        while (repeatX && dst.left() + minX * dst.width() > 0) {
+            --minX;
+        }
+        while (repeatX && dst.left() + maxX * dst.width() < width) {
+            ++maxX;
+        }
+        while (repeatY && dst.top() + minY * dst.height() > 0) {
+            --minY;
+        }
+        while (repeatY && dst.top() + maxY * dst.height() < height) {
+            ++maxY;
+        }
+        canvas.save();
+        canvas.clipRect(SkRect::MakeWH(width, height), true);
+        for (int i = minX; i <= maxX; ++i) {
+            for (int j = minY; j <= maxY; ++j) {
+                canvas.drawImageRect(image, dst.makeOffset(i * dst.width(), j * dst.height()), nullptr);
+            }
+        }
+        canvas.restore();
+    }
+
+    // largest difference of a color channel between the image drawn by RSImage and tile by tile
+    static int CompareTiles(ImageRepeat repeat)
+    {
+        auto image = CreateTileImage(TILE_SIZE);
+        if (image == nullptr) {
+            return -1;
+        }
+        SkBitmap bitmaps[2];
+        for (int i = 0; i < 2; i++) {
+            auto surface = RSPixelTestUtils::MakeSurface(FRAME_WIDTH, FRAME_HEIGHT);
+            if (surface == nullptr) {
+                return -1;
+            }
+            surface->getCanvas()->clear(SK_ColorWHITE);
+            if (i == 0) {
+                DrawTiles(*surface->getCanvas(), image, repeat, FRAME_WIDTH, FRAME_HEIGHT);
+            } else {
+                DrawImage(*surface->getCanvas(), image, repeat, FRAME_WIDTH, FRAME_HEIGHT);
+            }
+            if (!RSPixelTestUtils::ReadPixels(*surface, bitmaps[i])) {
+                return -1;
+            }
+        }
+        return RSPixelTestUtils::MaxChannelDifference(bitmaps[0], bitmaps[1]);
+    }
+
+    using Drawer = void (*)(SkCanvas&, const sk_sp<SkImage>&, ImageRepeat, int, int);
+
+    // raster time of a frame in us
+    static double MeasureFrameTime(Drawer draw, const sk_sp<SkImage>& image, ImageRepeat repeat)
+    {
+        auto surface = RSPixelTestUtils::MakeSurface(BENCHMARK_WIDTH, BENCHMARK_HEIGHT);
+        if (surface == nullptr) {
+            return 0.0;
+        }
+        draw(*surface->getCanvas(), image, repeat, BENCHMARK_WIDTH, BENCHMARK_HEIGHT);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < BENCHMARK_FRAME_COUNT; i++) {
+            draw(*surface->getCanvas(), image, repeat, BENCHMARK_WIDTH, BENCHMARK_HEIGHT);
+        }
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / BENCHMARK_FRAME_COUNT;
+    }
+};
+
+void RSImageTest::SetUpTestCase() {}
+void RSImageTest::TearDownTestCase() {}
+void RSImageTest::SetUp() {}
+void RSImageTest::TearDown() {}
+
+/**
+ * @tc.name: Repeat001
+ * @tc.desc: repeated images match the tiles drawn one by one and take a single draw
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSImageTest, Repeat001, TestSize.Level1)
+{
+    auto image = CreateTileImage(TILE_SIZE);
+    ASSERT_NE(image, nullptr);
+    for (auto repeat : { ImageRepeat::NO_REPEAT, ImageRepeat::REPEAT_X, ImageRepeat::REPEAT_Y, ImageRepeat::REPEAT }) {
+        int difference = CompareTiles(repeat);
+        EXPECT_GE(difference, 0);
+        EXPECT_LE(difference, MAX_TILE_CHANNEL_DIFFERENCE);
+
+        DrawCountCanvas canvas(FRAME_WIDTH, FRAME_HEIGHT);
+        DrawImage(canvas, image, repeat, FRAME_WIDTH, FRAME_HEIGHT);
+        EXPECT_EQ(canvas.GetDrawCount(), 1);
+    }
+}
+
+/**
+ * @tc.name: Repeat002
+ * @tc.desc: images without a size are not drawn
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSImageTest, Repeat002, TestSize.Level1)
+{
+    auto image = CreateTileImage(TILE_SIZE);
+    ASSERT_NE(image, nullptr);
+    RSImage rsImage;
+    rsImage.SetImage(image);
+    rsImage.SetImageRepeat(static_cast<int>(ImageRepeat::REPEAT));
+    rsImage.SetDstRect(RectF(0.f, 0.f, 0.f, 0.f));
+    DrawCountCanvas canvas(FRAME_WIDTH, FRAME_HEIGHT);
+    SkPaint paint;
+    rsImage.CanvasDrawImage(canvas, SkRect::MakeWH(FRAME_WIDTH, FRAME_HEIGHT), paint, true);
+    EXPECT_EQ(canvas.GetDrawCount(), 0);
+}
+
+/**
+ * @tc.name: Benchmark001
+ * @tc.desc: draws and raster time of small images repeated over a screen, tile by tile and with an image shader
+ * @tc.type: PERF
+ */
+HWTEST_F(RSImageTest, Benchmark001, TestSize.Level2)
+{
+    for (int tileSize : { 8, 32 }) {
+        auto image = CreateTileImage(tileSize);
+        ASSERT_NE(image, nullptr);
+        for (auto repeat : { ImageRepeat::REPEAT_X, ImageRepeat::REPEAT_Y, ImageRepeat::REPEAT }) {
+            DrawCountCanvas tileCanvas(BENCHMARK_WIDTH, BENCHMARK_HEIGHT);
+            DrawTiles(tileCanvas, image, repeat, BENCHMARK_WIDTH, BENCHMARK_HEIGHT);
+            DrawCountCanvas shaderCanvas(BENCHMARK_WIDTH, BENCHMARK_HEIGHT);
+            DrawImage(shaderCanvas, image, repeat, BENCHMARK_WIDTH, BENCHMARK_HEIGHT);
+            double tiles = MeasureFrameTime(DrawTiles, image, repeat);
+            double shader = MeasureFrameTime(DrawImage, image, repeat);
+            printf("RSImageTest %dpx tiles, repeat %d: tiles %d draws %.1f us/frame, shader %d draws %.1f us/frame\n",
+                tileSize, static_cast<int>(repeat), tileCanvas.GetDrawCount(), tiles, shaderCanvas.GetDrawCount(),
+                shader);
+            EXPECT_EQ(shaderCanvas.GetDrawCount(), 1);
+            EXPECT_GT(tileCanvas.GetDrawCount(), shaderCanvas.GetDrawCount());
+        }
+    }
+}
+} // namespace OHOS::Rosen
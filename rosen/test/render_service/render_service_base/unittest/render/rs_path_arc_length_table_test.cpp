@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "include/core/SkPath.h"
+#include "include/render/rs_path.h"
+#include "include/render/rs_path_arc_length_table.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+namespace {
+constexpr int SAMPLE_COUNT = 100;
+constexpr float POSITION_TOLERANCE = 0.5f;
+constexpr float LENGTH_TOLERANCE = 0.01f;
+constexpr float DEGREES_TOLERANCE = 0.1f;
+constexpr float CIRCLE_CENTER = 100.f;
+constexpr float CIRCLE_RADIUS = 50.f;
+} // namespace
+
+class RSPathArcLengthTableTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+
+    // positions along the table match the ones measured by RSPath
+    static void ExpectSamePositions(const RSPath& path)
+    {
+        RSPathArcLengthTable table;
+        table.Build(path);
+        ASSERT_FALSE(table.IsEmpty());
+        float length = path.GetDistance();
+        EXPECT_NEAR(table.GetDistance(), length, length * LENGTH_TOLERANCE);
+        for (int i = 0; i <= SAMPLE_COUNT; i++) {
+            float progress = static_cast<float>(i) / SAMPLE_COUNT;
+            Vector2f expected;
+            Vector2f actual;
+            float expectedDegrees = 0.f;
+            float actualDegrees = 0.f;
+            ASSERT_TRUE(path.GetPosTan(length * progress, expected, expectedDegrees));
+            ASSERT_TRUE(table.GetPosTan(table.GetDistance() * progress, actual, actualDegrees));
+            EXPECT_NEAR(actual.x_, expected.x_, length * LENGTH_TOLERANCE + POSITION_TOLERANCE);
+            EXPECT_NEAR(actual.y_, expected.y_, length * LENGTH_TOLERANCE + POSITION_TOLERANCE);
+        }
+    }
+};
+
+void RSPathArcLengthTableTest::SetUpTestCase() {}
+void RSPathArcLengthTableTest::TearDownTestCase() {}
+void RSPathArcLengthTableTest::SetUp() {}
+void RSPathArcLengthTableTest::TearDown() {}
+
+/**
+ * @tc.name: PolyLine001
+ * @tc.desc: positions and tangents of straight segments are exact
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSPathArcLengthTableTest, PolyLine001, TestSize.Level1)
+{
+    auto path = RSPath::CreateRSPath("M0 0 L100 0 L100 100");
+    RSPathArcLengthTable table;
+    table.Build(*path);
+    EXPECT_FLOAT_EQ(table.GetDistance(), 200.f);
+
+    Vector2f pos;
+    float degrees = 0.f;
+    ASSERT_TRUE(table.GetPosTan(50.f, pos, degrees));
+    EXPECT_FLOAT_EQ(pos.x_, 50.f);
+    EXPECT_FLOAT_EQ(pos.y_, 0.f);
+    EXPECT_FLOAT_EQ(degrees, 0.f);
+    ASSERT_TRUE(table.GetPosTan(150.f, pos, degrees));
+    EXPECT_FLOAT_EQ(pos.x_, 100.f);
+    EXPECT_FLOAT_EQ(pos.y_, 50.f);
+    EXPECT_FLOAT_EQ(degrees, 90.f);
+
+    // distances are clamped to the path
+    ASSERT_TRUE(table.GetPosTan(-10.f, pos, degrees));
+    EXPECT_FLOAT_EQ(pos.x_, 0.f);
+    ASSERT_TRUE(table.GetPosTan(1000.f, pos, degrees));
+    EXPECT_FLOAT_EQ(pos.y_, 100.f);
+}
+
+/**
+ * @tc.name: Curve001
+ * @tc.desc: flattened curves follow the positions measured by RSPath
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSPathArcLengthTableTest, Curve001, TestSize.Level1)
+{
+    ExpectSamePositions(*RSPath::CreateRSPath("M0 0 C50 100 150 -100 200 0"));
+    ExpectSamePositions(*RSPath::CreateRSPath("M10 10 Q100 200 300 10 L300 300"));
+
+    SkPath circle;
+    circle.addCircle(100.f, 100.f, 50.f);
+    ExpectSamePositions(*RSPath::CreateRSPath(circle));
+}
+
+/**
+ * @tc.name: Tangent001
+ * @tc.desc: tangents on curves turn smoothly along the path instead of jumping at the flattened points
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSPathArcLengthTableTest, Tangent001, TestSize.Level1)
+{
+    SkPath circle;
+    circle.addCircle(CIRCLE_CENTER, CIRCLE_CENTER, CIRCLE_RADIUS);
+    RSPathArcLengthTable table;
+    table.Build(*RSPath::CreateRSPath(circle));
+    ASSERT_FALSE(table.IsEmpty());
+
+    // a quarter of a degree apart, the flattened points are about two
+    constexpr int steps = 1440;
+    float lastDegrees = 0.f;
+    for (int i = 0; i <= steps; i++) {
+        Vector2f pos;
+        float degrees = 0.f;
+        ASSERT_TRUE(table.GetPosTan(table.GetDistance() * i / steps, pos, degrees));
+        EXPECT_GT(degrees, -180.f);
+        EXPECT_LE(degrees, 180.f);
+        // a clockwise circle runs at right angles to its radius
+        float expected = SkRadiansToDegrees(std::atan2(pos.y_ - CIRCLE_CENTER, pos.x_ - CIRCLE_CENTER)) + 90.f;
+        EXPECT_NEAR(std::remainder(degrees - expected, 360.f), 0.f, DEGREES_TOLERANCE);
+        if (i > 0) {
+            EXPECT_NEAR(std::remainder(degrees - lastDegrees, 360.f), 360.f / steps, DEGREES_TOLERANCE);
+        }
+        lastDegrees = degrees;
+    }
+}
+
+/**
+ * @tc.name: Contour001
+ * @tc.desc: only the first contour with a length is measured, empty paths have no positions
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSPathArcLengthTableTest, Contour001, TestSize.Level1)
+{
+    RSPathArcLengthTable table;
+    table.Build(*RSPath::CreateRSPath("M0 0 M10 10 L10 20 M100 100 L200 100"));
+    EXPECT_FLOAT_EQ(table.GetDistance(), 10.f);
+
+    table.Build(*RSPath::CreateRSPath(""));
+    EXPECT_TRUE(table.IsEmpty());
+    Vector2f pos;
+    float degrees = 0.f;
+    EXPECT_FALSE(table.GetPosTan(0.f, pos, degrees));
+}
+} // namespace OHOS::Rosen
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkMaskFilter.h"
+#include "include/core/SkPoint3.h"
+#include "include/core/SkSurface.h"
+#include "include/utils/SkShadowUtils.h"
+#include "include/property/rs_properties.h"
+#include "include/property/rs_properties_painter.h"
+#include "include/property/rs_shadow_cache.h"
+#include "rs_pixel_test_utils.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+namespace {
+constexpr int CANVAS_SIZE = 300;
+constexpr float SHADOW_RADIUS = 6.f;
+constexpr float SHADOW_ELEVATION = 12.f;
+constexpr float SHADOW_OFFSET = 4.f;
+constexpr float CORNER_RADIUS = 10.f;
+// spot shadows move faster than the node and are blitted at subpixel positions
+constexpr int MAX_SPOT_CHANNEL_DIFFERENCE = 8;
+const Vector4f BOUNDS = { 20.f, 30.f, 80.f, 50.f };
+} // namespace
+
+class RSShadowCacheTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+
+    static void InitProperties(RSProperties& properties, bool elevation)
+    {
+        properties.SetBounds(BOUNDS);
+        properties.SetCornerRadius(CORNER_RADIUS);
+        properties.SetShadowColor(Color(0, 0, 0, 200));
+        properties.SetShadowOffsetX(SHADOW_OFFSET);
+        properties.SetShadowOffsetY(SHADOW_OFFSET);
+        if (elevation) {
+            properties.SetShadowElevation(SHADOW_ELEVATION);
+        } else {
+            properties.SetShadowRadius(SHADOW_RADIUS);
+        }
+    }
+
+    // the shadow as drawn before it was cached
+    static void DrawShadowDirectly(const RSProperties& properties, bool elevation, SkCanvas& canvas)
+    {
+        SkRRect rrect = SkRRect::MakeRectXY(SkRect::MakeWH(BOUNDS.z_, BOUNDS.w_), CORNER_RADIUS, CORNER_RADIUS);
+        canvas.save();
+        canvas.clipRRect(rrect, SkClipOp::kDifference, true);
+        SkPath path;
+        path.addRRect(rrect);
+        path.offset(SHADOW_OFFSET, SHADOW_OFFSET);
+        SkColor color = properties.GetShadowColor().AsArgbInt();
+        if (elevation) {
+            SkPoint3 planeParams = { 0.f, 0.f, SHADOW_ELEVATION };
+            SkPoint3 lightPos = { DEFAULT_LIGHT_POSITION_X, DEFAULT_LIGHT_POSITION_Y, DEFAULT_LIGHT_HEIGHT };
+            SkShadowUtils::DrawShadow(&canvas, path, planeParams, lightPos, DEFAULT_LIGHT_RADIUS,
+                DEFAULT_AMBIENT_COLOR, color, SkShadowFlags::kTransparentOccluder_ShadowFlag);
+        } else {
+            SkPaint paint;
+            paint.setColor(color);
+            paint.setAntiAlias(true);
+            paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, SHADOW_RADIUS));
+            canvas.drawPath(path, paint);
+        }
+        canvas.restore();
+    }
+
+    // largest difference of a color channel between the shadow drawn by the painter and drawn directly, both moved
+    // by [dx, dy]
+    static int CompareShadow(bool elevation, float dx, float dy)
+    {
+        RSProperties properties;
+        InitProperties(properties, elevation);
+        SkBitmap bitmaps[2];
+        for (int i = 0; i < 2; i++) {
+            auto surface = RSPixelTestUtils::MakeSurface(CANVAS_SIZE, CANVAS_SIZE);
+            if (surface == nullptr) {
+                return -1;
+            }
+            auto canvas = surface->getCanvas();
+            canvas->clear(SK_ColorWHITE);
+            canvas->translate(dx, dy);
+            if (i == 0) {
+                DrawShadowDirectly(properties, elevation, *canvas);
+            } else {
+                RSPropertiesPainter::DrawShadow(properties, *canvas);
+            }
+            if (!RSPixelTestUtils::ReadPixels(*surface, bitmaps[i])) {
+                return -1;
+            }
+        }
+        return RSPixelTestUtils::MaxChannelDifference(bitmaps[0], bitmaps[1]);
+    }
+};
+
+void RSShadowCacheTest::SetUpTestCase() {}
+void RSShadowCacheTest::TearDownTestCase() {}
+void RSShadowCacheTest::SetUp()
+{
+    RSShadowCache::Instance().Clear();
+}
+void RSShadowCacheTest::TearDown()
+{
+    RSShadowCache::Instance().Clear();
+}
+
+/**
+ * @tc.name: BlurShadow001
+ * @tc.desc: radius shadows are drawn from the cache at any position, scaled ones are cached again
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSShadowCacheTest, BlurShadow001, TestSize.Level1)
+{
+    auto& cache = RSShadowCache::Instance();
+    int difference = CompareShadow(false, 40.f, 40.f);
+    EXPECT_GE(difference, 0);
+    EXPECT_LE(difference, RSPixelTestUtils::MAX_CHANNEL_DIFFERENCE);
+    EXPECT_EQ(cache.GetEntryCount(), 1u);
+    EXPECT_EQ(cache.GetHitCount(), 0u);
+
+    difference = CompareShadow(false, 137.f, 185.f);
+    EXPECT_GE(difference, 0);
+    EXPECT_LE(difference, RSPixelTestUtils::MAX_CHANNEL_DIFFERENCE);
+    EXPECT_EQ(cache.GetEntryCount(), 1u);
+    EXPECT_EQ(cache.GetHitCount(), 1u);
+
+    // a different scale is a different device space path
+    RSProperties properties;
+    InitProperties(properties, false);
+    auto surface = RSPixelTestUtils::MakeSurface(CANVAS_SIZE, CANVAS_SIZE);
+    ASSERT_NE(surface, nullptr);
+    surface->getCanvas()->scale(1.5f, 1.5f);
+    RSPropertiesPainter::DrawShadow(properties, *surface->getCanvas());
+    EXPECT_EQ(cache.GetEntryCount(), 2u);
+    EXPECT_GT(cache.GetMemoryUsage(), 0u);
+    EXPECT_LE(cache.GetMemoryUsage(), RSShadowCache::MAX_BYTES);
+}
+
+/**
+ * @tc.name: ElevationShadow001
+ * @tc.desc: ambient and spot parts of elevation shadows are drawn from the cache at any position
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSShadowCacheTest, ElevationShadow001, TestSize.Level1)
+{
+    auto& cache = RSShadowCache::Instance();
+    int difference = CompareShadow(true, 40.f, 40.f);
+    EXPECT_GE(difference, 0);
+    EXPECT_LE(difference, MAX_SPOT_CHANNEL_DIFFERENCE);
+    EXPECT_EQ(cache.GetEntryCount(), 2u);
+
+    difference = CompareShadow(true, 120.f, 150.f);
+    EXPECT_GE(difference, 0);
+    EXPECT_LE(difference, MAX_SPOT_CHANNEL_DIFFERENCE);
+    EXPECT_EQ(cache.GetEntryCount(), 2u);
+    EXPECT_EQ(cache.GetHitCount(), 2u);
+}
+
+/**
+ * @tc.name: Rotation001
+ * @tc.desc: shadows under a rotation are drawn directly
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSShadowCacheTest, Rotation001, TestSize.Level1)
+{
+    RSProperties properties;
+    InitProperties(properties, false);
+    auto surface = RSPixelTestUtils::MakeSurface(CANVAS_SIZE, CANVAS_SIZE);
+    ASSERT_NE(surface, nullptr);
+    surface->getCanvas()->rotate(15.f);
+    RSPropertiesPainter::DrawShadow(properties, *surface->getCanvas());
+    EXPECT_EQ(RSShadowCache::Instance().GetEntryCount(), 0u);
+}
+
+/**
+ * @tc.name: Lookup001
+ * @tc.desc: entries are found by path contents, a shadow put again replaces its entry, old entries are evicted
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSShadowCacheTest, Lookup001, TestSize.Level1)
+{
+    auto makeKey = [](float size) {
+        RSShadowCache::Key key;
+        key.path.addRoundRect(SkRect::MakeWH(size, size), CORNER_RADIUS, CORNER_RADIUS);
+        key.param = SHADOW_RADIUS;
+        key.color = SK_ColorBLACK;
+        RSShadowCache::UpdateHash(key);
+        return key;
+    };
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(CANVAS_SIZE, CANVAS_SIZE);
+    RSShadowCache::Shadow shadow;
+    shadow.image = SkImage::MakeFromBitmap(bitmap);
+
+    auto& cache = RSShadowCache::Instance();
+    cache.Put(makeKey(BOUNDS.z_), shadow);
+    cache.Put(makeKey(BOUNDS.z_), shadow);
+    EXPECT_EQ(cache.GetEntryCount(), 1u);
+    RSShadowCache::Shadow cached;
+    // an equal path built separately
+    EXPECT_TRUE(cache.Get(makeKey(BOUNDS.z_), cached));
+    EXPECT_EQ(cached.image, shadow.image);
+    EXPECT_FALSE(cache.Get(makeKey(BOUNDS.w_), cached));
+
+    // fill the budget, the least recently used entries go first
+    size_t entryBytes = shadow.image->imageInfo().computeMinByteSize();
+    size_t maxEntries = RSShadowCache::MAX_BYTES / entryBytes;
+    for (size_t i = 0; i < maxEntries; i++) {
+        cache.Put(makeKey(BOUNDS.z_ + 1 + i), shadow);
+    }
+    EXPECT_EQ(cache.GetEntryCount(), maxEntries);
+    EXPECT_LE(cache.GetMemoryUsage(), RSShadowCache::MAX_BYTES);
+    EXPECT_FALSE(cache.Get(makeKey(BOUNDS.z_), cached));
+    EXPECT_TRUE(cache.Get(makeKey(BOUNDS.z_ + 1), cached));
+}
+} // namespace OHOS::Rosen
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rs_pixel_test_utils.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace OHOS::Rosen {
+sk_sp<SkSurface> RSPixelTestUtils::MakeSurface(int width, int height)
+{
+    return SkSurface::MakeRasterN32Premul(width, height);
+}
+
+bool RSPixelTestUtils::ReadPixels(SkSurface& surface, SkBitmap& bitmap)
+{
+    bitmap.allocN32Pixels(surface.width(), surface.height());
+    return surface.readPixels(bitmap, 0, 0);
+}
+
+void RSPixelTestUtils::DrawCheckerboard(SkCanvas& canvas, int width, int height, int cellSize, SkColor evenColor,
+    SkColor oddColor)
+{
+    SkPaint paint;
+    for (int y = 0; y < height; y += cellSize) {
+        for (int x = 0; x < width; x += cellSize) {
+            paint.setColor(((x + y) / cellSize) % 2 ? oddColor : evenColor);
+            canvas.drawRect(SkRect::MakeXYWH(x, y, cellSize, cellSize), paint);
+        }
+    }
+}
+
+RSPixelTestUtils::Difference RSPixelTestUtils::Compare(const SkBitmap& lhs, const SkBitmap& rhs, const SkIRect& area,
+    bool compareAlpha)
+{
+    Difference difference;
+    if (lhs.dimensions() != rhs.dimensions() || !SkIRect::MakeSize(lhs.dimensions()).contains(area) ||
+        area.isEmpty()) {
+        return difference;
+    }
+    difference.max = 0;
+    double total = 0.0;
+    int count = 0;
+    for (int y = area.top(); y < area.bottom(); y++) {
+        for (int x = area.left(); x < area.right(); x++) {
+            SkColor lhsColor = lhs.getColor(x, y);
+            SkColor rhsColor = rhs.getColor(x, y);
+            int channels[] = {
+                std::abs(static_cast<int>(SkColorGetR(lhsColor) - SkColorGetR(rhsColor))),
+                std::abs(static_cast<int>(SkColorGetG(lhsColor) - SkColorGetG(rhsColor))),
+                std::abs(static_cast<int>(SkColorGetB(lhsColor) - SkColorGetB(rhsColor))),
+                std::abs(static_cast<int>(SkColorGetA(lhsColor) - SkColorGetA(rhsColor))),
+            };
+            int channelCount = compareAlpha ? 4 : 3;
+            for (int i = 0; i < channelCount; i++) {
+                difference.max = std::max(difference.max, channels[i]);
+                total += channels[i];
+                count++;
+            }
+        }
+    }
+    difference.mean = total / count;
+    return difference;
+}
+
+int RSPixelTestUtils::MaxChannelDifference(const SkBitmap& lhs, const SkBitmap& rhs, bool compareAlpha)
+{
+    return Compare(lhs, rhs, SkIRect::MakeSize(lhs.dimensions()), compareAlpha).max;
+}
+} // namespace OHOS::Rosen
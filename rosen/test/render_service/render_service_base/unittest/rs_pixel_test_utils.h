@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ROSEN_TEST_RENDER_SERVICE_BASE_RS_PIXEL_TEST_UTILS_H
+#define ROSEN_TEST_RENDER_SERVICE_BASE_RS_PIXEL_TEST_UTILS_H
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkSurface.h"
+
+namespace OHOS::Rosen {
+// Raster surfaces and pixel comparisons for tests that draw a scene through a faster path and through the one it
+// replaces.
+class RSPixelTestUtils {
+public:
+    // the same scene drawn in two ways may round a color channel differently by this much
+    static constexpr int MAX_CHANNEL_DIFFERENCE = 2;
+
+    struct Difference {
+        // largest difference of a channel, -1 if the pixels could not be compared
+        int max = -1;
+        double mean = 0.0;
+    };
+
+    static sk_sp<SkSurface> MakeSurface(int width, int height);
+
+    // copies all pixels of [surface] into [bitmap]
+    static bool ReadPixels(SkSurface& surface, SkBitmap& bitmap);
+
+    // squares of [cellSize] alternating between [evenColor] and [oddColor], starting at the top left corner
+    static void DrawCheckerboard(SkCanvas& canvas, int width, int height, int cellSize, SkColor evenColor,
+        SkColor oddColor);
+
+    // differences of the color channels of [lhs] and [rhs] within [area], and of their alpha with [compareAlpha]
+    static Difference Compare(const SkBitmap& lhs, const SkBitmap& rhs, const SkIRect& area,
+        bool compareAlpha = false);
+
+    // largest difference of a channel of all pixels, -1 if the bitmaps differ in size
+    static int MaxChannelDifference(const SkBitmap& lhs, const SkBitmap& rhs, bool compareAlpha = false);
+};
+} // namespace OHOS::Rosen
+
+#endif // ROSEN_TEST_RENDER_SERVICE_BASE_RS_PIXEL_TEST_UTILS_H